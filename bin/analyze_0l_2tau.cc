@@ -71,11 +71,7 @@
 #include "tthAnalysis/HiggsToTauTau/interface/Data_to_MC_CorrectionInterface_0l_2tau_trigger.h" // Data_to_MC_CorrectionInterface_0l_2tau_trigger
 #include "tthAnalysis/HiggsToTauTau/interface/cutFlowTable.h" // cutFlowTableType
 #include "tthAnalysis/HiggsToTauTau/interface/NtupleFillerBDT.h" // NtupleFillerBDT
-
-#include "TauAnalysis/ClassicSVfit/interface/ClassicSVfit.h"
-#include "TauAnalysis/ClassicSVfit/interface/MeasuredTauLepton.h"
-#include "TauAnalysis/ClassicSVfit/interface/svFitHistogramAdapter.h"
-#include "TauAnalysis/ClassicSVfit/interface/svFitAuxFunctions.h"
+#include "tthAnalysis/HiggsToTauTau/interface/SVfitInterface.h" // SVfitInterface
 
 #include <boost/range/algorithm/copy.hpp> // boost::copy()
 #include <boost/range/adaptor/map.hpp> // boost::adaptors::map_keys
@@ -318,6 +314,8 @@ int main(int argc, char* argv[])
   std::string selEventsFileName_output = cfg_analyze.getParameter<std::string>("selEventsFileName_output");
   std::cout << "selEventsFileName_output = " << selEventsFileName_output << std::endl;
 
+  SVfitInterface svFitInterface(5.);
+
   const bool selectBDT = [&cfg_analyze]() -> bool
   {
     if(cfg_analyze.exists("selectBDT"))
@@ -696,6 +694,32 @@ int main(int argc, char* argv[])
   CutFlowTableHistManager_0l_2tau* cutFlowHistManager = new CutFlowTableHistManager_0l_2tau(makeHistManager_cfg(process_string, 
     Form("%s/sel/cutFlow", histogramDir.data()), central_or_shift));
   cutFlowHistManager->bookHistograms(fs);
+//--- register the cuts once, so that the event loop refers to them by integer handles instead of looking up their names
+  enum { kCut_runLumiEvent, kCut_trigger, kCut_preselHadTaus, kCut_jets1, kCut_bJets1, kCut_selHadTaus,
+         kCut_noTightLeptons, kCut_jets2, kCut_bJets2, kCut_mll, kCut_leadHadTau, kCut_subleadHadTau, kCut_hadTauCharge,
+         kCut_signalRegionVeto, kNumCuts };
+  const std::string cutNames[kNumCuts] = {
+    "run:ls:event selection",
+    "trigger",
+    ">= 2 presel taus",
+    ">= 2 jets",
+    ">= 2 loose b-jets || 1 medium b-jet (1)",
+    ">= 2 sel taus",
+    "no tight leptons",
+    ">= 4 jets",
+    ">= 2 loose b-jets || 1 medium b-jet (2)",
+    "m(ll) > 12 GeV",
+    "lead hadTau pT > 40 GeV && abs(eta) < 2.1",
+    "sublead hadTau pT > 40 GeV && abs(eta) < 2.1",
+    Form("tau-pair %s charge", hadTauChargeSelection_string.data()),
+    "signal region veto"
+  };
+  int cutIdxs_histogram[kNumCuts];
+  for ( int idxCut = 0; idxCut < kNumCuts; ++idxCut ) {
+    const int cutIdx_table = cutFlowTable.registerCut(cutNames[idxCut]);
+    assert(cutIdx_table == idxCut);
+    cutIdxs_histogram[idxCut] = cutFlowHistManager->getCutIdx(idxCut == kCut_hadTauCharge ? "tau-pair OS/SS charge" : cutNames[idxCut]);
+  }
   for ( int idxEntry = 0; idxEntry < numEntries && (maxEvents == -1 || idxEntry < maxEvents); ++idxEntry ) {
     if ( idxEntry > 0 && (idxEntry % reportEvery) == 0 ) {
       std::cout << "processing Entry " << idxEntry << " (" << selectedEntries << " Entries selected)" << std::endl;
@@ -710,8 +734,8 @@ int main(int argc, char* argv[])
     inputTree->GetEntry(idxEntry);
 
     if ( run_lumi_eventSelector && !(*run_lumi_eventSelector)(run, lumi, event) ) continue;
-    cutFlowTable.update("run:ls:event selection");
-    cutFlowHistManager->fillHistograms("run:ls:event selection", lumiScale);
+    cutFlowTable.update(kCut_runLumiEvent);
+    cutFlowHistManager->fillHistograms(cutIdxs_histogram[kCut_runLumiEvent], lumiScale);
 
     if ( run_lumi_eventSelector ) {
       std::cout << "processing Entry " << idxEntry << ":"
@@ -751,8 +775,8 @@ int main(int argc, char* argv[])
       }
       continue;
     }
-    cutFlowTable.update("trigger");
-    cutFlowHistManager->fillHistograms("trigger", lumiScale);
+    cutFlowTable.update(kCut_trigger);
+    cutFlowHistManager->fillHistograms(cutIdxs_histogram[kCut_trigger], lumiScale);
 
 //--- build collections of electrons, muons and hadronic taus;
 //    resolve overlaps in order of priority: muon, electron,
@@ -845,8 +869,8 @@ int main(int argc, char* argv[])
     //  as sample of hadronic tau candidates passing loose preselection criteria contains significant contamination from jets)
     std::sort(preselHadTaus.begin(), preselHadTaus.end(), isHigherPt);
     if ( !(preselHadTaus.size() >= 2) ) continue;
-    cutFlowTable.update(">= 2 presel taus");
-    cutFlowHistManager->fillHistograms(">= 2 presel taus", lumiScale);
+    cutFlowTable.update(kCut_preselHadTaus);
+    cutFlowHistManager->fillHistograms(cutIdxs_histogram[kCut_preselHadTaus], lumiScale);
     const RecoHadTau* preselHadTau_lead = preselHadTaus[0];
     const RecoHadTau* preselHadTau_sublead = preselHadTaus[1];
     const hadTauGenMatchEntry& preselHadTau_genMatch = getHadTauGenMatch(hadTauGenMatch_definitions, preselHadTau_lead, preselHadTau_sublead);
@@ -857,11 +881,11 @@ int main(int argc, char* argv[])
 
     // apply requirement on jets (incl. b-tagged jets) on preselection level
     if ( !(selJets.size() >= 2) ) continue;
-    cutFlowTable.update(">= 2 jets");
-    cutFlowHistManager->fillHistograms(">= 2 jets", lumiScale);
+    cutFlowTable.update(kCut_jets1);
+    cutFlowHistManager->fillHistograms(cutIdxs_histogram[kCut_jets1], lumiScale);
     if ( !(selBJets_loose.size() >= 2 || selBJets_medium.size() >= 1) ) continue;
-    cutFlowTable.update(">= 2 loose b-jets || 1 medium b-jet (1)");
-    cutFlowHistManager->fillHistograms(">= 2 loose b-jets || 1 medium b-jet (1)", lumiScale);
+    cutFlowTable.update(kCut_bJets1);
+    cutFlowHistManager->fillHistograms(cutIdxs_histogram[kCut_bJets1], lumiScale);
 
 //--- compute MHT and linear MET discriminant (met_LD)
     RecoMEt met = metReader->read();
@@ -889,8 +913,8 @@ int main(int argc, char* argv[])
 //--- apply final event selection 
     // require presence of exactly two hadronic taus passing tight selection criteria of final event selection
     if ( !(selHadTaus.size() >= 2) ) continue;
-    cutFlowTable.update(">= 2 sel taus", lumiScale);
-    cutFlowHistManager->fillHistograms(">= 2 sel taus", lumiScale);
+    cutFlowTable.update(kCut_selHadTaus, lumiScale);
+    cutFlowHistManager->fillHistograms(cutIdxs_histogram[kCut_selHadTaus], lumiScale);
     const RecoHadTau* selHadTau_lead = selHadTaus[0];
     const RecoHadTau* selHadTau_sublead = selHadTaus[1];
     const hadTauGenMatchEntry& selHadTau_genMatch = getHadTauGenMatch(hadTauGenMatch_definitions, selHadTau_lead, selHadTau_sublead);
@@ -994,8 +1018,8 @@ int main(int argc, char* argv[])
       }
       continue;
     }
-    cutFlowTable.update("no tight leptons", evtWeight);
-    cutFlowHistManager->fillHistograms("no tight leptons", evtWeight);
+    cutFlowTable.update(kCut_noTightLeptons, evtWeight);
+    cutFlowHistManager->fillHistograms(cutIdxs_histogram[kCut_noTightLeptons], evtWeight);
 
     double weight_fakeRate = 1.;
     if ( applyFakeRateWeights == kFR_2tau) {
@@ -1019,11 +1043,11 @@ int main(int argc, char* argv[])
 
     // apply requirement on jets (incl. b-tagged jets) and hadronic taus on level of final event selection
     if ( !(selJets.size() >= 4) ) continue;
-    cutFlowTable.update(">= 4 jets", evtWeight);
-    cutFlowHistManager->fillHistograms(">= 4 jets", evtWeight);
+    cutFlowTable.update(kCut_jets2, evtWeight);
+    cutFlowHistManager->fillHistograms(cutIdxs_histogram[kCut_jets2], evtWeight);
     if ( !(selBJets_loose.size() >= 2 || selBJets_medium.size() >= 1) ) continue;
-    cutFlowTable.update(">= 2 loose b-jets || 1 medium b-jet (2)", evtWeight);
-    cutFlowHistManager->fillHistograms(">= 2 loose b-jets || 1 medium b-jet (2)", evtWeight);
+    cutFlowTable.update(kCut_bJets2, evtWeight);
+    cutFlowHistManager->fillHistograms(cutIdxs_histogram[kCut_bJets2], evtWeight);
  
     bool failsLowMassVeto = false;
     for ( std::vector<const RecoLepton*>::const_iterator lepton1 = preselLeptons.begin();
@@ -1042,28 +1066,28 @@ int main(int argc, char* argv[])
       }
       continue;
     }
-    cutFlowTable.update("m(ll) > 12 GeV", evtWeight);
-    cutFlowHistManager->fillHistograms("m(ll) > 12 GeV", evtWeight);
+    cutFlowTable.update(kCut_mll, evtWeight);
+    cutFlowHistManager->fillHistograms(cutIdxs_histogram[kCut_mll], evtWeight);
 
     if ( !(selHadTau_lead->pt() > 40. && selHadTau_lead->absEta() < 2.1) ) continue;
-    cutFlowTable.update("lead hadTau pT > 40 GeV && abs(eta) < 2.1", evtWeight);
-    cutFlowHistManager->fillHistograms("lead hadTau pT > 40 GeV && abs(eta) < 2.1", evtWeight);
+    cutFlowTable.update(kCut_leadHadTau, evtWeight);
+    cutFlowHistManager->fillHistograms(cutIdxs_histogram[kCut_leadHadTau], evtWeight);
 
     if ( !(selHadTau_sublead->pt() > 40. && selHadTau_sublead->absEta() < 2.1) ) continue;
-    cutFlowTable.update("sublead hadTau pT > 40 GeV && abs(eta) < 2.1", evtWeight);
-    cutFlowHistManager->fillHistograms("sublead hadTau pT > 40 GeV && abs(eta) < 2.1", evtWeight);
+    cutFlowTable.update(kCut_subleadHadTau, evtWeight);
+    cutFlowHistManager->fillHistograms(cutIdxs_histogram[kCut_subleadHadTau], evtWeight);
 
     bool isCharge_SS = selHadTau_lead->charge()*selHadTau_sublead->charge() > 0;
     bool isCharge_OS = selHadTau_lead->charge()*selHadTau_sublead->charge() < 0;
     if ( hadTauChargeSelection == kOS && isCharge_SS ) continue;
     if ( hadTauChargeSelection == kSS && isCharge_OS ) continue;
-    cutFlowTable.update(Form("tau-pair %s charge", hadTauChargeSelection_string.data()), evtWeight);
-    cutFlowHistManager->fillHistograms("tau-pair OS/SS charge", evtWeight);
+    cutFlowTable.update(kCut_hadTauCharge, evtWeight);
+    cutFlowHistManager->fillHistograms(cutIdxs_histogram[kCut_hadTauCharge], evtWeight);
     
     if ( hadTauSelection == kFakeable ) {
       if ( tightHadTaus_lead.size() >= 1 && tightHadTaus_sublead.size() >= 1 ) continue; // CV: avoid overlap with signal region
-      cutFlowTable.update("signal region veto", evtWeight);
-      cutFlowHistManager->fillHistograms("signal region veto", evtWeight);
+      cutFlowTable.update(kCut_signalRegionVeto, evtWeight);
+      cutFlowHistManager->fillHistograms(cutIdxs_histogram[kCut_signalRegionVeto], evtWeight);
     }
     
 //--- reconstruct mass of tau-pair using SVfit algorithm
@@ -1072,21 +1096,9 @@ int main(int argc, char* argv[])
 //          because the algorithm takes O(1 second per event) to run
 //
     std::vector<classic_svFit::MeasuredTauLepton> measuredTauLeptons;
-    classic_svFit::MeasuredTauLepton::kDecayType leg1Type = classic_svFit::MeasuredTauLepton::kTauToHadDecay;
-    double leg1Mass = selHadTau_lead->mass();
-    if ( leg1Mass < classic_svFit::chargedPionMass ) leg1Mass = classic_svFit::chargedPionMass;
-    if ( leg1Mass > 1.5                            ) leg1Mass = 1.5;
-    classic_svFit::MeasuredTauLepton::kDecayType leg2Type = classic_svFit::MeasuredTauLepton::kTauToHadDecay;
-    double leg2Mass = selHadTau_sublead->mass();
-    if ( leg2Mass < classic_svFit::chargedPionMass ) leg2Mass = classic_svFit::chargedPionMass;
-    if ( leg2Mass > 1.5                            ) leg2Mass = 1.5;
-    measuredTauLeptons.push_back(classic_svFit::MeasuredTauLepton(leg1Type, selHadTau_lead->pt(), selHadTau_lead->eta(), selHadTau_lead->phi(), leg1Mass));
-    measuredTauLeptons.push_back(classic_svFit::MeasuredTauLepton(leg2Type, selHadTau_sublead->pt(), selHadTau_sublead->eta(), selHadTau_sublead->phi(), leg2Mass));
-    ClassicSVfit svFitAlgo;
-    svFitAlgo.addLogM_dynamic(false);
-    svFitAlgo.addLogM_fixed(true, 5.);
-    svFitAlgo.integrate(measuredTauLeptons, met.p4().px(), met.p4().py(), met.cov());
-    double mTauTau = ( svFitAlgo.isValidSolution() ) ? static_cast<classic_svFit::DiTauSystemHistogramAdapter*>(svFitAlgo.getHistogramAdapter())->getMass() : -1.;
+    measuredTauLeptons.push_back(SVfitInterface::getMeasuredTauLepton(selHadTau_lead));
+    measuredTauLeptons.push_back(SVfitInterface::getMeasuredTauLepton(selHadTau_sublead));
+    double mTauTau = svFitInterface(measuredTauLeptons, met);
 
 //--- compute output of BDTs used to discriminate ttH vs. ttbar trained by Arun for 1l_2tau category
     mvaInputs_ttbar["nJet"]                 = selJets.size();
@@ -69,12 +69,9 @@
 #include "tthAnalysis/HiggsToTauTau/interface/Data_to_MC_CorrectionInterface_1l_1tau_trigger.h" // Data_to_MC_CorrectionInterface_1l_1tau_trigger
 #include "tthAnalysis/HiggsToTauTau/interface/cutFlowTable.h" // cutFlowTableType
 #include "tthAnalysis/HiggsToTauTau/interface/NtupleFillerBDT.h" // NtupleFillerBDT
+#include "tthAnalysis/HiggsToTauTau/interface/SVfitInterface.h" // SVfitInterface
 #include "tthAnalysis/HiggsToTauTau/interface/TTreeWrapper.h" // TTreeWrapper
 
-#include "TauAnalysis/ClassicSVfit/interface/ClassicSVfit.h"
-#include "TauAnalysis/ClassicSVfit/interface/MeasuredTauLepton.h"
-#include "TauAnalysis/ClassicSVfit/interface/svFitHistogramAdapter.h"
-#include "TauAnalysis/ClassicSVfit/interface/svFitAuxFunctions.h"
 
 #include <iostream> // std::cerr, std::fixed
 #include <iomanip> // std::setprecision(), std::setw()
@@ -350,6 +347,8 @@ int main(int argc, char* argv[])
   std::string selEventsFileName_output = cfg_analyze.getParameter<std::string>("selEventsFileName_output");
   std::cout << "selEventsFileName_output = " << selEventsFileName_output << std::endl;
 
+  SVfitInterface svFitInterface(4.);
+
   const bool selectBDT = [&cfg_analyze]() -> bool
   {
     if(cfg_analyze.exists("selectBDT"))
@@ -1268,26 +1267,9 @@ int main(int argc, char* argv[])
 //          because the algorithm takes O(1 second per event) to run
 //
     std::vector<classic_svFit::MeasuredTauLepton> measuredTauLeptons;
-    classic_svFit::MeasuredTauLepton::kDecayType leg1Type = classic_svFit::MeasuredTauLepton::kUndefinedDecayType;
-    double leg1Mass;
-    if ( std::abs(selLepton->pdgId()) == 11 ) {
-      leg1Type = classic_svFit::MeasuredTauLepton::kTauToElecDecay;
-      leg1Mass = classic_svFit::electronMass;
-    } else if ( std::abs(selLepton->pdgId()) == 13 ) {
-      leg1Type = classic_svFit::MeasuredTauLepton::kTauToMuDecay;
-      leg1Mass = classic_svFit::muonMass;
-    } else assert(0);
-    classic_svFit::MeasuredTauLepton::kDecayType leg2Type = classic_svFit::MeasuredTauLepton::kTauToHadDecay;
-    double leg2Mass = selHadTau->mass();
-    if ( leg2Mass < classic_svFit::chargedPionMass ) leg2Mass = classic_svFit::chargedPionMass;
-    if ( leg2Mass > 1.5                            ) leg2Mass = 1.5;
-    measuredTauLeptons.push_back(classic_svFit::MeasuredTauLepton(leg1Type, selLepton->pt(), selLepton->eta(), selLepton->phi(), leg1Mass));
-    measuredTauLeptons.push_back(classic_svFit::MeasuredTauLepton(leg2Type, selHadTau->pt(), selHadTau->eta(), selHadTau->phi(), leg2Mass));
-    ClassicSVfit svFitAlgo;
-    svFitAlgo.addLogM_dynamic(false);
-    svFitAlgo.addLogM_fixed(true, 4.);
-    svFitAlgo.integrate(measuredTauLeptons, met.p4().px(), met.p4().py(), met.cov());
-    double mTauTau = ( svFitAlgo.isValidSolution() ) ? static_cast<classic_svFit::DiTauSystemHistogramAdapter*>(svFitAlgo.getHistogramAdapter())->getMass() : -1.;
+    measuredTauLeptons.push_back(SVfitInterface::getMeasuredTauLepton(selLepton));
+    measuredTauLeptons.push_back(SVfitInterface::getMeasuredTauLepton(selHadTau));
+    double mTauTau = svFitInterface(measuredTauLeptons, met);
 
 //--- compute output of BDTs used to discriminate ttH vs. ttbar trained by Arun for 1l_2tau category
     mvaInputs_ttbar["lep_pt"]              = selLepton->pt();
@@ -1432,6 +1414,8 @@ int main(int argc, char* argv[])
   cutFlowTable.print(std::cout);
   std::cout << std::endl;
 
+  std::cout << std::endl;
+
   std::cout << "sel. Entries by gen. matching:" << std::endl;
   for ( std::vector<leptonGenMatchEntry>::const_iterator leptonGenMatch_definition = leptonGenMatch_definitions.begin();
 	leptonGenMatch_definition != leptonGenMatch_definitions.end(); ++leptonGenMatch_definition ) {
@@ -39,6 +39,7 @@
 #include "tthAnalysis/HiggsToTauTau/interface/EventInfoReader.h" // EventInfoReader, EventInfo
 #include "tthAnalysis/HiggsToTauTau/interface/convert_to_ptrs.h" // convert_to_ptrs
 #include "tthAnalysis/HiggsToTauTau/interface/ParticleCollectionCleaner.h" // RecoElectronCollectionCleaner, RecoMuonCollectionCleaner, RecoHadTauCollectionCleaner, RecoJetCollectionCleaner
+#include "tthAnalysis/HiggsToTauTau/interface/EventGeometry.h" // EventGeometry
 #include "tthAnalysis/HiggsToTauTau/interface/ParticleCollectionGenMatcher.h" // RecoElectronCollectionGenMatcher, RecoMuonCollectionGenMatcher, RecoHadTauCollectionGenMatcher, RecoJetCollectionGenMatcher
 #include "tthAnalysis/HiggsToTauTau/interface/RecoElectronCollectionSelectorLoose.h" // RecoElectronCollectionSelectorLoose
 #include "tthAnalysis/HiggsToTauTau/interface/RecoElectronCollectionSelectorFakeable.h" // RecoElectronCollectionSelectorFakeable
@@ -52,6 +53,7 @@
 #include "tthAnalysis/HiggsToTauTau/interface/RecoJetCollectionSelector.h" // RecoJetCollectionSelector
 #include "tthAnalysis/HiggsToTauTau/interface/RecoJetCollectionSelectorBtag.h" // RecoJetCollectionSelectorBtagLoose, RecoJetCollectionSelectorBtagMedium
 #include "tthAnalysis/HiggsToTauTau/interface/RunLumiEventSelector.h" // RunLumiEventSelector
+#include "tthAnalysis/HiggsToTauTau/interface/EventIndex.h" // EventIndex
 #include "tthAnalysis/HiggsToTauTau/interface/ElectronHistManager.h" // ElectronHistManager
 #include "tthAnalysis/HiggsToTauTau/interface/MuonHistManager.h" // MuonHistManager
 #include "tthAnalysis/HiggsToTauTau/interface/HadTauHistManager.h" // HadTauHistManager
@@ -63,10 +65,14 @@
 #include "tthAnalysis/HiggsToTauTau/interface/WeightHistManager.h" // WeightHistManager
 #include "tthAnalysis/HiggsToTauTau/interface/GenEvtHistManager.h" // GenEvtHistManager
 #include "tthAnalysis/HiggsToTauTau/interface/LHEInfoHistManager.h" // LHEInfoHistManager
+#include "tthAnalysis/HiggsToTauTau/interface/LHEWeightEngine.h" // LHEWeightEngine
+#include "tthAnalysis/HiggsToTauTau/interface/EventWeightCalculator.h" // EventWeightCalculator
 #include "tthAnalysis/HiggsToTauTau/interface/leptonTypes.h" // getLeptonType, kElectron, kMuon
 #include "tthAnalysis/HiggsToTauTau/interface/analysisAuxFunctions.h" // getBranchName_bTagWeight, getHadTau_genPdgId, isHigherPt, isMatched
 #include "tthAnalysis/HiggsToTauTau/interface/leptonGenMatchingAuxFunctions.h" // getLeptonGenMatch_definitions_1lepton, getLeptonGenMatch_string, getLeptonGenMatch_int
 #include "tthAnalysis/HiggsToTauTau/interface/hadTauGenMatchingAuxFunctions.h" // getHadTauGenMatch_definitions_1tau, getHadTauGenMatch_string, getHadTauGenMatch_int
+#include "tthAnalysis/HiggsToTauTau/interface/HistManagerDispatchTable.h" // HistManagerDispatchTable, getNumGenMatches
+#include "tthAnalysis/HiggsToTauTau/interface/HistogramTemplateSet.h" // HistogramTemplateSet
 #include "tthAnalysis/HiggsToTauTau/interface/fakeBackgroundAuxFunctions.h" // getWeight_2L, getWeight_3L
 #include "tthAnalysis/HiggsToTauTau/interface/backgroundEstimation.h" // prob_chargeMisId
 #include "tthAnalysis/HiggsToTauTau/interface/hltPath.h" // hltPath, create_hltPaths, hltPaths_setBranchAddresses, hltPaths_isTriggered, hltPaths_delete
@@ -76,11 +82,13 @@
 #include "tthAnalysis/HiggsToTauTau/interface/NtupleFillerBDT.h" // NtupleFillerBDT
 #include "tthAnalysis/HiggsToTauTau/interface/HadTopTagger.h" // HadTopTagger
 #include "tthAnalysis/HiggsToTauTau/interface/TTreeWrapper.h" // TTreeWrapper
+#include "tthAnalysis/HiggsToTauTau/interface/EventLoopProfiler.h" // EventLoopProfiler
 
 #include <iostream> // std::cerr, std::fixed
 #include <iomanip> // std::setprecision(), std::setw()
 #include <string> // std::string
 #include <vector> // std::vector<>
+#include <memory> // std::shared_ptr<>, std::make_shared<>()
 #include <cstdlib> // EXIT_SUCCESS, EXIT_FAILURE
 #include <algorithm> // std::sort
 #include <fstream> // std::ofstream
@@ -100,13 +108,14 @@ double comp_mvaOutput_Hj_tagger(const RecoJet* jet,
                                 const std::vector<const RecoLepton*>& leptons,
                                 std::map<std::string, double>& mvaInputs_Hj_tagger,
                                 TMVAInterface& mva_Hj_tagger,
-                                const EventInfo & eventInfo)
+                                const EventInfo & eventInfo,
+                                const EventGeometry& geometry)
 {
   double dRmin_lepton = -1.;
   double dRmax_lepton = -1.;
   for ( std::vector<const RecoLepton*>::const_iterator lepton = leptons.begin();
 	lepton != leptons.end(); ++lepton ) {
-    double dR = deltaR(jet->eta(), jet->phi(), (*lepton)->eta(), (*lepton)->phi());
+    double dR = geometry.dR(*jet, **lepton);
     if ( dRmin_lepton == -1. || dR < dRmin_lepton ) dRmin_lepton = dR;
     if ( dRmax_lepton == -1. || dR > dRmax_lepton ) dRmax_lepton = dR;
   }
@@ -123,21 +132,19 @@ double comp_mvaOutput_Hj_tagger(const RecoJet* jet,
   return mvaOutput_Hj_tagger;
 }
 
-double comp_mvaOutput_Hjj_tagger(const RecoJet* jet1, const RecoJet* jet2, const std::vector<const RecoJet*>& jets,
+/**
+ * @brief Computes output of the Hjj tagger for a pair of jets,
+ *        given the outputs of the Hj tagger for the two jets (computed once per jet by the caller)
+ */
+double comp_mvaOutput_Hjj_tagger(const RecoJet* jet1, double jet1_mvaOutput_Hj_tagger,
+                                 const RecoJet* jet2, double jet2_mvaOutput_Hj_tagger,
+                                 const std::vector<const RecoJet*>& jets,
 				 const std::vector<const RecoLepton*>& leptons,
 				 std::map<std::string, double>& mvaInputs_Hjj_tagger, TMVAInterface& mva_Hjj_tagger,
-				 std::map<std::string, double>& mvaInputs_Hj_tagger, TMVAInterface& mva_Hj_tagger,
-                 const EventInfo & eventInfo)
+                 const EventInfo & eventInfo,
+                 const EventGeometry& geometry)
 {
-  double jet1_mvaOutput_Hj_tagger = comp_mvaOutput_Hj_tagger(
-    jet1, leptons,
-    mvaInputs_Hj_tagger, mva_Hj_tagger,
-    eventInfo);
-  double jet2_mvaOutput_Hj_tagger = comp_mvaOutput_Hj_tagger(
-    jet2, leptons,
-    mvaInputs_Hj_tagger, mva_Hj_tagger,
-    eventInfo);
-  Particle::LorentzVector dijetP4 = jet1->p4() + jet2->p4();
+  Particle::LorentzVectorCartesian dijetP4 = jet1->p4_cartesian() + jet2->p4_cartesian();
   const RecoLepton* lepton_nearest = 0;
   double dRmin_lepton = -1.;
   for ( std::vector<const RecoLepton*>::const_iterator lepton = leptons.begin();
@@ -157,9 +164,9 @@ double comp_mvaOutput_Hjj_tagger(const RecoJet* jet1, const RecoJet* jet2, const
     if ( dRmin_jet_other == -1. || dR < dRmin_jet_other ) dRmin_jet_other = dR;
     if ( dRmax_jet_other == -1. || dR > dRmax_jet_other ) dRmax_jet_other = dR;
   }
-  mvaInputs_Hjj_tagger["bdtJetPair_minlepmass"] = ( lepton_nearest ) ? (dijetP4 + lepton_nearest->p4()).mass() : 0.;
+  mvaInputs_Hjj_tagger["bdtJetPair_minlepmass"] = ( lepton_nearest ) ? (dijetP4 + lepton_nearest->p4_cartesian()).mass() : 0.;
   mvaInputs_Hjj_tagger["bdtJetPair_sumbdt"] = jet1_mvaOutput_Hj_tagger + jet2_mvaOutput_Hj_tagger;
-  mvaInputs_Hjj_tagger["bdtJetPair_dr"] = deltaR(jet1->eta(), jet1->phi(), jet2->eta(), jet2->phi());
+  mvaInputs_Hjj_tagger["bdtJetPair_dr"] = geometry.dR(*jet1, *jet2);
   mvaInputs_Hjj_tagger["bdtJetPair_minjdr"] = dRmin_jet_other;
   mvaInputs_Hjj_tagger["bdtJetPair_mass"] = dijetP4.mass();
   mvaInputs_Hjj_tagger["bdtJetPair_minjOvermaxjdr"] = ( dRmax_jet_other > 0. ) ? dRmin_jet_other/dRmax_jet_other : 1.;
@@ -255,6 +262,7 @@ int main(int argc, char* argv[])
   std::vector<leptonGenMatchEntry> leptonGenMatch_definitions = getLeptonGenMatch_definitions_2lepton(apply_leptonGenMatching);
   std::cout << "leptonGenMatch_definitions:" << std::endl;
   std::cout << leptonGenMatch_definitions;
+  leptonGenMatchLookupTable leptonGenMatch_lookupTable(leptonGenMatch_definitions);
   bool apply_leptonGenMatching_ttZ_workaround = cfg_analyze.getParameter<bool>("apply_leptonGenMatching_ttZ_workaround");
   std::cout << "apply_leptonGenMatching_ttZ_workaround = " << apply_leptonGenMatching_ttZ_workaround << std::endl;
 
@@ -275,6 +283,7 @@ int main(int argc, char* argv[])
   std::vector<hadTauGenMatchEntry> hadTauGenMatch_definitions = getHadTauGenMatch_definitions_1tau(apply_hadTauGenMatching);
   std::cout << "hadTauGenMatch_definitions:" << std::endl;
   std::cout << hadTauGenMatch_definitions;
+  hadTauGenMatchLookupTable hadTauGenMatch_lookupTable(hadTauGenMatch_definitions);
 
   std::string chargeSumSelection_string = cfg_analyze.getParameter<std::string>("chargeSumSelection");
   int chargeSumSelection = -1;
@@ -373,6 +382,42 @@ int main(int argc, char* argv[])
     }
   }
 
+//--- fill histograms of the final discriminants for all LHE scale and PDF variations in the same event loop,
+//    instead of running one job per central_or_shift = "CMS_ttHl_thu_shape_*" value
+  bool fillHistograms_lheVariations = ( cfg_analyze.exists("fillHistograms_lheVariations") ) ? cfg_analyze.getParameter<bool>("fillHistograms_lheVariations") : false;
+  LHEWeightEngine* lheWeightEngine = 0;
+  if ( fillHistograms_lheVariations ) {
+    if ( !isMC || central_or_shift != "central" ) throw cms::Exception("analyze_2lss_1tau")
+      << "Configuration parameter 'fillHistograms_lheVariations' requires MC and central_or_shift = 'central' !!\n";
+    std::string lheScaleShiftName = "CMS_ttHl_thu_shape";
+    if      ( process_string == "signal" ) lheScaleShiftName += "_ttH";
+    else if ( process_string == "TTW"    ) lheScaleShiftName += "_ttW";
+    else if ( process_string == "TTZ"    ) lheScaleShiftName += "_ttZ";
+    std::string lhePdfShiftName = ( cfg_analyze.exists("lhePdfShiftName") ) ? cfg_analyze.getParameter<std::string>("lhePdfShiftName") : "CMS_ttHl_pdf";
+    int numWeights_pdf = ( cfg_analyze.exists("numWeights_pdf") ) ? cfg_analyze.getParameter<int>("numWeights_pdf") : 0;
+    lheWeightEngine = new LHEWeightEngine(lheScaleShiftName, lhePdfShiftName, numWeights_pdf);
+    std::cout << "filling histograms for " << lheWeightEngine->getNumVariations() << " LHE scale and PDF variations" << std::endl;
+  }
+
+//--- register the components of the event weight, together with the shifts that change their values
+//   (the shifts of the other components are applied by the reader and interface classes configured for central_or_shift)
+  std::vector<std::string> evtWeight_shifts;
+  if ( central_or_shift != "central" ) evtWeight_shifts.push_back(central_or_shift);
+  EventWeightCalculator evtWeightCalculator(evtWeight_shifts);
+  const int idxEvtWeight_shift = evtWeightCalculator.getShiftIndex(central_or_shift);
+  const int idxEvtWeight_lumiScale = evtWeightCalculator.addComponent("lumiScale");
+  const int idxEvtWeight_genWeightSign = evtWeightCalculator.addComponent("genWeightSign");
+  const int idxEvtWeight_genWeight_tH = evtWeightCalculator.addComponent("genWeight_tH");
+  const int idxEvtWeight_pileupWeight = evtWeightCalculator.addComponent("pileupWeight");
+  const int idxEvtWeight_lheScale = evtWeightCalculator.addComponent("lheScale",
+    ( lheScale_option != kLHE_scale_central ) ? evtWeight_shifts : std::vector<std::string>());
+  const int idxEvtWeight_btagWeight = evtWeightCalculator.addComponent("btagWeight");
+  const int idxEvtWeight_triggerEff = evtWeightCalculator.addComponent("triggerEff");
+  const int idxEvtWeight_data_to_MC_correction = evtWeightCalculator.addComponent("data_to_MC_correction");
+  const int idxEvtWeight_fakeRate = evtWeightCalculator.addComponent("fakeRate");
+  const int idxEvtWeight_hadTauFakeRateSF = evtWeightCalculator.addComponent("hadTauFakeRateSF");
+  const int idxEvtWeight_chargeMisId = evtWeightCalculator.addComponent("chargeMisId");
+
   edm::ParameterSet cfg_dataToMCcorrectionInterface;
   cfg_dataToMCcorrectionInterface.addParameter<std::string>("era", era_string);
   cfg_dataToMCcorrectionInterface.addParameter<std::string>("hadTauSelection", hadTauSelection_part2);
@@ -431,6 +476,21 @@ int main(int argc, char* argv[])
 
   std::string selEventsFileName_output = cfg_analyze.getParameter<std::string>("selEventsFileName_output");
 
+//--- read only the TTree entries listed in the event index sidecar files written by produceNtuple/preselNtuple_*;
+//    if selEventsFileName_input is given, the entries are further restricted to the events listed in that file
+  vstring eventIndexFileNames_input = cfg_analyze.getParameter<vstring>("eventIndexFileNames_input");
+  EventIndex* eventIndex = 0;
+  if ( !eventIndexFileNames_input.empty() ) {
+    eventIndex = new EventIndex();
+    for ( vstring::const_iterator eventIndexFileName = eventIndexFileNames_input.begin();
+          eventIndexFileName != eventIndexFileNames_input.end(); ++eventIndexFileName ) {
+      eventIndex->read(*eventIndexFileName);
+    }
+    if ( selEventsFileName_input != "" ) {
+      eventIndex->readEventList(selEventsFileName_input);
+    }
+  }
+
   fwlite::InputSource inputFiles(cfg);
   int maxEvents = inputFiles.maxEvents();
   std::cout << " maxEvents = " << maxEvents << std::endl;
@@ -440,6 +500,15 @@ int main(int argc, char* argv[])
   fwlite::TFileService fs = fwlite::TFileService(outputFile.file().data());
 
   TTreeWrapper * inputTree = new TTreeWrapper(treeName.data(), inputFiles.files(), maxEvents);
+  if ( eventIndex ) {
+    inputTree -> setEventIndex(eventIndex);
+  }
+
+//--- break the time spent in the event loop down into stages;
+//    switching between stages costs a few ns, so the profiler is always enabled
+  EventLoopProfiler profiler("analyze_2lss_1tau");
+  const std::size_t counter_hadTopTagger = profiler.addCounter("hadTopTagger jet triplets");
+  inputTree -> setProfiler(&profiler);
 
   std::cout << "Loaded " << inputTree -> getFileCount() << " file(s).\n";
 
@@ -453,7 +522,9 @@ int main(int argc, char* argv[])
     inputTree -> registerReader(hltPaths);
   }
 
-//--- declare particle collections
+//--- declare particle collections;
+//    the distances between the particles of each event are cached, so that they are shared by the overlap removal and the MVA input variables
+  EventGeometry geometry;
   const bool readGenObjects = isMC && !redoGenMatching;
   RecoMuonReader* muonReader = new RecoMuonReader(era, Form("n%s", branchName_muons.data()), branchName_muons, readGenObjects);
   if ( use_HIP_mitigation_mediumMuonId ) muonReader->enable_HIP_mitigation();
@@ -468,6 +539,7 @@ int main(int argc, char* argv[])
   inputTree -> registerReader(electronReader);
   RecoElectronCollectionGenMatcher electronGenMatcher;
   RecoElectronCollectionCleaner electronCleaner(0.3);
+  electronCleaner.setGeometry(&geometry);
   RecoElectronCollectionSelectorLoose preselElectronSelector(era);
   RecoElectronCollectionSelectorFakeable fakeableElectronSelector(era);
   RecoElectronCollectionSelectorTight tightElectronSelector(era);
@@ -477,6 +549,7 @@ int main(int argc, char* argv[])
   inputTree -> registerReader(hadTauReader);
   RecoHadTauCollectionGenMatcher hadTauGenMatcher;
   RecoHadTauCollectionCleaner hadTauCleaner(0.3);
+  hadTauCleaner.setGeometry(&geometry);
   RecoHadTauCollectionSelectorLoose preselHadTauSelector(era);
   if ( hadTauSelection_part2 == "dR03mvaVLoose" || hadTauSelection_part2 == "dR03mvaVVLoose" ) preselHadTauSelector.set(hadTauSelection_part2);
   preselHadTauSelector.set_min_antiElectron(hadTauSelection_antiElectron);
@@ -500,6 +573,7 @@ int main(int argc, char* argv[])
   inputTree -> registerReader(jetReader);
   RecoJetCollectionGenMatcher jetGenMatcher;
   RecoJetCollectionCleaner jetCleaner(0.4);
+  jetCleaner.setGeometry(&geometry);
   RecoJetCollectionSelector jetSelector(era);
   RecoJetCollectionSelectorBtagLoose jetSelectorBtagLoose(era);
   RecoJetCollectionSelectorBtagMedium jetSelectorBtagMedium(era);
@@ -693,8 +767,9 @@ int main(int argc, char* argv[])
     MEtHistManager* met_;
     EvtHistManager_2lss_1tau* evt_;
   };
-  typedef std::map<int, preselHistManagerType*> int_to_preselHistManagerMap;
-  std::map<int, int_to_preselHistManagerMap> preselHistManagers;
+  const int numLeptonGenMatches = getNumGenMatches(leptonGenMatch_definitions);
+  const int numHadTauGenMatches = getNumGenMatches(hadTauGenMatch_definitions);
+  HistManagerDispatchTable<preselHistManagerType> preselHistManagers(numLeptonGenMatches, numHadTauGenMatches);
   struct selHistManagerType
   {
     ElectronHistManager* electrons_;
@@ -721,12 +796,28 @@ int main(int argc, char* argv[])
     MVAInputVarHistManager* mvaInputVariables_2lss_;
     MVAInputVarHistManager* mvaInputVariables_2lss_1tau_;
     EvtHistManager_2lss_1tau* evt_;
-    std::map<std::string, EvtHistManager_2lss_1tau*> evt_in_decayModes_;
+    std::vector<EvtHistManager_2lss_1tau*> evt_in_decayModes_; // indexed by EventInfo::getDecayModeIdx()
     std::map<std::string, EvtHistManager_2lss_1tau*> evt_in_categories_;
     WeightHistManager* weights_;
+    LHEInfoHistManager* lheVariations_;
   };
-  typedef std::map<int, selHistManagerType*> int_to_selHistManagerMap;
-  std::map<int, int_to_selHistManagerMap> selHistManagers;
+  HistManagerDispatchTable<selHistManagerType> selHistManagers(numLeptonGenMatches, numHadTauGenMatches);
+//--- the histograms for the LHE scale and PDF variations have the same binning as in EvtHistManager_2lss_1tau;
+//    the binning is shared by all variations and by the histograms of all generator level matches
+  std::shared_ptr<HistogramTemplateSet> lheVariations_templates;
+  int idxLHEVariations_mvaDiscr_2lss = -1;
+  int idxLHEVariations_mvaDiscr_2lss_1tau = -1;
+  int idxLHEVariations_mvaDiscr_2lss_1tau_wMEM = -1;
+  if ( lheWeightEngine ) {
+    lheVariations_templates = std::make_shared<HistogramTemplateSet>();
+    int numBins_mvaDiscr_2lss = ( era == kEra_2015 ) ? 6 : 7;
+    idxLHEVariations_mvaDiscr_2lss = lheVariations_templates->add1D(
+      "mvaDiscr_2lss", "mvaDiscr_2lss", numBins_mvaDiscr_2lss, 0.5, numBins_mvaDiscr_2lss + 0.5);
+    idxLHEVariations_mvaDiscr_2lss_1tau = lheVariations_templates->add1D(
+      "mvaDiscr_2lss_1tau", "mvaDiscr_2lss_1tau", 8, 0.5, 8.5);
+    idxLHEVariations_mvaDiscr_2lss_1tau_wMEM = lheVariations_templates->add1D(
+      "mvaDiscr_2lss_1tau_wMEM", "mvaDiscr_2lss_1tau_wMEM", 8, 0.5, 8.5);
+  }
   for ( std::vector<leptonGenMatchEntry>::const_iterator leptonGenMatch_definition = leptonGenMatch_definitions.begin();
 	leptonGenMatch_definition != leptonGenMatch_definitions.end(); ++leptonGenMatch_definition ) {
     for ( std::vector<hadTauGenMatchEntry>::const_iterator hadTauGenMatch_definition = hadTauGenMatch_definitions.begin();
@@ -765,7 +856,7 @@ int main(int argc, char* argv[])
       preselHistManager->evt_ = new EvtHistManager_2lss_1tau(makeHistManager_cfg(process_and_genMatch,
         Form("%s/presel/evt", histogramDir.data()), era_string, central_or_shift));
       preselHistManager->evt_->bookHistograms(fs);
-      preselHistManagers[idxLepton][idxHadTau] = preselHistManager;
+      preselHistManagers.set(idxLepton, idxHadTau, preselHistManager);
 
       selHistManagerType* selHistManager = new selHistManagerType();
       selHistManager->electrons_ = new ElectronHistManager(makeHistManager_cfg(process_and_genMatch,
@@ -832,19 +923,27 @@ int main(int argc, char* argv[])
           if(apply_leptonGenMatching && apply_hadTauGenMatching) decayMode_and_genMatch += "&";
           if(apply_hadTauGenMatching)                            decayMode_and_genMatch += hadTauGenMatch_definition -> name_;
 
-          selHistManager -> evt_in_decayModes_[decayMode_evt] = new EvtHistManager_2lss_1tau(makeHistManager_cfg(
+          EvtHistManager_2lss_1tau * evt_in_decayMode = new EvtHistManager_2lss_1tau(makeHistManager_cfg(
             decayMode_and_genMatch,
             Form("%s/sel/evt", histogramDir.data()),
             era_string,
             central_or_shift
           ));
-          selHistManager -> evt_in_decayModes_[decayMode_evt] -> bookHistograms(fs);
+          evt_in_decayMode -> bookHistograms(fs);
+          selHistManager -> evt_in_decayModes_.push_back(evt_in_decayMode);
         }
       }
       selHistManager->weights_ = new WeightHistManager(makeHistManager_cfg(process_and_genMatch,
         Form("%s/sel/weights", histogramDir.data()), central_or_shift));
       selHistManager->weights_->bookHistograms(fs, { "genWeight", "pileupWeight", "triggerWeight", "data_to_MC_correction", "fakeRate" });
-      selHistManagers[idxLepton][idxHadTau] = selHistManager;
+      selHistManager->lheVariations_ = 0;
+      if ( lheWeightEngine ) {
+//--- book the histograms in the same directory as EvtHistManager_2lss_1tau
+	selHistManager->lheVariations_ = new LHEInfoHistManager(makeHistManager_cfg(process_and_genMatch,
+          Form("%s/sel/evt", histogramDir.data()), central_or_shift));
+	selHistManager->lheVariations_->bookHistograms_variations(fs, *lheWeightEngine, lheVariations_templates);
+      }
+      selHistManagers.set(idxLepton, idxHadTau, selHistManager);
     }
   }
 
@@ -957,10 +1056,12 @@ int main(int argc, char* argv[])
       }
     }
 
+    profiler.enter(EventLoopProfiler::kFillHistograms);
     if ( isMC ) {
       genEvtHistManager_beforeCuts->fillHistograms(genElectrons, genMuons, genHadTaus, genJets);
     }
 
+    profiler.enter(EventLoopProfiler::kSelection);
     bool isTriggered_1e = hltPaths_isTriggered(triggers_1e) || (isMC && !apply_trigger_bits);
     bool isTriggered_2e = hltPaths_isTriggered(triggers_2e) || (isMC && !apply_trigger_bits);
     bool isTriggered_1mu = hltPaths_isTriggered(triggers_1mu) || (isMC && !apply_trigger_bits);
@@ -1044,9 +1145,13 @@ int main(int argc, char* argv[])
 
 //--- build collections of electrons, muons and hadronic taus;
 //    resolve overlaps in order of priority: muon, electron,
+    profiler.enter(EventLoopProfiler::kRead);
     std::vector<RecoMuon> muons = muonReader->read();
+    geometry.reset();
+    geometry.add(muons);
     std::vector<const RecoMuon*> muon_ptrs = convert_to_ptrs(muons);
     std::vector<const RecoMuon*> cleanedMuons = muon_ptrs; // CV: no cleaning needed for muons, as they have the highest priority in the overlap removal
+    profiler.enter(EventLoopProfiler::kSelection);
     std::vector<const RecoMuon*> preselMuons = preselMuonSelector(cleanedMuons);
     std::vector<const RecoMuon*> fakeableMuons = fakeableMuonSelector(preselMuons);
     std::vector<const RecoMuon*> tightMuons = tightMuonSelector(preselMuons);
@@ -1066,9 +1171,13 @@ int main(int argc, char* argv[])
       }
     }
 
+    profiler.enter(EventLoopProfiler::kRead);
     std::vector<RecoElectron> electrons = electronReader->read();
+    geometry.add(electrons);
     std::vector<const RecoElectron*> electron_ptrs = convert_to_ptrs(electrons);
+    profiler.enter(EventLoopProfiler::kCleaning);
     std::vector<const RecoElectron*> cleanedElectrons = electronCleaner(electron_ptrs, selMuons);
+    profiler.enter(EventLoopProfiler::kSelection);
     std::vector<const RecoElectron*> preselElectrons = preselElectronSelector(cleanedElectrons);
     std::vector<const RecoElectron*> fakeableElectrons = fakeableElectronSelector(preselElectrons);
     std::vector<const RecoElectron*> tightElectrons = tightElectronSelector(preselElectrons);
@@ -1088,9 +1197,13 @@ int main(int argc, char* argv[])
       }
     }
 
+    profiler.enter(EventLoopProfiler::kRead);
     std::vector<RecoHadTau> hadTaus = hadTauReader->read();
+    geometry.add(hadTaus);
     std::vector<const RecoHadTau*> hadTau_ptrs = convert_to_ptrs(hadTaus);
+    profiler.enter(EventLoopProfiler::kCleaning);
     std::vector<const RecoHadTau*> cleanedHadTaus = hadTauCleaner(hadTau_ptrs, preselMuons, preselElectrons);
+    profiler.enter(EventLoopProfiler::kSelection);
     std::vector<const RecoHadTau*> preselHadTaus = preselHadTauSelector(cleanedHadTaus);
     std::vector<const RecoHadTau*> fakeableHadTaus = fakeableHadTauSelector(cleanedHadTaus);
     std::vector<const RecoHadTau*> tightHadTaus = tightHadTauSelector(cleanedHadTaus);
@@ -1112,7 +1225,9 @@ int main(int argc, char* argv[])
     selHadTaus = pickFirstNobjects(selHadTaus, 1);
 
 //--- build collections of jets and select subset of jets passing b-tagging criteria
+    profiler.enter(EventLoopProfiler::kRead);
     std::vector<RecoJet> jets = jetReader->read();
+    geometry.add(jets);
     std::vector<const RecoJet*> jet_ptrs = convert_to_ptrs(jets);
     if ( isDEBUG ) {
       if ( run_lumi_eventSelector ) {
@@ -1123,12 +1238,15 @@ int main(int argc, char* argv[])
         }
       }
     }
+    profiler.enter(EventLoopProfiler::kCleaning);
     std::vector<const RecoJet*> cleanedJets = jetCleaner(jet_ptrs, fakeableMuons, fakeableElectrons, selHadTaus);
+    profiler.enter(EventLoopProfiler::kSelection);
     std::vector<const RecoJet*> selJets = jetSelector(cleanedJets);
     std::vector<const RecoJet*> selBJets_loose = jetSelectorBtagLoose(cleanedJets);
     std::vector<const RecoJet*> selBJets_medium = jetSelectorBtagMedium(cleanedJets);
 
 //--- build collections of generator level particles (after some cuts are applied, to safe computing time)
+    profiler.enter(EventLoopProfiler::kRead);
     if ( isMC && redoGenMatching && !fillGenEvtHistograms ) {
       if ( genLeptonReader ) {
 	genLeptons = genLeptonReader->read();
@@ -1148,6 +1266,7 @@ int main(int argc, char* argv[])
     }
 
 //--- match reconstructed to generator level particles
+    profiler.enter(EventLoopProfiler::kSelection);
     if ( isMC && redoGenMatching ) {
       muonGenMatcher.addGenLeptonMatch(preselMuons, genLeptons, 0.2);
       muonGenMatcher.addGenHadTauMatch(preselMuons, genHadTaus, 0.2);
@@ -1184,7 +1303,7 @@ int main(int argc, char* argv[])
     cutFlowHistManager->fillHistograms(">= 2 presel leptons", lumiScale);
     const RecoLepton* preselLepton_lead = preselLeptons[0];
     const RecoLepton* preselLepton_sublead = preselLeptons[1];
-    const leptonGenMatchEntry& preselLepton_genMatch = getLeptonGenMatch(leptonGenMatch_definitions, preselLepton_lead, preselLepton_sublead);
+    const leptonGenMatchEntry& preselLepton_genMatch = getLeptonGenMatch(leptonGenMatch_lookupTable, preselLepton_lead, preselLepton_sublead);
     int idxPreselLepton_genMatch = preselLepton_genMatch.idx_;
     if ( apply_leptonGenMatching_ttZ_workaround ) idxPreselLepton_genMatch = kGen_2l0j;
     assert(idxPreselLepton_genMatch != kGen_LeptonUndefined2);
@@ -1240,7 +1359,7 @@ int main(int argc, char* argv[])
     cutFlowTable.update(">= 1 sel tau (1)");
     cutFlowHistManager->fillHistograms(">= 1 sel tau (1)", lumiScale);
     const RecoHadTau* selHadTau = selHadTaus[0];
-    const hadTauGenMatchEntry& selHadTau_genMatch = getHadTauGenMatch(hadTauGenMatch_definitions, selHadTau);
+    const hadTauGenMatchEntry& selHadTau_genMatch = getHadTauGenMatch(hadTauGenMatch_lookupTable, selHadTau);
     int idxSelHadTau_genMatch = selHadTau_genMatch.idx_;
     assert(idxSelHadTau_genMatch != kGen_HadTauUndefined1);
 
@@ -1250,11 +1369,12 @@ int main(int argc, char* argv[])
     Particle::LorentzVector mht_p4 = compMHT(fakeableLeptons, selHadTaus, selJets);
     double met_LD = compMEt_LD(met.p4(), mht_p4);
 
-    double mTauTauVis1_presel = (preselLepton_lead->p4() + selHadTau->p4()).mass();
-    double mTauTauVis2_presel = (preselLepton_sublead->p4() + selHadTau->p4()).mass();
+    double mTauTauVis1_presel = (preselLepton_lead->p4_cartesian() + selHadTau->p4_cartesian()).mass();
+    double mTauTauVis2_presel = (preselLepton_sublead->p4_cartesian() + selHadTau->p4_cartesian()).mass();
 
 //--- fill histograms with events passing preselection
-    preselHistManagerType* preselHistManager = preselHistManagers[idxPreselLepton_genMatch][idxSelHadTau_genMatch];
+    profiler.enter(EventLoopProfiler::kFillHistograms);
+    preselHistManagerType* preselHistManager = preselHistManagers.get(idxPreselLepton_genMatch, idxSelHadTau_genMatch);
     assert(preselHistManager != 0);
     preselHistManager->electrons_->fillHistograms(preselElectrons, 1.);
     preselHistManager->muons_->fillHistograms(preselMuons, 1.);
@@ -1271,6 +1391,7 @@ int main(int argc, char* argv[])
       0, -1., 1.);
 
 //--- apply final event selection
+    profiler.enter(EventLoopProfiler::kSelection);
     std::vector<const RecoLepton*> selLeptons;
     selLeptons.reserve(selElectrons.size() + selMuons.size());
     selLeptons.insert(selLeptons.end(), selElectrons.begin(), selElectrons.end());
@@ -1290,7 +1411,7 @@ int main(int argc, char* argv[])
     int selLepton_lead_type = getLeptonType(selLepton_lead->pdgId());
     const RecoLepton* selLepton_sublead = selLeptons[1];
     int selLepton_sublead_type = getLeptonType(selLepton_sublead->pdgId());
-    const leptonGenMatchEntry& selLepton_genMatch = getLeptonGenMatch(leptonGenMatch_definitions, selLepton_lead, selLepton_sublead);
+    const leptonGenMatchEntry& selLepton_genMatch = getLeptonGenMatch(leptonGenMatch_lookupTable, selLepton_lead, selLepton_sublead);
     int idxSelLepton_genMatch = selLepton_genMatch.idx_;
     if ( apply_leptonGenMatching_ttZ_workaround ) idxSelLepton_genMatch = kGen_2l0j;
     assert(idxSelLepton_genMatch != kGen_LeptonUndefined2);
@@ -1302,24 +1423,21 @@ int main(int argc, char* argv[])
 //--- compute event-level weight for data/MC correction of b-tagging efficiency and mistag rate
 //   (using the method "Event reweighting using scale factors calculated with a tag and probe method",
 //    described on the BTV POG twiki https://twiki.cern.ch/twiki/bin/view/CMS/BTagShapeCalibration )
-    double evtWeight = 1.;
+    evtWeightCalculator.reset();
     if ( isMC ) {
-      evtWeight *= lumiScale;
-      if ( apply_genWeight ) evtWeight *= sgn(eventInfo.genWeight);
-      if ( isMC_tH ) evtWeight *= eventInfo.genWeight_tH;
-      evtWeight *= eventInfo.pileupWeight;
+      evtWeightCalculator.setWeight(idxEvtWeight_lumiScale, lumiScale);
+      if ( apply_genWeight ) evtWeightCalculator.setWeight(idxEvtWeight_genWeightSign, sgn(eventInfo.genWeight));
+      if ( isMC_tH ) evtWeightCalculator.setWeight(idxEvtWeight_genWeight_tH, eventInfo.genWeight_tH);
+      evtWeightCalculator.setWeight(idxEvtWeight_pileupWeight, eventInfo.pileupWeight);
       if ( lheScale_option != kLHE_scale_central ) {
-	if      ( lheScale_option == kLHE_scale_xDown ) evtWeight *= lheInfoReader->getWeight_scale_xDown();
-	else if ( lheScale_option == kLHE_scale_xUp   ) evtWeight *= lheInfoReader->getWeight_scale_xUp();
-	else if ( lheScale_option == kLHE_scale_yDown ) evtWeight *= lheInfoReader->getWeight_scale_yDown();
-	else if ( lheScale_option == kLHE_scale_yUp   ) evtWeight *= lheInfoReader->getWeight_scale_yUp();
+	evtWeightCalculator.setWeight(idxEvtWeight_lheScale, idxEvtWeight_shift, lheInfoReader->getWeights()[lheScale_option]);
       }
       double btagWeight = 1.;
       for ( std::vector<const RecoJet*>::const_iterator jet = selJets.begin();
 	    jet != selJets.end(); ++jet ) {
 	btagWeight *= (*jet)->BtagWeight();
       }
-      evtWeight *= btagWeight;
+      evtWeightCalculator.setWeight(idxEvtWeight_btagWeight, btagWeight);
       if ( isDEBUG ) {
 	std::cout << "lumiScale = " << lumiScale << std::endl;
 	if ( apply_genWeight ) std::cout << "genWeight = " << sgn(eventInfo.genWeight) << std::endl;
@@ -1341,7 +1459,7 @@ int main(int argc, char* argv[])
 	if ( isDEBUG ) {
 	  std::cout << "triggerWeight = " << triggerWeight << std::endl;
 	}
-	evtWeight *= triggerWeight;
+	evtWeightCalculator.setWeight(idxEvtWeight_triggerEff, triggerWeight);
       }
 
 //--- apply data/MC corrections for trigger efficiency
@@ -1374,7 +1492,7 @@ int main(int argc, char* argv[])
 	std::cout << "weight_data_to_MC_correction = " << weight_data_to_MC_correction << std::endl;
       }
 
-      evtWeight *= weight_data_to_MC_correction;
+      evtWeightCalculator.setWeight(idxEvtWeight_data_to_MC_correction, weight_data_to_MC_correction);
     }
 
     double weight_fakeRate = 1.;
@@ -1399,7 +1517,7 @@ int main(int argc, char* argv[])
 	if ( isDEBUG ) {
 	  std::cout << "weight_fakeRate = " << weight_fakeRate << std::endl;
 	}
-	evtWeight *= weight_fakeRate;
+	evtWeightCalculator.setWeight(idxEvtWeight_fakeRate, weight_fakeRate);
       } else if ( applyFakeRateWeights == kFR_2lepton) {
 	double prob_fake_lepton_lead = 1.;
 	if      ( std::abs(selLepton_lead->pdgId()) == 11 ) prob_fake_lepton_lead = leptonFakeRateInterface->getWeight_e(selLepton_lead->cone_pt(), selLepton_lead->absEta());
@@ -1417,14 +1535,14 @@ int main(int argc, char* argv[])
 	if ( isDEBUG ) {
 	  std::cout << "weight_fakeRate = " << weight_fakeRate << std::endl;
 	}
-	evtWeight *= weight_fakeRate;
+	evtWeightCalculator.setWeight(idxEvtWeight_fakeRate, weight_fakeRate);
       } else if ( applyFakeRateWeights == kFR_1tau) {
 	double prob_fake_hadTau = jetToTauFakeRateInterface->getWeight_lead(selHadTau->pt(), selHadTau->absEta());
 	weight_fakeRate = prob_fake_hadTau;
 	if ( isDEBUG ) {
 	  std::cout << "weight_fakeRate = " << weight_fakeRate << std::endl;
 	}
-	evtWeight *= weight_fakeRate;
+	evtWeightCalculator.setWeight(idxEvtWeight_fakeRate, weight_fakeRate);
       }
 
       // CV: apply data/MC ratio for jet->tau fake-rates in case data-driven "fake" background estimation is applied to leptons only
@@ -1433,9 +1551,10 @@ int main(int argc, char* argv[])
 	if ( isDEBUG ) {
 	  std::cout << "weight_data_to_MC_correction_hadTau = " << weight_data_to_MC_correction_hadTau << std::endl;
 	}
-	evtWeight *= weight_data_to_MC_correction_hadTau;
+	evtWeightCalculator.setWeight(idxEvtWeight_hadTauFakeRateSF, weight_data_to_MC_correction_hadTau);
       }
     }
+    double evtWeight = evtWeightCalculator.getWeight(idxEvtWeight_shift);
     if ( isDEBUG ) {
       std::cout << "evtWeight = " << evtWeight << std::endl;
     }
@@ -1513,7 +1632,7 @@ int main(int argc, char* argv[])
 	  lepton1 != preselLeptons.end(); ++lepton1 ) {
       for ( std::vector<const RecoLepton*>::const_iterator lepton2 = lepton1 + 1;
 	    lepton2 != preselLeptons.end(); ++lepton2 ) {
-	double mass = ((*lepton1)->p4() + (*lepton2)->p4()).mass();
+	double mass = ((*lepton1)->p4_cartesian() + (*lepton2)->p4_cartesian()).mass();
 	if ( mass < 12. ) {
 	  failsLowMassVeto = true;
 	}
@@ -1586,6 +1705,7 @@ int main(int argc, char* argv[])
       continue;
     }
     if ( leptonChargeSelection == kOS ) {
+      double weight_chargeMisId = 1.;
       double prob_chargeMisId_lead = prob_chargeMisId(getLeptonType(selLepton_lead->pdgId()), selLepton_lead->pt(), selLepton_lead->eta());
       double prob_chargeMisId_sublead = prob_chargeMisId(getLeptonType(selLepton_sublead->pdgId()), selLepton_sublead->pt(), selLepton_sublead->eta());
 
@@ -1594,18 +1714,20 @@ int main(int argc, char* argv[])
 	  // CV: apply charge misidentification probability to lepton of same charge as hadronic tau
 	  //    (if the lepton of charge opposite to the charge of the hadronic tau "flips",
 	  //     the event has sum of charges equal to three and fails "lepton+tau charge" cut)
-	  if ( selLepton_lead->charge()*selHadTau->charge()    > 0 ) evtWeight *= prob_chargeMisId_lead;
-	  if ( selLepton_sublead->charge()*selHadTau->charge() > 0 ) evtWeight *= prob_chargeMisId_sublead;
+	  if ( selLepton_lead->charge()*selHadTau->charge()    > 0 ) weight_chargeMisId *= prob_chargeMisId_lead;
+	  if ( selLepton_sublead->charge()*selHadTau->charge() > 0 ) weight_chargeMisId *= prob_chargeMisId_sublead;
 	} else if ( chargeSumSelection == kSS ) {
 	  // CV: apply charge misidentification probability to lepton of opposite charge as hadronic tau
 	  //    (if the lepton of same charge as the hadronic tau "flips",
 	  //     the event has sum of charges equal to one and fails "lepton+tau charge" cut)
-	  if ( selLepton_lead->charge()*selHadTau->charge()    < 0 ) evtWeight *= prob_chargeMisId_lead;
-	  if ( selLepton_sublead->charge()*selHadTau->charge() < 0 ) evtWeight *= prob_chargeMisId_sublead;
+	  if ( selLepton_lead->charge()*selHadTau->charge()    < 0 ) weight_chargeMisId *= prob_chargeMisId_lead;
+	  if ( selLepton_sublead->charge()*selHadTau->charge() < 0 ) weight_chargeMisId *= prob_chargeMisId_sublead;
 	} else assert(0);
       } else {
-	evtWeight *= ( prob_chargeMisId_lead + prob_chargeMisId_sublead);
+	weight_chargeMisId = prob_chargeMisId_lead + prob_chargeMisId_sublead;
       }
+      evtWeightCalculator.setWeight(idxEvtWeight_chargeMisId, weight_chargeMisId);
+      evtWeight = evtWeightCalculator.getWeight(idxEvtWeight_shift);
     }
     cutFlowTable.update(Form("sel lepton-pair %s charge", leptonChargeSelection_string.data()), evtWeight);
     cutFlowHistManager->fillHistograms("sel lepton-pair OS/SS charge", evtWeight);
@@ -1632,7 +1754,7 @@ int main(int argc, char* argv[])
 	    lepton2 != fakeableLeptons.end(); ++lepton2 ) {
 	//std::cout << "lepton1: pT = " << (*lepton1)->pt() << ", eta = " << (*lepton1)->eta() << ", phi = " << (*lepton1)->phi() << ", pdgId = " << (*lepton1)->pdgId() << std::endl;
 	//std::cout << "lepton2: pT = " << (*lepton2)->pt() << ", eta = " << (*lepton2)->eta() << ", phi = " << (*lepton2)->phi() << ", pdgId = " << (*lepton2)->pdgId() << std::endl;
-	double mass = ((*lepton1)->p4() + (*lepton2)->p4()).mass();
+	double mass = ((*lepton1)->p4_cartesian() + (*lepton2)->p4_cartesian()).mass();
 	//std::cout << "mass = " << mass << std::endl;
 	if ( (*lepton1)->is_electron() && (*lepton2)->is_electron() && std::fabs(mass - z_mass) < z_window ) {
 	  //std::cout << "--> setting failsZbosonMassVeto = true !!" << std::endl;
@@ -1671,20 +1793,21 @@ int main(int argc, char* argv[])
       cutFlowHistManager->fillHistograms("signal region veto", evtWeight);
     }
 
-    double mTauTauVis1_sel = (selLepton_lead->p4() + selHadTau->p4()).mass();
-    double mTauTauVis2_sel = (selLepton_sublead->p4() + selHadTau->p4()).mass();
+    double mTauTauVis1_sel = (selLepton_lead->p4_cartesian() + selHadTau->p4_cartesian()).mass();
+    double mTauTauVis2_sel = (selLepton_sublead->p4_cartesian() + selHadTau->p4_cartesian()).mass();
 
 //--- compute output of BDTs used to discriminate ttH vs. ttV and ttH vs. ttbar
 //    in 2lss_1tau category of ttH multilepton analysis
+    profiler.enter(EventLoopProfiler::kMVA);
     mvaInputs_2lss["max(abs(LepGood_eta[iF_Recl[0]]),abs(LepGood_eta[iF_Recl[1]]))"] = std::max(std::fabs(selLepton_lead->eta()), std::fabs(selLepton_sublead->eta()));
     mvaInputs_2lss["MT_met_lep1"]                = comp_MT_met_lep1(selLepton_lead->cone_p4(), met.pt(), met.phi());
-    mvaInputs_2lss["nJet25_Recl"]                = comp_n_jet25_recl(selJets);
-    mvaInputs_2lss["mindr_lep1_jet"]             = comp_mindr_lep1_jet(*selLepton_lead, selJets);
-    mvaInputs_2lss["mindr_lep2_jet"]             = comp_mindr_lep2_jet(*selLepton_sublead, selJets);
+    mvaInputs_2lss["nJet25_Recl"]                = comp_n_jet25_recl(selJets, geometry);
+    mvaInputs_2lss["mindr_lep1_jet"]             = comp_mindr_lep1_jet(*selLepton_lead, selJets, geometry);
+    mvaInputs_2lss["mindr_lep2_jet"]             = comp_mindr_lep2_jet(*selLepton_sublead, selJets, geometry);
     mvaInputs_2lss["LepGood_conePt[iF_Recl[0]]"] = comp_lep1_conePt(*selLepton_lead);
     mvaInputs_2lss["LepGood_conePt[iF_Recl[1]]"] = comp_lep2_conePt(*selLepton_sublead);
     mvaInputs_2lss["min(met_pt,400)"]            = std::min(met.pt(), (Double_t)400.);
-    mvaInputs_2lss["avg_dr_jet"]                 = comp_avg_dr_jet(selJets);
+    mvaInputs_2lss["avg_dr_jet"]                 = comp_avg_dr_jet(selJets, geometry);
 
     check_mvaInputs(mvaInputs_2lss, eventInfo);
     //for ( std::map<std::string, double>::const_iterator mvaInput = mvaInputs_2lss.begin();
@@ -1719,6 +1842,7 @@ int main(int argc, char* argv[])
     //std::cout << "mvaDiscr_2lss = " << mvaDiscr_2lss << std::endl;
     //std::cout << std::endl;
 
+    profiler.enter(EventLoopProfiler::kRead);
     MEMOutput_2lss_1tau memOutput_2lss_1tau_matched;
     if ( memReader ) {
       std::vector<MEMOutput_2lss_1tau> memOutputs_2lss_1tau = memReader->read();
@@ -1777,6 +1901,7 @@ int main(int argc, char* argv[])
     Double_t memDiscr = getSF_from_TH2(mem_mapping, memOutput_ttbar_LR, memOutput_ttZ_LR);
 
 //--- compute output of hadronic top tagger BDT
+    profiler.enter(EventLoopProfiler::kHadTopTagger);
     double max_mvaOutput_hadTopTagger = -1.;
     Particle::LorentzVector fittedHadTopP4;
     for ( std::vector<const RecoJet*>::const_iterator selBJet = selJets.begin();
@@ -1792,6 +1917,7 @@ int main(int argc, char* argv[])
 	  if ( &(*selWJet2) == &(*selBJet) ) continue;
 
 	  std::vector<double> mvaOutput_hadTopTagger = (*hadTopTagger)(**selBJet, **selWJet1, **selWJet2);
+	  profiler.count(counter_hadTopTagger);
 	  if ( mvaOutput_hadTopTagger[0] > max_mvaOutput_hadTopTagger ) {
 	    max_mvaOutput_hadTopTagger = mvaOutput_hadTopTagger[0];
 	    fittedHadTopP4 = hadTopTagger->kinFit()->fittedTop();
@@ -1801,18 +1927,19 @@ int main(int argc, char* argv[])
     }
 
 //--- compute output of BDTs used to discriminate ttH vs. ttV and ttH vs. ttbar trained by Arun for 2lss_1tau category
-    mvaInputs_2lss_1tau["avg_dr_jet"]                                            = comp_avg_dr_jet(selJets);
-    mvaInputs_2lss_1tau["dr_leps"]                                               = deltaR(selLepton_lead->p4(), selLepton_sublead->p4());
-    mvaInputs_2lss_1tau["dr_lep1_tau"]                                           = deltaR(selLepton_lead->p4(), selHadTau->p4());
-    //mvaInputs_2lss_1tau["dr_lep2_tau"]                                           = deltaR(selLepton_sublead->p4(), selHadTau->p4());
+    profiler.enter(EventLoopProfiler::kMVA);
+    mvaInputs_2lss_1tau["avg_dr_jet"]                                            = comp_avg_dr_jet(selJets, geometry);
+    mvaInputs_2lss_1tau["dr_leps"]                                               = geometry.dR(*selLepton_lead, *selLepton_sublead);
+    mvaInputs_2lss_1tau["dr_lep1_tau"]                                           = geometry.dR(*selLepton_lead, *selHadTau);
+    //mvaInputs_2lss_1tau["dr_lep2_tau"]                                           = geometry.dR(*selLepton_sublead, *selHadTau);
     //mvaInputs_2lss_1tau["htmiss"]                                                = mht_p4.pt();
     mvaInputs_2lss_1tau["lep1_conePt"]                                           = selLepton_lead->cone_pt();
     //mvaInputs_2lss_1tau["lep1_pt"]                                               = selLepton_lead->pt();
     mvaInputs_2lss_1tau["lep2_conePt"]                                           = selLepton_sublead->cone_pt();
     //mvaInputs_2lss_1tau["lep2_pt"]                                               = selLepton_sublead->pt();
-    mvaInputs_2lss_1tau["mindr_lep1_jet"]                                        = TMath::Min(10., comp_mindr_lep1_jet(*selLepton_lead, selJets));
-    mvaInputs_2lss_1tau["mindr_lep2_jet"]                                        = TMath::Min(10., comp_mindr_lep2_jet(*selLepton_sublead, selJets));
-    //mvaInputs_2lss_1tau["mindr_tau_jet" ]                                        = TMath::Min(10., comp_mindr_hadTau1_jet(*selHadTau, selJets));
+    mvaInputs_2lss_1tau["mindr_lep1_jet"]                                        = TMath::Min(10., comp_mindr_lep1_jet(*selLepton_lead, selJets, geometry));
+    mvaInputs_2lss_1tau["mindr_lep2_jet"]                                        = TMath::Min(10., comp_mindr_lep2_jet(*selLepton_sublead, selJets, geometry));
+    //mvaInputs_2lss_1tau["mindr_tau_jet" ]                                        = TMath::Min(10., comp_mindr_hadTau1_jet(*selHadTau, selJets, geometry));
     mvaInputs_2lss_1tau["mT_lep1"]                                               = comp_MT_met_lep1(selLepton_lead->p4(), met.pt(), met.phi());
     //mvaInputs_2lss_1tau["mT_lep2"]                                               = comp_MT_met_lep2(selLepton_sublead->p4(), met.pt(), met.phi());
     mvaInputs_2lss_1tau["mTauTauVis1"]                                           = mTauTauVis1_sel;
@@ -1842,32 +1969,35 @@ int main(int argc, char* argv[])
     double mvaOutput_2lss_1tau_ttbar_wMEM = mva_2lss_1tau_ttbar_wMEM(mvaInputs_2lss_1tau_wMEM);
     Double_t mvaDiscr_2lss_1tau_wMEM = getSF_from_TH2(mva_mapping_2lss_1tau_wMEM, mvaOutput_2lss_1tau_ttbar_wMEM, mvaOutput_2lss_1tau_ttV_wMEM) + 1.;
 
+//--- compute the output of the Hj tagger once per jet and reuse it for all pairs of jets in the Hjj tagger
     double mvaOutput_Hj_tagger = -1.;
+    std::vector<double> selJets_mvaOutput_Hj_tagger;
     for ( std::vector<const RecoJet*>::const_iterator selJet = selJets.begin();
 	  selJet != selJets.end(); ++selJet ) {
       double mvaOutput = comp_mvaOutput_Hj_tagger(
         *selJet, fakeableLeptons,
 	mvaInputs_Hj_tagger, mva_Hj_tagger,
-        eventInfo);
+        eventInfo, geometry);
+      selJets_mvaOutput_Hj_tagger.push_back(mvaOutput);
       if ( mvaOutput > mvaOutput_Hj_tagger ) mvaOutput_Hj_tagger = mvaOutput;
     }
 
     double mvaOutput_Hjj_tagger = -1.;
-    for ( std::vector<const RecoJet*>::const_iterator selJet1 = selJets.begin();
-	  selJet1 != selJets.end(); ++selJet1 ) {
-      for ( std::vector<const RecoJet*>::const_iterator selJet2 = selJet1 + 1;
-	    selJet2 != selJets.end(); ++selJet2 ) {
+    for ( size_t idxSelJet1 = 0; idxSelJet1 < selJets.size(); ++idxSelJet1 ) {
+      for ( size_t idxSelJet2 = idxSelJet1 + 1; idxSelJet2 < selJets.size(); ++idxSelJet2 ) {
 	double mvaOutput = comp_mvaOutput_Hjj_tagger(
-	  *selJet1, *selJet2, selJets, fakeableLeptons,
+	  selJets[idxSelJet1], selJets_mvaOutput_Hj_tagger[idxSelJet1],
+	  selJets[idxSelJet2], selJets_mvaOutput_Hj_tagger[idxSelJet2],
+	  selJets, fakeableLeptons,
 	  mvaInputs_Hjj_tagger, mva_Hjj_tagger,
-	  mvaInputs_Hj_tagger, mva_Hj_tagger,
-      eventInfo);
+      eventInfo, geometry);
 	if ( mvaOutput > mvaOutput_Hjj_tagger ) mvaOutput_Hjj_tagger = mvaOutput;
       }
     }
 
 //--- fill histograms with events passing final selection
-    selHistManagerType* selHistManager = selHistManagers[idxSelLepton_genMatch][idxSelHadTau_genMatch];
+    profiler.enter(EventLoopProfiler::kFillHistograms);
+    selHistManagerType* selHistManager = selHistManagers.get(idxSelLepton_genMatch, idxSelHadTau_genMatch);
     assert(selHistManager != 0);
     selHistManager->electrons_->fillHistograms(selElectrons, evtWeight);
     selHistManager->muons_->fillHistograms(selMuons, evtWeight);
@@ -1892,10 +2022,10 @@ int main(int argc, char* argv[])
       mTauTauVis1_sel, mTauTauVis2_sel,
       memOutput_2lss_1tau_matched.is_initialized() ? &memOutput_2lss_1tau_matched : nullptr, memDiscr, evtWeight);
     if ( isSignal ) {
-      const std::string decayModeStr = eventInfo.getDecayModeString();
-      if(! decayModeStr.empty())
+      const int decayModeIdx = eventInfo.getDecayModeIdx();
+      if(decayModeIdx >= 0)
       {
-        selHistManager->evt_in_decayModes_[decayModeStr]->fillHistograms(
+        selHistManager->evt_in_decayModes_[decayModeIdx]->fillHistograms(
           selElectrons.size(),
           selMuons.size(),
           selHadTaus.size(),
@@ -1921,16 +2051,21 @@ int main(int argc, char* argv[])
       }
     }
     selHistManager->weights_->fillHistograms("genWeight", eventInfo.genWeight);
-    selHistManager->weights_->fillHistograms("pileupWeight", eventInfo.pileupWeight);
     selHistManager->weights_->fillHistograms("triggerWeight", triggerWeight);
-    selHistManager->weights_->fillHistograms("data_to_MC_correction", weight_data_to_MC_correction);
-    selHistManager->weights_->fillHistograms("fakeRate", weight_fakeRate);
+    selHistManager->weights_->fillHistograms(evtWeightCalculator, idxEvtWeight_shift);
 
     if ( isMC ) {
       genEvtHistManager_afterCuts->fillHistograms(genElectrons, genMuons, genHadTaus, genJets);
       lheInfoHistManager->fillHistograms(*lheInfoReader, evtWeight);
+      if ( lheWeightEngine ) {
+	lheWeightEngine->compute(*lheInfoReader, evtWeight);
+	selHistManager->lheVariations_->fillHistograms_variations(idxLHEVariations_mvaDiscr_2lss, mvaDiscr_2lss, *lheWeightEngine);
+	selHistManager->lheVariations_->fillHistograms_variations(idxLHEVariations_mvaDiscr_2lss_1tau, mvaDiscr_2lss_1tau, *lheWeightEngine);
+	selHistManager->lheVariations_->fillHistograms_variations(idxLHEVariations_mvaDiscr_2lss_1tau_wMEM, mvaDiscr_2lss_1tau_wMEM, *lheWeightEngine);
+      }
     }
 
+    profiler.enter(EventLoopProfiler::kWrite);
     if ( selEventsFile ) {
       (*selEventsFile) << eventInfo.run << ':' << eventInfo.lumi << ':' << eventInfo.event << '\n';
     }
@@ -1954,24 +2089,24 @@ int main(int argc, char* argv[])
           ("lep1_conePt",            comp_lep1_conePt(*selLepton_lead))
           ("lep1_eta",               selLepton_lead -> eta())
           ("lep1_tth_mva",           selLepton_lead -> mvaRawTTH())
-          ("mindr_lep1_jet",         TMath::Min(10., comp_mindr_lep1_jet(*selLepton_lead, selJets)))
+          ("mindr_lep1_jet",         TMath::Min(10., comp_mindr_lep1_jet(*selLepton_lead, selJets, geometry)))
           ("mT_lep1",                comp_MT_met_lep1(*selLepton_lead, met.pt(), met.phi()))
-          ("dr_lep1_tau",            deltaR(selLepton_lead -> p4(), selHadTau -> p4()))
+          ("dr_lep1_tau",            geometry.dR(*selLepton_lead, *selHadTau))
           ("lep2_pt",                selLepton_sublead -> pt())
           ("lep2_conePt",            comp_lep1_conePt(*selLepton_sublead))
           ("lep2_eta",               selLepton_sublead -> eta())
           ("lep2_tth_mva",           selLepton_sublead -> mvaRawTTH())
-          ("mindr_lep2_jet",         TMath::Min(10., comp_mindr_lep1_jet(*selLepton_sublead, selJets)))
+          ("mindr_lep2_jet",         TMath::Min(10., comp_mindr_lep1_jet(*selLepton_sublead, selJets, geometry)))
           ("mT_lep2",                comp_MT_met_lep1(*selLepton_sublead, met.pt(), met.phi()))
-          ("dr_lep2_tau",            deltaR(selLepton_sublead -> p4(), selHadTau -> p4()))
-          ("mindr_tau_jet",          TMath::Min(10., comp_mindr_hadTau1_jet(*selHadTau, selJets)))
-          ("avg_dr_jet",             comp_avg_dr_jet(selJets))
+          ("dr_lep2_tau",            geometry.dR(*selLepton_sublead, *selHadTau))
+          ("mindr_tau_jet",          TMath::Min(10., comp_mindr_hadTau1_jet(*selHadTau, selJets, geometry)))
+          ("avg_dr_jet",             comp_avg_dr_jet(selJets, geometry))
           ("ptmiss",                 met.pt())
           ("htmiss",                 mht_p4.pt())
           ("tau_mva",                selHadTau -> raw_mva_dR03())
           ("tau_pt",                 selHadTau -> pt())
           ("tau_eta",                selHadTau -> eta())
-          ("dr_leps",                deltaR(selLepton_lead -> p4(), selLepton_sublead -> p4()))
+          ("dr_leps",                geometry.dR(*selLepton_lead, *selLepton_sublead))
           ("mTauTauVis1",            mTauTauVis1_sel)
           ("mTauTauVis2",            mTauTauVis2_sel)
           ("memOutput_isValid",      memOutput_2lss_1tau_matched.is_initialized() ? memOutput_2lss_1tau_matched.isValid()        : -100.)
@@ -2015,6 +2150,7 @@ int main(int argc, char* argv[])
     selectedEntries_weighted += evtWeight;
     histogram_selectedEntries->Fill(0.);
   }
+  profiler.stop();
 
   std::cout << "max num. Entries = " << inputTree -> getCumulativeMaxEventCount()
             << " (limited by " << maxEvents << ") processed in "
@@ -2026,6 +2162,10 @@ int main(int argc, char* argv[])
   cutFlowTable.print(std::cout);
   std::cout << std::endl;
 
+  profiler.print(std::cout);
+  profiler.write(fs);
+  std::cout << std::endl;
+
   std::cout << "sel. Entries by gen. matching:" << std::endl;
   for ( std::vector<leptonGenMatchEntry>::const_iterator leptonGenMatch_definition = leptonGenMatch_definitions.begin();
 	leptonGenMatch_definition != leptonGenMatch_definitions.end(); ++leptonGenMatch_definition ) {
@@ -2040,18 +2180,26 @@ int main(int argc, char* argv[])
       int idxLepton = leptonGenMatch_definition->idx_;
       int idxHadTau = hadTauGenMatch_definition->idx_;
 
-      const TH1* histogram_EventCounter = selHistManagers[idxLepton][idxHadTau]->evt_->getHistogram_EventCounter();
+      const TH1* histogram_EventCounter = selHistManagers.get(idxLepton, idxHadTau)->evt_->getHistogram_EventCounter();
       std::cout << " " << process_and_genMatch << " = " << histogram_EventCounter->GetEntries() << " (weighted = " << histogram_EventCounter->Integral() << ")" << std::endl;
     }
   }
   std::cout << std::endl;
 
+//--- the histograms for the LHE scale and PDF variations are not owned by TFileService and need to be written explicitly
+  if ( lheWeightEngine ) {
+    for ( selHistManagerType* selHistManager : selHistManagers.getAll() ) {
+      if ( selHistManager && selHistManager->lheVariations_ ) selHistManager->lheVariations_->writeHistograms_variations();
+    }
+  }
+
   delete dataToMCcorrectionInterface;
 
   delete leptonFakeRateInterface;
   delete jetToTauFakeRateInterface;
 
   delete run_lumi_eventSelector;
+  delete eventIndex;
 
   delete inputFile_mva_mapping_2lss_1tau;
   delete inputFile_mva_mapping_2lss_1tau_wMEM;
@@ -2074,6 +2222,7 @@ int main(int argc, char* argv[])
   delete genEvtHistManager_beforeCuts;
   delete genEvtHistManager_afterCuts;
   delete lheInfoHistManager;
+  delete lheWeightEngine;
   delete cutFlowHistManager;
 
   delete inputTree;
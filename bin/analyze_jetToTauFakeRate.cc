@@ -45,6 +45,7 @@
 #include "tthAnalysis/HiggsToTauTau/interface/RecoHadTauCollectionSelectorLoose.h" // RecoHadTauCollectionSelectorLoose
 #include "tthAnalysis/HiggsToTauTau/interface/RecoHadTauCollectionSelectorFakeable.h" // RecoHadTauCollectionSelectorFakeable
 #include "tthAnalysis/HiggsToTauTau/interface/RecoHadTauCollectionSelectorTight.h" // RecoHadTauCollectionSelectorTight
+#include "tthAnalysis/HiggsToTauTau/interface/RecoHadTauCollectionSelectorMultiWP.h" // RecoHadTauCollectionSelectorMultiWP
 #include "tthAnalysis/HiggsToTauTau/interface/RecoJetCollectionSelector.h" // RecoJetCollectionSelector
 #include "tthAnalysis/HiggsToTauTau/interface/RecoJetCollectionSelectorBtag.h" // RecoJetCollectionSelectorBtagLoose, RecoJetCollectionSelectorBtagMedium
 #include "tthAnalysis/HiggsToTauTau/interface/ParticleCollectionSelector.h" // RecoElectronSelectorTight, RecoMuonSelectorTight, RecoHadTauSelectorLoose, RecoHadTauSelectorTight
@@ -107,6 +108,7 @@ struct denominatorHistManagers
     , hadTauHistManager_genLepton_(0)
     , hadTauHistManager_genJet_(0)
     , fakeableHadTauSelector_(0)
+    , idxWorkingPoint_denominator_(0)
     , evtHistManager_(0)
   {
     std::string etaBin = getEtaBin(minAbsEta_, maxAbsEta_);
@@ -208,6 +210,7 @@ struct denominatorHistManagers
   HadTauHistManager* hadTauHistManager_genLepton_;
   HadTauHistManager* hadTauHistManager_genJet_;
   RecoHadTauSelectorFakeable* fakeableHadTauSelector_;
+  std::size_t idxWorkingPoint_denominator_; ///< index of denominator working point in RecoHadTauCollectionSelectorMultiWP
   EvtHistManager_jetToTauFakeRate* evtHistManager_;
 };
 
@@ -221,7 +224,8 @@ struct numeratorSelector_and_HistManagers : public denominatorHistManagers
     const std::string& hadTauSelection_denominator, const std::string& hadTauSelection_numerator, double minAbsEta, double maxAbsEta, const std::string& central_or_shift)
     : denominatorHistManagers(process, era, isMC, chargeSelection, hadTauSelection_denominator, minAbsEta, maxAbsEta, central_or_shift),
       hadTauSelection_numerator_(hadTauSelection_numerator),
-      tightHadTauSelector_(0)
+      tightHadTauSelector_(0),
+      idxWorkingPoint_numerator_(0)
   {
     std::string etaBin = getEtaBin(minAbsEta_, maxAbsEta_);    
     subdir_ = Form("jetToTauFakeRate_%s/numerator/%s/%s", chargeSelection_.data(), hadTauSelection_numerator_.data(), etaBin.data());
@@ -246,6 +250,7 @@ struct numeratorSelector_and_HistManagers : public denominatorHistManagers
   }
   std::string hadTauSelection_numerator_;
   RecoHadTauSelectorTight* tightHadTauSelector_;
+  std::size_t idxWorkingPoint_numerator_; ///< index of numerator working point in RecoHadTauCollectionSelectorMultiWP
 };
 
 /**
@@ -464,6 +469,10 @@ int main(int argc, char* argv[])
   RecoHadTauCollectionSelectorTight tightHadTauSelector(era);
   tightHadTauSelector.set_min_antiElectron(hadTauSelection_antiElectron);
   tightHadTauSelector.set_min_antiMuon(hadTauSelection_antiMuon);
+//--- evaluate the denominator and all numerator working points in a single pass over the preselected taus
+  RecoHadTauCollectionSelectorMultiWP hadTauWorkingPointSelector(era);
+  hadTauWorkingPointSelector.set_min_antiElectron(hadTauSelection_antiElectron);
+  hadTauWorkingPointSelector.set_min_antiMuon(hadTauSelection_antiMuon);
 
   RecoJetReader* jetReader = new RecoJetReader(era, isMC, "nJet", "Jet");
   jetReader->setJetPt_central_or_shift(jetPt_option);
@@ -538,6 +547,7 @@ int main(int argc, char* argv[])
     denominatorHistManagers* denominator = new denominatorHistManagers(
       process_string, era, isMC, chargeSelection_string, hadTauSelection_denominator, minAbsEta, maxAbsEta, central_or_shift);
     denominator->bookHistograms(fs);
+    denominator->idxWorkingPoint_denominator_ = hadTauWorkingPointSelector.addWorkingPoint(hadTauSelection_denominator);
     denominators.push_back(denominator);
 
     for ( vstring::const_iterator hadTauSelection_numerator = hadTauSelections_numerator.begin();
@@ -545,6 +555,7 @@ int main(int argc, char* argv[])
       numeratorSelector_and_HistManagers* numerator = new numeratorSelector_and_HistManagers(
 	process_string, era, isMC, chargeSelection_string, hadTauSelection_denominator, *hadTauSelection_numerator, minAbsEta, maxAbsEta, central_or_shift);
       numerator->bookHistograms(fs);
+      numerator->idxWorkingPoint_numerator_ = hadTauWorkingPointSelector.addWorkingPoint(*hadTauSelection_numerator);
       numerators.push_back(numerator);
     }
   }
@@ -913,6 +924,8 @@ int main(int argc, char* argv[])
       mLL, mT_e, mT_mu, 
       evtWeight);
 
+    hadTauWorkingPointSelector(preselHadTaus);
+
 //--- iterate over jets
     for ( std::vector<const RecoJet*>::const_iterator cleanedJet = cleanedJets.begin();
 	  cleanedJet != cleanedJets.end(); ++cleanedJet ) {
@@ -920,12 +933,14 @@ int main(int argc, char* argv[])
 	     (*cleanedJet)->pt() < jet_maxPt && std::fabs((*cleanedJet)->eta()) < jet_maxAbsEta) ) continue;
 
       const RecoHadTau* preselHadTau_dRmatched = 0;
+      std::size_t idxPreselHadTau_dRmatched = 0;
       double dRmin = 1.e+3;
       for ( std::vector<const RecoHadTau*>::const_iterator preselHadTau = preselHadTaus.begin();
 	    preselHadTau != preselHadTaus.end(); ++preselHadTau ) {
 	double dR = deltaR((*preselHadTau)->eta(), (*preselHadTau)->phi(), (*cleanedJet)->eta(), (*cleanedJet)->phi());
 	if ( dR < dRmin || !preselHadTau_dRmatched ) {
 	  preselHadTau_dRmatched = (*preselHadTau);
+	  idxPreselHadTau_dRmatched = preselHadTau - preselHadTaus.begin();
 	  dRmin = dR;
 	}
       }
@@ -940,7 +955,7 @@ int main(int argc, char* argv[])
       
       for ( std::vector<denominatorHistManagers*>::iterator denominator = denominators.begin();
 	    denominator != denominators.end(); ++denominator ) {
-	if ( !(*(*denominator)->fakeableHadTauSelector_)(*preselHadTau_dRmatched) ) continue;
+	if ( !hadTauWorkingPointSelector.passes(idxPreselHadTau_dRmatched, (*denominator)->idxWorkingPoint_denominator_) ) continue;
 
 //--- apply data/MC corrections for hadronic tau identification efficiency 
 //    and for e->tau and mu->tau misidentification rates
@@ -955,7 +970,7 @@ int main(int argc, char* argv[])
 
       for ( std::vector<numeratorSelector_and_HistManagers*>::iterator numerator = numerators.begin();
 	    numerator != numerators.end(); ++numerator ) {
-	if ( !(*(*numerator)->tightHadTauSelector_)(*preselHadTau_dRmatched) ) continue;
+	if ( !hadTauWorkingPointSelector.passes(idxPreselHadTau_dRmatched, (*numerator)->idxWorkingPoint_numerator_) ) continue;
 
 //--- apply data/MC corrections for hadronic tau identification efficiency 
 //    and for e->tau and mu->tau misidentification rates
@@ -971,12 +986,11 @@ int main(int argc, char* argv[])
 
     for ( std::vector<denominatorHistManagers*>::iterator denominator = denominators.begin();
 	  denominator != denominators.end(); ++denominator ) {
-      int numHadTaus_denominator = 0;
+      int numHadTaus_denominator = hadTauWorkingPointSelector.getView((*denominator)->idxWorkingPoint_denominator_).size();
       double evtWeight_denominator = evtWeight;
       dataToMCcorrectionInterface->setHadTauSelection((*denominator)->fakeableHadTauSelector_->get());
       for ( std::vector<const RecoHadTau*>::const_iterator preselHadTau = preselHadTaus.begin();
 	    preselHadTau != preselHadTaus.end(); ++preselHadTau ) {
-	if ( (*(*denominator)->fakeableHadTauSelector_)(**preselHadTau) ) ++numHadTaus_denominator;
 	int preselHadTau_genPdgId = getHadTau_genPdgId(*preselHadTau);
 	dataToMCcorrectionInterface->setHadTaus(preselHadTau_genPdgId, (*preselHadTau)->pt(), (*preselHadTau)->eta());
 	evtWeight_denominator *= dataToMCcorrectionInterface->getSF_hadTauID_and_Iso();
@@ -989,12 +1003,11 @@ int main(int argc, char* argv[])
     
     for ( std::vector<numeratorSelector_and_HistManagers*>::iterator numerator = numerators.begin();
 	  numerator != numerators.end(); ++numerator ) {
-      int numHadTaus_numerator = 0;
+      int numHadTaus_numerator = hadTauWorkingPointSelector.getView((*numerator)->idxWorkingPoint_numerator_).size();
       double evtWeight_numerator = evtWeight;
       dataToMCcorrectionInterface->setHadTauSelection((*numerator)->hadTauSelection_numerator_);
       for ( std::vector<const RecoHadTau*>::const_iterator preselHadTau = preselHadTaus.begin();
 	    preselHadTau != preselHadTaus.end(); ++preselHadTau ) {
-	if ( (*(*numerator)->tightHadTauSelector_)(**preselHadTau) ) ++numHadTaus_numerator;
 	int preselHadTau_genPdgId = getHadTau_genPdgId(*preselHadTau);
 	dataToMCcorrectionInterface->setHadTaus(preselHadTau_genPdgId, (*preselHadTau)->pt(), (*preselHadTau)->eta());
 	evtWeight_numerator *= dataToMCcorrectionInterface->getSF_hadTauID_and_Iso();
@@ -0,0 +1,619 @@
+#include "FWCore/ParameterSet/interface/ParameterSet.h" // edm::ParameterSet
+#include "FWCore/PythonParameterSet/interface/MakeParameterSets.h" // edm::readPSetsFrom()
+#include "FWCore/Utilities/interface/Exception.h" // cms::Exception
+
+#include <Rtypes.h> // Int_t, Long64_t, Double_t
+#include <TFile.h> // TFile
+#include <TTree.h> // TTree
+#include <TH1.h> // TH1, TH1D
+#include <TRandom3.h> // TRandom3
+#include <TMath.h> // TMath::Pi()
+#include <TString.h> // Form
+#include <TError.h> // gErrorAbortLevel, kError
+
+#include "tthAnalysis/HiggsToTauTau/interface/RecoJet.h" // RecoJet
+#include "tthAnalysis/HiggsToTauTau/interface/RecoHadTau.h" // RecoHadTau
+#include "tthAnalysis/HiggsToTauTau/interface/RecoJetReader.h" // RecoJetReader
+#include "tthAnalysis/HiggsToTauTau/interface/convert_to_ptrs.h" // convert_to_ptrs
+#include "tthAnalysis/HiggsToTauTau/interface/ParticleCollectionCleaner.h" // RecoJetCollectionCleaner
+#include "tthAnalysis/HiggsToTauTau/interface/RecoHadTauCollectionSelectorFakeable.h" // RecoHadTauSelectorFakeable
+#include "tthAnalysis/HiggsToTauTau/interface/lutAuxFunctions.h" // lutWrapperTH2, lut::kXptYabsEta
+#include "tthAnalysis/HiggsToTauTau/interface/TMVAInterface.h" // TMVAInterface
+#include "tthAnalysis/HiggsToTauTau/interface/XGBReader.h" // XGBReader
+#include "tthAnalysis/HiggsToTauTau/interface/HadTopKinFit.h" // HadTopKinFit
+#include "tthAnalysis/HiggsToTauTau/interface/HadTopTagger.h" // HadTopTagger
+#include "tthAnalysis/HiggsToTauTau/interface/histogramAuxFunctions.h" // fill, fillWithOverFlow, addHistograms
+#include "tthAnalysis/HiggsToTauTau/interface/analysisAuxFunctions.h" // kEra_2015, kEra_2016, kEra_2017
+
+#include <iostream> // std::cout
+#include <iomanip> // std::setprecision(), std::setw()
+#include <string> // std::string
+#include <vector> // std::vector<>
+#include <map> // std::map<,>
+#include <set> // std::set<>
+#include <functional> // std::function<>
+#include <algorithm> // std::min()
+#include <chrono> // std::chrono::
+#include <atomic> // std::atomic<>
+#include <new> // std::bad_alloc
+#include <cstdlib> // EXIT_SUCCESS, EXIT_FAILURE, std::malloc(), std::free()
+#include <cstring> // std::memset()
+#include <cstdint> // std::uint64_t
+#include <fstream> // std::ifstream, std::ofstream
+#include <sstream> // std::istringstream, std::ostringstream
+
+#if defined(__linux__)
+#include <linux/perf_event.h> // perf_event_attr, PERF_COUNT_HW_CACHE_MISSES
+#include <sys/ioctl.h> // ioctl()
+#include <sys/syscall.h> // __NR_perf_event_open
+#include <unistd.h> // syscall(), read(), close()
+#endif
+
+typedef std::vector<std::string> vstring;
+
+//--- count the memory allocations made by the benchmarked code;
+//    replacing the global allocation functions affects this executable only
+namespace
+{
+  std::atomic<unsigned long long> numAllocations(0);
+}
+
+void* operator new(std::size_t size)
+{
+  numAllocations.fetch_add(1, std::memory_order_relaxed);
+  void* ptr = std::malloc(size > 0 ? size : 1);
+  if ( !ptr ) throw std::bad_alloc();
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+namespace
+{
+  /**
+   * @brief Counts the cache misses of the calling thread via the perf_event_open system call
+   *
+   * @note The counter is not available on other operating systems than Linux,
+   *       nor if access to the hardware counters is restricted (e.g. by /proc/sys/kernel/perf_event_paranoid or in virtual machines)
+   */
+  class cacheMissCounter
+  {
+   public:
+    cacheMissCounter()
+      : fd_(-1)
+    {
+#if defined(__linux__)
+      perf_event_attr attr;
+      std::memset(&attr, 0, sizeof(attr));
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.size = sizeof(attr);
+      attr.config = PERF_COUNT_HW_CACHE_MISSES;
+      attr.disabled = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      fd_ = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+      if ( fd_ >= 0 ) ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+    ~cacheMissCounter()
+    {
+#if defined(__linux__)
+      if ( fd_ >= 0 ) close(fd_);
+#endif
+    }
+
+    bool isAvailable() const { return fd_ >= 0; }
+
+    std::uint64_t get() const
+    {
+      std::uint64_t value = 0;
+#if defined(__linux__)
+      if ( fd_ >= 0 && read(fd_, &value, sizeof(value)) != sizeof(value) ) value = 0;
+#endif
+      return value;
+    }
+
+   private:
+    int fd_;
+  };
+
+  /**
+   * @brief Time, allocations and cache misses accumulated by one benchmark
+   */
+  struct benchmarkResult
+  {
+    benchmarkResult(const std::string& name = "")
+      : name_(name)
+      , numOps_(0)
+      , time_ns_(0.)
+      , numAllocations_(0)
+      , numCacheMisses_(0)
+    {}
+
+    double ns_per_op() const { return numOps_ > 0 ? time_ns_/numOps_ : 0.; }
+    double allocations_per_op() const { return numOps_ > 0 ? double(numAllocations_)/numOps_ : 0.; }
+    double cacheMisses_per_op() const { return numOps_ > 0 ? double(numCacheMisses_)/numOps_ : 0.; }
+
+    std::string name_;
+    unsigned long long numOps_;
+    double time_ns_;
+    unsigned long long numAllocations_;
+    std::uint64_t numCacheMisses_;
+  };
+
+  /**
+   * @brief Accumulates the measurements between calls to start() and stop();
+   *        the counters are read outside of the timed interval, so that their overhead is not included in the time
+   */
+  class benchmarkTimer
+  {
+   public:
+    benchmarkTimer(const cacheMissCounter& cacheMisses, benchmarkResult& result)
+      : cacheMisses_(cacheMisses)
+      , result_(result)
+      , startAllocations_(0)
+      , startCacheMisses_(0)
+    {}
+
+    void start()
+    {
+      startCacheMisses_ = cacheMisses_.get();
+      startAllocations_ = numAllocations.load(std::memory_order_relaxed);
+      startTime_ = std::chrono::steady_clock::now();
+    }
+
+    void stop(unsigned long long numOps)
+    {
+      const std::chrono::steady_clock::time_point stopTime = std::chrono::steady_clock::now();
+      const unsigned long long stopAllocations = numAllocations.load(std::memory_order_relaxed);
+      const std::uint64_t stopCacheMisses = cacheMisses_.get();
+      result_.time_ns_ += std::chrono::duration<double, std::nano>(stopTime - startTime_).count();
+      result_.numAllocations_ += stopAllocations - startAllocations_;
+      result_.numCacheMisses_ += stopCacheMisses - startCacheMisses_;
+      result_.numOps_ += numOps;
+    }
+
+   private:
+    const cacheMissCounter& cacheMisses_;
+    benchmarkResult& result_;
+    unsigned long long startAllocations_;
+    std::uint64_t startCacheMisses_;
+    std::chrono::steady_clock::time_point startTime_;
+  };
+
+  /**
+   * @brief Calls the function given as argument numOps times, after one untimed call to warm up caches and lazy initializations
+   */
+  void runBenchmark(const cacheMissCounter& cacheMisses, benchmarkResult& result, unsigned long long numOps, const std::function<void(unsigned long long)>& op)
+  {
+    op(0);
+    benchmarkTimer timer(cacheMisses, result);
+    timer.start();
+    for ( unsigned long long idxOp = 0; idxOp < numOps; ++idxOp ) {
+      op(idxOp);
+    }
+    timer.stop(numOps);
+  }
+
+  /**
+   * @brief Results of a previous run, per operation
+   */
+  struct baselineEntry
+  {
+    double ns_per_op_;
+    double allocations_per_op_;
+    double cacheMisses_per_op_; // -1 if the cache misses were not measured
+  };
+
+  /**
+   * @brief Reads the results of a previous run of benchmarkKernels from a text file, one line per benchmark:
+   *
+   *   name ns/op allocations/op cacheMisses/op
+   *
+   * where cacheMisses/op is -1 if the cache misses were not measured; lines starting with '#' are ignored
+   */
+  std::map<std::string, baselineEntry> readBaseline(const std::string& baselineFileName)
+  {
+    std::ifstream baselineFile(baselineFileName);
+    if ( !baselineFile ) throw cms::Exception("benchmarkKernels")
+      << "Failed to open baseline file = " << baselineFileName << " !!\n";
+    std::map<std::string, baselineEntry> baseline;
+    std::string line;
+    while ( std::getline(baselineFile, line) ) {
+      if ( line.empty() || line[0] == '#' ) continue;
+      std::istringstream lineStream(line);
+      std::string name;
+      baselineEntry entry;
+      if ( !(lineStream >> name >> entry.ns_per_op_ >> entry.allocations_per_op_ >> entry.cacheMisses_per_op_) ) throw cms::Exception("benchmarkKernels")
+        << "Invalid line '" << line << "' in baseline file = " << baselineFileName << " !!\n";
+      baseline[name] = entry;
+    }
+    return baseline;
+  }
+
+  void writeBaseline(const std::string& baselineFileName, const std::vector<benchmarkResult>& results, bool hasCacheMisses)
+  {
+    std::ofstream baselineFile(baselineFileName);
+    if ( !baselineFile ) throw cms::Exception("benchmarkKernels")
+      << "Failed to create baseline file = " << baselineFileName << " !!\n";
+    baselineFile << "# name ns/op allocations/op cacheMisses/op\n";
+    for ( std::vector<benchmarkResult>::const_iterator result = results.begin();
+          result != results.end(); ++result ) {
+      baselineFile << result->name_ << ' ' << result->ns_per_op() << ' ' << result->allocations_per_op() << ' '
+                   << (hasCacheMisses ? result->cacheMisses_per_op() : -1.) << '\n';
+    }
+  }
+
+  /**
+   * @brief Synthetic event, with jets and hadronic taus drawn from a fixed random seed
+   */
+  struct syntheticEvent
+  {
+    std::vector<RecoJet> jets_;
+    std::vector<RecoHadTau> hadTaus_;
+  };
+
+  std::vector<syntheticEvent> makeSyntheticEvents(unsigned numEvents, TRandom3& rnd)
+  {
+    std::vector<syntheticEvent> events(numEvents);
+    for ( unsigned idxEvent = 0; idxEvent < numEvents; ++idxEvent ) {
+      syntheticEvent& event = events[idxEvent];
+      const int numJets = 3 + rnd.Integer(8);
+      for ( int idxJet = 0; idxJet < numJets; ++idxJet ) {
+        event.jets_.push_back(RecoJet(
+          25. + rnd.Exp(40.), rnd.Uniform(-2.4, +2.4), rnd.Uniform(-TMath::Pi(), +TMath::Pi()), rnd.Uniform(5., 20.),
+          1., 1.02, 0.98, rnd.Uniform(0., 1.), 1., rnd.Uniform(0., 1.), 0, idxJet));
+      }
+      const int numHadTaus = rnd.Integer(4);
+      for ( int idxHadTau = 0; idxHadTau < numHadTaus; ++idxHadTau ) {
+        const int id_mva_dR03 = rnd.Integer(8);
+        event.hadTaus_.push_back(RecoHadTau(
+          20. + rnd.Exp(30.), rnd.Uniform(-2.3, +2.3), rnd.Uniform(-TMath::Pi(), +TMath::Pi()), 1.,
+          rnd.Rndm() > 0.5 ? +1 : -1, rnd.Gaus(0., 0.01), rnd.Gaus(0., 0.02), rnd.Integer(11), 1, 1,
+          id_mva_dR03, rnd.Uniform(-1., +1.), id_mva_dR03, rnd.Uniform(-1., +1.),
+          rnd.Integer(4), rnd.Exp(2.), rnd.Integer(4), rnd.Exp(2.), rnd.Integer(6), rnd.Integer(3)));
+      }
+    }
+    return events;
+  }
+}
+
+/**
+ * @brief Micro-benchmarks of the functions that dominate the run time of the analyze_* executables
+ *
+ * Each benchmark is run on synthetic events drawn from a fixed random seed, so that successive runs process identical inputs;
+ * the benchmark of RecoJetReader::read() is run on a recorded Ntuple instead.
+ * For each benchmark, the time (ns/op), the number of memory allocations (allocations/op)
+ * and, where the hardware counters are accessible, the number of cache misses (cacheMisses/op) per operation are reported.
+ *
+ * The results can be written to a text file and compared to the results of a previous run (the "baseline"),
+ * to check the effect of a code change on performance.
+ */
+int main(int argc, char* argv[])
+{
+//--- throw an exception in case ROOT encounters an error
+  gErrorAbortLevel = kError;
+
+//--- parse command-line arguments
+  if ( argc < 2 ) {
+    std::cout << "Usage: " << argv[0] << " [parameters.py]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "<benchmarkKernels>:" << std::endl;
+
+//--- read python configuration parameters
+  if ( !edm::readPSetsFrom(argv[1])->existsAs<edm::ParameterSet>("process") )
+    throw cms::Exception("benchmarkKernels")
+      << "No ParameterSet 'process' found in configuration file = " << argv[1] << " !!\n";
+
+  edm::ParameterSet cfg = edm::readPSetsFrom(argv[1])->getParameter<edm::ParameterSet>("process");
+
+  edm::ParameterSet cfg_benchmarkKernels = cfg.getParameter<edm::ParameterSet>("benchmarkKernels");
+
+  std::string era_string = cfg_benchmarkKernels.getParameter<std::string>("era");
+  int era = -1;
+  if      ( era_string == "2015" ) era = kEra_2015;
+  else if ( era_string == "2016" ) era = kEra_2016;
+  else if ( era_string == "2017" ) era = kEra_2017;
+  else throw cms::Exception("benchmarkKernels")
+    << "Invalid Configuration parameter 'era' = " << era_string << " !!\n";
+
+  vstring benchmarks_vstring = cfg_benchmarkKernels.getParameter<vstring>("benchmarks");
+  std::set<std::string> benchmarks(benchmarks_vstring.begin(), benchmarks_vstring.end());
+  auto isEnabled = [&benchmarks](const std::string& name) { return benchmarks.empty() || benchmarks.count(name); };
+
+  unsigned seed = cfg_benchmarkKernels.getParameter<unsigned>("seed");
+  unsigned numEvents = cfg_benchmarkKernels.getParameter<unsigned>("numEvents");
+  if ( numEvents == 0 ) throw cms::Exception("benchmarkKernels")
+    << "Invalid Configuration parameter 'numEvents' = " << numEvents << " !!\n";
+  unsigned long long numOps = cfg_benchmarkKernels.getParameter<unsigned>("numOps");
+  unsigned long long numOps_slow = cfg_benchmarkKernels.getParameter<unsigned>("numOps_slow");
+
+  std::string inputFileName = cfg_benchmarkKernels.getParameter<std::string>("inputFileName");
+  std::string treeName = cfg_benchmarkKernels.getParameter<std::string>("treeName");
+  std::string branchName_jets = cfg_benchmarkKernels.getParameter<std::string>("branchName_jets");
+  unsigned numReadsPerEntry = cfg_benchmarkKernels.getParameter<unsigned>("numReadsPerEntry");
+
+  std::string lutFileName = cfg_benchmarkKernels.getParameter<std::string>("lutFileName");
+  std::string lutName = cfg_benchmarkKernels.getParameter<std::string>("lutName");
+
+  std::string mvaFileName = cfg_benchmarkKernels.getParameter<std::string>("mvaFileName");
+  vstring mvaInputVariables = cfg_benchmarkKernels.getParameter<vstring>("mvaInputVariables");
+
+  std::string mvaFileName_hadTopTaggerWithKinFit = cfg_benchmarkKernels.getParameter<std::string>("mvaFileName_hadTopTaggerWithKinFit");
+  std::string mvaFileName_hadTopTaggerNoKinFit = cfg_benchmarkKernels.getParameter<std::string>("mvaFileName_hadTopTaggerNoKinFit");
+
+  std::string baselineFileName_input = cfg_benchmarkKernels.getParameter<std::string>("baselineFileName_input");
+  std::string baselineFileName_output = cfg_benchmarkKernels.getParameter<std::string>("baselineFileName_output");
+  double tolerance = cfg_benchmarkKernels.getParameter<double>("tolerance");
+  bool failOnRegression = cfg_benchmarkKernels.getParameter<bool>("failOnRegression");
+
+  cacheMissCounter cacheMisses;
+  if ( !cacheMisses.isAvailable() ) {
+    std::cout << "Warning: hardware counters not accessible, cache misses will not be measured" << std::endl;
+  }
+
+  TRandom3 rnd(seed);
+  std::vector<syntheticEvent> events = makeSyntheticEvents(numEvents, rnd);
+  std::vector<std::vector<const RecoJet*>> jet_ptrs(numEvents);
+  std::vector<std::vector<const RecoHadTau*>> hadTau_ptrs(numEvents);
+  for ( unsigned idxEvent = 0; idxEvent < numEvents; ++idxEvent ) {
+    jet_ptrs[idxEvent] = convert_to_ptrs(events[idxEvent].jets_);
+    hadTau_ptrs[idxEvent] = convert_to_ptrs(events[idxEvent].hadTaus_);
+  }
+  std::vector<const RecoHadTau*> allHadTaus;
+  for ( unsigned idxEvent = 0; idxEvent < numEvents; ++idxEvent ) {
+    allHadTaus.insert(allHadTaus.end(), hadTau_ptrs[idxEvent].begin(), hadTau_ptrs[idxEvent].end());
+  }
+  if ( allHadTaus.empty() ) throw cms::Exception("benchmarkKernels")
+    << "No hadronic taus generated in " << numEvents << " synthetic events, increase Configuration parameter 'numEvents' !!\n";
+
+//--- accumulate the results of the benchmarked functions, so that the compiler cannot optimize the calls away
+  volatile double sink = 0.;
+
+  std::vector<benchmarkResult> results;
+
+  if ( isEnabled("RecoJetReader::read") ) {
+    if ( inputFileName.empty() ) {
+      std::cout << "Skipping benchmark RecoJetReader::read, as no input file is given" << std::endl;
+    } else {
+      TFile* inputFile = TFile::Open(inputFileName.data());
+      if ( !inputFile || inputFile->IsZombie() ) throw cms::Exception("benchmarkKernels")
+        << "Failed to open input file = " << inputFileName << " !!\n";
+      TTree* inputTree = dynamic_cast<TTree*>(inputFile->Get(treeName.data()));
+      if ( !inputTree ) throw cms::Exception("benchmarkKernels")
+        << "Failed to find TTree = " << treeName << " in input file = " << inputFileName << " !!\n";
+      RecoJetReader* jetReader = new RecoJetReader(era, true, Form("n%s", branchName_jets.data()), branchName_jets);
+      jetReader->setBranchAddresses(inputTree);
+      results.push_back(benchmarkResult("RecoJetReader::read"));
+      benchmarkTimer timer(cacheMisses, results.back());
+      const Long64_t numEntries = std::min(inputTree->GetEntries(), Long64_t(numEvents));
+      for ( Long64_t idxEntry = 0; idxEntry < numEntries; ++idxEntry ) {
+//--- reading the entry from the file is not part of the benchmark
+        inputTree->GetEntry(idxEntry);
+        timer.start();
+        for ( unsigned idxRead = 0; idxRead < numReadsPerEntry; ++idxRead ) {
+          std::vector<RecoJet> jets = jetReader->read();
+          sink = sink + jets.size();
+        }
+        timer.stop(numReadsPerEntry);
+      }
+      delete jetReader;
+      delete inputFile;
+    }
+  }
+
+  if ( isEnabled("ParticleCollectionCleaner") ) {
+    RecoJetCollectionCleaner jetCleaner(0.4);
+    results.push_back(benchmarkResult("ParticleCollectionCleaner"));
+    runBenchmark(cacheMisses, results.back(), numOps, [&](unsigned long long idxOp) {
+      const unsigned idxEvent = idxOp % numEvents;
+      std::vector<const RecoJet*> cleanedJets = jetCleaner(jet_ptrs[idxEvent], hadTau_ptrs[idxEvent]);
+      sink = sink + cleanedJets.size();
+    });
+  }
+
+  if ( isEnabled("RecoHadTauSelectorBase") ) {
+    RecoHadTauSelectorFakeable hadTauSelector(era);
+    results.push_back(benchmarkResult("RecoHadTauSelectorBase"));
+    runBenchmark(cacheMisses, results.back(), numOps, [&](unsigned long long idxOp) {
+      sink = sink + hadTauSelector(*allHadTaus[idxOp % allHadTaus.size()]);
+    });
+  }
+
+  if ( isEnabled("lutWrapperBase::getSF") ) {
+    std::map<std::string, TFile*> inputFiles;
+    lutWrapperTH2 lut(inputFiles, lutFileName, lutName, lut::kXptYabsEta);
+    std::vector<std::pair<double, double>> pt_and_eta(numEvents);
+    for ( unsigned idxEvent = 0; idxEvent < numEvents; ++idxEvent ) {
+      pt_and_eta[idxEvent] = std::make_pair(10. + rnd.Exp(40.), rnd.Uniform(-2.5, +2.5));
+    }
+    results.push_back(benchmarkResult("lutWrapperBase::getSF"));
+    runBenchmark(cacheMisses, results.back(), numOps, [&](unsigned long long idxOp) {
+      const std::pair<double, double>& point = pt_and_eta[idxOp % numEvents];
+      sink = sink + lut.getSF(point.first, point.second);
+    });
+    for ( std::map<std::string, TFile*>::iterator inputFile = inputFiles.begin();
+          inputFile != inputFiles.end(); ++inputFile ) {
+      delete inputFile->second;
+    }
+  }
+
+  if ( isEnabled("TMVAInterface::operator()") ) {
+    TMVAInterface mva(mvaFileName, mvaInputVariables);
+    std::vector<std::map<std::string, double>> mvaInputs(numEvents);
+    for ( unsigned idxEvent = 0; idxEvent < numEvents; ++idxEvent ) {
+      for ( vstring::const_iterator mvaInputVariable = mvaInputVariables.begin();
+            mvaInputVariable != mvaInputVariables.end(); ++mvaInputVariable ) {
+        mvaInputs[idxEvent][*mvaInputVariable] = rnd.Uniform(0., 100.);
+      }
+    }
+    results.push_back(benchmarkResult("TMVAInterface::operator()"));
+    runBenchmark(cacheMisses, results.back(), numOps, [&](unsigned long long idxOp) {
+      sink = sink + mva(mvaInputs[idxOp % numEvents]);
+    });
+  }
+
+//--- jet triplets (b-jet, W-jet 1, W-jet 2) for the kinematic fit and the hadronic top tagger
+  std::vector<std::vector<const RecoJet*>> jetTriplets;
+  for ( unsigned idxEvent = 0; idxEvent < numEvents; ++idxEvent ) {
+    const std::vector<RecoJet>& jets = events[idxEvent].jets_;
+    jetTriplets.push_back({ &jets[0], &jets[1], &jets[2] });
+  }
+
+  if ( isEnabled("XGBReader") ) {
+    std::vector<std::map<std::string, double>> mvaInputs(numEvents);
+    for ( unsigned idxEvent = 0; idxEvent < numEvents; ++idxEvent ) {
+      const RecoJet* recBJet = jetTriplets[idxEvent][0];
+      const RecoJet* recWJet1 = jetTriplets[idxEvent][1];
+      const RecoJet* recWJet2 = jetTriplets[idxEvent][2];
+      std::map<std::string, double>& mvaInputs_event = mvaInputs[idxEvent];
+      mvaInputs_event["CSV_b"]      = recBJet->BtagCSV();
+      mvaInputs_event["qg_Wj2"]     = recWJet2->QGDiscr();
+      mvaInputs_event["qg_Wj1"]     = recWJet1->QGDiscr();
+      mvaInputs_event["m_bWj1Wj2"]  = (recBJet->p4() + recWJet1->p4() + recWJet2->p4()).mass();
+      mvaInputs_event["pT_bWj1Wj2"] = (recBJet->p4() + recWJet1->p4() + recWJet2->p4()).pt();
+      mvaInputs_event["m_Wj1Wj2"]   = (recWJet1->p4() + recWJet2->p4()).mass();
+      mvaInputs_event["pT_Wj2"]     = recWJet2->pt();
+    }
+    char* pklpath = const_cast<char*>(mvaFileName_hadTopTaggerNoKinFit.data());
+    results.push_back(benchmarkResult("XGBReader"));
+    runBenchmark(cacheMisses, results.back(), numOps_slow, [&](unsigned long long idxOp) {
+      sink = sink + XGBReader(mvaInputs[idxOp % numEvents], pklpath);
+    });
+  }
+
+  if ( isEnabled("HadTopKinFit::fit") ) {
+    HadTopKinFit kinFit;
+    results.push_back(benchmarkResult("HadTopKinFit::fit"));
+    runBenchmark(cacheMisses, results.back(), numOps_slow, [&](unsigned long long idxOp) {
+      const std::vector<const RecoJet*>& jetTriplet = jetTriplets[idxOp % numEvents];
+      kinFit.fit(jetTriplet[0]->p4(), jetTriplet[1]->p4(), jetTriplet[2]->p4());
+      sink = sink + kinFit.nll();
+    });
+  }
+
+  if ( isEnabled("HadTopTagger::operator()") ) {
+    HadTopTagger hadTopTagger(mvaFileName_hadTopTaggerWithKinFit, mvaFileName_hadTopTaggerNoKinFit);
+    results.push_back(benchmarkResult("HadTopTagger::operator()"));
+    runBenchmark(cacheMisses, results.back(), numOps_slow, [&](unsigned long long idxOp) {
+      const std::vector<const RecoJet*>& jetTriplet = jetTriplets[idxOp % numEvents];
+      std::vector<double> mvaOutputs = hadTopTagger(*jetTriplet[0], *jetTriplet[1], *jetTriplet[2]);
+      sink = sink + mvaOutputs[0];
+    });
+  }
+
+  std::vector<std::pair<double, double>> x_and_weight(numEvents);
+  for ( unsigned idxEvent = 0; idxEvent < numEvents; ++idxEvent ) {
+    x_and_weight[idxEvent] = std::make_pair(rnd.Exp(60.), rnd.Gaus(1., 0.2));
+  }
+
+  if ( isEnabled("fill") ) {
+    TH1* histogram = new TH1D("benchmark_fill", "benchmark_fill", 40, 0., 200.);
+    histogram->SetDirectory(0);
+    results.push_back(benchmarkResult("fill"));
+    runBenchmark(cacheMisses, results.back(), numOps, [&](unsigned long long idxOp) {
+      const std::pair<double, double>& point = x_and_weight[idxOp % numEvents];
+      fill(histogram, point.first, point.second, 0.01);
+    });
+    sink = sink + histogram->Integral();
+    delete histogram;
+  }
+
+  if ( isEnabled("fillWithOverFlow") ) {
+    TH1* histogram = new TH1D("benchmark_fillWithOverFlow", "benchmark_fillWithOverFlow", 40, 0., 200.);
+    histogram->SetDirectory(0);
+    results.push_back(benchmarkResult("fillWithOverFlow"));
+    runBenchmark(cacheMisses, results.back(), numOps, [&](unsigned long long idxOp) {
+      const std::pair<double, double>& point = x_and_weight[idxOp % numEvents];
+      fillWithOverFlow(histogram, point.first, point.second, 0.01);
+    });
+    sink = sink + histogram->Integral();
+    delete histogram;
+  }
+
+  if ( isEnabled("addHistograms") ) {
+//--- sum of 10 histograms with 100 bins each, typical of the sum of background processes in prepareDatacards and makePlots
+    std::vector<TH1*> histograms;
+    for ( int idxHistogram = 0; idxHistogram < 10; ++idxHistogram ) {
+      TH1* histogram = new TH1D(Form("benchmark_addHistograms%i", idxHistogram), "benchmark_addHistograms", 100, 0., 1.);
+      histogram->SetDirectory(0);
+      histogram->Sumw2();
+      for ( int idxFill = 0; idxFill < 1000; ++idxFill ) {
+        histogram->Fill(rnd.Rndm(), rnd.Gaus(1., 0.2));
+      }
+      histograms.push_back(histogram);
+    }
+    results.push_back(benchmarkResult("addHistograms"));
+    runBenchmark(cacheMisses, results.back(), numOps_slow, [&](unsigned long long idxOp) {
+      TH1* histogramSum = addHistograms("benchmark_addHistograms_sum", histograms);
+      histogramSum->SetDirectory(0);
+      sink = sink + histogramSum->Integral();
+      delete histogramSum;
+    });
+    for ( std::vector<TH1*>::iterator histogram = histograms.begin();
+          histogram != histograms.end(); ++histogram ) {
+      delete (*histogram);
+    }
+  }
+
+//--- print the results and compare them to the baseline
+  std::map<std::string, baselineEntry> baseline;
+  if ( baselineFileName_input != "" ) {
+    baseline = readBaseline(baselineFileName_input);
+  }
+  int numRegressions = 0;
+//--- format into a local stream, so that the precision and format flags of std::cout are left unchanged
+  std::ostringstream table;
+  table << std::left << std::setw(28) << "benchmark" << std::right
+        << std::setw(12) << "ops" << std::setw(14) << "ns/op" << std::setw(16) << "allocations/op" << std::setw(16) << "cacheMisses/op";
+  if ( !baseline.empty() ) table << std::setw(22) << "ns/op (baseline)";
+  table << std::endl;
+  for ( std::vector<benchmarkResult>::const_iterator result = results.begin();
+        result != results.end(); ++result ) {
+    table << std::left << std::setw(28) << result->name_ << std::right
+          << std::setw(12) << result->numOps_
+          << std::fixed << std::setprecision(1)
+          << std::setw(14) << result->ns_per_op()
+          << std::setprecision(2) << std::setw(16) << result->allocations_per_op();
+    if ( cacheMisses.isAvailable() ) table << std::setw(16) << result->cacheMisses_per_op();
+    else table << std::setw(16) << "n/a";
+    std::map<std::string, baselineEntry>::const_iterator reference = baseline.find(result->name_);
+    if ( reference != baseline.end() && reference->second.ns_per_op_ > 0. ) {
+      const double ratio = result->ns_per_op()/reference->second.ns_per_op_;
+      table << std::setprecision(1) << std::setw(14) << reference->second.ns_per_op_
+            << " (" << std::setprecision(2) << ratio << "x)";
+//--- the allocations are deterministic, so that any increase is reported
+      if ( ratio > (1. + tolerance) || result->allocations_per_op() > reference->second.allocations_per_op_ + 0.01 ) {
+        table << " REGRESSION";
+        ++numRegressions;
+      }
+    }
+    table << std::endl;
+  }
+  std::cout << table.str();
+
+  if ( baselineFileName_output != "" ) {
+    writeBaseline(baselineFileName_output, results, cacheMisses.isAvailable());
+    std::cout << "Results written to " << baselineFileName_output << std::endl;
+  }
+
+  std::cout << "(checksum = " << sink << ")" << std::endl;
+
+  if ( numRegressions > 0 ) {
+    std::cout << numRegressions << " benchmark(s) slower than the baseline by more than " << 100.*tolerance << "%"
+              << " or with more allocations" << std::endl;
+    if ( failOnRegression ) return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -12,6 +12,12 @@
 #include <set> // std::set<>
 #include <iterator> // std::inserter()
 #include <regex> // std::regex, std::smatch, std::regex_match()
+#include <sstream> // std::istringstream, std::ostringstream
+#include <thread> // std::thread
+#include <mutex> // std::mutex, std::lock_guard<>
+#include <atomic> // std::atomic<>
+#include <cstdint> // std::uint64_t
+#include <ctime> // std::time_t
 
 #include <boost/filesystem.hpp> // boost::filesystem::
 #include <boost/program_options.hpp> // boost::program_options::
@@ -26,6 +32,7 @@
 #include <TROOT.h> // gROOT
 #include <TError.h> // kError
 #include <TString.h> // Form()
+#include <TList.h> // TList
 
 #define IMPROPER_FILE_C -1
 #define ZOMBIE_FILE_C   -2
@@ -37,6 +44,8 @@
 
 #define LINE std::string(80, '*') + '\n'
 
+#define CACHE_HEADER std::string("# check_broken cache; histogram: ")
+
 /**
  * @file
  * Check broken root files in the file system
@@ -44,7 +53,7 @@
  * You are encouraged to build it with scram, but if you are keen to not use it,
  * then proceed with the following command in order to build the executable:
  *
-   g++ -std=c++11 \
+   g++ -std=c++11 -pthread \
      -I/cvmfs/cms.cern.ch/slc6_amd64_gcc493/external/boost/1.57.0-kpegke/include \
      -I/cvmfs/cms.cern.ch/slc6_amd64_gcc493/lcg/root/6.02.12-kpegke4/include \
      check_broken.cc -o check_broken \
@@ -72,10 +81,21 @@
     -P [ --python ]             generate rudimentary python configuration file
     -v [ --verbose ]            log every file and folder
     -f [ --filter ]             only look at datasets containing specified string
+    -j [ --jobs ] arg (=1)      number of files checked in parallel
+    -c [ --cache ] arg          cache file; only new or modified files are
+                                checked
+    -F [ --fast ]               check only file header/footer and histogram
+                                keys, without reading the event counts
 
  * Example usage:
 
    check_broken -p /hdfs/local/lucia/VHBBHeppyV24bis/ --histo Count --output=/home/lucia/sandbox -P -z -v
+
+ * The files are checked by a pool of --jobs threads. If --cache is given, the results are stored
+ * in the cache file keyed by (path, file size, modification time), so that subsequent runs only
+ * need to check the files that have been added or modified in the meantime:
+
+   check_broken -p /hdfs/local/lucia/VHBBHeppyV24bis/ -j 16 -c /home/lucia/sandbox/check_broken.cache
  */
 
 
@@ -135,36 +155,180 @@ struct recursive_directory_range
 };
 
 /**
- * @brief Checks whether a given root file is broken or not
- * @param path Full path to an actual root file
- * @param tree TTree name
- * @return IMPROPER_FILE_C if the file doesn't have TTree called 'tree',
- *         ZOMBIE_FILE_C   if the file is broken,
+ * @brief Reads the number of events from a given root file
+ * @param f     Opened root file
+ * @param histo Name of the histogram holding the event count
+ * @return IMPROPER_FILE_C if the file doesn't have a histogram called 'histo',
  *         otherwise the number of events in that file
  */
 double
-check_broken(const std::string & path,
-             const std::string & histo,
-             const bool isData = false)
+get_nof_events(TFile & f,
+               const std::string & histo,
+               const bool isData = false)
+{
+  if(! f.GetListOfKeys() -> Contains(histo.c_str()))
+    return IMPROPER_FILE_C;
+  TH1 * h;
+  if(isData == true)
+    h = dynamic_cast<TH1 *>(f.Get("Count"));
+  else
+    h = dynamic_cast<TH1 *>(f.Get(histo.c_str()));
+  return h -> Integral();
+}
+
+/**
+ * @brief Checks the ROOT file header and footer without opening the file in ROOT
+ *
+ * The file must start with the magic bytes "root"; the header records the position
+ * of the end of the file (fEND), which must coincide with the actual file size.
+ * Files that were truncated during the transfer or whose writing was interrupted
+ * are thus caught without any ROOT I/O.
+ *
+ * @param path      Full path to an actual root file
+ * @param file_size Size of the file in bytes
+ * @return true if the header is intact, false otherwise
+ */
+bool
+check_header(const std::string & path,
+             boost::uintmax_t file_size)
+{
+  std::ifstream f(path, std::ios::binary);
+  unsigned char header[20];
+  if(! f.read(reinterpret_cast<char *>(header), sizeof(header)))
+    return false;
+  if(header[0] != 'r' || header[1] != 'o' || header[2] != 'o' || header[3] != 't')
+    return false;
+
+//--- the header is stored in big-endian byte order;
+//--- files larger than 2GB use 64-bit pointers, indicated by fVersion > 1000000
+  const auto read_be = [&header](unsigned offset, unsigned nof_bytes) -> std::uint64_t
+  {
+    std::uint64_t val = 0;
+    for(unsigned i = 0; i < nof_bytes; ++i)
+      val = (val << 8) | header[offset + i];
+    return val;
+  };
+  const std::uint64_t version = read_be(4, 4);
+  const std::uint64_t end_pos = version > 1000000 ? read_be(12, 8) : read_be(12, 4);
+  return end_pos == file_size;
+}
+
+/**
+ * @brief Result of checking a single file
+ */
+struct FileCheck
+{
+  std::string path;
+  boost::uintmax_t size;
+  std::time_t mtime;
+  bool isData;
+  double nof_events;
+  double nof_events_unweighted;
+  bool cached;
+};
+
+/**
+ * @brief Checks a single file and fills the event counts
+ *
+ * The file is opened only once to read both the weighted and the unweighted event count.
+ * In the fast mode, only the header/footer and the presence of the histograms are checked,
+ * and the streamer information is not read; the event counts are set to 0
+ *
+ * @param file_check File to be checked
+ * @param histo      Name of the histogram holding the weighted event count
+ * @param fast       Use the fast mode
+ */
+void
+check_file(FileCheck & file_check,
+           const std::string & histo,
+           bool fast)
 {
-  TFile f(path.c_str());
-  double ret_val = ZOMBIE_FILE_C;
+  file_check.nof_events = ZOMBIE_FILE_C;
+  file_check.nof_events_unweighted = ZOMBIE_FILE_C;
+  if(! check_header(file_check.path, file_check.size))
+    return;
+
+  TFile f(file_check.path.c_str());
   if(! f.IsZombie())
   {
-    if(f.GetListOfKeys() -> Contains(histo.c_str()))
+    if(fast)
     {
-      TH1 * h;
-      if(isData == true)
-        h = dynamic_cast<TH1 *>(f.Get("Count"));
-      else
-        h = dynamic_cast<TH1 *>(f.Get(histo.c_str()));
-      ret_val = h -> Integral();
+      const TList * keys = f.GetListOfKeys();
+      file_check.nof_events            = keys -> Contains(histo.c_str()) ? 0. : IMPROPER_FILE_C;
+      file_check.nof_events_unweighted = keys -> Contains("Count")       ? 0. : IMPROPER_FILE_C;
     }
     else
-      return IMPROPER_FILE_C;
+    {
+      file_check.nof_events            = get_nof_events(f, histo,   file_check.isData);
+      file_check.nof_events_unweighted = get_nof_events(f, "Count", file_check.isData);
+    }
   }
   f.Close();
-  return ret_val;
+}
+
+/**
+ * @brief Reads the results of previous runs
+ *
+ * Each line of the cache file holds the path, size, modification time and
+ * the weighted and unweighted event counts of a single file, separated by tabs.
+ * The first line records the histogram name the event counts refer to;
+ * if it differs from the current one, the cache is ignored.
+ *
+ * @param cache_path Path to the cache file
+ * @param histo      Name of the histogram holding the weighted event count
+ * @return map of path -> cached result
+ */
+std::map<std::string, FileCheck>
+read_cache(const std::string & cache_path,
+           const std::string & histo)
+{
+  std::map<std::string, FileCheck> cache;
+  std::ifstream in(cache_path);
+  if(! in.good())
+    return cache;
+
+  std::string line;
+  if(! std::getline(in, line) || line != CACHE_HEADER + histo)
+  {
+    std::cout << "Ignoring cache file '" << cache_path << "' created for a different histogram\n";
+    return cache;
+  }
+  while(std::getline(in, line))
+  {
+    std::istringstream line_stream(line);
+    FileCheck file_check;
+    if(std::getline(line_stream, file_check.path, '\t') &&
+       line_stream >> file_check.size >> file_check.mtime
+                   >> file_check.nof_events >> file_check.nof_events_unweighted)
+    {
+      file_check.cached = true;
+      cache[file_check.path] = file_check;
+    }
+  }
+  std::cout << "Read " << cache.size() << " entries from cache file '" << cache_path << "'\n";
+  return cache;
+}
+
+/**
+ * @brief Writes the results of the current run to the cache file
+ * @param cache_path  Path to the cache file
+ * @param histo       Name of the histogram holding the weighted event count
+ * @param file_checks Results of the current run
+ */
+void
+write_cache(const std::string & cache_path,
+            const std::string & histo,
+            const std::vector<FileCheck> & file_checks)
+{
+  std::ofstream out(cache_path);
+  out << CACHE_HEADER << histo << '\n' << std::setprecision(17);
+  for(const FileCheck & file_check: file_checks)
+    out << file_check.path                  << '\t'
+        << file_check.size                  << '\t'
+        << file_check.mtime                 << '\t'
+        << file_check.nof_events            << '\t'
+        << file_check.nof_events_unweighted << '\n';
+  std::cout << "Wrote " << file_checks.size() << " entries to cache file '" << cache_path << "'\n";
 }
 
 unsigned
@@ -855,9 +1019,10 @@ main(int argc,
   std::cout << "All samples have been successfully defined\n";
   
   //--- parse command line arguments
-  std::string histo_str, output_dir_str, filter;
+  std::string histo_str, output_dir_str, filter, cache_str;
   std::vector<std::string> target_strs;
-  bool save_zerofs, save_improper, save_python, verbose, data_only;
+  bool save_zerofs, save_improper, save_python, verbose, data_only, fast;
+  unsigned nof_jobs;
   try
   {
     boost::program_options::options_description desc("Allowed options");
@@ -882,6 +1047,12 @@ main(int argc,
                      "only go through data directories")
       ("filter,f",   boost::program_options::value<std::string>(&filter) -> default_value(""),
                      "check only dataset containing specified string")
+      ("jobs,j",     boost::program_options::value<unsigned>(&nof_jobs) -> default_value(1),
+                     "number of files checked in parallel")
+      ("cache,c",    boost::program_options::value<std::string>(&cache_str) -> default_value(""),
+                     "cache file; only new or modified files are checked")
+      ("fast,F",     boost::program_options::bool_switch(&fast) -> default_value(false),
+                     "check only file header/footer and histogram keys, without reading the event counts")
                      
     ;
     boost::program_options::variables_map vm;
@@ -930,6 +1101,17 @@ main(int argc,
     std::cerr << "Output directory not specified\n";
     return EXIT_FAILURE;
   }
+  if(fast && save_python)
+  {
+    std::cerr << "Cannot generate python configuration file in the fast mode, "
+                 "since the event counts are not read\n";
+    return EXIT_FAILURE;
+  }
+  if(! nof_jobs)
+  {
+    std::cerr << "Number of jobs must be positive\n";
+    return EXIT_FAILURE;
+  }
 
 //--- quick printout of the chosen options
   std::cout << "Command entered: "
@@ -938,7 +1120,11 @@ main(int argc,
     std::cout << "Directory to analyze: " << target_str << '\n';
   }
   std::cout << "TH1F name: "            << histo_str << '\n'
+            << "Number of jobs: "       << nof_jobs << '\n'
+            << "Fast mode: "            << std::boolalpha << fast << '\n'
             << "Verbose printout: "     << std::boolalpha << verbose << '\n';
+  if(! cache_str.empty())
+    std::cout << "Cache file: " << cache_str << '\n';
   if(! output_dir_path.empty())
     std::cout << "Output directory: " << output_dir_path.string() << '\n';
   std::cout << LINE;
@@ -996,17 +1182,20 @@ main(int argc,
     }
   }
 
+//--- read the results of previous runs
+  const std::map<std::string, FileCheck> cache = cache_str.empty() ?
+    std::map<std::string, FileCheck>() : read_cache(cache_str, histo_str);
+
 //--- loop over the list of immediate subdirectories recursively
+//--- and collect the files that need to be checked
+  std::vector<std::pair<Sample *, FileCheck>> file_checks;
   for(Sample *sample: samples.get_list())
   {
     if(verbose) std::cout << ">> Looping over: " << sample->pathStr << std::endl;
     for(const boost::filesystem::directory_entry & it: recursive_directory_range(sample->path))
     {
-      //std::cout << "it " << it << std::endl;
       const boost::filesystem::path file = it.path();
-      //std::cout << "path " << it.path() << std::endl;
       const std::string file_str = file.string();
-      //std::cout << "file_str " << file_str << std::endl;
       
       if(boost::contains(file_str,"170217_153318")) continue; //One-time issue of 2 submissions as sibling directories
       
@@ -1014,11 +1203,6 @@ main(int argc,
       if(boost::filesystem::is_regular_file(file) &&
          boost::filesystem::extension(file) == ".root")
       {
-        //if(verbose) std::cout << "Sample name: " << sample.dbs_name << '\n';
-        //if(verbose) std::cout << "Sample category: " << sample.category << '\n';
-        //if(verbose) std::cout << "Process name: " << sample.process_name << '\n';
-        //if(verbose) std::cout << "Checking: " << file_str << '\n';
-
         // see if the root file matches to the format: tree_<digits>.root
         try
         {
@@ -1044,16 +1228,25 @@ main(int argc,
 //--- don't even bother checking whether the file is zombie or not
           continue;
         }
-        bool isData = false;
-        if(sample->category.find("data_obs")!=std::string::npos) isData = true;
-        const double nof_events = check_broken(file_str, histo_str, isData); //tree_str);
-        const double nof_events_unweighted = check_broken(file_str, "Count", isData); //tree_str);
-        
-        if     (nof_events > 0)                    sample->nof_events += nof_events;
-        else if(nof_events -0.5 < ZOMBIE_FILE_C)   sample->zombies.push_back(file_str);
-        else if(nof_events -0.5 < IMPROPER_FILE_C) sample->improper.push_back(file_str);
-        
-        if     (nof_events_unweighted > 0)                sample->nof_events_unweighted += nof_events_unweighted;
+        FileCheck file_check;
+        file_check.path = file_str;
+        file_check.size = file_size;
+        file_check.mtime = boost::filesystem::last_write_time(file);
+        file_check.isData = sample->category.find("data_obs") != std::string::npos;
+        file_check.nof_events = 0.;
+        file_check.nof_events_unweighted = 0.;
+        file_check.cached = false;
+
+//--- reuse the result of a previous run if the file hasn't changed since
+        const auto cached = cache.find(file_str);
+        if(cached != cache.end() &&
+           cached -> second.size == file_size && cached -> second.mtime == file_check.mtime)
+        {
+          file_check.nof_events = cached -> second.nof_events;
+          file_check.nof_events_unweighted = cached -> second.nof_events_unweighted;
+          file_check.cached = true;
+        }
+        file_checks.push_back({ sample, file_check });
         
 //--- if the valid root file has path ../<grid job id>/000X/tree_i.root, then in order
 //--- to build the Python configuration file is to gather the paths to <grid job id>
@@ -1062,19 +1255,96 @@ main(int argc,
 
       } // is root file
     } // recursive loop
-    if (sample->nof_events_unweighted > sample->nof_dbs_events)
-    {
-      std::cout << sample->nof_events_unweighted << " > " << sample->nof_dbs_events << std::endl;
-      //throw std::runtime_error("Sample has more events than specified in DBS");
-      std::cout << "WARNING: Sample has more events than specified in DBS" << std::endl;
-    }
-    else if(sample->nof_events_unweighted < sample->nof_dbs_events)
-      std::cout << "WARNING: " << sample->name << " missing " << sample->nof_dbs_events - sample->nof_events_unweighted << " events." << std::endl;
-    //else everything is fine - all events have been processed
-    
   } // immediate subdirectory loop
   if(verbose) std::cout << LINE;
 
+//--- check the files that are not in the cache in parallel
+  std::vector<std::size_t> uncached_idxs;
+  for(std::size_t file_idx = 0; file_idx < file_checks.size(); ++file_idx)
+    if(! file_checks[file_idx].second.cached)
+      uncached_idxs.push_back(file_idx);
+  std::cout << "Checking " << uncached_idxs.size() << " out of " << file_checks.size() << " files "
+            << "(" << file_checks.size() - uncached_idxs.size() << " found in cache) "
+            << "with " << nof_jobs << " job(s)\n";
+
+  if(nof_jobs > 1)
+    ROOT::EnableThreadSafety();
+  if(fast)
+    TFile::SetReadStreamerInfo(false);
+
+  const std::size_t progress_step = std::max<std::size_t>(uncached_idxs.size() / 20, 1);
+  std::atomic<std::size_t> next_idx(0);
+  std::atomic<std::size_t> nof_checked(0);
+  std::mutex print_mutex;
+  const auto worker = [&]() -> void
+  {
+    for(std::size_t idx = next_idx++; idx < uncached_idxs.size(); idx = next_idx++)
+    {
+      FileCheck & file_check = file_checks[uncached_idxs[idx]].second;
+      check_file(file_check, histo_str, fast);
+      const std::size_t nof_done = ++nof_checked;
+      if(verbose || nof_done % progress_step == 0 || nof_done == uncached_idxs.size())
+      {
+        std::lock_guard<std::mutex> lock(print_mutex);
+        if(verbose)
+          std::cout << "Checked: " << file_check.path << '\n';
+        if(nof_done % progress_step == 0 || nof_done == uncached_idxs.size())
+        {
+          // format into a local stream, so that the precision of std::cout is left unchanged
+          std::ostringstream progress;
+          progress << "Progress: " << nof_done << '/' << uncached_idxs.size() << " files ("
+                   << std::setprecision(1) << std::fixed << 100. * nof_done / uncached_idxs.size() << "%)\n";
+          std::cout << progress.str();
+        }
+      }
+    }
+  };
+  std::vector<std::thread> workers;
+  for(unsigned job_idx = 1; job_idx < nof_jobs; ++job_idx)
+    workers.emplace_back(worker);
+  worker();
+  for(std::thread & t: workers)
+    t.join();
+
+  if(! cache_str.empty() && ! fast)
+  {
+    std::vector<FileCheck> cache_out;
+    for(const auto & file_check: file_checks)
+      cache_out.push_back(file_check.second);
+    write_cache(cache_str, histo_str, cache_out);
+  }
+
+//--- collect the results in the order in which the files were found
+  for(const auto & file_check: file_checks)
+  {
+    Sample * sample = file_check.first;
+    const double nof_events = file_check.second.nof_events;
+    const double nof_events_unweighted = file_check.second.nof_events_unweighted;
+    const std::string & file_str = file_check.second.path;
+
+    if     (nof_events > 0)                    sample->nof_events += nof_events;
+    else if(nof_events -0.5 < ZOMBIE_FILE_C)   sample->zombies.push_back(file_str);
+    else if(nof_events -0.5 < IMPROPER_FILE_C) sample->improper.push_back(file_str);
+
+    if     (nof_events_unweighted > 0)                sample->nof_events_unweighted += nof_events_unweighted;
+  }
+
+  if(! fast)
+  {
+    for(const Sample * sample: samples.get_list())
+    {
+      if (sample->nof_events_unweighted > sample->nof_dbs_events)
+      {
+        std::cout << sample->nof_events_unweighted << " > " << sample->nof_dbs_events << std::endl;
+        //throw std::runtime_error("Sample has more events than specified in DBS");
+        std::cout << "WARNING: Sample has more events than specified in DBS" << std::endl;
+      }
+      else if(sample->nof_events_unweighted < sample->nof_dbs_events)
+        std::cout << "WARNING: " << sample->name << " missing " << sample->nof_dbs_events - sample->nof_events_unweighted << " events." << std::endl;
+      //else everything is fine - all events have been processed
+    }
+  }
+
 //--- post-process
 
   std::cout << "Post-processing ...\n";
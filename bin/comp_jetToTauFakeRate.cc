@@ -37,10 +37,16 @@
 #include <TLegend.h>
 #include <TRandom3.h>
 #include <TError.h> // gErrorAbortLevel, kError
+#include <TROOT.h> // ROOT::EnableThreadSafety()
+#include <Math/MinimizerOptions.h> // ROOT::Math::MinimizerOptions
 
 #include <iostream>
+#include <sstream> // std::ostringstream
 #include <string>
 #include <vector>
+#include <thread> // std::thread
+#include <atomic> // std::atomic<>
+#include <exception> // std::exception_ptr
 #include <assert.h>
 
 typedef std::vector<std::string> vstring;
@@ -89,11 +95,31 @@ struct EigenVector_and_Value
   double eigenValue_;
 };
 
-std::vector<EigenVector_and_Value> compEigenVectors_and_Values(const TMatrixD& cov)
+void printMatrix(std::ostream& stream, const TMatrixD& matrix)
 {
-  std::cout << "<compEigenVectors_and_Values>:" << std::endl;
-  std::cout << " cov:" << std::endl;
-  cov.Print();
+  for ( int iRow = 0; iRow < matrix.GetNrows(); ++iRow ) {
+    for ( int iColumn = 0; iColumn < matrix.GetNcols(); ++iColumn ) {
+      stream << " " << matrix(iRow, iColumn);
+    }
+    stream << std::endl;
+  }
+}
+
+void printVector(std::ostream& stream, const TVectorD& vector)
+{
+  for ( int iComponent = 0; iComponent < vector.GetNrows(); ++iComponent ) {
+    stream << " " << vector(iComponent);
+  }
+  stream << std::endl;
+}
+
+// CV: the output is written to the stream given as function argument instead of std::cout,
+//     so that the output of fits running in parallel threads can be printed in a deterministic order
+std::vector<EigenVector_and_Value> compEigenVectors_and_Values(const TMatrixD& cov, std::ostream& stream)
+{
+  stream << "<compEigenVectors_and_Values>:" << std::endl;
+  stream << " cov:" << std::endl;
+  printMatrix(stream, cov);
   if ( cov.GetNcols() != cov.GetNrows() ) 
     throw cms::Exception("compEigenVectors_and_Values") 
       << "Matrix given as function argument is not symmetric !!\n";
@@ -110,18 +136,18 @@ std::vector<EigenVector_and_Value> compEigenVectors_and_Values(const TMatrixD& c
     }
     double eigenValue = eigenValues(iEigenVector);
     TVectorD vec1 = cov*eigenVector;
-    std::cout << "vec1:" << std::endl;
-    vec1.Print();
+    stream << "vec1:" << std::endl;
+    printVector(stream, vec1);
     TVectorD vec2 = eigenValue*eigenVector;
     //std::cout << "vec2:" << std::endl;
     //vec2.Print();
     // CV: check that EigenVector is indeed an EigenVector,
     //     i.e. that we interpreted the ordering of columns and rows of the eigenVectors matrix correctly
     for ( int iComponent = 0; iComponent < dimension; ++iComponent ) {   
-      std::cout << "component #" << iComponent << ": vec1 = " << vec1(iComponent) << ", vec2 = " << vec2(iComponent) << std::endl;
+      stream << "component #" << iComponent << ": vec1 = " << vec1(iComponent) << ", vec2 = " << vec2(iComponent) << std::endl;
       double diff = vec1(iComponent) - vec2(iComponent);
       double sum = TMath::Abs(TMath::Max(1.e-6, vec1(iComponent))) + TMath::Abs(TMath::Max(1.e-6, vec2(iComponent)));
-      std::cout << "assert(" << diff << " < " << TMath::Max(1.e-6, 1.e-3*sum) << ")" << std::endl;
+      stream << "assert(" << diff << " < " << TMath::Max(1.e-6, 1.e-3*sum) << ")" << std::endl;
       assert(diff < TMath::Max(1.e-6, 1.e-3*sum));
     }
     eigenVectors_and_Values.push_back(EigenVector_and_Value(eigenVector, eigenValue));
@@ -693,6 +719,45 @@ TGraphAsymmErrors* compRatioGraph(const std::string& ratioGraphName, const TGrap
   return graphRatio;
 }
 
+struct fitTask
+{
+  fitTask(TDirectory* outputDir, TGraphAsymmErrors* graph, TF1* fitFunction, const std::string& fitFunction_formula, const std::string& controlPlotFileName)
+    : outputDir_(outputDir),
+      graph_(graph),
+      fitFunction_(fitFunction),
+      fitFunction_formula_(fitFunction_formula),
+      controlPlotFileName_(controlPlotFileName),
+      isValid_(false)
+  {}
+  ~fitTask() {}
+  TDirectory* outputDir_;
+  TGraphAsymmErrors* graph_;
+  TF1* fitFunction_;
+  std::string fitFunction_formula_;
+  std::string controlPlotFileName_;
+  // results of the fit
+  bool isValid_;
+  std::vector<EigenVector_and_Value> eigenVectors_and_Values_;
+  std::string log_;
+  std::exception_ptr exception_;
+};
+
+void runFit(fitTask& task, const std::string& fitOptions)
+{
+  std::ostringstream log;
+  try {
+    TFitResultPtr fitResult = task.graph_->Fit(task.fitFunction_, fitOptions.data());
+    task.isValid_ = fitResult->IsValid();
+    if ( task.isValid_ ) {
+      TMatrixD cov = fitResult->GetCovarianceMatrix();
+      task.eigenVectors_and_Values_ = compEigenVectors_and_Values(cov, log);
+    }
+  } catch ( ... ) {
+    task.exception_ = std::current_exception();
+  }
+  task.log_ = log.str();
+}
+
 int main(int argc, char* argv[]) 
 {
 //--- throw an exception in case ROOT encounters an error
@@ -753,6 +818,10 @@ int main(int argc, char* argv[])
   double xMax = cfg_comp.getParameter<double>("xMax");
   std::cout << "xMin = " << xMin << ", xMax = " << xMax << std::endl;
 
+  bool makeControlPlots = ( cfg_comp.exists("makeControlPlots") ) ? cfg_comp.getParameter<bool>("makeControlPlots") : true;
+  unsigned numThreads = ( cfg_comp.exists("numThreads") ) ? cfg_comp.getParameter<unsigned>("numThreads") : 1;
+  if ( numThreads < 1 ) numThreads = 1;
+
   fwlite::InputSource inputFiles(cfg); 
   if ( !(inputFiles.files().size() == 1) )
     throw cms::Exception("comp_jetToTauFakeRate") 
@@ -769,6 +838,8 @@ int main(int argc, char* argv[])
   assert(inputDir_tight);
   std::cout << "inputDir_tight = " << inputDir_tight << ": name = " << inputDir_tight->GetName() << std::endl;
 
+  std::vector<fitTask> fitTasks;
+
   int numEtaBins = absEtaBins.size() - 1;
   for ( int idxEtaBin = 0; idxEtaBin < numEtaBins; ++idxEtaBin ) {
     double minAbsEta = absEtaBins[idxEtaBin];
@@ -839,13 +910,15 @@ int main(int argc, char* argv[])
 
 	graph_data_div_mc_jetToTauFakeRate->Write();
 
-	std::string controlPlotFileName_suffix = Form("_%s_%s_%s.png", hadTauSelection->data(), etaBin.data(), histogramToFit->data());
-	controlPlotFileName_suffix = TString(controlPlotFileName_suffix.data()).ReplaceAll("/", "_").Data();
-	std::string controlPlotFileName = TString(outputFile.file().data()).ReplaceAll(".root", controlPlotFileName_suffix.data()).Data();
-	makeControlPlot(graph_data_jetToTauFakeRate, "Data",
-			graph_mc_jetToTauFakeRate, "MC",
-			graph_data_div_mc_jetToTauFakeRate, 
-			xMin, xMax, "p_{T} [GeV]", true, 1.e-2, 1.e0, controlPlotFileName);
+	if ( makeControlPlots ) {
+	  std::string controlPlotFileName_suffix = Form("_%s_%s_%s.png", hadTauSelection->data(), etaBin.data(), histogramToFit->data());
+	  controlPlotFileName_suffix = TString(controlPlotFileName_suffix.data()).ReplaceAll("/", "_").Data();
+	  std::string controlPlotFileName = TString(outputFile.file().data()).ReplaceAll(".root", controlPlotFileName_suffix.data()).Data();
+	  makeControlPlot(graph_data_jetToTauFakeRate, "Data",
+			  graph_mc_jetToTauFakeRate, "MC",
+			  graph_data_div_mc_jetToTauFakeRate, 
+			  xMin, xMax, "p_{T} [GeV]", true, 1.e-2, 1.e0, controlPlotFileName);
+	}
 
 	std::string fitFunctionName = Form("fitFunction_data_div_mc_%s", TString(histogramToFit->data()).ReplaceAll("/", "_").Data());
 	double x0 = 0.5*(histogram_data_loose->GetMean() + histogram_mc_loose->GetMean());
@@ -861,58 +934,104 @@ int main(int argc, char* argv[])
 	    fitFunction->SetParameter(idxFitParameter, initialParameter_value);
 	  }
 	}
-	
-	TFitResultPtr fitResult = graph_data_div_mc_jetToTauFakeRate->Fit(fitFunction, "ERNS");
-	std::vector<fitFunction_and_legendEntry> fitFunctions_sysShifts;
-	if ( fitResult->IsValid() ) {
-	  fitFunction->Write();
-	  TMatrixD cov = fitResult->GetCovarianceMatrix();
-	  std::vector<EigenVector_and_Value> eigenVectors_and_Values = compEigenVectors_and_Values(cov);
-	  size_t dimension = fitFunction->GetNpar();
-	  assert(eigenVectors_and_Values.size() == dimension);
-	  int idxPar = 1;
-	  for ( std::vector<EigenVector_and_Value>::const_iterator eigenVector_and_Value = eigenVectors_and_Values.begin();
-		eigenVector_and_Value != eigenVectors_and_Values.end(); ++eigenVector_and_Value ) {
-	    assert(eigenVector_and_Value->eigenVector_.GetNrows() == (int)dimension);
-	    std::cout << "EigenVector #" << idxPar << ":" << std::endl;
-	    eigenVector_and_Value->eigenVector_.Print();
-	    std::cout << "EigenValue #" << idxPar << " = " << eigenVector_and_Value->eigenValue_ << std::endl;
-	    assert(eigenVector_and_Value->eigenValue_ >= 0.);
-	    std::string fitFunctionParUpName = Form("%s_par%iUp", fitFunctionName.data(), idxPar);
-	    TF1* fitFunctionParUp = new TF1(fitFunctionParUpName.data(), fitFunction_formula_wrt_x0.data(), xMin, xMax);
-	    for ( size_t idxComponent = 0; idxComponent < dimension; ++idxComponent ) {    
-	      fitFunctionParUp->SetParameter(
-		idxComponent, 
-		fitFunction->GetParameter(idxComponent) + TMath::Sqrt(eigenVector_and_Value->eigenValue_)*eigenVector_and_Value->eigenVector_(idxComponent));
-	    }
-	    fitFunctions_sysShifts.push_back(fitFunction_and_legendEntry(fitFunctionParUp, Form("EigenVec #%i", idxPar)));
-	    fitFunctionParUp->Write();
-	    std::string fitFunctionParDownName = Form("%s_par%iDown", fitFunctionName.data(), idxPar);
-	    TF1* fitFunctionParDown = new TF1(fitFunctionParDownName.data(), fitFunction_formula_wrt_x0.data(), xMin, xMax);
-	    for ( size_t idxComponent = 0; idxComponent < dimension; ++idxComponent ) {    
-	      fitFunctionParDown->SetParameter(
-		idxComponent, 
-		fitFunction->GetParameter(idxComponent) - TMath::Sqrt(eigenVector_and_Value->eigenValue_)*eigenVector_and_Value->eigenVector_(idxComponent));
-	    }
-	    fitFunctions_sysShifts.push_back(fitFunction_and_legendEntry(fitFunctionParDown, Form("EigenVec #%i", idxPar)));
-	    fitFunctionParDown->Write();
-	    ++idxPar;
-	  }    
-	} else {
-	  std::cerr << "Warning: Fit failed to converge --> setting fitFunction to constant value !!" << std::endl;
-	  delete fitFunction;
-	  fitFunction = new TF1(fitFunctionName.data(), "1.0", xMin, xMax);
-	  fitFunction->Write();
+
+	std::string controlPlotFileName_fit = "";
+	if ( makeControlPlots ) {
+	  std::string controlPlotFileName_fit_suffix = Form("_%s_%s_%s_fit.png", hadTauSelection->data(), etaBin.data(), histogramToFit->data());
+	  controlPlotFileName_fit_suffix = TString(controlPlotFileName_fit_suffix.data()).ReplaceAll("/", "_").Data();
+	  controlPlotFileName_fit = TString(outputFile.file().data()).ReplaceAll(".root", controlPlotFileName_fit_suffix.data()).Data();
 	}
-	std::string controlPlotFileName_fit_suffix = Form("_%s_%s_%s_fit.png", hadTauSelection->data(), etaBin.data(), histogramToFit->data());
-	controlPlotFileName_fit_suffix = TString(controlPlotFileName_fit_suffix.data()).ReplaceAll("/", "_").Data();
-	std::string controlPlotFileName_fit = TString(outputFile.file().data()).ReplaceAll(".root", controlPlotFileName_fit_suffix.data()).Data();
-	makeControlPlot_fit(graph_data_div_mc_jetToTauFakeRate, 
-			    fitFunction, fitFunctions_sysShifts, xMin, xMax, "p_{T} [GeV]", false, -1.5, +1.5, controlPlotFileName_fit);
+	fitTasks.push_back(fitTask(outputDir, graph_data_div_mc_jetToTauFakeRate, fitFunction, fitFunction_formula_wrt_x0, controlPlotFileName_fit));
       }
     }
   }
 
+//--- run the fits for all eta bins, tau ID working points and histograms in parallel;
+//    the TF1 objects are created beforehand and the results are written afterwards, in the main thread,
+//    as creating TF1 objects (JIT compilation of formulas) and writing to the output file are not thread-safe.
+//    Each fit instantiates its own minimizer, hence Minuit2 is used instead of the (non thread-safe) TMinuit.
+//    The minimizer and the fit options do not depend on the number of threads, so that the fit results do not either
+  ROOT::Math::MinimizerOptions::SetDefaultMinimizer("Minuit2");
+  // CV: suppress printout of the minimizer, as the printout of fits running in parallel would be interleaved
+  const std::string fitOptions = "ERNSQ";
+  if ( numThreads > 1 ) {
+    ROOT::EnableThreadSafety();
+  }
+  std::atomic<size_t> nextFitTask(0);
+  auto runFits = [&fitTasks, &nextFitTask, &fitOptions]() {
+    for ( size_t idxFitTask = nextFitTask++; idxFitTask < fitTasks.size(); idxFitTask = nextFitTask++ ) {
+      runFit(fitTasks[idxFitTask], fitOptions);
+    }
+  };
+  std::cout << "running " << fitTasks.size() << " fits in " << numThreads << " thread(s)" << std::endl;
+  if ( numThreads > 1 ) {
+    std::vector<std::thread> workers;
+    for ( unsigned idxThread = 0; idxThread < numThreads; ++idxThread ) {
+      workers.push_back(std::thread(runFits));
+    }
+    for ( std::vector<std::thread>::iterator worker = workers.begin();
+	  worker != workers.end(); ++worker ) {
+      worker->join();
+    }
+  } else {
+    runFits();
+  }
+
+  for ( std::vector<fitTask>::iterator task = fitTasks.begin();
+	task != fitTasks.end(); ++task ) {
+    if ( task->exception_ ) std::rethrow_exception(task->exception_);
+    std::cout << "fit of " << task->graph_->GetName() << " (directory = " << task->outputDir_->GetPath() << "):" << std::endl;
+    std::cout << task->log_;
+    task->outputDir_->cd();
+    TF1* fitFunction = task->fitFunction_;
+    std::string fitFunctionName = fitFunction->GetName();
+    std::vector<fitFunction_and_legendEntry> fitFunctions_sysShifts;
+    if ( task->isValid_ ) {
+      fitFunction->Write();
+      const std::vector<EigenVector_and_Value>& eigenVectors_and_Values = task->eigenVectors_and_Values_;
+      size_t dimension = fitFunction->GetNpar();
+      assert(eigenVectors_and_Values.size() == dimension);
+      int idxPar = 1;
+      for ( std::vector<EigenVector_and_Value>::const_iterator eigenVector_and_Value = eigenVectors_and_Values.begin();
+	    eigenVector_and_Value != eigenVectors_and_Values.end(); ++eigenVector_and_Value ) {
+	assert(eigenVector_and_Value->eigenVector_.GetNrows() == (int)dimension);
+	std::cout << "EigenVector #" << idxPar << ":" << std::endl;
+	eigenVector_and_Value->eigenVector_.Print();
+	std::cout << "EigenValue #" << idxPar << " = " << eigenVector_and_Value->eigenValue_ << std::endl;
+	assert(eigenVector_and_Value->eigenValue_ >= 0.);
+	std::string fitFunctionParUpName = Form("%s_par%iUp", fitFunctionName.data(), idxPar);
+	TF1* fitFunctionParUp = new TF1(fitFunctionParUpName.data(), task->fitFunction_formula_.data(), xMin, xMax);
+	for ( size_t idxComponent = 0; idxComponent < dimension; ++idxComponent ) {    
+	  fitFunctionParUp->SetParameter(
+	    idxComponent, 
+	    fitFunction->GetParameter(idxComponent) + TMath::Sqrt(eigenVector_and_Value->eigenValue_)*eigenVector_and_Value->eigenVector_(idxComponent));
+	}
+	fitFunctions_sysShifts.push_back(fitFunction_and_legendEntry(fitFunctionParUp, Form("EigenVec #%i", idxPar)));
+	fitFunctionParUp->Write();
+	std::string fitFunctionParDownName = Form("%s_par%iDown", fitFunctionName.data(), idxPar);
+	TF1* fitFunctionParDown = new TF1(fitFunctionParDownName.data(), task->fitFunction_formula_.data(), xMin, xMax);
+	for ( size_t idxComponent = 0; idxComponent < dimension; ++idxComponent ) {    
+	  fitFunctionParDown->SetParameter(
+	    idxComponent, 
+	    fitFunction->GetParameter(idxComponent) - TMath::Sqrt(eigenVector_and_Value->eigenValue_)*eigenVector_and_Value->eigenVector_(idxComponent));
+	}
+	fitFunctions_sysShifts.push_back(fitFunction_and_legendEntry(fitFunctionParDown, Form("EigenVec #%i", idxPar)));
+	fitFunctionParDown->Write();
+	++idxPar;
+      }    
+    } else {
+      std::cerr << "Warning: Fit failed to converge --> setting fitFunction to constant value !!" << std::endl;
+      delete fitFunction;
+      fitFunction = new TF1(fitFunctionName.data(), "1.0", xMin, xMax);
+      task->fitFunction_ = fitFunction;
+      fitFunction->Write();
+    }
+    if ( makeControlPlots ) {
+      makeControlPlot_fit(task->graph_, 
+			  fitFunction, fitFunctions_sysShifts, xMin, xMax, "p_{T} [GeV]", false, -1.5, +1.5, task->controlPlotFileName_);
+    }
+  }
+
   delete inputFile;
 
   clock.Show("comp_jetToTauFakeRate");
@@ -84,131 +84,246 @@ namespace
     return blindedHistogram;
   }
 
-  void makePlot(double canvasSizeX, double canvasSizeY,
-		TH1* histogramData, TH1* histogramData_blinded,
-		std::vector<histogramEntryType*>& histogramsBackground, 	
-		TH1* histogramSignal,
-		TH1* histogramUncertainty,
-		double legendTextSize, double legendPosX, double legendPosY, double legendSizeX, double legendSizeY, 
-		const std::string& labelOnTop,
-		std::vector<std::string>& extraLabels, double labelTextSize,
-		double labelPosX, double labelPosY, double labelSizeX, double labelSizeY,
-	        double xMin, double xMax, const std::string& xAxisTitle, double xAxisOffset,
-		bool useLogScale, double yMin, double yMax, const std::string& yAxisTitle, double yAxisOffset,
-		const std::string& outputFileName)
+  // histograms divided by bin width, computed once per distribution and shared by the plots with linear and log scale
+  struct densityHistogramsType
   {
-    std::cout << "<makePlot>:" << std::endl;
-    std::cout << " outputFileName = " << outputFileName << std::endl;
-
-    TH1* histogramData_density = 0;
-    if ( histogramData ) {
-      histogramData_density = divideHistogramByBinWidth(histogramData);      
-    }
+    densityHistogramsType(TH1* histogramData, TH1* histogramData_blinded,
+			  std::vector<histogramEntryType*>& histogramsBackground, 
+			  TH1* histogramSignal,
+			  TH1* histogramUncertainty)
+    {
+      TH1* histogramData_density = 0;
+      if ( histogramData ) {
+        histogramData_density = divideHistogramByBinWidth(histogramData);      
+      }
 
-    TH1* histogramData_blinded_density = 0;
-    if ( histogramData_blinded ) {
-      if ( histogramData ) checkCompatibleBinning(histogramData_blinded, histogramData);
-      histogramData_blinded_density = divideHistogramByBinWidth(histogramData_blinded);
-    }
+      TH1* histogramData_blinded_density = 0;
+      if ( histogramData_blinded ) {
+        if ( histogramData ) checkCompatibleBinning(histogramData_blinded, histogramData);
+        histogramData_blinded_density = divideHistogramByBinWidth(histogramData_blinded);
+      }
 
-    std::vector<TH1*> histogramsBackground_density;
-    TH1* histogramTTW = 0;
-    TH1* histogramTTW_density = 0;
-    TH1* histogramTTWW = 0;
-    TH1* histogramTTWW_density = 0;
-    TH1* histogramTTZ = 0;
-    TH1* histogramTTZ_density = 0;
-    TH1* histogramTTH = 0;
-    TH1* histogramTTH_density = 0;
-    TH1* histogramTT = 0;
-    TH1* histogramTT_density = 0;
-    TH1* histogramWZ = 0;
-    TH1* histogramWZ_density = 0;
-    TH1* histogramDiboson = 0;
-    TH1* histogramDiboson_density = 0;
-    TH1* histogramEWK = 0;
-    TH1* histogramEWK_density = 0;
-    TH1* histogramRares = 0;
-    TH1* histogramRares_density = 0;
-    TH1* histogramFakes = 0;
-    TH1* histogramFakes_density = 0;
-    TH1* histogramFlips = 0;
-    TH1* histogramFlips_density = 0;
-    for ( std::vector<histogramEntryType*>::iterator histogramBackground_entry = histogramsBackground.begin();
+      std::vector<TH1*> histogramsBackground_density;
+      TH1* histogramTTW = 0;
+      TH1* histogramTTW_density = 0;
+      TH1* histogramTTWW = 0;
+      TH1* histogramTTWW_density = 0;
+      TH1* histogramTTZ = 0;
+      TH1* histogramTTZ_density = 0;
+      TH1* histogramTTH = 0;
+      TH1* histogramTTH_density = 0;
+      TH1* histogramTT = 0;
+      TH1* histogramTT_density = 0;
+      TH1* histogramWZ = 0;
+      TH1* histogramWZ_density = 0;
+      TH1* histogramDiboson = 0;
+      TH1* histogramDiboson_density = 0;
+      TH1* histogramEWK = 0;
+      TH1* histogramEWK_density = 0;
+      TH1* histogramRares = 0;
+      TH1* histogramRares_density = 0;
+      TH1* histogramFakes = 0;
+      TH1* histogramFakes_density = 0;
+      TH1* histogramFlips = 0;
+      TH1* histogramFlips_density = 0;
+      for ( std::vector<histogramEntryType*>::iterator histogramBackground_entry = histogramsBackground.begin();
 	  histogramBackground_entry != histogramsBackground.end(); ++histogramBackground_entry ) {
-      TH1* histogramBackground = (*histogramBackground_entry)->histogram_;
-      const std::string& process = (*histogramBackground_entry)->process_;
-      std::cout << "process = " << process << ": histogramBackground = " << histogramBackground << std::endl;
-      printHistogram(histogramBackground);
-      checkCompatibleBinning(histogramBackground, histogramData);
-      TH1* histogramBackground_density = divideHistogramByBinWidth(histogramBackground); 
-      if ( process.find("TTWW") != std::string::npos ) {
+        TH1* histogramBackground = (*histogramBackground_entry)->histogram_;
+        const std::string& process = (*histogramBackground_entry)->process_;
+        std::cout << "process = " << process << ": histogramBackground = " << histogramBackground << std::endl;
+        printHistogram(histogramBackground);
+        checkCompatibleBinning(histogramBackground, histogramData);
+        TH1* histogramBackground_density = divideHistogramByBinWidth(histogramBackground); 
+        if ( process.find("TTWW") != std::string::npos ) {
 	histogramTTWW = histogramBackground;
 	histogramTTWW_density = histogramBackground_density;
-      } else if ( process.find("TTW") != std::string::npos ) {
+        } else if ( process.find("TTW") != std::string::npos ) {
 	histogramTTW = histogramBackground;
 	histogramTTW_density = histogramBackground_density;
-      } else if ( process.find("TTZ") != std::string::npos ) {
+        } else if ( process.find("TTZ") != std::string::npos ) {
 	histogramTTZ = histogramBackground;
 	histogramTTZ_density = histogramBackground_density;
-      } else if ( process.find("signal") != std::string::npos ) {
+        } else if ( process.find("signal") != std::string::npos ) {
 	histogramTTH = histogramBackground;
 	histogramTTH_density = histogramBackground_density;
-      } else if ( process.find("TT") != std::string::npos ) {
+        } else if ( process.find("TT") != std::string::npos ) {
 	histogramTT = histogramBackground;
 	histogramTT_density = histogramBackground_density;
-      } else if ( process.find("EWK") != std::string::npos ) {
+        } else if ( process.find("EWK") != std::string::npos ) {
 	histogramEWK = histogramBackground;
 	histogramEWK_density = histogramBackground_density;
-      } else if ( process.find("Diboson") != std::string::npos ) { 
+        } else if ( process.find("Diboson") != std::string::npos ) { 
 	histogramDiboson = histogramBackground;
 	histogramDiboson_density = histogramBackground_density;
-      } else if ( process.find("WZ") != std::string::npos ) {
+        } else if ( process.find("WZ") != std::string::npos ) {
 	histogramWZ = histogramBackground;
 	histogramWZ_density = histogramBackground_density;
-      } else if ( process.find("Rares") != std::string::npos ) {
+        } else if ( process.find("Rares") != std::string::npos ) {
 	histogramRares = histogramBackground;
 	histogramRares_density = histogramBackground_density;
-      } else if ( process.find("Fakes") != std::string::npos || process.find("fakes") != std::string::npos ) {
+        } else if ( process.find("Fakes") != std::string::npos || process.find("fakes") != std::string::npos ) {
 	histogramFakes = histogramBackground;
 	histogramFakes_density = histogramBackground_density;
-      } else if ( process.find("Flips") != std::string::npos || process.find("flips") != std::string::npos ) {
+        } else if ( process.find("Flips") != std::string::npos || process.find("flips") != std::string::npos ) {
 	histogramFlips = histogramBackground;
 	histogramFlips_density = histogramBackground_density;
+        }
+        histogramsBackground_density.push_back(histogramBackground_density);
+      }
+      std::cout << "histogramTTW_density = " << histogramTTW_density << std::endl;
+      std::cout << "histogramTTWW_density = " << histogramTTWW_density << std::endl;
+      std::cout << "histogramTTZ_density = " << histogramTTZ_density << std::endl;
+
+      TH1* histogramSignal_density = 0;
+      if ( histogramSignal ) {
+        if ( histogramSignal ) checkCompatibleBinning(histogramSignal, histogramData);
+        histogramSignal_density = divideHistogramByBinWidth(histogramSignal); 
       }
-      histogramsBackground_density.push_back(histogramBackground_density);
-    }
-    std::cout << "histogramTTW_density = " << histogramTTW_density << std::endl;
-    std::cout << "histogramTTWW_density = " << histogramTTWW_density << std::endl;
-    std::cout << "histogramTTZ_density = " << histogramTTZ_density << std::endl;
-
-    TH1* histogramSignal_density = 0;
-    if ( histogramSignal ) {
-      if ( histogramSignal ) checkCompatibleBinning(histogramSignal, histogramData);
-      histogramSignal_density = divideHistogramByBinWidth(histogramSignal); 
-    }
 
-    TH1* histogramSum_density = 0;
-    std::vector<TH1*> histogramsSignal_and_Background_density = histogramsBackground_density;
-    if ( histogramSignal_density ) histogramsSignal_and_Background_density.push_back(histogramSignal_density);
-    for ( std::vector<TH1*>::iterator histogram_density = histogramsSignal_and_Background_density.begin();
+      TH1* histogramSum_density = 0;
+      std::vector<TH1*> histogramsSignal_and_Background_density = histogramsBackground_density;
+      if ( histogramSignal_density ) histogramsSignal_and_Background_density.push_back(histogramSignal_density);
+      for ( std::vector<TH1*>::iterator histogram_density = histogramsSignal_and_Background_density.begin();
 	  histogram_density != histogramsSignal_and_Background_density.end(); ++histogram_density ) {
-      if ( !histogramSum_density ) histogramSum_density = (TH1*)(*histogram_density)->Clone("histogramSum_density"); // CV: used for y-axis normalization only
-      else histogramSum_density->Add(*histogram_density);
-    }
-    assert(histogramSum_density);
+        if ( !histogramSum_density ) histogramSum_density = (TH1*)(*histogram_density)->Clone("histogramSum_density"); // CV: used for y-axis normalization only
+        else histogramSum_density->Add(*histogram_density);
+      }
+      assert(histogramSum_density);
 
-    TH1* histogramUncertainty_density = 0;
-    if ( histogramUncertainty ) {
-      if ( histogramData ) checkCompatibleBinning(histogramUncertainty, histogramData);
-      histogramUncertainty_density = divideHistogramByBinWidth(histogramUncertainty);
+      TH1* histogramUncertainty_density = 0;
+      if ( histogramUncertainty ) {
+        if ( histogramData ) checkCompatibleBinning(histogramUncertainty, histogramData);
+        histogramUncertainty_density = divideHistogramByBinWidth(histogramUncertainty);
+      }
+
+      //---------------------------------------------------------------------------
+      // CV: sum ttW and ttWW backgrounds
+      histogramTTW->Add(histogramTTWW);
+      histogramTTW_density->Add(histogramTTWW_density);
+      //---------------------------------------------------------------------------
+
+      histogramData_ = histogramData;
+      histogramData_blinded_ = histogramData_blinded;
+      histogramSignal_ = histogramSignal;
+      histogramUncertainty_ = histogramUncertainty;
+      histogramTTW_ = histogramTTW;
+      histogramTTZ_ = histogramTTZ;
+      histogramTTH_ = histogramTTH;
+      histogramTT_ = histogramTT;
+      histogramWZ_ = histogramWZ;
+      histogramDiboson_ = histogramDiboson;
+      histogramEWK_ = histogramEWK;
+      histogramRares_ = histogramRares;
+      histogramFakes_ = histogramFakes;
+      histogramFlips_ = histogramFlips;
+      histogramData_density_ = histogramData_density;
+      histogramData_blinded_density_ = histogramData_blinded_density;
+      histogramSignal_density_ = histogramSignal_density;
+      histogramUncertainty_density_ = histogramUncertainty_density;
+      histogramSum_density_ = histogramSum_density;
+      histogramTTW_density_ = histogramTTW_density;
+      histogramTTWW_density_ = histogramTTWW_density;
+      histogramTTZ_density_ = histogramTTZ_density;
+      histogramTTH_density_ = histogramTTH_density;
+      histogramTT_density_ = histogramTT_density;
+      histogramWZ_density_ = histogramWZ_density;
+      histogramDiboson_density_ = histogramDiboson_density;
+      histogramEWK_density_ = histogramEWK_density;
+      histogramRares_density_ = histogramRares_density;
+      histogramFakes_density_ = histogramFakes_density;
+      histogramFlips_density_ = histogramFlips_density;
+      histogramsBackground_density_ = histogramsBackground_density;
     }
+    ~densityHistogramsType()
+    {
+      delete histogramData_density_;
+      delete histogramData_blinded_density_;
+      delete histogramSignal_density_;
+      for ( std::vector<TH1*>::iterator histogramBackground_density = histogramsBackground_density_.begin();
+	    histogramBackground_density != histogramsBackground_density_.end(); ++histogramBackground_density ) {
+	delete (*histogramBackground_density);
+      }
+      delete histogramSum_density_;
+      delete histogramUncertainty_density_;
+    }
+    TH1* histogramData_;
+    TH1* histogramData_blinded_;
+    TH1* histogramSignal_;
+    TH1* histogramUncertainty_;
+    TH1* histogramTTW_;
+    TH1* histogramTTZ_;
+    TH1* histogramTTH_;
+    TH1* histogramTT_;
+    TH1* histogramWZ_;
+    TH1* histogramDiboson_;
+    TH1* histogramEWK_;
+    TH1* histogramRares_;
+    TH1* histogramFakes_;
+    TH1* histogramFlips_;
+    TH1* histogramData_density_;
+    TH1* histogramData_blinded_density_;
+    TH1* histogramSignal_density_;
+    TH1* histogramUncertainty_density_;
+    TH1* histogramSum_density_;
+    TH1* histogramTTW_density_;
+    TH1* histogramTTWW_density_;
+    TH1* histogramTTZ_density_;
+    TH1* histogramTTH_density_;
+    TH1* histogramTT_density_;
+    TH1* histogramWZ_density_;
+    TH1* histogramDiboson_density_;
+    TH1* histogramEWK_density_;
+    TH1* histogramRares_density_;
+    TH1* histogramFakes_density_;
+    TH1* histogramFlips_density_;
+    std::vector<TH1*> histogramsBackground_density_; // owned
+   private:
+    densityHistogramsType(const densityHistogramsType&);
+    densityHistogramsType& operator=(const densityHistogramsType&);
+  };
 
-    //---------------------------------------------------------------------------
-    // CV: sum ttW and ttWW backgrounds
-    histogramTTW->Add(histogramTTWW);
-    histogramTTW_density->Add(histogramTTWW_density);
-    //---------------------------------------------------------------------------
+  void makePlot(double canvasSizeX, double canvasSizeY,
+		const densityHistogramsType& densityHistograms,
+		double legendTextSize, double legendPosX, double legendPosY, double legendSizeX, double legendSizeY, 
+		const std::string& labelOnTop,
+		std::vector<std::string>& extraLabels, double labelTextSize,
+		double labelPosX, double labelPosY, double labelSizeX, double labelSizeY,
+	        double xMin, double xMax, const std::string& xAxisTitle, double xAxisOffset,
+		bool useLogScale, double yMin, double yMax, const std::string& yAxisTitle, double yAxisOffset,
+		const std::string& outputFileName)
+  {
+    std::cout << "<makePlot>:" << std::endl;
+    std::cout << " outputFileName = " << outputFileName << std::endl;
+
+    TH1* histogramData = densityHistograms.histogramData_;
+    TH1* histogramData_blinded = densityHistograms.histogramData_blinded_;
+    TH1* histogramSignal = densityHistograms.histogramSignal_;
+    TH1* histogramUncertainty = densityHistograms.histogramUncertainty_;
+    TH1* histogramTTW = densityHistograms.histogramTTW_;
+    TH1* histogramTTZ = densityHistograms.histogramTTZ_;
+    TH1* histogramTTH = densityHistograms.histogramTTH_;
+    TH1* histogramTT = densityHistograms.histogramTT_;
+    TH1* histogramWZ = densityHistograms.histogramWZ_;
+    TH1* histogramDiboson = densityHistograms.histogramDiboson_;
+    TH1* histogramEWK = densityHistograms.histogramEWK_;
+    TH1* histogramRares = densityHistograms.histogramRares_;
+    TH1* histogramFakes = densityHistograms.histogramFakes_;
+    TH1* histogramFlips = densityHistograms.histogramFlips_;
+    TH1* histogramData_blinded_density = densityHistograms.histogramData_blinded_density_;
+    TH1* histogramData_density = densityHistograms.histogramData_density_;
+    TH1* histogramSignal_density = densityHistograms.histogramSignal_density_;
+    TH1* histogramUncertainty_density = densityHistograms.histogramUncertainty_density_;
+    TH1* histogramSum_density = densityHistograms.histogramSum_density_;
+    TH1* histogramTTW_density = densityHistograms.histogramTTW_density_;
+    TH1* histogramTTZ_density = densityHistograms.histogramTTZ_density_;
+    TH1* histogramTTH_density = densityHistograms.histogramTTH_density_;
+    TH1* histogramTT_density = densityHistograms.histogramTT_density_;
+    TH1* histogramWZ_density = densityHistograms.histogramWZ_density_;
+    TH1* histogramDiboson_density = densityHistograms.histogramDiboson_density_;
+    TH1* histogramEWK_density = densityHistograms.histogramEWK_density_;
+    TH1* histogramRares_density = densityHistograms.histogramRares_density_;
+    TH1* histogramFakes_density = densityHistograms.histogramFakes_density_;
+    TH1* histogramFlips_density = densityHistograms.histogramFlips_density_;
 
     TCanvas* canvas = new TCanvas("canvas", "", canvasSizeX, canvasSizeY);
     canvas->SetFillColor(10);
@@ -562,21 +677,6 @@ namespace
     canvas->Print(std::string(outputFileName_plot).append(".pdf").data());
     canvas->Print(std::string(outputFileName_plot).append(".root").data());
 
-    delete histogramData_density;
-    delete histogramData_blinded_density;
-    delete histogramSignal_density;
-    delete histogramTTW_density;
-    delete histogramTTZ_density;
-    delete histogramTTH_density;
-    delete histogramTT_density;
-    delete histogramWZ_density;
-    delete histogramDiboson_density;
-    delete histogramEWK_density;
-    delete histogramRares_density;
-    delete histogramFakes_density;
-    delete histogramFlips_density;
-    delete histogramSum_density;
-    delete histogramUncertainty_density;
     delete legend;
     delete labelOnTop_pave;
     delete extraLabels_pave;
@@ -645,12 +745,26 @@ int main(int argc, char* argv[])
   
   std::string outputFileName = cfgMakePlots.getParameter<std::string>("outputFileName");
 
+  unsigned numProcesses = ( cfgMakePlots.exists("numProcesses") ) ? cfgMakePlots.getParameter<unsigned>("numProcesses") : 1;
+  if ( numProcesses < 1 ) numProcesses = 1;
+
   fwlite::InputSource inputFiles(cfg); 
   if ( !(inputFiles.files().size() == 1) )
     throw cms::Exception("makePlots") 
       << "Exactly one input file expected !!\n";
+
+//--- distribute the plots over numProcesses processes;
+//    the input file is opened after the worker processes have been forked, so that each process has its own file handle
+  std::vector<int> workerPIDs;
+  unsigned idxProcess = 0;
+  if ( numProcesses > 1 ) {
+    std::cout << "making plots in " << numProcesses << " processes" << std::endl;
+    idxProcess = forkWorkerProcesses(numProcesses, workerPIDs);
+  }
+
   TFile* inputFile = new TFile(inputFiles.files().front().data());
   
+  unsigned idxPlot = 0;
   for ( std::vector<categoryEntryType*>::iterator category = categories.begin();
 	category != categories.end(); ++category ) {
     std::cout << "processing category = " << (*category)->name_ << std::endl;
@@ -660,6 +774,7 @@ int main(int argc, char* argv[])
 
     for ( std::vector<plotEntryType*>::iterator distribution = distributions.begin();
 	  distribution != distributions.end(); ++distribution ) {
+      if ( (idxPlot++ % numProcesses) != idxProcess ) continue;
 
       TH1* histogramData = 0;
       TH1* histogramData_blinded = 0;
@@ -697,12 +812,14 @@ int main(int argc, char* argv[])
       outputFileName_plot.append(Form("_%s", (*distribution)->outputFileName_.data()));
       if ( idx != std::string::npos ) outputFileName_plot.append(std::string(outputFileName, idx));
 	  
-      makePlot(
-	800, 900,
+      const densityHistogramsType densityHistograms(
 	histogramData, histogramData_blinded,
 	histogramsBackground,
 	histogramSignal,
-	histogramUncertainty,
+	histogramUncertainty);
+      makePlot(
+	800, 900,
+	densityHistograms,
 	(*distribution)->legendTextSize_, (*distribution)->legendPosX_, (*distribution)->legendPosY_, (*distribution)->legendSizeX_, (*distribution)->legendSizeY_, 
 	labelOnTop,
 	extraLabels, 0.055, 0.185, 0.915 - 0.055*extraLabels.size(), extraLabelsSizeX, 0.055*extraLabels.size(),
@@ -711,10 +828,7 @@ int main(int argc, char* argv[])
 	outputFileName_plot);
       makePlot(
 	800, 900,
-	histogramData, histogramData_blinded,
-	histogramsBackground,
-	histogramSignal,
-	histogramUncertainty,
+	densityHistograms,
 	(*distribution)->legendTextSize_, (*distribution)->legendPosX_, (*distribution)->legendPosY_, (*distribution)->legendSizeX_, (*distribution)->legendSizeY_, 
 	labelOnTop,
 	extraLabels, 0.055, 0.185, 0.915 - 0.055*extraLabels.size(), extraLabelsSizeX, 0.055*extraLabels.size(),
@@ -737,6 +851,8 @@ int main(int argc, char* argv[])
     delete (*it);
   }
 
+  if ( idxProcess == 0 ) waitForWorkerProcesses(workerPIDs);
+
   clock.Show("makePlots");
 
   return 0;
@@ -81,10 +81,44 @@ namespace
     return histogram_normalized;
   }
   
-  void makePlot_mcClosure(double canvasSizeX, double canvasSizeY,
-			  TH1* histogramSignal,
+  // histograms divided by bin width, computed once per distribution and shared by the plots with linear and log scale
+  struct densityHistogramsType
+  {
+    densityHistogramsType(TH1* histogramSignal,
 			  TH1* histogramSideband,
-			  TH1* histogramUncertainty,
+			  TH1* histogramUncertainty)
+      : histogramSignal_(histogramSignal)
+      , histogramSideband_(histogramSideband)
+      , histogramUncertainty_(histogramUncertainty)
+      , histogramUncertainty_density_(0)
+    {
+      histogramSignal_density_ = divideHistogramByBinWidth(histogramSignal);      
+      checkCompatibleBinning(histogramSideband, histogramSignal);
+      histogramSideband_density_ = divideHistogramByBinWidth(histogramSideband);
+      if ( histogramUncertainty ) {
+	checkCompatibleBinning(histogramUncertainty, histogramSignal);
+	histogramUncertainty_density_ = divideHistogramByBinWidth(histogramUncertainty);
+      }
+    }
+    ~densityHistogramsType()
+    {
+      delete histogramSignal_density_;
+      delete histogramSideband_density_;
+      delete histogramUncertainty_density_;
+    }
+    TH1* histogramSignal_;
+    TH1* histogramSideband_;
+    TH1* histogramUncertainty_;
+    TH1* histogramSignal_density_;
+    TH1* histogramSideband_density_;
+    TH1* histogramUncertainty_density_;
+   private:
+    densityHistogramsType(const densityHistogramsType&);
+    densityHistogramsType& operator=(const densityHistogramsType&);
+  };
+
+  void makePlot_mcClosure(double canvasSizeX, double canvasSizeY,
+			  const densityHistogramsType& densityHistograms,
 			  double legendTextSize, double legendPosX, double legendPosY, double legendSizeX, double legendSizeY, 
 			  const std::string& labelOnTop,
 			  std::vector<std::string>& extraLabels, double labelTextSize,
@@ -95,15 +129,12 @@ namespace
   {
     std::cout << "<makePlot_mcClosure>:" << std::endl;
 
-    TH1* histogramSignal_density = divideHistogramByBinWidth(histogramSignal);      
-    checkCompatibleBinning(histogramSideband, histogramSignal);
-    TH1* histogramSideband_density = divideHistogramByBinWidth(histogramSideband);
-
-    TH1* histogramUncertainty_density = 0;
-    if ( histogramUncertainty ) {
-      checkCompatibleBinning(histogramUncertainty, histogramSignal);
-      histogramUncertainty_density = divideHistogramByBinWidth(histogramUncertainty);
-    }
+    TH1* histogramSignal = densityHistograms.histogramSignal_;
+    TH1* histogramSideband = densityHistograms.histogramSideband_;
+    TH1* histogramUncertainty = densityHistograms.histogramUncertainty_;
+    TH1* histogramSignal_density = densityHistograms.histogramSignal_density_;
+    TH1* histogramSideband_density = densityHistograms.histogramSideband_density_;
+    TH1* histogramUncertainty_density = densityHistograms.histogramUncertainty_density_;
 
     TCanvas* canvas = new TCanvas("canvas", "", canvasSizeX, canvasSizeY);
     canvas->SetFillColor(10);
@@ -335,9 +366,6 @@ namespace
     canvas->Print(std::string(outputFileName_plot).append(".pdf").data());
     canvas->Print(std::string(outputFileName_plot).append(".root").data());
 
-    delete histogramSignal_density;
-    delete histogramSideband_density;
-    delete histogramUncertainty_density;
     delete legend;
     delete labelOnTop_pave;
     delete extraLabels_pave;
@@ -410,12 +438,26 @@ int main(int argc, char* argv[])
   
   std::string outputFileName = cfgMakePlots.getParameter<std::string>("outputFileName");
 
+  unsigned numProcesses = ( cfgMakePlots.exists("numProcesses") ) ? cfgMakePlots.getParameter<unsigned>("numProcesses") : 1;
+  if ( numProcesses < 1 ) numProcesses = 1;
+
   fwlite::InputSource inputFiles(cfg); 
   if ( !(inputFiles.files().size() == 1) )
     throw cms::Exception("makePlots") 
       << "Exactly one input file expected !!\n";
+
+//--- distribute the plots over numProcesses processes;
+//    the input file is opened after the worker processes have been forked, so that each process has its own file handle
+  std::vector<int> workerPIDs;
+  unsigned idxProcess = 0;
+  if ( numProcesses > 1 ) {
+    std::cout << "making plots in " << numProcesses << " processes" << std::endl;
+    idxProcess = forkWorkerProcesses(numProcesses, workerPIDs);
+  }
+
   TFile* inputFile = new TFile(inputFiles.files().front().data());
   
+  unsigned idxPlot = 0;
   for ( std::vector<categoryEntryType*>::iterator category = categories.begin();
 	category != categories.end(); ++category ) {
     std::cout << "processing category: signal = " << (*category)->signal_ << ", sideband = " << (*category)->sideband_ << std::endl;
@@ -427,6 +469,7 @@ int main(int argc, char* argv[])
 
     for ( std::vector<plotEntryType*>::iterator distribution = distributions.begin();
 	  distribution != distributions.end(); ++distribution ) {
+      if ( (idxPlot++ % numProcesses) != idxProcess ) continue;
 
       TH1* histogramSignal = getHistogram_wrapper(dir_signal, process_signal, (*distribution)->histogramName_, "central", true);
 
@@ -451,11 +494,13 @@ int main(int argc, char* argv[])
       outputFileName_plot.append(Form("_%s", (*distribution)->outputFileName_.data()));
       if ( idx != std::string::npos ) outputFileName_plot.append(std::string(outputFileName, idx));
 	  
-      makePlot_mcClosure(
-	800, 900,
+      const densityHistogramsType densityHistograms(
 	histogramSignal,
 	histogramSideband,
-	histogramUncertainty,
+	histogramUncertainty);
+      makePlot_mcClosure(
+	800, 900,
+	densityHistograms,
 	(*distribution)->legendTextSize_, (*distribution)->legendPosX_, (*distribution)->legendPosY_, (*distribution)->legendSizeX_, (*distribution)->legendSizeY_, 
 	labelOnTop,
 	extraLabels, 0.055, 0.185, 0.815 - 0.055*extraLabels.size(), extraLabelsSizeX, 0.055*extraLabels.size(),
@@ -464,9 +509,7 @@ int main(int argc, char* argv[])
 	outputFileName_plot);
       makePlot_mcClosure(
 	800, 900,
-	histogramSignal,
-	histogramSideband,
-	histogramUncertainty,
+	densityHistograms,
 	(*distribution)->legendTextSize_, (*distribution)->legendPosX_, (*distribution)->legendPosY_, (*distribution)->legendSizeX_, (*distribution)->legendSizeY_, 
 	labelOnTop,
 	extraLabels, 0.055, 0.185, 0.815 - 0.055*extraLabels.size(), extraLabelsSizeX, 0.055*extraLabels.size(),
@@ -481,11 +524,13 @@ int main(int argc, char* argv[])
       TString outputFileName_plot_normalized = outputFileName_plot.data();
       outputFileName_plot_normalized = outputFileName_plot_normalized.ReplaceAll((*distribution)->outputFileName_.data(), Form("%s_normalized", (*distribution)->outputFileName_.data()));
             
-      makePlot_mcClosure(
-	800, 900,
+      const densityHistogramsType densityHistograms_normalized(
 	histogramSignal_normalized,
 	histogramSideband_normalized,
-	histogramUncertainty_normalized,
+	histogramUncertainty_normalized);
+      makePlot_mcClosure(
+	800, 900,
+	densityHistograms_normalized,
 	(*distribution)->legendTextSize_, (*distribution)->legendPosX_, (*distribution)->legendPosY_, (*distribution)->legendSizeX_, (*distribution)->legendSizeY_, 
 	labelOnTop,
 	extraLabels, 0.055, 0.185, 0.915 - 0.055*extraLabels.size(), extraLabelsSizeX, 0.055*extraLabels.size(),
@@ -494,9 +539,7 @@ int main(int argc, char* argv[])
 	outputFileName_plot_normalized.Data());
       makePlot_mcClosure(
 	800, 900,
-	histogramSignal_normalized,
-	histogramSideband_normalized,
-	histogramUncertainty_normalized,
+	densityHistograms_normalized,
 	(*distribution)->legendTextSize_, (*distribution)->legendPosX_, (*distribution)->legendPosY_, (*distribution)->legendSizeX_, (*distribution)->legendSizeY_, 
 	labelOnTop,
 	extraLabels, 0.055, 0.185, 0.915 - 0.055*extraLabels.size(), extraLabelsSizeX, 0.055*extraLabels.size(),
@@ -521,6 +564,8 @@ int main(int argc, char* argv[])
     delete (*it);
   }
 
+  if ( idxProcess == 0 ) waitForWorkerProcesses(workerPIDs);
+
   clock.Show("makePlots_mcClosure");
 
   return 0;
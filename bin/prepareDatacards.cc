@@ -26,6 +26,7 @@ cfg_prepareDatacards
 #include <TBenchmark.h>
 #include <TMath.h>
 #include <TError.h> // gErrorAbortLevel, kError
+#include <TROOT.h> // ROOT::EnableThreadSafety()
 #include "TPRegexp.h"
 #include "TDirectory.h"
 #include "TList.h"
@@ -34,8 +35,12 @@ cfg_prepareDatacards
 #include "TString.h"
 
 #include <iostream>
+#include <sstream> // std::ostringstream
 #include <string>
 #include <vector>
+#include <thread> // std::thread
+#include <atomic> // std::atomic<>
+#include <exception> // std::exception_ptr, std::current_exception(), std::rethrow_exception()
 #include <cstdlib> // EXIT_SUCCESS, EXIT_FAILURE
 #include <assert.h>
 
@@ -67,67 +72,98 @@ namespace
     return histogramBinning;
   }
   
-  TH1* rebinHistogram(const std::vector<double>& histogramBinning, const TH1* histogram)
+  struct rebinningMapType
   {
-    TArrayF histogramBinning_array(histogramBinning.size());
+    TArrayF histogramBinning_rebinned_;
+    std::vector<double> binWidths_rebinned_;
+    // index of the rebinned bin that each bin of the input histogram is added to (0 = bin is dropped)
+    std::vector<int> idxBins_rebinned_;
+    int numBins_;
+    double xMin_;
+    double xMax_;
+  };
+
+  rebinningMapType compRebinningMap(const std::vector<double>& histogramBinning, const TH1* histogram)
+  {
+    rebinningMapType rebinningMap;
+    rebinningMap.histogramBinning_rebinned_.Set(histogramBinning.size());
     int idx = 0;
     for ( std::vector<double>::const_iterator binEdge = histogramBinning.begin();
 	  binEdge != histogramBinning.end(); ++binEdge ) {
-      histogramBinning_array[idx] = (*binEdge);
+      rebinningMap.histogramBinning_rebinned_[idx] = (*binEdge);
       ++idx;
     }
-    std::string histogramName = Form("%s_rebinned", histogram->GetName());
-    std::string histogramTitle = histogram->GetTitle();
-    int numBins_rebinned = histogramBinning_array.GetSize() - 1;
-    //std::cout << "numBins_rebinned = " << numBins_rebinned << std::endl;
-    TH1* histogram_rebinned = new TH1D(histogramName.data(), histogramTitle.data(), numBins_rebinned, histogramBinning_array.GetArray());
-    if ( !histogram_rebinned->GetSumw2N() ) histogram_rebinned->Sumw2();
+    const TArrayF& binEdges_rebinned = rebinningMap.histogramBinning_rebinned_;
+    int numBins_rebinned = binEdges_rebinned.GetSize() - 1;
+    for ( int iBin_rebinned = 1; iBin_rebinned <= numBins_rebinned; ++iBin_rebinned ) {
+      rebinningMap.binWidths_rebinned_.push_back((double)binEdges_rebinned[iBin_rebinned] - (double)binEdges_rebinned[iBin_rebinned - 1]);
+    }
     const TAxis* xAxis = histogram->GetXaxis();
     int numBins = xAxis->GetNbins();
-    const TAxis* xAxis_rebinned = histogram_rebinned->GetXaxis();
-    double binContentSum = 0.;
-    double binError2Sum = 0.;
+    rebinningMap.numBins_ = numBins;
+    rebinningMap.xMin_ = xAxis->GetXmin();
+    rebinningMap.xMax_ = xAxis->GetXmax();
+    // same assignment of bins as done by the bin-by-bin loop over the input histogram used before:
+    // a bin is added to the next rebinned bin once its center exceeds the low edge of that bin,
+    // the content of the last bin of the input histogram is not added to any rebinned bin
+    rebinningMap.idxBins_rebinned_.assign(numBins + 2, 0);
     int iBin_rebinned = 1;
-    double binEdgeLow_rebinned = xAxis_rebinned->GetBinLowEdge(iBin_rebinned);
-    for ( int iBin = 1; iBin <= numBins; ++iBin ) {
-      double binCenter = xAxis->GetBinCenter(iBin);
-      double binContent = histogram->GetBinContent(iBin);
-      double binError = histogram->GetBinError(iBin);
-      bool isNextBin_rebinned = false;
-      if ( iBin == numBins ) {
-	isNextBin_rebinned = true;
-      } else {
-	if ( iBin_rebinned < numBins_rebinned && binCenter > xAxis_rebinned->GetBinLowEdge(iBin_rebinned + 1) ) {
-	  isNextBin_rebinned = true;
-	}
-      }
-      if ( isNextBin_rebinned ) {
-	double binWidth_rebinned = xAxis_rebinned->GetBinLowEdge(iBin_rebinned + 1) - binEdgeLow_rebinned;
-	histogram_rebinned->SetBinContent(iBin_rebinned, binContentSum/binWidth_rebinned);
-	histogram_rebinned->SetBinError(iBin_rebinned, TMath::Sqrt(binError2Sum)/binWidth_rebinned);
-	binContentSum = 0.;
-	binError2Sum = 0.;
-	binEdgeLow_rebinned = xAxis_rebinned->GetBinLowEdge(iBin_rebinned + 1);
+    for ( int iBin = 1; iBin < numBins; ++iBin ) {
+      if ( iBin_rebinned < numBins_rebinned && xAxis->GetBinCenter(iBin) > (double)binEdges_rebinned[iBin_rebinned] ) {
 	++iBin_rebinned;
       }
-      //std::cout << "binCenter = " << binCenter << ": iBin = " << iBin << ", iBin_rebinned = " << iBin_rebinned << std::endl;
-      binContentSum += binContent;
-      binError2Sum += (binError*binError);
+      rebinningMap.idxBins_rebinned_[iBin] = iBin_rebinned;
+    }
+    return rebinningMap;
+  }
+
+  bool isCompatible(const rebinningMapType& rebinningMap, const TH1* histogram)
+  {
+    const TAxis* xAxis = histogram->GetXaxis();
+    return xAxis->GetNbins() == rebinningMap.numBins_ && xAxis->GetXmin() == rebinningMap.xMin_ && xAxis->GetXmax() == rebinningMap.xMax_;
+  }
+
+  TH1* rebinHistogram(const rebinningMapType& rebinningMap, const TH1* histogram)
+  {
+    assert(isCompatible(rebinningMap, histogram));
+    std::string histogramName = Form("%s_rebinned", histogram->GetName());
+    std::string histogramTitle = histogram->GetTitle();
+    int numBins_rebinned = rebinningMap.histogramBinning_rebinned_.GetSize() - 1;
+    TH1* histogram_rebinned = new TH1D(histogramName.data(), histogramTitle.data(), numBins_rebinned, rebinningMap.histogramBinning_rebinned_.GetArray());
+    if ( !histogram_rebinned->GetSumw2N() ) histogram_rebinned->Sumw2();
+    std::vector<double> binContentSums(numBins_rebinned + 2, 0.);
+    std::vector<double> binError2Sums(numBins_rebinned + 2, 0.);
+    const double* binError2s = ( histogram->GetSumw2N() ) ? histogram->GetSumw2()->GetArray() : 0;
+    for ( int iBin = 1; iBin <= rebinningMap.numBins_; ++iBin ) {
+      int iBin_rebinned = rebinningMap.idxBins_rebinned_[iBin];
+      if ( !iBin_rebinned ) continue;
+      binContentSums[iBin_rebinned] += histogram->GetBinContent(iBin);
+      if ( binError2s ) {
+	binError2Sums[iBin_rebinned] += binError2s[iBin];
+      } else {
+	double binError = histogram->GetBinError(iBin);
+	binError2Sums[iBin_rebinned] += (binError*binError);
+      }
+    }
+    for ( int iBin_rebinned = 1; iBin_rebinned <= numBins_rebinned; ++iBin_rebinned ) {
+      double binWidth_rebinned = rebinningMap.binWidths_rebinned_[iBin_rebinned - 1];
+      histogram_rebinned->SetBinContent(iBin_rebinned, binContentSums[iBin_rebinned]/binWidth_rebinned);
+      histogram_rebinned->SetBinError(iBin_rebinned, TMath::Sqrt(binError2Sums[iBin_rebinned])/binWidth_rebinned);
     }
     return histogram_rebinned;
   } 
 
   TH1* copyHistogram(TDirectory* dir_input, const std::string& process, const std::string& histogramName_input, 
 		     const std::string& histogramName_output, double sf, double setBinsToZeroBelow, int rebin, const std::string& central_or_shift, 
-		     bool enableException, bool setEmptySystematicFromCentral = true)
+		     bool enableException, std::ostream& log, bool setEmptySystematicFromCentral = true)
   {
-    std::cout << "<copyHistogram>:" << std::endl;
-    std::cout << " dir_input = " << dir_input->GetName() << std::endl;
-    std::cout << " process = " << process << std::endl;
-    std::cout << " histogramName_input = " << histogramName_input << std::endl;
-    std::cout << " histogramName_output = " << histogramName_output << std::endl;
-    std::cout << " central_or_shift = " << central_or_shift << std::endl;
-    std::cout << " enableException = " << enableException << std::endl;
+    log << "<copyHistogram>:" << std::endl;
+    log << " dir_input = " << dir_input->GetName() << std::endl;
+    log << " process = " << process << std::endl;
+    log << " histogramName_input = " << histogramName_input << std::endl;
+    log << " histogramName_output = " << histogramName_output << std::endl;
+    log << " central_or_shift = " << central_or_shift << std::endl;
+    log << " enableException = " << enableException << std::endl;
 
     std::string histogramName_input_full = "";
     if ( !(central_or_shift == "" || central_or_shift == "central") ) histogramName_input_full.append(central_or_shift);
@@ -140,7 +176,7 @@ namespace
 	  << "Failed to find histogram = " << histogramName_input_full << " in directory = " << dir_input->GetName() << " !!\n";
       return 0;
     }   
-    std::cout << " integral(" << process << ") = " << histogram_input->Integral() << std::endl;
+    log << " integral(" << process << ") = " << histogram_input->Integral() << std::endl;
     // std::string histogramName_output_full = std::string("x").append("_").append(process); // DEF LINE
     std::string histogramName_output_full = process; // MY LINE
     if ( !(central_or_shift == "" || central_or_shift == "central") ) histogramName_output_full.append("_").append(central_or_shift);
@@ -201,6 +237,19 @@ namespace
     std::string output_;
   };
 
+  struct categoryOutputType
+  {
+    categoryOutputType()
+      : histogramBackgroundSum_(0)
+    {}
+    ~categoryOutputType() {}
+    std::vector<TH1*> histograms_;
+    std::vector<TH1*> histograms_rebinned_;
+    TH1* histogramBackgroundSum_;
+    std::ostringstream log_;
+    std::exception_ptr exception_;
+  };
+
   bool compMatch(const std::string& s, TPRegexp* pattern)
   {
     bool isMatched = false;
@@ -248,23 +297,9 @@ int main(int argc, char* argv[])
   edm::ParameterSet cfg_prepareDatacards = cfg.getParameter<edm::ParameterSet>("prepareDatacards");
 
   vstring processesToCopy_string = cfg_prepareDatacards.getParameter<vstring>("processesToCopy");
-  std::vector<TPRegexp*> processesToCopy;
-  for ( vstring::const_iterator processToCopy_string = processesToCopy_string.begin();
-	processToCopy_string != processesToCopy_string.end(); ++processToCopy_string ) {
-    TPRegexp* processToCopy = new TPRegexp(processToCopy_string->data());
-    processesToCopy.push_back(processToCopy);
-  }
   
   double sf_signal = cfg_prepareDatacards.getParameter<double>("sf_signal");
   vstring signals_string = cfg_prepareDatacards.getParameter<vstring>("signals");
-  std::vector<TPRegexp*> signals;
-  for ( vstring::const_iterator signal_string = signals_string.begin();
-	signal_string != signals_string.end(); ++signal_string ) {
-    TPRegexp* signal = new TPRegexp(signal_string->data());
-    signals.push_back(signal);
-  }
-
-  TPRegexp* data = new TPRegexp("data_obs");
 
   std::vector<categoryType> categories;
   edm::VParameterSet cfg_categories = cfg_prepareDatacards.getParameter<edm::VParameterSet>("categories");
@@ -284,99 +319,186 @@ int main(int argc, char* argv[])
   bool apply_automatic_rebinning = cfg_prepareDatacards.getParameter<bool>("apply_automatic_rebinning");
   double minEvents_automatic_rebinning = cfg_prepareDatacards.getParameter<double>("minEvents_automatic_rebinning");
 
+  bool makeSubDir = cfg_prepareDatacards.getParameter<bool>("makeSubDir");
+
+  unsigned numThreads = ( cfg_prepareDatacards.exists("numThreads") ) ? cfg_prepareDatacards.getParameter<unsigned>("numThreads") : 1;
+  if ( numThreads < 1 ) numThreads = 1;
+  if ( numThreads > categories.size() && !categories.empty() ) numThreads = categories.size();
+
   fwlite::InputSource inputFiles(cfg); 
   if ( !(inputFiles.files().size() == 1) )
     throw cms::Exception("prepareDatacards") 
       << "Exactly one input file expected !!\n";
-  TFile* inputFile = new TFile(inputFiles.files().front().data());
+  std::string inputFileName = inputFiles.files().front();
 
   fwlite::OutputFiles outputFile(cfg);
   fwlite::TFileService fs = fwlite::TFileService(outputFile.file().data());
 
-  for ( std::vector<categoryType>::const_iterator category = categories.begin();
-	category != categories.end(); ++category ) {
-    std::cout << "processing category = " << category->input_ << std::endl;
+//--- read, copy and rebin the histograms of all categories,
+//    either in the main thread or distributed over numThreads worker threads;
+//    the histograms are kept detached from any directory while the categories are processed
+//    and are added to the output file afterwards, in the order of the categories
+  std::vector<categoryOutputType> categoryOutputs(categories.size());
+  std::atomic<size_t> nextCategory(0);
+  auto processCategories = [&]()
+  {
+    // each thread opens the input file and compiles the regular expressions by itself,
+    // as neither TFile nor TPRegexp can be shared between threads
+    TFile* inputFile = new TFile(inputFileName.data());
+    std::vector<TPRegexp*> processesToCopy;
+    for ( vstring::const_iterator processToCopy_string = processesToCopy_string.begin();
+	  processToCopy_string != processesToCopy_string.end(); ++processToCopy_string ) {
+      TPRegexp* processToCopy = new TPRegexp(processToCopy_string->data());
+      processesToCopy.push_back(processToCopy);
+    }
+    std::vector<TPRegexp*> signals;
+    for ( vstring::const_iterator signal_string = signals_string.begin();
+	  signal_string != signals_string.end(); ++signal_string ) {
+      TPRegexp* signal = new TPRegexp(signal_string->data());
+      signals.push_back(signal);
+    }
+    TPRegexp* data = new TPRegexp("data_obs");
+
+    size_t idxCategory;
+    while ( (idxCategory = nextCategory++) < categories.size() ) {
+      const categoryType* category = &categories[idxCategory];
+      categoryOutputType& categoryOutput = categoryOutputs[idxCategory];
+      std::ostream& log = categoryOutput.log_;
+      try {
+	log << "processing category = " << category->input_ << std::endl;
       
-    TDirectory* dir = getDirectory(inputFile, category->input_, true);
-    assert(dir);
+	TDirectory* dir = getDirectory(inputFile, category->input_, true);
+	assert(dir);
       
-    // copy histograms that do not require modifications
-    std::cout << "copying histograms that do not require modifications" << std::endl;
-    TList* list = dir->GetListOfKeys();
-    TIter next(list);
-    TKey* key = 0;
-    TH1* histogramBackgroundSum = 0;
-    std::vector<TH1*> histogramsToRebin;
-    while ( (key = dynamic_cast<TKey*>(next())) ) {
-      TObject* object = key->ReadObj();
-      TDirectory* subdir = dynamic_cast<TDirectory*>(object);
-      if ( !subdir ) continue;
-      std::cout << "subdir = " << subdir->GetName() << std::endl;
-      bool isToCopy = false;
-      for ( std::vector<TPRegexp*>::iterator processToCopy = processesToCopy.begin();
-	    processToCopy != processesToCopy.end(); ++processToCopy ) {
-	bool isMatched = compMatch(subdir->GetName(), *processToCopy);
-	if ( isMatched ) {
-	  std::cout << " matches processToCopy = " << (*processToCopy)->GetPattern() << std::endl;
-	  isToCopy = true;
-	} else {
-	  std::cout << " does not match processToCopy = " << (*processToCopy)->GetPattern() << std::endl;
-	}
-      }
-      bool isSignal = false;
-      for ( std::vector<TPRegexp*>::iterator signal = signals.begin();
-	    signal != signals.end(); ++signal ) {
-	bool isMatched = compMatch(subdir->GetName(), *signal);
-	if ( isMatched ) {
-	  std::cout << " matches signal = " << (*signal)->GetPattern() << std::endl;
-	  isSignal = true;
-	} else {
-	  std::cout << " does not match signal = " << (*signal)->GetPattern() << std::endl;
-	}
-      }
-      if ( isToCopy || isSignal ) {
-	for ( vstring::const_iterator central_or_shift = central_or_shifts.begin();
-	      central_or_shift != central_or_shifts.end(); ++central_or_shift ) {
-	  std::cout << "histogramToFit = " << histogramToFit << ", central_or_shift = " << (*central_or_shift) << std::endl;
-	  
-	  TFileDirectory* subdir_output = &fs;
-	  subdir_output->cd();
-	  //Make subdirectory if given
-	  bool makeSubDir = cfg_prepareDatacards.getParameter<bool>("makeSubDir");
-	  if ( makeSubDir == true && category->output_.length() > 0 ){
-	    TDirectory* subsubdir_output = createSubdirectory_recursively(fs, category->output_);
-	    subsubdir_output->cd();
+	// copy histograms that do not require modifications
+	log << "copying histograms that do not require modifications" << std::endl;
+	TList* list = dir->GetListOfKeys();
+	TIter next(list);
+	TKey* key = 0;
+	TH1*& histogramBackgroundSum = categoryOutput.histogramBackgroundSum_;
+	std::vector<TH1*>& histogramsToRebin = categoryOutput.histograms_;
+	while ( (key = dynamic_cast<TKey*>(next())) ) {
+	  TObject* object = key->ReadObj();
+	  TDirectory* subdir = dynamic_cast<TDirectory*>(object);
+	  if ( !subdir ) continue;
+	  log << "subdir = " << subdir->GetName() << std::endl;
+	  bool isToCopy = false;
+	  for ( std::vector<TPRegexp*>::iterator processToCopy = processesToCopy.begin();
+		processToCopy != processesToCopy.end(); ++processToCopy ) {
+	    bool isMatched = compMatch(subdir->GetName(), *processToCopy);
+	    if ( isMatched ) {
+	      log << " matches processToCopy = " << (*processToCopy)->GetPattern() << std::endl;
+	      isToCopy = true;
+	    } else {
+	      log << " does not match processToCopy = " << (*processToCopy)->GetPattern() << std::endl;
+	    }
 	  }
-	  double sf = ( isSignal ) ? sf_signal : 1.;
-	  TH1* histogram = copyHistogram(
-	    subdir, subdir->GetName(), histogramToFit, "", 
-	    sf, setBinsToZeroBelow, histogramToFit_rebin, *central_or_shift, (*central_or_shift) == "" || (*central_or_shift) == "central");	  
-	  if (!histogram) continue;
-	  assert(histogram);
-	  bool isData = compMatch(subdir->GetName(), data);
-	  if ( !(isData || isSignal) ) {
-	    if   ( !histogramBackgroundSum ) histogramBackgroundSum = (TH1*)histogram->Clone(Form("%s_BackgroundSum", category->input_.data()));
-	    else                             histogramBackgroundSum->Add(histogram);  	    
+	  bool isSignal = false;
+	  for ( std::vector<TPRegexp*>::iterator signal = signals.begin();
+		signal != signals.end(); ++signal ) {
+	    bool isMatched = compMatch(subdir->GetName(), *signal);
+	    if ( isMatched ) {
+	      log << " matches signal = " << (*signal)->GetPattern() << std::endl;
+	      isSignal = true;
+	    } else {
+	      log << " does not match signal = " << (*signal)->GetPattern() << std::endl;
+	    }
+	  }
+	  if ( isToCopy || isSignal ) {
+	    for ( vstring::const_iterator central_or_shift = central_or_shifts.begin();
+		  central_or_shift != central_or_shifts.end(); ++central_or_shift ) {
+	      log << "histogramToFit = " << histogramToFit << ", central_or_shift = " << (*central_or_shift) << std::endl;
+	      double sf = ( isSignal ) ? sf_signal : 1.;
+	      TH1* histogram = copyHistogram(
+	        subdir, subdir->GetName(), histogramToFit, "", 
+		sf, setBinsToZeroBelow, histogramToFit_rebin, *central_or_shift, (*central_or_shift) == "" || (*central_or_shift) == "central", log);	  
+	      if (!histogram) continue;
+	      assert(histogram);
+	      bool isData = compMatch(subdir->GetName(), data);
+	      if ( !(isData || isSignal) ) {
+		if   ( !histogramBackgroundSum ) histogramBackgroundSum = (TH1*)histogram->Clone(Form("%s_BackgroundSum", category->input_.data()));
+		else                             histogramBackgroundSum->Add(histogram);  	    
+	      }
+	      histogramsToRebin.push_back(histogram);
+	    }
+	  }
+	}
+
+	if ( apply_automatic_rebinning ) {
+	  // rebin histograms to avoid bins with zero background;
+	  // the binning is computed once per category and shared by all processes and systematic shifts,
+	  // and so is the assignment of bins of the input histograms to the rebinned bins
+	  assert(histogramBackgroundSum);
+	  std::vector<double> histogramBinning = compBinning(histogramBackgroundSum, minEvents_automatic_rebinning);
+	  rebinningMapType rebinningMap = compRebinningMap(histogramBinning, histogramBackgroundSum);
+	  for ( std::vector<TH1*>::iterator histogram = histogramsToRebin.begin();
+		histogram != histogramsToRebin.end(); ++histogram ) {
+	    if ( !isCompatible(rebinningMap, *histogram) ) rebinningMap = compRebinningMap(histogramBinning, *histogram);
+	    categoryOutput.histograms_rebinned_.push_back(rebinHistogram(rebinningMap, *histogram));
 	  }
-	  histogramsToRebin.push_back(histogram);
 	}
+
+	delete histogramBackgroundSum;
+	histogramBackgroundSum = 0;
+      } catch ( ... ) {
+	categoryOutput.exception_ = std::current_exception();
       }
     }
 
-    if ( apply_automatic_rebinning ) {
-      // rebin histograms to avoid bins with zero background
-      assert(histogramBackgroundSum);
-      std::vector<double> histogramBinning = compBinning(histogramBackgroundSum, minEvents_automatic_rebinning);
-      for ( std::vector<TH1*>::iterator histogram = histogramsToRebin.begin();
-	    histogram != histogramsToRebin.end(); ++histogram ) {
-	rebinHistogram(histogramBinning, *histogram);
-      }
+    delete data;
+    for ( std::vector<TPRegexp*>::iterator signal = signals.begin();
+	  signal != signals.end(); ++signal ) {
+      delete (*signal);
+    }
+    for ( std::vector<TPRegexp*>::iterator processToCopy = processesToCopy.begin();
+	  processToCopy != processesToCopy.end(); ++processToCopy ) {
+      delete (*processToCopy);
+    }
+    delete inputFile;
+  };
+
+  bool addDirectoryStatus = TH1::AddDirectoryStatus();
+  TH1::AddDirectory(false);
+  if ( numThreads > 1 ) {
+    std::cout << "processing " << categories.size() << " categories in " << numThreads << " threads" << std::endl;
+    ROOT::EnableThreadSafety();
+    std::vector<std::thread> workers;
+    for ( unsigned idxThread = 0; idxThread < numThreads; ++idxThread ) {
+      workers.push_back(std::thread(processCategories));
     }
+    for ( std::vector<std::thread>::iterator worker = workers.begin();
+	  worker != workers.end(); ++worker ) {
+      worker->join();
+    }
+  } else {
+    processCategories();
+  }
+  TH1::AddDirectory(addDirectoryStatus);
 
-    delete histogramBackgroundSum;
+//--- add the histograms to the output file
+  for ( size_t idxCategory = 0; idxCategory < categories.size(); ++idxCategory ) {
+    const categoryType* category = &categories[idxCategory];
+    categoryOutputType& categoryOutput = categoryOutputs[idxCategory];
+    std::cout << categoryOutput.log_.str();
+    if ( categoryOutput.exception_ ) std::rethrow_exception(categoryOutput.exception_);
+    if ( categoryOutput.histograms_.empty() ) continue;
+
+    TFileDirectory* subdir_output = &fs;
+    subdir_output->cd();
+    //Make subdirectory if given
+    if ( makeSubDir == true && category->output_.length() > 0 ){
+      TDirectory* subsubdir_output = createSubdirectory_recursively(fs, category->output_);
+      subsubdir_output->cd();
+    }
+    for ( std::vector<TH1*>::iterator histogram = categoryOutput.histograms_.begin();
+	  histogram != categoryOutput.histograms_.end(); ++histogram ) {
+      (*histogram)->SetDirectory(gDirectory);
+    }
+    for ( std::vector<TH1*>::iterator histogram = categoryOutput.histograms_rebinned_.begin();
+	  histogram != categoryOutput.histograms_rebinned_.end(); ++histogram ) {
+      (*histogram)->SetDirectory(gDirectory);
+    }
   }
-  
-  delete inputFile;
 
   clock.Show("prepareDatacards");
   
@@ -56,6 +56,8 @@
 #include "tthAnalysis/HiggsToTauTau/interface/MEMPermutationWriter.h" // MEMPermutationWriter
 #include "tthAnalysis/HiggsToTauTau/interface/analysisAuxFunctions.h" // isHigherPt, random_start
 #include "tthAnalysis/HiggsToTauTau/interface/RunLumiEventSelector.h" // RunLumiEventSelector
+#include "tthAnalysis/HiggsToTauTau/interface/EventIndex.h" // EventIndexWriter
+#include "tthAnalysis/HiggsToTauTau/interface/TTreeOutputWriter.h" // TTreeOutputWriter
 #include "tthAnalysis/HiggsToTauTau/interface/cutFlowTable.h" // cutFlowTableType
 #include "tthAnalysis/HiggsToTauTau/interface/CutFlowTableHistManager_2lss_1tau.h" // CutFlowTableHistManager_2lss_1tau
 #include "tthAnalysis/HiggsToTauTau/interface/histogramAuxFunctions.h" // createSubdirectory_recursively
@@ -185,6 +187,17 @@ int main(int argc, char* argv[])
     run_lumi_eventSelector = makeRunLumiEventSelector(selEventsFileName_input);
   }
 
+  std::string eventIndexFileName_output = cfg_produceNtuple.getParameter<std::string>("eventIndexFileName_output");
+  std::cout << "eventIndexFileName_output = " << eventIndexFileName_output << std::endl;
+  // name of the Ntuple recorded in the event index; set to the final location of the output file if it is copied there at the end of the job
+  std::string eventIndexNtupleFileName = cfg_produceNtuple.getParameter<std::string>("eventIndexNtupleFileName");
+  if ( eventIndexNtupleFileName != "" ) std::cout << "eventIndexNtupleFileName = " << eventIndexNtupleFileName << std::endl;
+
+  std::string outputCompression = cfg_produceNtuple.getParameter<std::string>("outputCompression");
+  int outputCompressionLevel = cfg_produceNtuple.getParameter<int>("outputCompressionLevel");
+  int outputAutoFlush = cfg_produceNtuple.getParameter<int>("outputAutoFlush");
+  unsigned outputNumThreads = cfg_produceNtuple.getParameter<unsigned>("outputNumThreads");
+
   vstring outputCommands_string = cfg_produceNtuple.getParameter<vstring>("outputCommands");
   std::vector<outputCommandEntry> outputCommands = getOutputCommands(outputCommands_string);
 
@@ -204,6 +217,11 @@ int main(int argc, char* argv[])
   fwlite::OutputFiles outputFile(cfg);
   fwlite::TFileService fs = fwlite::TFileService(outputFile.file().data());
 
+//--- write (run, lumi, event) -> (file, entry) index next to the output Ntuple, 
+//    so that selected events can later be read without scanning the full Ntuple
+  EventIndexWriter* eventIndexWriter = ( eventIndexFileName_output != "" ) ? 
+    new EventIndexWriter(eventIndexFileName_output, ( eventIndexNtupleFileName != "" ) ? eventIndexNtupleFileName : outputFile.file()) : 0;
+
   TChain* inputTree = new TChain(treeName.data());
   for ( std::vector<std::string>::const_iterator inputFileName = inputFiles.files().begin();
         inputFileName != inputFiles.files().end(); ++inputFileName ) {
@@ -315,6 +333,7 @@ int main(int argc, char* argv[])
     fs.cd();
   }
   TTree* outputTree = new TTree(outputTreeName.data(), outputTreeName.data());
+  TTreeOutputWriter outputTreeWriter(outputTree, outputCompression, outputCompressionLevel, outputAutoFlush, outputNumThreads);
 
   outputTree->Branch("run", &run, "run/i");
   outputTree->Branch("lumi", &lumi, "lumi/i");
@@ -651,7 +670,10 @@ int main(int argc, char* argv[])
       branchEntry->second->copyBranch();
     }
 
-    outputTree->Fill();
+    outputTreeWriter.fill();
+    if ( eventIndexWriter ) {
+      eventIndexWriter->write(run, lumi, event, outputTree->GetEntries() - 1, selLeptons.size(), selHadTaus.size(), selJets.size());
+    }
 
     ++selectedEntries;
   }
@@ -666,9 +688,11 @@ int main(int argc, char* argv[])
 
   std::cout << "output Tree:" << std::endl;
   outputTree->Print();
+  outputTreeWriter.printStatistics(std::cout);
   //outputTree->Scan("*", "", "", 20, 0);
 
   delete run_lumi_eventSelector;
+  delete eventIndexWriter;
 
   delete muonReader;
   delete electronReader;
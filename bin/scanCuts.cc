@@ -0,0 +1,219 @@
+
+/** \executable scanCuts
+ *
+ * Compute the signal and background yields and S/sqrt(B) for a grid of cuts on the event-level variables
+ * stored in analysis Ntuples (e.g. the trees written by EvtTreeManager_2lss_1tau or NtupleFillerBDT).
+ *
+ * The variables needed for the cuts are read from the Ntuple of each sample once and kept in memory,
+ * and the yields for all points of the grid are computed in a single pass (cf. CutScanner),
+ * instead of rerunning the analyze_* executables for each cut variation.
+ *
+ */
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/PythonParameterSet/interface/MakeParameterSets.h"
+
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include "tthAnalysis/HiggsToTauTau/interface/CutScanner.h"
+
+#include <TChain.h>
+#include <TTree.h>
+#include <TTreeFormula.h>
+#include <TString.h> // Form
+#include <TBenchmark.h>
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <assert.h>
+
+typedef std::vector<std::string> vstring;
+typedef std::vector<double> vdouble;
+
+namespace
+{
+  /**
+   * @brief Read the values of the cut expressions and the event weights for the events of one sample passing the selection
+   */
+  void readColumns(const std::string& treeName, const vstring& inputFileNames,
+		   const std::string& selection, const std::string& weight, const vstring& cutExpressions,
+		   int maxEvents, unsigned reportEvery,
+		   std::vector<std::vector<float> >& columns, std::vector<float>& weights)
+  {
+    TChain* inputTree = new TChain(treeName.data());
+    for ( vstring::const_iterator inputFileName = inputFileNames.begin();
+	  inputFileName != inputFileNames.end(); ++inputFileName ) {
+      std::cout << "input Tree: adding file = " << (*inputFileName) << std::endl;
+      inputTree->AddFile(inputFileName->data());
+    }
+
+    if ( !(inputTree->GetListOfFiles()->GetEntries() >= 1) ) {
+      throw cms::Exception("scanCuts")
+	<< "Failed to identify input Tree !!\n";
+    }
+
+    // need to call TChain::LoadTree before processing first event
+    // in order to prevent ROOT causing a segmentation violation,
+    // cf. http://root.cern.ch/phpBB3/viewtopic.php?t=10062
+    inputTree->LoadTree(0);
+
+    TTreeFormula* selectionFormula = ( selection != "" ) ? new TTreeFormula("scanCuts_selection", selection.data(), inputTree) : 0;
+    TTreeFormula* weightFormula = new TTreeFormula("scanCuts_weight", weight.data(), inputTree);
+    std::vector<TTreeFormula*> cutFormulas;
+    for ( size_t idxCut = 0; idxCut < cutExpressions.size(); ++idxCut ) {
+      cutFormulas.push_back(new TTreeFormula(Form("scanCuts_cut%i", (int)idxCut), cutExpressions[idxCut].data(), inputTree));
+    }
+
+    int currentTreeNumber = inputTree->GetTreeNumber();
+
+    Long64_t numEntries = inputTree->GetEntries();
+    std::cout << "input Tree contains " << numEntries << " Entries in " << inputTree->GetListOfFiles()->GetEntries() << " files." << std::endl;
+    if ( maxEvents != -1 && numEntries > maxEvents ) numEntries = maxEvents;
+
+    columns.assign(cutExpressions.size(), std::vector<float>());
+    for ( std::vector<std::vector<float> >::iterator column = columns.begin();
+	  column != columns.end(); ++column ) {
+      column->reserve(numEntries);
+    }
+    weights.clear();
+    weights.reserve(numEntries);
+
+    for ( Long64_t iEntry = 0; iEntry < numEntries; ++iEntry ) {
+      if ( iEntry > 0 && (iEntry % reportEvery) == 0 ) {
+	std::cout << "processing Entry " << iEntry << std::endl;
+      }
+
+//--- only the branches that are used in the selection, weight and cut expressions are read, by TTreeFormula
+      inputTree->LoadTree(iEntry);
+
+      if ( inputTree->GetTreeNumber() != currentTreeNumber ) {
+	if ( selectionFormula ) selectionFormula->UpdateFormulaLeaves();
+	weightFormula->UpdateFormulaLeaves();
+	for ( std::vector<TTreeFormula*>::iterator cutFormula = cutFormulas.begin();
+	      cutFormula != cutFormulas.end(); ++cutFormula ) {
+	  (*cutFormula)->UpdateFormulaLeaves();
+	}
+	currentTreeNumber = inputTree->GetTreeNumber();
+      }
+
+      if ( selectionFormula ) {
+	selectionFormula->GetNdata();
+	if ( !(selectionFormula->EvalInstance() > 0.5) ) continue;
+      }
+
+      weightFormula->GetNdata();
+      weights.push_back(weightFormula->EvalInstance());
+      for ( size_t idxCut = 0; idxCut < cutFormulas.size(); ++idxCut ) {
+	cutFormulas[idxCut]->GetNdata();
+	columns[idxCut].push_back(cutFormulas[idxCut]->EvalInstance());
+      }
+    }
+    std::cout << "num. Entries passing selection = " << weights.size() << std::endl;
+
+    for ( std::vector<TTreeFormula*>::iterator cutFormula = cutFormulas.begin();
+	  cutFormula != cutFormulas.end(); ++cutFormula ) {
+      delete (*cutFormula);
+    }
+    delete weightFormula;
+    delete selectionFormula;
+
+    delete inputTree;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+//--- parse command-line arguments
+  if ( argc < 2 ) {
+    std::cout << "Usage: " << argv[0] << " [parameters.py]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "<scanCuts>:" << std::endl;
+
+//--- keep track of time it takes the macro to execute
+  TBenchmark clock;
+  clock.Start("scanCuts");
+
+//--- read python configuration parameters
+  if ( !edm::readPSetsFrom(argv[1])->existsAs<edm::ParameterSet>("process") )
+    throw cms::Exception("scanCuts")
+      << "No ParameterSet 'process' found in configuration file = " << argv[1] << " !!\n";
+
+  edm::ParameterSet cfg = edm::readPSetsFrom(argv[1])->getParameter<edm::ParameterSet>("process");
+
+  edm::ParameterSet cfg_scanCuts = cfg.getParameter<edm::ParameterSet>("scanCuts");
+
+  std::string treeName = cfg_scanCuts.getParameter<std::string>("treeName");
+  std::string selection = cfg_scanCuts.getParameter<std::string>("selection");
+  std::string weight = cfg_scanCuts.getParameter<std::string>("weight");
+  int maxEvents = cfg_scanCuts.getParameter<int>("maxEvents");
+  unsigned reportEvery = cfg_scanCuts.getParameter<unsigned>("outputEvery");
+
+  CutScanner cutScanner;
+  vstring cutExpressions;
+  typedef std::vector<edm::ParameterSet> vParameterSet;
+  vParameterSet cfg_cuts = cfg_scanCuts.getParameter<vParameterSet>("cuts");
+  for ( vParameterSet::const_iterator cfg_cut = cfg_cuts.begin();
+	cfg_cut != cfg_cuts.end(); ++cfg_cut ) {
+    std::string cutExpression = cfg_cut->getParameter<std::string>("expression");
+    std::string cutOperator = cfg_cut->getParameter<std::string>("operator");
+    vdouble cutThresholds = cfg_cut->getParameter<vdouble>("thresholds");
+    cutScanner.addCut(cutExpression, cutOperator, cutThresholds);
+    cutExpressions.push_back(cutExpression);
+  }
+  std::cout << "scanning " << cutScanner.getNumCutPoints() << " cut points." << std::endl;
+
+  vParameterSet cfg_samples = cfg_scanCuts.getParameter<vParameterSet>("samples");
+  for ( vParameterSet::const_iterator cfg_sample = cfg_samples.begin();
+	cfg_sample != cfg_samples.end(); ++cfg_sample ) {
+    std::string sampleName = cfg_sample->getParameter<std::string>("name");
+    std::string sampleType = cfg_sample->getParameter<std::string>("type");
+    bool isSignal = false;
+    if      ( sampleType == "signal"     ) isSignal = true;
+    else if ( sampleType == "background" ) isSignal = false;
+    else throw cms::Exception("scanCuts")
+      << "Invalid Configuration parameter 'type' = " << sampleType << " for sample = " << sampleName << " !!\n";
+    vstring inputFileNames = cfg_sample->getParameter<vstring>("inputFileNames");
+//--- additional selection and weight for this sample, combined with the common ones
+    std::string sampleSelection = selection;
+    if ( cfg_sample->exists("selection") && cfg_sample->getParameter<std::string>("selection") != "" ) {
+      std::string selection_sample = cfg_sample->getParameter<std::string>("selection");
+      sampleSelection = ( sampleSelection != "" ) ? Form("(%s) && (%s)", sampleSelection.data(), selection_sample.data()) : selection_sample;
+    }
+    std::string sampleWeight = weight;
+    if ( cfg_sample->exists("weight") && cfg_sample->getParameter<std::string>("weight") != "" ) {
+      sampleWeight = Form("(%s)*(%s)", sampleWeight.data(), cfg_sample->getParameter<std::string>("weight").data());
+    }
+    std::cout << "processing sample = " << sampleName << " (" << sampleType << ")" << std::endl;
+
+    std::vector<std::vector<float> > columns;
+    std::vector<float> weights;
+    readColumns(treeName, inputFileNames, sampleSelection, sampleWeight, cutExpressions, maxEvents, reportEvery, columns, weights);
+
+    int idxSample = cutScanner.addSample(sampleName, isSignal);
+    cutScanner.fill(idxSample, columns, weights);
+  }
+
+  size_t idxCutPoint_best = cutScanner.getBestCutPoint();
+  std::vector<double> thresholds_best = cutScanner.getThresholds(idxCutPoint_best);
+  std::cout << "best cut point:" << std::endl;
+  for ( size_t idxCut = 0; idxCut < cutExpressions.size(); ++idxCut ) {
+    std::cout << " " << cutExpressions[idxCut] << " " << cfg_cuts[idxCut].getParameter<std::string>("operator") << " " << thresholds_best[idxCut] << std::endl;
+  }
+  std::cout << " S = " << cutScanner.getYield_signal(idxCutPoint_best) << ", B = " << cutScanner.getYield_background(idxCutPoint_best)
+	    << ": S/sqrt(B) = " << cutScanner.getSignificance(idxCutPoint_best) << std::endl;
+
+  std::string outputFileName = cfg_scanCuts.getParameter<std::string>("outputFileName");
+  std::cout << "writing yields for all cut points to file = " << outputFileName << std::endl;
+  std::ofstream* outputFile = new std::ofstream(outputFileName.data());
+  cutScanner.print(*outputFile);
+  delete outputFile;
+
+  clock.Show("scanCuts");
+
+  return 0;
+}
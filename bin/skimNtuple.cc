@@ -0,0 +1,584 @@
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h" // edm::ParameterSet
+#include "FWCore/PythonParameterSet/interface/MakeParameterSets.h" // edm::readPSetsFrom()
+#include "FWCore/Utilities/interface/Exception.h" // cms::Exception
+#include "DataFormats/FWLite/interface/InputSource.h" // fwlite::InputSource
+
+#include <Rtypes.h> // Int_t, Long64_t, Double_t
+#include <TChain.h> // TChain
+#include <TTree.h> // TTree
+#include <TBranch.h> // TBranch
+#include <TFile.h> // TFile
+#include <TH1.h> // TH1, TH1F, TH1D
+#include <TBenchmark.h> // TBenchmark
+#include <TString.h> // TString, Form
+#include <TObjString.h> // TObjString
+#include <TError.h> // gErrorAbortLevel, kError
+
+#include "tthAnalysis/HiggsToTauTau/interface/RecoLepton.h" // RecoLepton
+#include "tthAnalysis/HiggsToTauTau/interface/RecoJet.h" // RecoJet
+#include "tthAnalysis/HiggsToTauTau/interface/RecoHadTau.h" // RecoHadTau
+#include "tthAnalysis/HiggsToTauTau/interface/KeyTypes.h"
+#include "tthAnalysis/HiggsToTauTau/interface/RecoElectronReader.h" // RecoElectronReader
+#include "tthAnalysis/HiggsToTauTau/interface/RecoMuonReader.h" // RecoMuonReader
+#include "tthAnalysis/HiggsToTauTau/interface/RecoHadTauReader.h" // RecoHadTauReader
+#include "tthAnalysis/HiggsToTauTau/interface/RecoJetReader.h" // RecoJetReader
+#include "tthAnalysis/HiggsToTauTau/interface/RecoMEtReader.h" // RecoMEtReader
+#include "tthAnalysis/HiggsToTauTau/interface/GenLeptonReader.h" // GenLeptonReader
+#include "tthAnalysis/HiggsToTauTau/interface/GenHadTauReader.h" // GenHadTauReader
+#include "tthAnalysis/HiggsToTauTau/interface/GenJetReader.h" // GenJetReader
+#include "tthAnalysis/HiggsToTauTau/interface/convert_to_ptrs.h" // convert_to_ptrs
+#include "tthAnalysis/HiggsToTauTau/interface/ParticleCollectionCleaner.h" // RecoElectronCollectionCleaner, RecoHadTauCollectionCleaner, RecoJetCollectionCleaner
+#include "tthAnalysis/HiggsToTauTau/interface/RecoElectronCollectionSelectorLoose.h" // RecoElectronCollectionSelectorLoose
+#include "tthAnalysis/HiggsToTauTau/interface/RecoElectronCollectionSelectorFakeable.h" // RecoElectronCollectionSelectorFakeable
+#include "tthAnalysis/HiggsToTauTau/interface/RecoElectronCollectionSelectorTight.h" // RecoElectronCollectionSelectorTight
+#include "tthAnalysis/HiggsToTauTau/interface/RecoMuonCollectionSelectorLoose.h" // RecoMuonCollectionSelectorLoose
+#include "tthAnalysis/HiggsToTauTau/interface/RecoMuonCollectionSelectorFakeable.h" // RecoMuonCollectionSelectorFakeable
+#include "tthAnalysis/HiggsToTauTau/interface/RecoMuonCollectionSelectorTight.h" // RecoMuonCollectionSelectorTight
+#include "tthAnalysis/HiggsToTauTau/interface/RecoHadTauCollectionSelectorLoose.h" // RecoHadTauCollectionSelectorLoose
+#include "tthAnalysis/HiggsToTauTau/interface/RecoHadTauCollectionSelectorFakeable.h" // RecoHadTauCollectionSelectorFakeable
+#include "tthAnalysis/HiggsToTauTau/interface/RecoHadTauCollectionSelectorTight.h" // RecoHadTauCollectionSelectorTight
+#include "tthAnalysis/HiggsToTauTau/interface/RecoJetCollectionSelector.h" // RecoJetCollectionSelector
+#include "tthAnalysis/HiggsToTauTau/interface/RecoJetCollectionSelectorBtag.h" // RecoJetCollectionSelectorBtagLoose, RecoJetCollectionSelectorBtagMedium
+#include "tthAnalysis/HiggsToTauTau/interface/analysisAuxFunctions.h" // mergeLeptonCollections
+#include "tthAnalysis/HiggsToTauTau/interface/RunLumiEventSelector.h" // RunLumiEventSelector
+#include "tthAnalysis/HiggsToTauTau/interface/TTreeOutputWriter.h" // TTreeOutputWriter
+#include "tthAnalysis/HiggsToTauTau/interface/hltPath.h" // hltPath, hltPaths_isTriggered
+#include "tthAnalysis/HiggsToTauTau/interface/branchEntryTypeAuxFunctions.h" // getOutputCommands, getBranchesToKeep
+
+#include <iostream> // std::cerr, std::fixed
+#include <iomanip> // std::setprecision(), std::setw()
+#include <string> // std::string
+#include <vector> // std::vector<>
+#include <map> // std::map<,>
+#include <set> // std::set<>
+#include <cstdlib> // EXIT_SUCCESS, EXIT_FAILURE
+#include <fstream> // std::ofstream
+#include <assert.h> // assert
+
+typedef std::vector<std::string> vstring;
+
+/**
+ * @brief Preselection and output of one channel
+ *
+ * The output TTree is a clone of the input TTree restricted to the branches to keep,
+ * so that the kept branches are written from the same buffers that the reader classes and TChain::GetEntry() fill.
+ */
+struct skimChannelType
+{
+  skimChannelType(const edm::ParameterSet& cfg)
+    : name_(cfg.getParameter<std::string>("name"))
+    , outputFileName_(cfg.getParameter<std::string>("outputFileName"))
+    , manifestFileName_(cfg.getParameter<std::string>("manifestFileName"))
+    , minNumLeptons_(cfg.getParameter<int>("minNumLeptons"))
+    , maxNumLeptons_(cfg.exists("maxNumLeptons") ? cfg.getParameter<int>("maxNumLeptons") : -1)
+    , minNumHadTaus_(cfg.getParameter<int>("minNumHadTaus"))
+    , maxNumHadTaus_(cfg.exists("maxNumHadTaus") ? cfg.getParameter<int>("maxNumHadTaus") : -1)
+    , minNumLeptons_and_HadTaus_(cfg.getParameter<int>("minNumLeptons_and_HadTaus"))
+    , minNumJets_(cfg.getParameter<int>("minNumJets"))
+    , minNumBJets_loose_(cfg.getParameter<int>("minNumBJets_loose"))
+    , minNumBJets_medium_(cfg.getParameter<int>("minNumBJets_medium"))
+    , triggers_(cfg.getParameter<vstring>("triggers"))
+    , outputCommands_(cfg.getParameter<vstring>("outputCommands"))
+    , outputFile_(0)
+    , outputTree_(0)
+    , outputTreeWriter_(0)
+    , manifestFile_(0)
+    , numSelected_(0)
+  {}
+  ~skimChannelType()
+  {
+    delete outputTreeWriter_;
+    delete outputFile_;
+    delete manifestFile_;
+  }
+
+  bool isSelected(int numSelLeptons, int numSelHadTaus, int numSelJets, int numSelBJets_loose, int numSelBJets_medium) const
+  {
+    if ( numSelLeptons < minNumLeptons_ || (maxNumLeptons_ >= 0 && numSelLeptons > maxNumLeptons_) ) return false;
+    if ( numSelHadTaus < minNumHadTaus_ || (maxNumHadTaus_ >= 0 && numSelHadTaus > maxNumHadTaus_) ) return false;
+    if ( (numSelLeptons + numSelHadTaus) < minNumLeptons_and_HadTaus_ ) return false;
+    if ( numSelJets < minNumJets_ ) return false;
+    if ( !(numSelBJets_loose >= minNumBJets_loose_ || numSelBJets_medium >= minNumBJets_medium_) ) return false;
+//--- an empty list of triggers means that no trigger requirement is applied
+    if ( !hltPaths_.empty() && !hltPaths_isTriggered(hltPaths_) ) return false;
+    return true;
+  }
+
+  std::string name_;
+  std::string outputFileName_;
+  std::string manifestFileName_;
+
+  int minNumLeptons_;
+  int maxNumLeptons_;
+  int minNumHadTaus_;
+  int maxNumHadTaus_;
+  int minNumLeptons_and_HadTaus_;
+  int minNumJets_;
+  int minNumBJets_loose_;
+  int minNumBJets_medium_;
+
+  vstring triggers_;
+  std::vector<hltPath*> hltPaths_; // owned by the hltPath map in main, shared by channels requiring the same trigger
+
+  vstring outputCommands_;
+  std::map<std::string, bool> isBranchToKeep_; // key = branchName
+
+  TFile* outputFile_;
+  TTree* outputTree_;
+  TTreeOutputWriter* outputTreeWriter_;
+  std::ofstream* manifestFile_;
+
+  long numSelected_;
+
+ private:
+  skimChannelType(const skimChannelType&);
+  skimChannelType& operator=(const skimChannelType&);
+};
+
+/**
+ * @brief Skim the Ntuples produced by produceNtuple into compact Ntuples for several analysis channels in a single pass
+ *
+ * The collections of leptons, hadronic taus and jets are built once per event;
+ * an event is written to the output Ntuple of each channel whose (loose) preselection it passes.
+ * The output Ntuples contain the branches read by the reader classes (and by the triggers of the channel),
+ * plus the branches selected by the outputCommands of the channel, so that the analyze_* executables can run on them unchanged.
+ *
+ * For each channel, a manifest is written that records where each selected event came from, one line per event:
+ *
+ *   run:lumi:event skimEntry inputFileName inputEntry
+ *
+ * where skimEntry is the index of the event in the skimmed Ntuple and inputEntry the index of the event in the TTree of the input file.
+ */
+int main(int argc, char* argv[])
+{
+//--- throw an exception in case ROOT encounters an error
+  gErrorAbortLevel = kError;
+
+//--- parse command-line arguments
+  if ( argc < 2 ) {
+    std::cout << "Usage: " << argv[0] << " [parameters.py]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "<skimNtuple>:" << std::endl;
+
+//--- keep track of time it takes the macro to execute
+  TBenchmark clock;
+  clock.Start("skimNtuple");
+
+//--- read python configuration parameters
+  if ( !edm::readPSetsFrom(argv[1])->existsAs<edm::ParameterSet>("process") )
+    throw cms::Exception("skimNtuple")
+      << "No ParameterSet 'process' found in configuration file = " << argv[1] << " !!\n";
+
+  edm::ParameterSet cfg = edm::readPSetsFrom(argv[1])->getParameter<edm::ParameterSet>("process");
+
+  edm::ParameterSet cfg_skimNtuple = cfg.getParameter<edm::ParameterSet>("skimNtuple");
+
+  std::string treeName = cfg_skimNtuple.getParameter<std::string>("treeName");
+
+  std::string era_string = cfg_skimNtuple.getParameter<std::string>("era");
+  int era = -1;
+  if      ( era_string == "2015" ) era = kEra_2015;
+  else if ( era_string == "2016" ) era = kEra_2016;
+  else if ( era_string == "2017" ) era = kEra_2017;
+  else throw cms::Exception("skimNtuple")
+    << "Invalid Configuration parameter 'era' = " << era_string << " !!\n";
+
+  std::string leptonSelection_string = cfg_skimNtuple.getParameter<std::string>("leptonSelection").data();
+  int leptonSelection = -1;
+  if      ( leptonSelection_string == "Loose"    ) leptonSelection = kLoose;
+  else if ( leptonSelection_string == "Fakeable" ) leptonSelection = kFakeable;
+  else if ( leptonSelection_string == "Tight"    ) leptonSelection = kTight;
+  else throw cms::Exception("skimNtuple")
+    << "Invalid Configuration parameter 'leptonSelection' = " << leptonSelection_string << " !!\n";
+
+  TString hadTauSelection_string = cfg_skimNtuple.getParameter<std::string>("hadTauSelection").data();
+  TObjArray* hadTauSelection_parts = hadTauSelection_string.Tokenize("|");
+  assert(hadTauSelection_parts->GetEntries() >= 1);
+  std::string hadTauSelection_part1 = (dynamic_cast<TObjString*>(hadTauSelection_parts->At(0)))->GetString().Data();
+  int hadTauSelection = -1;
+  if      ( hadTauSelection_part1 == "Loose"    ) hadTauSelection = kLoose;
+  else if ( hadTauSelection_part1 == "Fakeable" ) hadTauSelection = kFakeable;
+  else if ( hadTauSelection_part1 == "Tight"    ) hadTauSelection = kTight;
+  else throw cms::Exception("skimNtuple")
+    << "Invalid Configuration parameter 'hadTauSelection' = " << hadTauSelection_string << " !!\n";
+  std::string hadTauSelection_part2 = ( hadTauSelection_parts->GetEntries() == 2 ) ? (dynamic_cast<TObjString*>(hadTauSelection_parts->At(1)))->GetString().Data() : "";
+  delete hadTauSelection_parts;
+
+  const std::string branchName_electrons   = cfg_skimNtuple.getParameter<std::string>("branchName_electrons");
+  const std::string branchName_muons       = cfg_skimNtuple.getParameter<std::string>("branchName_muons");
+  const std::string branchName_hadTaus     = cfg_skimNtuple.getParameter<std::string>("branchName_hadTaus");
+  const std::string branchName_jets        = cfg_skimNtuple.getParameter<std::string>("branchName_jets");
+  const std::string branchName_met         = cfg_skimNtuple.getParameter<std::string>("branchName_met");
+  const std::string branchName_genLeptons1 = cfg_skimNtuple.getParameter<std::string>("branchName_genLeptons1");
+  const std::string branchName_genLeptons2 = cfg_skimNtuple.getParameter<std::string>("branchName_genLeptons2");
+  const std::string branchName_genHadTaus  = cfg_skimNtuple.getParameter<std::string>("branchName_genHadTaus");
+  const std::string branchName_genJets     = cfg_skimNtuple.getParameter<std::string>("branchName_genJets");
+
+  bool use_HIP_mitigation_mediumMuonId = cfg_skimNtuple.getParameter<bool>("use_HIP_mitigation_mediumMuonId");
+  std::cout << "use_HIP_mitigation_mediumMuonId = " << use_HIP_mitigation_mediumMuonId << std::endl;
+
+  bool isMC = cfg_skimNtuple.getParameter<bool>("isMC");
+
+  std::string selEventsFileName_input = cfg_skimNtuple.getParameter<std::string>("selEventsFileName_input");
+  std::cout << "selEventsFileName_input = " << selEventsFileName_input << std::endl;
+  RunLumiEventSelector* run_lumi_eventSelector = 0;
+  if ( selEventsFileName_input != "" ) {
+    run_lumi_eventSelector = makeRunLumiEventSelector(selEventsFileName_input);
+  }
+
+  std::string outputCompression = cfg_skimNtuple.getParameter<std::string>("outputCompression");
+  int outputCompressionLevel = cfg_skimNtuple.getParameter<int>("outputCompressionLevel");
+  int outputAutoFlush = cfg_skimNtuple.getParameter<int>("outputAutoFlush");
+  unsigned outputNumThreads = cfg_skimNtuple.getParameter<unsigned>("outputNumThreads");
+
+  vstring copy_histograms = cfg_skimNtuple.getParameter<vstring>("copy_histograms");
+
+  std::vector<skimChannelType*> channels;
+  edm::VParameterSet cfg_channels = cfg_skimNtuple.getParameter<edm::VParameterSet>("channels");
+  for ( edm::VParameterSet::const_iterator cfg_channel = cfg_channels.begin();
+        cfg_channel != cfg_channels.end(); ++cfg_channel ) {
+    channels.push_back(new skimChannelType(*cfg_channel));
+  }
+  if ( channels.empty() ) {
+    throw cms::Exception("skimNtuple")
+      << "No channels defined in Configuration parameter 'channels' !!\n";
+  }
+
+  fwlite::InputSource inputFiles(cfg);
+  int maxEvents = inputFiles.maxEvents();
+  std::cout << " maxEvents = " << maxEvents << std::endl;
+  unsigned reportEvery = inputFiles.reportAfter();
+
+  TChain* inputTree = new TChain(treeName.data());
+  for ( std::vector<std::string>::const_iterator inputFileName = inputFiles.files().begin();
+        inputFileName != inputFiles.files().end(); ++inputFileName ) {
+    std::cout << "input Tree: adding file = " << (*inputFileName) << std::endl;
+    inputTree->AddFile(inputFileName->data());
+  }
+
+  if ( !(inputTree->GetListOfFiles()->GetEntries() >= 1) ) {
+    throw cms::Exception("skimNtuple")
+      << "Failed to identify input Tree !!\n";
+  }
+
+  std::cout << "input Tree contains " << inputTree->GetEntries() << " Entries in " << inputTree->GetListOfFiles()->GetEntries() << " files." << std::endl;
+
+//--- declare event-level variables
+  RUN_TYPE run;
+  inputTree->SetBranchAddress(RUN_KEY, &run);
+  LUMI_TYPE lumi;
+  inputTree->SetBranchAddress(LUMI_KEY, &lumi);
+  EVT_TYPE event;
+  inputTree->SetBranchAddress(EVT_KEY, &event);
+
+//--- declare triggers; channels that require the same trigger share one hltPath object,
+//    as ROOT supports only one address per branch
+  std::map<std::string, hltPath*> hltPaths; // key = branchName
+  for ( std::vector<skimChannelType*>::iterator channel = channels.begin();
+        channel != channels.end(); ++channel ) {
+    for ( vstring::const_iterator trigger = (*channel)->triggers_.begin();
+          trigger != (*channel)->triggers_.end(); ++trigger ) {
+      if ( !hltPaths[*trigger] ) {
+        hltPaths[*trigger] = new hltPath(*trigger);
+        hltPaths[*trigger]->setBranchAddresses(inputTree);
+      }
+      (*channel)->hltPaths_.push_back(hltPaths[*trigger]);
+    }
+  }
+
+//--- declare particle collections
+  RecoMuonReader* muonReader = new RecoMuonReader(era, Form("n%s", branchName_muons.c_str()), branchName_muons);
+  if ( use_HIP_mitigation_mediumMuonId ) muonReader->enable_HIP_mitigation();
+  else muonReader->disable_HIP_mitigation();
+  muonReader->setBranchAddresses(inputTree);
+  RecoMuonCollectionSelectorLoose preselMuonSelector(era);
+  RecoMuonCollectionSelectorFakeable fakeableMuonSelector(era);
+  RecoMuonCollectionSelectorTight tightMuonSelector(era);
+
+  RecoElectronReader* electronReader = new RecoElectronReader(era, Form("n%s", branchName_electrons.c_str()), branchName_electrons);
+  electronReader->setBranchAddresses(inputTree);
+  RecoElectronCollectionCleaner electronCleaner(0.3);
+  RecoElectronCollectionSelectorLoose preselElectronSelector(era);
+  RecoElectronCollectionSelectorFakeable fakeableElectronSelector(era);
+  RecoElectronCollectionSelectorTight tightElectronSelector(era);
+
+  RecoHadTauReader* hadTauReader = new RecoHadTauReader(era, Form("n%s", branchName_hadTaus.c_str()), branchName_hadTaus);
+  hadTauReader->setBranchAddresses(inputTree);
+  RecoHadTauCollectionCleaner hadTauCleaner(0.3);
+  RecoHadTauCollectionSelectorLoose preselHadTauSelector(era);
+  if ( hadTauSelection_part2 == "dR03mvaVLoose" || hadTauSelection_part2 == "dR03mvaVVLoose" ) preselHadTauSelector.set(hadTauSelection_part2);
+  preselHadTauSelector.set_min_antiElectron(-1);
+  preselHadTauSelector.set_min_antiMuon(-1);
+  RecoHadTauCollectionSelectorFakeable fakeableHadTauSelector(era);
+  if ( hadTauSelection_part2 == "dR03mvaVLoose" || hadTauSelection_part2 == "dR03mvaVVLoose" ) fakeableHadTauSelector.set(hadTauSelection_part2);
+  fakeableHadTauSelector.set_min_antiElectron(-1);
+  fakeableHadTauSelector.set_min_antiMuon(-1);
+  RecoHadTauCollectionSelectorTight tightHadTauSelector(era);
+  if ( hadTauSelection_part2 != "" ) tightHadTauSelector.set(hadTauSelection_part2);
+  tightHadTauSelector.set_min_antiElectron(-1);
+  tightHadTauSelector.set_min_antiMuon(-1);
+//--- lower thresholds on hadronic taus by 2 GeV with respect to thresholds applied on analysis level,
+//    to allow for tau-ES uncertainties to be estimated (same as in produceNtuple)
+  preselHadTauSelector.set_min_pt(18.);
+  fakeableHadTauSelector.set_min_pt(18.);
+  tightHadTauSelector.set_min_pt(18.);
+
+  RecoJetReader* jetReader = new RecoJetReader(era, isMC, Form("n%s", branchName_jets.c_str()), branchName_jets);
+  jetReader->setJetPt_central_or_shift(RecoJetReader::kJetPt_central);
+  jetReader->read_BtagWeight_systematics(isMC);
+  jetReader->setBranchAddresses(inputTree);
+  RecoJetCollectionCleaner jetCleaner(0.4);
+  RecoJetSelector jetSelector(era);
+  RecoJetCollectionSelectorBtagLoose jetSelectorBtagLoose(era);
+  RecoJetCollectionSelectorBtagMedium jetSelectorBtagMedium(era);
+
+//--- declare missing transverse energy
+  RecoMEtReader* metReader = new RecoMEtReader(era, branchName_met);
+  metReader->setBranchAddresses(inputTree);
+
+//--- declare generator level information;
+//    the generator level branches are not needed for the preselection, but are read by the analyze_* executables
+  GenLeptonReader* genLeptonReader = 0;
+  GenHadTauReader* genHadTauReader = 0;
+  GenJetReader* genJetReader = 0;
+  if ( isMC ) {
+    genLeptonReader = new GenLeptonReader(
+                                           Form("n%s", branchName_genLeptons1.c_str()),      branchName_genLeptons1,
+      ! branchName_genLeptons2.empty() ? Form("n%s", branchName_genLeptons2.c_str()) : "", branchName_genLeptons2
+    );
+    genLeptonReader->setBranchAddresses(inputTree);
+    genHadTauReader = new GenHadTauReader(Form("n%s", branchName_genHadTaus.c_str()), branchName_genHadTaus);
+    genHadTauReader->setBranchAddresses(inputTree);
+    genJetReader = new GenJetReader(Form("n%s", branchName_genJets.c_str()), branchName_genJets);
+    genJetReader->setBranchAddresses(inputTree);
+  }
+
+//--- load the first input file, so that the branch addresses set by the reader classes are applied to its TTree;
+//    the branches that have an address are kept in the output of every channel
+  inputTree->LoadTree(0);
+  std::set<std::string> readerBranches;
+  TObjArray* inputTree_branches = inputTree->GetListOfBranches();
+  for ( int idxBranch = 0; idxBranch < inputTree_branches->GetEntries(); ++idxBranch ) {
+    const TBranch* branch = dynamic_cast<const TBranch*>(inputTree_branches->At(idxBranch));
+    assert(branch);
+    if ( branch->GetAddress() ) readerBranches.insert(branch->GetName());
+  }
+
+//--- create the output TTrees as clones of the input TTree restricted to the branches to keep;
+//    TTree::CloneTree() clones only the active branches, and updates the addresses of the cloned branches whenever the TChain opens the next input file
+  std::set<std::string> branchesToRead = readerBranches;
+  for ( std::vector<skimChannelType*>::iterator channel = channels.begin();
+        channel != channels.end(); ++channel ) {
+    std::vector<outputCommandEntry> outputCommands = getOutputCommands((*channel)->outputCommands_);
+    (*channel)->isBranchToKeep_ = getBranchesToKeep(inputTree, outputCommands);
+    for ( std::set<std::string>::const_iterator readerBranch = readerBranches.begin();
+          readerBranch != readerBranches.end(); ++readerBranch ) {
+      (*channel)->isBranchToKeep_[*readerBranch] = true;
+    }
+    inputTree->SetBranchStatus("*", 0);
+    std::cout << "channel = " << (*channel)->name_ << ": keeping branches:" << std::endl;
+    for ( std::map<std::string, bool>::const_iterator branch = (*channel)->isBranchToKeep_.begin();
+          branch != (*channel)->isBranchToKeep_.end(); ++branch ) {
+      if ( !branch->second ) continue;
+      std::cout << " " << branch->first << std::endl;
+      inputTree->SetBranchStatus(branch->first.data(), 1);
+      branchesToRead.insert(branch->first);
+    }
+
+    (*channel)->outputFile_ = new TFile((*channel)->outputFileName_.data(), "RECREATE");
+    if ( !(*channel)->outputFile_ || (*channel)->outputFile_->IsZombie() ) {
+      throw cms::Exception("skimNtuple")
+        << "Failed to open output File = '" << (*channel)->outputFileName_ << "' !!\n";
+    }
+    (*channel)->outputFile_->cd();
+    (*channel)->outputTree_ = inputTree->CloneTree(0);
+    (*channel)->outputTree_->SetDirectory((*channel)->outputFile_);
+    (*channel)->outputTreeWriter_ = new TTreeOutputWriter((*channel)->outputTree_, outputCompression, outputCompressionLevel, outputAutoFlush, outputNumThreads);
+
+    (*channel)->manifestFile_ = new std::ofstream((*channel)->manifestFileName_.data(), std::ios::out);
+    if ( !(*channel)->manifestFile_->good() ) {
+      throw cms::Exception("skimNtuple")
+        << "Failed to open manifest File = '" << (*channel)->manifestFileName_ << "' !!\n";
+    }
+  }
+
+//--- read only the branches that are kept in the output of at least one channel
+  inputTree->SetBranchStatus("*", 0);
+  for ( std::set<std::string>::const_iterator branchToRead = branchesToRead.begin();
+        branchToRead != branchesToRead.end(); ++branchToRead ) {
+    inputTree->SetBranchStatus(branchToRead->data(), 1);
+  }
+
+  int numEntries = inputTree->GetEntries();
+  int analyzedEntries = 0;
+  int selectedEntries = 0;
+  for ( int idxEntry = 0; idxEntry < numEntries && (maxEvents == -1 || idxEntry < maxEvents); ++idxEntry ) {
+
+    inputTree->GetEntry(idxEntry);
+
+    if ( idxEntry > 0 && (idxEntry % reportEvery) == 0 ) {
+      std::cout << "processing Entry " << idxEntry << ":"
+                << " run = " << run << ", lumi = " << lumi << ", event = " << event
+                << " (" << selectedEntries << " Entries selected)" << std::endl;
+    }
+    ++analyzedEntries;
+
+    if ( run_lumi_eventSelector && !(*run_lumi_eventSelector)(run, lumi, event) ) continue;
+
+//--- build collections of electrons, muons and hadronic taus once for all channels;
+//    resolve overlaps in order of priority: muon, electron, hadronic tau
+    std::vector<RecoMuon> muons = muonReader->read();
+    std::vector<const RecoMuon*> muon_ptrs = convert_to_ptrs(muons);
+    std::vector<const RecoMuon*> preselMuons = preselMuonSelector(muon_ptrs);
+    std::vector<const RecoMuon*> fakeableMuons = fakeableMuonSelector(preselMuons);
+    std::vector<const RecoMuon*> tightMuons = tightMuonSelector(preselMuons);
+    std::vector<const RecoMuon*> selMuons;
+    if      ( leptonSelection == kLoose    ) selMuons = preselMuons;
+    else if ( leptonSelection == kFakeable ) selMuons = fakeableMuons;
+    else if ( leptonSelection == kTight    ) selMuons = tightMuons;
+    else assert(0);
+
+    std::vector<RecoElectron> electrons = electronReader->read();
+    std::vector<const RecoElectron*> electron_ptrs = convert_to_ptrs(electrons);
+    std::vector<const RecoElectron*> cleanedElectrons = electronCleaner(electron_ptrs, fakeableMuons);
+    std::vector<const RecoElectron*> preselElectrons = preselElectronSelector(cleanedElectrons);
+    std::vector<const RecoElectron*> fakeableElectrons = fakeableElectronSelector(preselElectrons);
+    std::vector<const RecoElectron*> tightElectrons = tightElectronSelector(preselElectrons);
+    std::vector<const RecoElectron*> selElectrons;
+    if      ( leptonSelection == kLoose    ) selElectrons = preselElectrons;
+    else if ( leptonSelection == kFakeable ) selElectrons = fakeableElectrons;
+    else if ( leptonSelection == kTight    ) selElectrons = tightElectrons;
+    else assert(0);
+
+    std::vector<RecoHadTau> hadTaus = hadTauReader->read();
+    std::vector<const RecoHadTau*> hadTau_ptrs = convert_to_ptrs(hadTaus);
+    std::vector<const RecoHadTau*> cleanedHadTaus = hadTauCleaner(hadTau_ptrs, preselMuons, preselElectrons);
+    std::vector<const RecoHadTau*> selHadTaus;
+    if      ( hadTauSelection == kLoose    ) selHadTaus = preselHadTauSelector(cleanedHadTaus);
+    else if ( hadTauSelection == kFakeable ) selHadTaus = fakeableHadTauSelector(cleanedHadTaus);
+    else if ( hadTauSelection == kTight    ) selHadTaus = tightHadTauSelector(cleanedHadTaus);
+    else assert(0);
+
+//--- build collections of jets and select subset of jets passing b-tagging criteria;
+//    jets are selected if they pass the pT threshold for the central value or for the JEC up or down shifts (same as in produceNtuple)
+    std::vector<RecoJet> jets = jetReader->read();
+    std::vector<const RecoJet*> jet_ptrs = convert_to_ptrs(jets);
+    std::vector<const RecoJet*> cleanedJets = jetCleaner(jet_ptrs, fakeableMuons, fakeableElectrons);
+    int numSelJets = 0;
+    for ( std::vector<const RecoJet*>::const_iterator cleanedJet = cleanedJets.begin();
+          cleanedJet != cleanedJets.end(); ++cleanedJet ) {
+      double cleanedJet_pt = (*cleanedJet)->pt();
+      double cleanedJet_pt_JECUp = cleanedJet_pt*((*cleanedJet)->corr_JECUp()/(*cleanedJet)->corr());
+      double cleanedJet_pt_JECDown = cleanedJet_pt*((*cleanedJet)->corr_JECDown()/(*cleanedJet)->corr());
+      double min_pT = jetSelector.get_min_pt();
+      if ( (cleanedJet_pt >= min_pT || cleanedJet_pt_JECUp >= min_pT || cleanedJet_pt_JECDown >= min_pT ) && (*cleanedJet)->absEta() < jetSelector.get_max_absEta() ) {
+        ++numSelJets;
+      }
+    }
+    int numSelBJets_loose = jetSelectorBtagLoose(cleanedJets).size();
+    int numSelBJets_medium = jetSelectorBtagMedium(cleanedJets).size();
+
+    const std::vector<const RecoLepton*> selLeptons = mergeLeptonCollections(selElectrons, selMuons);
+
+//--- apply the preselection of each channel
+    bool isSelected = false;
+    for ( std::vector<skimChannelType*>::iterator channel = channels.begin();
+          channel != channels.end(); ++channel ) {
+      if ( !(*channel)->isSelected(selLeptons.size(), selHadTaus.size(), numSelJets, numSelBJets_loose, numSelBJets_medium) ) continue;
+      (*channel)->outputTreeWriter_->fill();
+      (*(*channel)->manifestFile_) << run << ':' << lumi << ':' << event << ' ' << (*channel)->outputTree_->GetEntries() - 1 << ' '
+                                   << inputTree->GetFile()->GetName() << ' ' << inputTree->GetTree()->GetReadEntry() << '\n';
+      ++(*channel)->numSelected_;
+      isSelected = true;
+    }
+    if ( isSelected ) ++selectedEntries;
+  }
+
+  std::cout << "num. Entries = " << numEntries << std::endl;
+  std::cout << " analyzed = " << analyzedEntries << std::endl;
+  std::cout << " selected (by any channel) = " << selectedEntries << std::endl;
+  for ( std::vector<skimChannelType*>::const_iterator channel = channels.begin();
+        channel != channels.end(); ++channel ) {
+    std::cout << " selected (channel = " << (*channel)->name_ << ") = " << (*channel)->numSelected_ << std::endl;
+  }
+  for ( std::vector<skimChannelType*>::const_iterator channel = channels.begin();
+        channel != channels.end(); ++channel ) {
+    (*channel)->outputTreeWriter_->printStatistics(std::cout);
+  }
+
+//--- write the output TTrees before the input TChain is deleted, as the cloned TTrees are connected to it
+  for ( std::vector<skimChannelType*>::iterator channel = channels.begin();
+        channel != channels.end(); ++channel ) {
+    (*channel)->outputFile_->cd();
+    (*channel)->outputTree_->Write();
+  }
+  delete inputTree;
+
+  delete run_lumi_eventSelector;
+
+  delete muonReader;
+  delete electronReader;
+  delete hadTauReader;
+  delete jetReader;
+  delete metReader;
+  delete genLeptonReader;
+  delete genHadTauReader;
+  delete genJetReader;
+
+  for ( std::map<std::string, hltPath*>::iterator hltPath_ = hltPaths.begin();
+        hltPath_ != hltPaths.end(); ++hltPath_ ) {
+    delete hltPath_->second;
+  }
+
+//--- copy histograms keeping track of number of processed events from input files to the output file of each channel
+  std::cout << "copying histograms:" << std::endl;
+  std::map<std::string, TH1*> histograms;
+  for ( std::vector<std::string>::const_iterator inputFileName = inputFiles.files().begin();
+        inputFileName != inputFiles.files().end(); ++inputFileName ) {
+    TFile* inputFile = new TFile(inputFileName->data());
+    if ( !inputFile || inputFile->IsZombie() )
+      throw cms::Exception("skimNtuple")
+        << "Failed to open input File = '" << (*inputFileName) << "' !!\n";
+
+    for ( vstring::const_iterator histogramName = copy_histograms.begin();
+          histogramName != copy_histograms.end(); ++histogramName ) {
+      std::cout << " " << (*histogramName) << " from input File = '" << (*inputFileName) << "'" << std::endl;
+      TH1* histogram_input = dynamic_cast<TH1*>(inputFile->Get(histogramName->data()));
+      if ( !histogram_input ) continue;
+
+      TH1* histogram_output = histograms[*histogramName];
+      if ( histogram_output ) {
+        histogram_output->Add(histogram_input);
+      } else {
+        histogram_output = dynamic_cast<TH1*>(histogram_input->Clone());
+        assert(histogram_output);
+        histogram_output->SetDirectory(0);
+        histograms[*histogramName] = histogram_output;
+      }
+    }
+    delete inputFile;
+  }
+
+  for ( std::vector<skimChannelType*>::iterator channel = channels.begin();
+        channel != channels.end(); ++channel ) {
+    (*channel)->outputFile_->cd();
+    for ( std::map<std::string, TH1*>::const_iterator histogram = histograms.begin();
+          histogram != histograms.end(); ++histogram ) {
+      if ( histogram->second ) histogram->second->Write();
+    }
+    (*channel)->outputFile_->Close();
+    delete (*channel);
+  }
+  for ( std::map<std::string, TH1*>::iterator histogram = histograms.begin();
+        histogram != histograms.end(); ++histogram ) {
+    delete histogram->second;
+  }
+
+  clock.Show("skimNtuple");
+
+  return EXIT_SUCCESS;
+}
+
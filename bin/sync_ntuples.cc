@@ -12,6 +12,7 @@
 #include <TTree.h> // TTree
 #include <TBenchmark.h> // TBenchmark
 #include <TString.h> // TString, Form
+#include <TFileMerger.h> // TFileMerger
 
 #include "tthAnalysis/HiggsToTauTau/interface/RecoLepton.h" // RecoLepton
 #include "tthAnalysis/HiggsToTauTau/interface/RecoJet.h" // RecoJet
@@ -64,6 +65,12 @@
 
 
 #include <iostream> // std::cout
+#include <fstream> // std::ifstream, std::ofstream
+#include <cstdio> // std::fflush(), std::remove()
+
+#include <sys/types.h> // pid_t
+#include <sys/wait.h> // waitpid(), WIFEXITED(), WEXITSTATUS()
+#include <unistd.h> // fork()
 
 typedef math::PtEtaPhiMLorentzVector LV;
 typedef std::vector<std::string> vstring;
@@ -74,6 +81,26 @@ const int hadTauSelection_antiElectron = -1; // not applied
 const int hadTauSelection_antiMuon = -1; // not applied
 const bool apply_trigger_bits = false;
 
+namespace
+{
+  /**
+   * @brief Returns the name of the file written by a worker process,
+   *        e.g. sync.root -> sync_worker2.root
+   */
+  std::string
+  getWorkerFileName(const std::string & fileName,
+                    unsigned idxWorker)
+  {
+    const std::size_t pos_slash = fileName.find_last_of('/');
+    const std::size_t pos_dot = fileName.find_last_of('.');
+    const bool has_extension = pos_dot != std::string::npos &&
+                               (pos_slash == std::string::npos || pos_dot > pos_slash);
+    const std::string base = has_extension ? fileName.substr(0, pos_dot) : fileName;
+    const std::string extension = has_extension ? fileName.substr(pos_dot) : "";
+    return Form("%s_worker%u%s", base.data(), idxWorker, extension.data());
+  }
+}
+
 /**
  * @brief Produce datacard and control plots for 2lss_1tau categories.
  */
@@ -177,7 +204,7 @@ int main(int argc, char* argv[])
   bool apply_offline_e_trigger_cuts_3mu = cfg_analyze.getParameter<bool>("apply_offline_e_trigger_cuts_3mu");*/
 
   const std::string selEventsFileName_input = cfg_analyze.getParameter<std::string>("selEventsFileName_input");
-  const std::string selEventsFileName_output = cfg_analyze.getParameter<std::string>("selEventsFileName_output");
+  std::string selEventsFileName_output = cfg_analyze.getParameter<std::string>("selEventsFileName_output");
   std::cout << "selEventsFileName_input = "  << selEventsFileName_input  << '\n'
             << "selEventsFileName_output = " << selEventsFileName_output << '\n';
 
@@ -213,7 +240,91 @@ int main(int argc, char* argv[])
   const unsigned reportEvery = inputFiles.reportAfter();
 
   fwlite::OutputFiles outputFile(cfg);
-  const std::string outputFileName = outputFile.file();
+  std::string outputFileName = outputFile.file();
+
+//--- split the input entries into contiguous ranges, each processed by a separate worker process that writes its own sync Ntuple;
+//    the workers are forked processes rather than threads, as some of the readers (e.g. RecoHadTauReader and RecoMEtReader)
+//    share their branch buffers through per-process static registries and cannot be instantiated for different input trees concurrently
+  const unsigned numWorkers = cfg_analyze.exists("numWorkers") ? cfg_analyze.getParameter<unsigned>("numWorkers") : 1;
+  int firstEntry = 0;
+  int lastEntry = -1; // process all entries
+  if ( numWorkers > 1 ) {
+    int numEntries_total = 0;
+    {
+      TChain inputTree_count(treeName.data());
+      for ( const std::string & inputFileName: inputFiles.files() ) {
+        inputTree_count.AddFile(inputFileName.c_str());
+      }
+      numEntries_total = inputTree_count.GetEntries();
+    }
+    if ( maxEvents != -1 && numEntries_total > maxEvents ) numEntries_total = maxEvents;
+    std::cout << "processing " << numEntries_total << " Entries in " << numWorkers << " worker processes\n";
+
+    std::vector<pid_t> workerPIDs;
+    std::vector<std::string> workerOutputFileNames;
+    std::vector<std::string> workerSelEventsFileNames;
+    int idxWorker = -1;
+    for ( unsigned idxWorker_fork = 0; idxWorker_fork < numWorkers; ++idxWorker_fork ) {
+      workerOutputFileNames.push_back(getWorkerFileName(outputFileName, idxWorker_fork));
+      workerSelEventsFileNames.push_back(selEventsFileName_output != "" ? getWorkerFileName(selEventsFileName_output, idxWorker_fork) : "");
+      std::cout.flush();
+      std::fflush(stdout);
+      const pid_t pid = fork();
+      if ( pid < 0 ) {
+        throw cms::Exception(argv[0]) << "Failed to fork worker process #" << idxWorker_fork << " !!\n";
+      } else if ( pid == 0 ) {
+        idxWorker = idxWorker_fork;
+        break;
+      }
+      workerPIDs.push_back(pid);
+    }
+
+    if ( idxWorker >= 0 ) {
+//--- worker process: continue with the event loop below for its range of entries
+      firstEntry = (static_cast<long long>(numEntries_total) * idxWorker) / numWorkers;
+      lastEntry = (static_cast<long long>(numEntries_total) * (idxWorker + 1)) / numWorkers;
+      outputFileName = workerOutputFileNames[idxWorker];
+      selEventsFileName_output = workerSelEventsFileNames[idxWorker];
+      std::cout << "worker #" << idxWorker << ": processing Entries " << firstEntry << " to " << (lastEntry - 1) << '\n';
+    } else {
+//--- parent process: wait for the workers to finish, then merge their sync Ntuples and lists of selected events
+      for ( unsigned idxWorker_wait = 0; idxWorker_wait < workerPIDs.size(); ++idxWorker_wait ) {
+        int status = 0;
+        if ( waitpid(workerPIDs[idxWorker_wait], &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS ) {
+          throw cms::Exception(argv[0]) << "Worker process #" << idxWorker_wait << " failed !!\n";
+        }
+      }
+
+      TFileMerger merger(false);
+      merger.OutputFile(outputFileName.data(), "RECREATE");
+      for ( const std::string & workerOutputFileName: workerOutputFileNames ) {
+        merger.AddFile(workerOutputFileName.data());
+      }
+      if ( !merger.Merge() ) {
+        throw cms::Exception(argv[0]) << "Failed to merge the output files of the worker processes !!\n";
+      }
+      for ( const std::string & workerOutputFileName: workerOutputFileNames ) {
+        std::remove(workerOutputFileName.data());
+      }
+
+      if ( selEventsFileName_output != "" ) {
+        std::ofstream selEventsFile(selEventsFileName_output.data(), std::ios::out);
+        for ( const std::string & workerSelEventsFileName: workerSelEventsFileNames ) {
+          std::ifstream workerSelEventsFile(workerSelEventsFileName.data());
+          if ( workerSelEventsFile.peek() != std::ifstream::traits_type::eof() ) {
+            selEventsFile << workerSelEventsFile.rdbuf();
+          }
+          workerSelEventsFile.close();
+          std::remove(workerSelEventsFileName.data());
+        }
+      }
+      std::cout << "Wrote file = " << outputFileName << '\n';
+
+      clock.Show(argv[0]);
+
+      return EXIT_SUCCESS;
+    }
+  }
 
   TChain* inputTree = new TChain(treeName.data());
   for(const std::string & inputFileName: inputFiles.files())
@@ -521,7 +632,7 @@ int main(int argc, char* argv[])
   int analyzedEntries = 0;
   int selectedEntries = 0;
 
-  for ( int idxEntry = 0; idxEntry < numEntries && (maxEvents == -1 || idxEntry < maxEvents); ++idxEntry ) {
+  for ( int idxEntry = firstEntry; idxEntry < numEntries && (maxEvents == -1 || idxEntry < maxEvents) && (lastEntry == -1 || idxEntry < lastEntry); ++idxEntry ) {
     if ( idxEntry > 0 && (idxEntry % reportEvery) == 0) {
       std::cout << "processing Entry " << idxEntry << " (" << selectedEntries << " Entries selected)\n";
     }
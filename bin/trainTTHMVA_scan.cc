@@ -0,0 +1,526 @@
+
+/** \executable trainTTHMVA_scan
+ *
+ * Train several MVA configurations (e.g. the points of a hyper-parameter scan) on the same training sample,
+ * and compare their ROC integrals.
+ *
+ * The input variables and spectators are read from the signal and background Trees only once,
+ * into an in-memory feature matrix, which is optionally cached in a ROOT file for subsequent invocations.
+ * The split of events into training and test samples is the same for all configurations.
+ * The configurations are trained in parallel processes, each with its own TMVA::Factory and output file
+ * (forked processes rather than threads, as TMVA trainings are not thread-safe).
+ *
+ */
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/PythonParameterSet/interface/MakeParameterSets.h"
+
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include "DataFormats/FWLite/interface/InputSource.h"
+
+#include "tthAnalysis/HiggsToTauTau/interface/plottingAuxFunctions.h" // forkWorkerProcesses(), waitForWorkerProcesses()
+
+#include "TMVA/Factory.h"
+#include "TMVA/Tools.h"
+#include <RVersion.h> // ROOT_VERSION_CODE, ROOT_VERSION()
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,8,0)
+#include "TMVA/DataLoader.h"
+#endif
+
+#include <TFile.h>
+#include <TChain.h>
+#include <TTree.h>
+#include <TTreeFormula.h>
+#include <TBenchmark.h>
+#include <TString.h>
+#include <TCut.h>
+#include <TList.h>
+#include <TObjString.h>
+#include <TRandom3.h>
+#include <TParameter.h>
+#include <TSystem.h>
+#include <TError.h> // gErrorAbortLevel, kError
+
+#include <iostream>
+#include <fstream>
+#include <sstream> // std::ostringstream
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <algorithm> // std::copy(), std::sort()
+#include <exception> // std::exception_ptr
+#include <assert.h>
+
+typedef std::vector<std::string> vstring;
+
+struct featureMatrix
+{
+  featureMatrix() {}
+  ~featureMatrix() {}
+  std::vector<std::vector<Double_t> > rows_; // values of input variables, followed by values of spectator variables
+  std::vector<Double_t> weights_;
+  std::vector<bool> isTraining_;
+};
+
+void fillFeatureMatrix(TChain* chain, const vstring& expressions, const std::string& selection, const std::string& weightExpression, featureMatrix& matrix)
+{
+  std::cout << "<fillFeatureMatrix>: reading " << chain->GetEntries() << " entries of Tree = " << chain->GetName() << std::endl;
+  std::vector<TTreeFormula*> formulas;
+  for ( size_t idxExpression = 0; idxExpression < expressions.size(); ++idxExpression ) {
+    formulas.push_back(new TTreeFormula(Form("feature%i", (int)idxExpression), expressions[idxExpression].data(), chain));
+  }
+  TTreeFormula* selectionFormula = ( selection != "" ) ? new TTreeFormula("selection", selection.data(), chain) : 0;
+  TTreeFormula* weightFormula = ( weightExpression != "" ) ? new TTreeFormula("weight", weightExpression.data(), chain) : 0;
+
+  int treeNumber = -1;
+  Long64_t numEntries = chain->GetEntries();
+  for ( Long64_t idxEntry = 0; idxEntry < numEntries; ++idxEntry ) {
+    chain->LoadTree(idxEntry);
+    if ( chain->GetTreeNumber() != treeNumber ) {
+      // the leaves referenced by the formulas change when TChain switches to the next file
+      for ( std::vector<TTreeFormula*>::iterator formula = formulas.begin();
+	    formula != formulas.end(); ++formula ) {
+	(*formula)->UpdateFormulaLeaves();
+      }
+      if ( selectionFormula ) selectionFormula->UpdateFormulaLeaves();
+      if ( weightFormula ) weightFormula->UpdateFormulaLeaves();
+      treeNumber = chain->GetTreeNumber();
+    }
+    if ( selectionFormula && !(selectionFormula->GetNdata() > 0 && selectionFormula->EvalInstance() != 0.) ) continue;
+    std::vector<Double_t> row;
+    for ( std::vector<TTreeFormula*>::iterator formula = formulas.begin();
+	  formula != formulas.end(); ++formula ) {
+      (*formula)->GetNdata();
+      row.push_back((*formula)->EvalInstance());
+    }
+    matrix.rows_.push_back(row);
+    double weight = 1.;
+    if ( weightFormula ) {
+      weightFormula->GetNdata();
+      weight = weightFormula->EvalInstance();
+    }
+    matrix.weights_.push_back(weight);
+  }
+
+  for ( std::vector<TTreeFormula*>::iterator formula = formulas.begin();
+	formula != formulas.end(); ++formula ) {
+    delete (*formula);
+  }
+  delete selectionFormula;
+  delete weightFormula;
+  std::cout << " selected " << matrix.rows_.size() << " entries" << std::endl;
+}
+
+void writeFeatureMatrix(const featureMatrix& matrix, const std::string& treeName, const vstring& expressions)
+{
+  int numFeatures = expressions.size();
+  std::vector<Double_t> features(numFeatures);
+  Double_t weight;
+  TTree* tree = new TTree(treeName.data(), treeName.data());
+  tree->Branch("features", features.data(), Form("features[%i]/D", numFeatures));
+  tree->Branch("weight", &weight, "weight/D");
+  for ( vstring::const_iterator expression = expressions.begin();
+	expression != expressions.end(); ++expression ) {
+    tree->GetUserInfo()->Add(new TObjString(expression->data()));
+  }
+  for ( size_t idxRow = 0; idxRow < matrix.rows_.size(); ++idxRow ) {
+    std::copy(matrix.rows_[idxRow].begin(), matrix.rows_[idxRow].end(), features.begin());
+    weight = matrix.weights_[idxRow];
+    tree->Fill();
+  }
+  tree->Write();
+}
+
+bool readFeatureMatrix(TFile* cacheFile, const std::string& treeName, const vstring& expressions, featureMatrix& matrix)
+{
+  TTree* tree = dynamic_cast<TTree*>(cacheFile->Get(treeName.data()));
+  if ( !tree ) return false;
+  // check that the cache file has been written for the same input and spectator variables
+  TList* userInfo = tree->GetUserInfo();
+  if ( userInfo->GetEntries() != (int)expressions.size() ) return false;
+  for ( size_t idxExpression = 0; idxExpression < expressions.size(); ++idxExpression ) {
+    TObjString* expression = dynamic_cast<TObjString*>(userInfo->At(idxExpression));
+    if ( !expression || expression->GetString() != expressions[idxExpression].data() ) return false;
+  }
+  int numFeatures = expressions.size();
+  std::vector<Double_t> features(numFeatures);
+  Double_t weight;
+  tree->SetBranchAddress("features", features.data());
+  tree->SetBranchAddress("weight", &weight);
+  Long64_t numEntries = tree->GetEntries();
+  for ( Long64_t idxEntry = 0; idxEntry < numEntries; ++idxEntry ) {
+    tree->GetEntry(idxEntry);
+    matrix.rows_.push_back(features);
+    matrix.weights_.push_back(weight);
+  }
+  std::cout << "<readFeatureMatrix>: read " << matrix.rows_.size() << " entries of Tree = " << treeName << std::endl;
+  return true;
+}
+
+void splitTrainingAndTest(featureMatrix& matrix, TRandom3& rnd)
+{
+  matrix.isTraining_.clear();
+  for ( size_t idxRow = 0; idxRow < matrix.rows_.size(); ++idxRow ) {
+    matrix.isTraining_.push_back(rnd.Rndm() < 0.5);
+  }
+}
+
+// compute the area under the curve of background rejection versus signal efficiency,
+// from the TestTree written by TMVA; computed here in order not to depend on the TMVA version
+double compROCIntegral(TTree* testTree, const std::string& methodName)
+{
+  Int_t classID;
+  Float_t weight;
+  Float_t mvaOutput;
+  testTree->SetBranchAddress("classID", &classID);
+  testTree->SetBranchAddress("weight", &weight);
+  testTree->SetBranchAddress(methodName.data(), &mvaOutput);
+  std::vector<std::pair<Float_t, std::pair<bool, Float_t> > > entries; // (MVA output, (isSignal, weight))
+  double sumWeights_signal = 0.;
+  double sumWeights_background = 0.;
+  Long64_t numEntries = testTree->GetEntries();
+  for ( Long64_t idxEntry = 0; idxEntry < numEntries; ++idxEntry ) {
+    testTree->GetEntry(idxEntry);
+    bool isSignal = ( classID == 0 ); // signal events are added first, so that TMVA assigns classID = 0 to signal
+    entries.push_back(std::make_pair(mvaOutput, std::make_pair(isSignal, weight)));
+    if ( isSignal ) sumWeights_signal += weight;
+    else sumWeights_background += weight;
+  }
+  testTree->ResetBranchAddresses();
+  if ( !(sumWeights_signal > 0. && sumWeights_background > 0.) ) return -1.;
+  std::sort(entries.begin(), entries.end());
+  // scan the cut on the MVA output from high to low values
+  double rocIntegral = 0.;
+  double effSignal = 0.;
+  double effBackground = 0.;
+  for ( std::vector<std::pair<Float_t, std::pair<bool, Float_t> > >::const_reverse_iterator entry = entries.rbegin();
+	entry != entries.rend(); ++entry ) {
+    if ( entry->second.first ) {
+      double effSignal_next = effSignal + entry->second.second/sumWeights_signal;
+      rocIntegral += (effSignal_next - effSignal)*(1. - effBackground);
+      effSignal = effSignal_next;
+    } else {
+      effBackground += entry->second.second/sumWeights_background;
+    }
+  }
+  return rocIntegral;
+}
+
+struct mvaConfiguration
+{
+  mvaConfiguration(const edm::ParameterSet& cfg)
+    : name_(cfg.getParameter<std::string>("name")),
+      mvaMethodType_(cfg.getParameter<std::string>("mvaMethodType")),
+      mvaTrainingOptions_(cfg.getParameter<std::string>("mvaTrainingOptions")),
+      rocIntegral_(-1.),
+      trainingTime_(0.)
+  {}
+  ~mvaConfiguration() {}
+  std::string name_;
+  std::string mvaMethodType_;
+  std::string mvaTrainingOptions_;
+  std::string outputFileName_;
+  double rocIntegral_;
+  double trainingTime_;
+  std::exception_ptr exception_;
+};
+
+template <typename T>
+void addEvents(T* loader, const featureMatrix& signal, const featureMatrix& background)
+{
+  for ( size_t idxRow = 0; idxRow < signal.rows_.size(); ++idxRow ) {
+    if ( signal.isTraining_[idxRow] ) loader->AddSignalTrainingEvent(signal.rows_[idxRow], signal.weights_[idxRow]);
+    else loader->AddSignalTestEvent(signal.rows_[idxRow], signal.weights_[idxRow]);
+  }
+  for ( size_t idxRow = 0; idxRow < background.rows_.size(); ++idxRow ) {
+    if ( background.isTraining_[idxRow] ) loader->AddBackgroundTrainingEvent(background.rows_[idxRow], background.weights_[idxRow]);
+    else loader->AddBackgroundTestEvent(background.rows_[idxRow], background.weights_[idxRow]);
+  }
+}
+
+std::string getJobName(const std::string& mvaName, const mvaConfiguration& configuration)
+{
+  return Form("%s_%s", mvaName.data(), configuration.name_.data());
+}
+
+std::string getTestTreeName(const std::string& jobName)
+{
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,8,0)
+  return Form("%s/TestTree", jobName.data());
+#else
+  return "TestTree";
+#endif
+}
+
+void trainMVA(mvaConfiguration& configuration, const std::string& mvaName,
+	      const vstring& inputVariableNames, const std::vector<char>& inputVariableTypes, const vstring& spectatorVariableNames,
+	      const featureMatrix& signal, const featureMatrix& background, bool isSilent)
+{
+  try {
+    TBenchmark clock;
+    clock.Start(configuration.name_.data());
+    std::string jobName = getJobName(mvaName, configuration);
+    TFile* outputFile = new TFile(configuration.outputFileName_.data(), "RECREATE");
+    std::string factoryOptions = ( isSilent ) ? "!V:Silent:!DrawProgressBar:AnalysisType=Classification" : "!V:!Silent:AnalysisType=Classification";
+    TMVA::Factory* factory = new TMVA::Factory(jobName.data(), outputFile, factoryOptions.data());
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,8,0)
+    TMVA::DataLoader* loader = new TMVA::DataLoader(jobName.data());
+#else
+    TMVA::Factory* loader = factory;
+#endif
+    for ( size_t idxVariable = 0; idxVariable < inputVariableNames.size(); ++idxVariable ) {
+      loader->AddVariable(inputVariableNames[idxVariable].data(), inputVariableTypes[idxVariable]);
+    }
+    for ( vstring::const_iterator spectatorVariableName = spectatorVariableNames.begin();
+	  spectatorVariableName != spectatorVariableNames.end(); ++spectatorVariableName ) {
+      loader->AddSpectator(spectatorVariableName->data());
+    }
+    addEvents(loader, signal, background);
+    // events have been assigned to training and test samples by splitTrainingAndTest already
+    loader->PrepareTrainingAndTestTree(TCut(""), "NormMode=NumEvents:!V");
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,8,0)
+    factory->BookMethod(loader, configuration.mvaMethodType_.data(), configuration.name_.data(), configuration.mvaTrainingOptions_.data());
+#else
+    factory->BookMethod(configuration.mvaMethodType_.data(), configuration.name_.data(), configuration.mvaTrainingOptions_.data());
+#endif
+    factory->TrainAllMethods();
+    factory->TestAllMethods();
+    factory->EvaluateAllMethods();
+    TTree* testTree = dynamic_cast<TTree*>(outputFile->Get(getTestTreeName(jobName).data()));
+    if ( testTree ) configuration.rocIntegral_ = compROCIntegral(testTree, configuration.name_);
+    delete factory;
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,8,0)
+    delete loader;
+#endif
+    clock.Stop(configuration.name_.data());
+    configuration.trainingTime_ = clock.GetRealTime(configuration.name_.data());
+    // store the training time in the output file, so that it can be read back by the parent process
+    outputFile->cd();
+    TParameter<double>("trainingTime", configuration.trainingTime_).Write();
+    delete outputFile;
+  } catch ( ... ) {
+    configuration.exception_ = std::current_exception();
+  }
+}
+
+void readTrainingResults(mvaConfiguration& configuration, const std::string& mvaName)
+{
+  TFile* outputFile = new TFile(configuration.outputFileName_.data());
+  TTree* testTree = dynamic_cast<TTree*>(outputFile->Get(getTestTreeName(getJobName(mvaName, configuration)).data()));
+  if ( testTree ) configuration.rocIntegral_ = compROCIntegral(testTree, configuration.name_);
+  TParameter<double>* trainingTime = dynamic_cast<TParameter<double>*>(outputFile->Get("trainingTime"));
+  if ( trainingTime ) configuration.trainingTime_ = trainingTime->GetVal();
+  delete outputFile;
+}
+
+int main(int argc, char* argv[])
+{
+//--- throw an exception in case ROOT encounters an error
+  gErrorAbortLevel = kError;
+
+//--- parse command-line arguments
+  if ( argc < 2 ) {
+    std::cout << "Usage: " << argv[0] << " [parameters.py]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "<trainTTHMVA_scan>:" << std::endl;
+
+//--- keep track of time it takes the macro to execute
+  TBenchmark clock;
+  clock.Start("trainTTHMVA_scan");
+
+//--- read python configuration parameters
+  if ( !edm::readPSetsFrom(argv[1])->existsAs<edm::ParameterSet>("process") )
+    throw cms::Exception("trainTTHMVA_scan")
+      << "No ParameterSet 'process' found in configuration file = " << argv[1] << " !!\n";
+
+  edm::ParameterSet cfg = edm::readPSetsFrom(argv[1])->getParameter<edm::ParameterSet>("process");
+
+  edm::ParameterSet cfgTrainTTHMVA = cfg.getParameter<edm::ParameterSet>("trainTTHMVA_scan");
+
+  std::string treeName = cfgTrainTTHMVA.getParameter<std::string>("treeName");
+
+  std::string signalDirPath = cfgTrainTTHMVA.getParameter<std::string>("signalDirPath");
+  std::string backgroundDirPath = cfgTrainTTHMVA.getParameter<std::string>("backgroundDirPath");
+  std::string backgroundDirPath2 = cfgTrainTTHMVA.getUntrackedParameter<std::string>("backgroundDirPath2", "");
+  std::string preselection = cfgTrainTTHMVA.getUntrackedParameter<std::string>("preselection", "");
+  std::string signalPreselection = cfgTrainTTHMVA.getUntrackedParameter<std::string>("signalPreselection", "");
+
+  vstring inputVariables = cfgTrainTTHMVA.getParameter<vstring>("inputVariables");
+
+  vstring spectatorVariables = cfgTrainTTHMVA.getParameter<vstring>("spectatorVariables");
+
+  std::string branchNameEvtWeight = cfgTrainTTHMVA.getParameter<std::string>("branchNameEvtWeight");
+
+  std::string mvaName = cfgTrainTTHMVA.getParameter<std::string>("mvaName");
+  std::vector<mvaConfiguration> mvaConfigurations;
+  edm::VParameterSet cfgMVAConfigurations = cfgTrainTTHMVA.getParameter<edm::VParameterSet>("mvaConfigurations");
+  for ( edm::VParameterSet::const_iterator cfgMVAConfiguration = cfgMVAConfigurations.begin();
+	cfgMVAConfiguration != cfgMVAConfigurations.end(); ++cfgMVAConfiguration ) {
+    mvaConfigurations.push_back(mvaConfiguration(*cfgMVAConfiguration));
+  }
+  if ( mvaConfigurations.empty() )
+    throw cms::Exception("trainTTHMVA_scan")
+      << "No MVA configurations to train !!\n";
+
+  unsigned numProcesses = cfgTrainTTHMVA.getParameter<unsigned>("numProcesses");
+  if ( numProcesses < 1 ) numProcesses = 1;
+  bool isSilent = ( cfgTrainTTHMVA.exists("isSilent") ) ? cfgTrainTTHMVA.getParameter<bool>("isSilent") : false;
+  std::string featureCacheFileName = cfgTrainTTHMVA.getParameter<std::string>("featureCacheFileName");
+  unsigned splitSeed = cfgTrainTTHMVA.getParameter<unsigned>("splitSeed");
+
+  fwlite::InputSource inputFiles(cfg);
+
+  std::string outputFileName = cfgTrainTTHMVA.getParameter<std::string>("outputFileName");
+  std::cout << " outputFileName = " << outputFileName << std::endl;
+  std::string reportFileName = cfgTrainTTHMVA.getParameter<std::string>("reportFileName");
+
+//--- determine names and types of input and spectator variables
+  vstring inputVariableNames;
+  std::vector<char> inputVariableTypes;
+  for ( vstring::const_iterator inputVariable = inputVariables.begin();
+	inputVariable != inputVariables.end(); ++inputVariable ) {
+    unsigned int idx = inputVariable->find_last_of("/");
+    if ( idx == (inputVariable->length() - 2) ) {
+      inputVariableNames.push_back(std::string(*inputVariable, 0, idx));
+      inputVariableTypes.push_back((*inputVariable)[idx + 1]);
+    } else {
+      throw cms::Exception("trainTTHMVA_scan")
+	<< "Failed to determine name & type for inputVariable = " << (*inputVariable) << " !!\n";
+    }
+  }
+  vstring spectatorVariableNames;
+  for ( vstring::const_iterator spectatorVariable = spectatorVariables.begin();
+	spectatorVariable != spectatorVariables.end(); ++spectatorVariable ) {
+    int idxSpectatorVariable = spectatorVariable->find_last_of("/");
+    std::string spectatorVariableName = std::string(*spectatorVariable, 0, idxSpectatorVariable);
+    bool isInputVariable = false;
+    for ( vstring::const_iterator inputVariableName = inputVariableNames.begin();
+	  inputVariableName != inputVariableNames.end(); ++inputVariableName ) {
+      if ( spectatorVariableName == (*inputVariableName) ) isInputVariable = true;
+    }
+    if ( !isInputVariable ) {
+      spectatorVariableNames.push_back(spectatorVariableName);
+    }
+  }
+  vstring expressions = inputVariableNames;
+  expressions.insert(expressions.end(), spectatorVariableNames.begin(), spectatorVariableNames.end());
+
+//--- read input and spectator variables into feature matrix,
+//    either from the cache file or from the signal and background Trees
+  featureMatrix signal;
+  featureMatrix background;
+  bool isCached = false;
+  if ( featureCacheFileName != "" && !gSystem->AccessPathName(featureCacheFileName.data()) ) {
+    TFile* cacheFile = new TFile(featureCacheFileName.data());
+    isCached = readFeatureMatrix(cacheFile, "signal", expressions, signal) && readFeatureMatrix(cacheFile, "background", expressions, background);
+    delete cacheFile;
+    if ( !isCached ) {
+      std::cout << "Warning: cache file = " << featureCacheFileName << " has been written for different variables, ignoring it !!" << std::endl;
+      signal = featureMatrix();
+      background = featureMatrix();
+    }
+  }
+  if ( !isCached ) {
+    TChain* tree_signal = new TChain((signalDirPath+'/'+treeName).data());
+    TChain* tree_background = new TChain((backgroundDirPath+'/'+treeName).data());
+    TChain* tree_background2 = new TChain((backgroundDirPath2+'/'+treeName).data());
+    for ( vstring::const_iterator inputFileName = inputFiles.files().begin();
+	  inputFileName != inputFiles.files().end(); ++inputFileName ) {
+      std::cout << "signal Tree: adding file = " << (*inputFileName) << std::endl;
+      tree_signal->AddFile(inputFileName->data());
+      std::cout << "background Tree: adding file = " << (*inputFileName) << std::endl;
+      tree_background->AddFile(inputFileName->data());
+      if ( backgroundDirPath2 != "" ) tree_background2->AddFile(inputFileName->data());
+    }
+    if ( !(tree_signal->GetListOfFiles()->GetEntries() >= 1) ) {
+      throw cms::Exception("trainTTHMVA_scan")
+	<< "Failed to identify signal Tree !!\n";
+    }
+    if ( !(tree_background->GetListOfFiles()->GetEntries() >= 1) ) {
+      throw cms::Exception("trainTTHMVA_scan")
+	<< "Failed to identify background Tree !!\n";
+    }
+
+    std::string signalSelection = preselection;
+    if ( signalPreselection != "" ) {
+      signalSelection = ( signalSelection != "" ) ? Form("(%s) && (%s)", signalSelection.data(), signalPreselection.data()) : signalPreselection;
+    }
+    fillFeatureMatrix(tree_signal, expressions, signalSelection, branchNameEvtWeight, signal);
+    fillFeatureMatrix(tree_background, expressions, preselection, branchNameEvtWeight, background);
+    if ( backgroundDirPath2 != "" ) fillFeatureMatrix(tree_background2, expressions, preselection, branchNameEvtWeight, background);
+
+    delete tree_signal;
+    delete tree_background;
+    delete tree_background2;
+
+    if ( featureCacheFileName != "" ) {
+      std::cout << "writing feature matrix to cache file = " << featureCacheFileName << std::endl;
+      TFile* cacheFile = new TFile(featureCacheFileName.data(), "RECREATE");
+      writeFeatureMatrix(signal, "signal", expressions);
+      writeFeatureMatrix(background, "background", expressions);
+      delete cacheFile;
+    }
+  }
+  if ( signal.rows_.empty() || background.rows_.empty() )
+    throw cms::Exception("trainTTHMVA_scan")
+      << "No signal or background events selected !!\n";
+
+//--- use the same split into training and test samples for all MVA configurations,
+//    so that their ROC integrals can be compared
+  TRandom3 rnd(splitSeed);
+  splitTrainingAndTest(signal, rnd);
+  splitTrainingAndTest(background, rnd);
+
+//--- train MVA configurations in parallel processes,
+//    each with its own TMVA::Factory and output file;
+//    the processes are forked rather than threads, as TMVA trainings are not thread-safe
+  for ( std::vector<mvaConfiguration>::iterator configuration = mvaConfigurations.begin();
+	configuration != mvaConfigurations.end(); ++configuration ) {
+    configuration->outputFileName_ = TString(outputFileName.data()).ReplaceAll(".root", Form("_%s.root", configuration->name_.data())).Data();
+  }
+  std::cout << "training " << mvaConfigurations.size() << " MVA configurations in " << numProcesses << " process(es)" << std::endl;
+  std::vector<int> workerPIDs;
+  unsigned idxProcess = 0;
+  if ( numProcesses > 1 ) idxProcess = forkWorkerProcesses(numProcesses, workerPIDs);
+  TMVA::Tools::Instance();
+  for ( size_t idxConfiguration = idxProcess; idxConfiguration < mvaConfigurations.size(); idxConfiguration += numProcesses ) {
+    trainMVA(mvaConfigurations[idxConfiguration], mvaName, inputVariableNames, inputVariableTypes, spectatorVariableNames, signal, background, isSilent);
+  }
+  TMVA::Tools::DestroyInstance();
+  if ( idxProcess != 0 ) {
+//--- worker process: the results are passed to the parent process via the output files
+    for ( size_t idxConfiguration = idxProcess; idxConfiguration < mvaConfigurations.size(); idxConfiguration += numProcesses ) {
+      if ( mvaConfigurations[idxConfiguration].exception_ ) std::rethrow_exception(mvaConfigurations[idxConfiguration].exception_);
+    }
+    return EXIT_SUCCESS;
+  }
+  waitForWorkerProcesses(workerPIDs);
+  for ( size_t idxConfiguration = 0; idxConfiguration < mvaConfigurations.size(); ++idxConfiguration ) {
+    if ( (idxConfiguration % numProcesses) != idxProcess ) readTrainingResults(mvaConfigurations[idxConfiguration], mvaName);
+  }
+
+//--- summarize ROC integrals of all MVA configurations
+  std::ostringstream report;
+  report << "ROC integrals (" << signal.rows_.size() << " signal, " << background.rows_.size() << " background events):" << std::endl;
+  for ( std::vector<mvaConfiguration>::const_iterator configuration = mvaConfigurations.begin();
+	configuration != mvaConfigurations.end(); ++configuration ) {
+    if ( configuration->exception_ ) std::rethrow_exception(configuration->exception_);
+    report << " " << std::setw(30) << std::left << configuration->name_ << " " << configuration->mvaMethodType_
+	   << ": ROC integral = " << std::setprecision(4) << std::fixed << configuration->rocIntegral_
+	   << " (training time = " << std::setprecision(1) << configuration->trainingTime_ << " s)"
+	   << ", output file = " << configuration->outputFileName_ << std::endl;
+    report << "  options = " << configuration->mvaTrainingOptions_ << std::endl;
+  }
+  std::cout << report.str();
+  if ( reportFileName != "" ) {
+    std::ofstream reportFile(reportFileName.data(), std::ios::out);
+    reportFile << report.str();
+  }
+
+  clock.Show("trainTTHMVA_scan");
+
+  return 0;
+}
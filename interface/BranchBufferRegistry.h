@@ -0,0 +1,171 @@
+#ifndef BRANCHBUFFERREGISTRY_H
+#define BRANCHBUFFERREGISTRY_H
+
+#include <string> // std::string
+#include <map> // std::map<,>
+#include <memory> // std::unique_ptr<>, std::shared_ptr<>
+#include <typeindex> // std::type_index
+#include <typeinfo> // typeid()
+
+#include <TTree.h> // TTree
+
+#include <FWCore/Utilities/interface/Exception.h> // cms::Exception
+
+/**
+ * @brief Owns the buffers into which the branches of an input TTree are read
+ *
+ * Readers request typed buffers by branch name. Identical requests (e.g. by RecoElectronReader
+ * and RecoMuonReader, which read the same lepton branches) are served by one buffer and
+ * one TTree::SetBranchAddress() call, so that each branch is decompressed into memory only once.
+ */
+class BranchBufferRegistry
+{
+public:
+  BranchBufferRegistry();
+  ~BranchBufferRegistry();
+
+  BranchBufferRegistry(const BranchBufferRegistry &) = delete;
+  BranchBufferRegistry & operator=(const BranchBufferRegistry &) = delete;
+
+  /**
+   * @brief Binds the buffers requested so far, and the ones requested afterwards, to the branches of a tree
+   * @param tree The input tree, or nullptr to unbind the buffers
+   *
+   * @note The buffers, and hence the pointers handed out to the readers, stay the same
+   *       when the registry is bound to another tree (e.g. when TTreeWrapper opens the next input file)
+   */
+  void
+  setTree(TTree * tree);
+
+  /**
+   * @brief Returns the tree the buffers are currently bound to
+   * @return Pointer to the tree, or nullptr
+   */
+  TTree *
+  getTree() const;
+
+  /**
+   * @brief Returns the number of distinct branches for which a buffer has been requested
+   * @return The number of buffers
+   */
+  std::size_t
+  getBufferCount() const;
+
+  /**
+   * @brief Returns the buffer for a branch holding a single value per event
+   * @param branchName Name of the branch
+   * @return Pointer to the buffer
+   */
+  template <typename T>
+  T *
+  getScalar(const std::string & branchName)
+  {
+    return getArray<T>(branchName, 1);
+  }
+
+  /**
+   * @brief Returns the buffer for a branch holding an array of values per event
+   * @param branchName Name of the branch
+   * @param size       Maximum number of values per event
+   * @return Pointer to the buffer
+   *
+   * @note Throws if the branch has been requested before with a different type
+   *       or with a smaller size
+   */
+  template <typename T>
+  T *
+  getArray(const std::string & branchName,
+           int size)
+  {
+    if(branchName.empty())
+    {
+      throw cms::Exception("BranchBufferRegistry") << "Empty branch name given\n";
+    }
+    if(size < 1)
+    {
+      throw cms::Exception("BranchBufferRegistry")
+        << "Invalid size = " << size << " requested for branch '" << branchName << "'\n";
+    }
+
+    auto buffer = buffers_.find(branchName);
+    if(buffer == buffers_.end())
+    {
+      std::unique_ptr<BufferBase> newBuffer(new Buffer<T>(size));
+      if(tree_)
+      {
+        newBuffer -> bind(tree_, branchName);
+      }
+      buffer = buffers_.insert(std::make_pair(branchName, std::move(newBuffer))).first;
+    }
+    else
+    {
+      if(buffer -> second -> type_ != std::type_index(typeid(T)))
+      {
+        throw cms::Exception("BranchBufferRegistry")
+          << "Branch '" << branchName << "' requested with type " << typeid(T).name()
+          << " but previously with type " << buffer -> second -> type_.name() << '\n';
+      }
+      if(buffer -> second -> size_ < size)
+      {
+        throw cms::Exception("BranchBufferRegistry")
+          << "Branch '" << branchName << "' requested with size " << size
+          << " but previously with size " << buffer -> second -> size_ << '\n';
+      }
+    }
+    return static_cast<Buffer<T> *>(buffer -> second.get()) -> data_.get();
+  }
+
+  /**
+   * @brief Returns the registry shared by all readers that are bound directly to a tree,
+   *        rather than through TTreeWrapper
+   * @param tree The input tree
+   * @return Pointer to the registry
+   *
+   * @note The registry is deleted when the last reader holding the returned pointer is deleted
+   * @note Trees read in different threads get different registries
+   */
+  static std::shared_ptr<BranchBufferRegistry>
+  getSharedInstance(TTree * tree);
+
+private:
+  struct BufferBase
+  {
+    BufferBase(const std::type_index & type,
+               int size)
+      : type_(type)
+      , size_(size)
+    {}
+    virtual ~BufferBase() {}
+
+    virtual void
+    bind(TTree * tree,
+         const std::string & branchName) = 0;
+
+    const std::type_index type_;
+    const int size_;
+  };
+
+  template <typename T>
+  struct Buffer
+    : public BufferBase
+  {
+    Buffer(int size)
+      : BufferBase(typeid(T), size)
+      , data_(new T[size]())
+    {}
+
+    void
+    bind(TTree * tree,
+         const std::string & branchName) override
+    {
+      tree -> SetBranchAddress(branchName.c_str(), data_.get());
+    }
+
+    std::unique_ptr<T[]> data_;
+  };
+
+  TTree * tree_;                                                ///< Tree the buffers are bound to
+  std::map<std::string, std::unique_ptr<BufferBase>> buffers_;  ///< Buffers, indexed by branch name
+};
+
+#endif // BRANCHBUFFERREGISTRY_H
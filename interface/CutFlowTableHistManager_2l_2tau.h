@@ -19,6 +19,11 @@ class CutFlowTableHistManager_2l_2tau
   /// book and fill histograms
   void bookHistograms(TFileDirectory& dir);
   void fillHistograms(const std::string& cut, double evtWeight = 1.);
+  void fillHistograms(int idxCut, double evtWeight = 1.);
+
+  /// return index of the bin for given cut, to be passed to fillHistograms(int, double);
+  /// to be called after bookHistograms
+  int getCutIdx(const std::string& cut) const;
 
  private:
   TH1* histogram_cutFlow_;
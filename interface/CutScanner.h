@@ -0,0 +1,119 @@
+#ifndef tthAnalysis_HiggsToTauTau_CutScanner_h
+#define tthAnalysis_HiggsToTauTau_CutScanner_h
+
+/** \class CutScanner
+ *
+ * Compute the signal and background yields for all points of a grid of cuts in one pass over the events
+ * (instead of rerunning the analysis for each cut point, as done by the runJobs_cut_optimization_*.sh scripts).
+ *
+ * Each dimension of the grid is a cut of type "<expression> <operator> <threshold>" with a list of thresholds.
+ * The events of each sample are passed as columns, one vector of values per cut plus one vector of event weights.
+ * For each event and cut, the number of thresholds that the event passes is obtained by a binary search,
+ * which gives the tightest point along the cut that the event passes;
+ * the event weight is added to the cell of the grid that corresponds to the tightest point it passes for all cuts.
+ * The yield for each point of the grid is then obtained by summing the cells that are at least as tight in every cut.
+ *
+ */
+
+#include <string> // std::string
+#include <vector> // std::vector<>
+#include <ostream> // std::ostream
+
+class CutScanner
+{
+ public:
+  CutScanner();
+  ~CutScanner() {}
+
+  /**
+   * @brief Add a dimension to the grid of cuts
+   * @param expression Name of the cut (e.g. TTree::Draw expression by which the values passed to fill() were computed)
+   * @param op         One of ">", ">=", "<", "<="
+   * @param thresholds Thresholds to scan, in any order
+   * @return Index of the cut, i.e. position of its values in the columns passed to fill()
+   */
+  int addCut(const std::string& expression, const std::string& op, const std::vector<double>& thresholds);
+
+  /**
+   * @brief Add a sample
+   * @return Index of the sample, to be passed to fill()
+   */
+  int addSample(const std::string& name, bool isSignal);
+
+  /**
+   * @brief Add the events of a sample to the grid
+   * @param columns Values of each cut (in the order in which the cuts have been added) for each event
+   * @param weights Weight of each event
+   *
+   * @note May be called several times for the same sample (e.g. once per input file)
+   */
+  void fill(int idxSample, const std::vector<std::vector<float> >& columns, const std::vector<float>& weights);
+
+  size_t getNumCuts() const { return cuts_.size(); }
+  size_t getNumCutPoints() const { return numCells_; }
+  size_t getNumSamples() const { return samples_.size(); }
+
+  /**
+   * @brief Returns the threshold of each cut at a given point of the grid
+   */
+  std::vector<double> getThresholds(size_t idxCutPoint) const;
+
+  double getYield(int idxSample, size_t idxCutPoint) const;
+  double getYield_signal(size_t idxCutPoint) const;
+  double getYield_background(size_t idxCutPoint) const;
+
+  /**
+   * @brief Returns S/sqrt(B) at a given point of the grid (0 if B is not positive)
+   */
+  double getSignificance(size_t idxCutPoint) const;
+
+  /**
+   * @brief Returns the point of the grid with the highest S/sqrt(B)
+   */
+  size_t getBestCutPoint() const;
+
+  /**
+   * @brief Print a table with the thresholds, the yields of all samples, S, B and S/sqrt(B) for each point of the grid
+   */
+  void print(std::ostream& stream) const;
+
+ private:
+  enum { kGreaterThan, kGreaterEqual, kLessThan, kLessEqual };
+
+  struct cutType
+  {
+    std::string expression_;
+    std::string op_string_;
+    int op_;
+    std::vector<double> thresholds_; // ordered from the loosest to the tightest cut
+    std::vector<double> thresholds_ascending_;
+  };
+
+  /**
+   * @brief Returns the number of thresholds of the cut that the value given as function argument passes
+   */
+  static size_t getNumPassed(const cutType& cut, double value);
+
+  /**
+   * @brief Sum the cells that are at least as tight in every cut, so that each cell contains the yield for its point of the grid
+   */
+  void compYields() const;
+
+  struct sampleType
+  {
+    std::string name_;
+    bool isSignal_;
+    std::vector<double> cells_; // sum of weights of the events for which this is the tightest point of the grid passed
+  };
+
+  std::vector<cutType> cuts_;
+  size_t numCells_;
+  std::vector<sampleType> samples_;
+
+  mutable std::vector<std::vector<double> > yields_; // [idxSample][idxCutPoint]
+  mutable bool isUpToDate_;
+
+  std::vector<int> idxCells_; // buffer used by fill()
+};
+
+#endif // tthAnalysis_HiggsToTauTau_CutScanner_h
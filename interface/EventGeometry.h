@@ -0,0 +1,144 @@
+#ifndef tthAnalysis_HiggsToTauTau_EventGeometry_h
+#define tthAnalysis_HiggsToTauTau_EventGeometry_h
+
+#include "tthAnalysis/HiggsToTauTau/interface/Particle.h" // Particle
+
+#include <vector> // std::vector<>
+#include <cstdint> // std::uintptr_t
+#include <type_traits> // std::is_base_of<>
+
+/**
+ * @brief Event-scoped cache of the angular distances between the reconstructed objects of an event
+ *
+ * The collections returned by the reader classes are registered by calling add() after reset() at the start of each event.
+ * The distances dR and dPhi between two registered objects are computed when they are first requested
+ * and are stored in a symmetric matrix, so that the overlap removal (ParticleCollectionCleaner)
+ * and the computation of the MVA input variables (mvaInputVariables.h) share them instead of recomputing them.
+ * In addition, the jet acceptance (pT > 25 GeV and |eta| < 2.4), which is applied in several MVA input variables,
+ * is evaluated once per object when the object is registered.
+ *
+ * An object is mapped to its index in the matrix via the address range of the collection that it belongs to,
+ * so that the lookup costs a few comparisons per registered collection.
+ *
+ * @note Objects that have not been registered are accepted too: their distances are computed on every call, without caching.
+ *       The registered collections must not be modified or reallocated until the next call to reset().
+ */
+class EventGeometry
+{
+public:
+  EventGeometry();
+  ~EventGeometry();
+
+  /**
+   * @brief Forget all registered collections; to be called at the start of each event
+   */
+  void
+  reset();
+
+  /**
+   * @brief Register a collection of objects (e.g. std::vector<RecoJet> as returned by RecoJetReader::read())
+   */
+  template <typename T>
+  void
+  add(const std::vector<T> & particles)
+  {
+    static_assert(std::is_base_of<Particle, T>::value, "EventGeometry::add() requires a collection of objects derived from Particle");
+    if(particles.empty())
+    {
+      return;
+    }
+    collectionType collection;
+    collection.begin_ = address(particles.front());
+    collection.end_ = collection.begin_ + particles.size() * sizeof(T);
+    collection.stride_ = sizeof(T);
+    collection.offset_ = eta_.size();
+    collections_.push_back(collection);
+    for(const T & particle: particles)
+    {
+      addParticle(particle);
+    }
+    resizeMatrix();
+  }
+
+  /**
+   * @brief Returns the distance in (eta, phi) between two objects
+   */
+  double
+  dR(const Particle & particle1,
+     const Particle & particle2) const;
+
+  /**
+   * @brief Returns the azimuthal angle of the first object minus the one of the second object, in the range [-pi, +pi]
+   */
+  double
+  dPhi(const Particle & particle1,
+       const Particle & particle2) const;
+
+  /**
+   * @brief Returns true if the jet passes pT > 25 GeV and |eta| < 2.4, as required by the MVA input variables
+   *        nJet25_Recl, avg_dr_jet and max_dr_jet
+   */
+  bool
+  isJetInAcceptance(const Particle & jet) const;
+
+  /**
+   * @brief Evaluates the jet acceptance without using the cache
+   */
+  static bool
+  passesJetAcceptance(const Particle & jet);
+
+private:
+  EventGeometry(const EventGeometry &) = delete;
+  EventGeometry & operator=(const EventGeometry &) = delete;
+
+  /**
+   * @brief Address range of a registered collection
+   */
+  struct collectionType
+  {
+    std::uintptr_t begin_;
+    std::uintptr_t end_;
+    std::size_t stride_;
+    std::size_t offset_;   ///< index of the first object of the collection in the matrix
+  };
+
+  static inline std::uintptr_t
+  address(const Particle & particle)
+  {
+    return reinterpret_cast<std::uintptr_t>(&particle);
+  }
+
+  /**
+   * @brief Returns the index of an object in the matrix, or -1 if the object has not been registered
+   */
+  int
+  getIndex(const Particle & particle) const;
+
+  void
+  addParticle(const Particle & particle);
+
+  /**
+   * @brief Grow the matrix to the number of registered objects, keeping the distances computed so far
+   */
+  void
+  resizeMatrix();
+
+  /**
+   * @brief Compute dR and dPhi for a pair of registered objects, unless they have been computed before
+   */
+  void
+  fill(int index1,
+       int index2) const;
+
+  std::vector<collectionType> collections_;
+  std::vector<double> eta_;
+  std::vector<double> phi_;
+  std::vector<bool> isJetInAcceptance_;
+
+  std::size_t numParticles_;        ///< number of rows (and columns) of the matrix
+  mutable std::vector<double> dR_;   ///< symmetric matrix; negative values mark pairs of objects that have not been computed yet
+  mutable std::vector<double> dPhi_; ///< antisymmetric matrix; filled together with dR_
+  std::vector<double> buffer_;       ///< used when resizing the matrix
+};
+
+#endif // tthAnalysis_HiggsToTauTau_EventGeometry_h
@@ -0,0 +1,174 @@
+#ifndef tthAnalysis_HiggsToTauTau_EventIndex_h
+#define tthAnalysis_HiggsToTauTau_EventIndex_h
+
+#include "tthAnalysis/HiggsToTauTau/interface/KeyTypes.h" // RUN_TYPE, LUMI_TYPE, EVT_TYPE
+
+#include <Rtypes.h> // Long64_t, UInt_t
+
+#include <string> // std::string
+#include <vector> // std::vector<>
+#include <map> // std::map<,>
+#include <unordered_map> // std::unordered_map<,>
+#include <unordered_set> // std::unordered_set<>
+#include <fstream> // std::ofstream
+
+/**
+ * @brief Event index sidecar files
+ *
+ * The sidecar is an ASCII file written next to an Ntuple by produceNtuple or preselNtuple_*.
+ * For each Ntuple it contains a header line
+ *
+ *   # ntuple: <file name>
+ *
+ * followed by one line per event
+ *
+ *   run:lumi:event entry numLeptons numHadTaus numJets
+ *
+ * where entry is the index of the event in the TTree of the Ntuple and the multiplicities refer to the
+ * selected leptons, hadronic taus and jets in the given event. Sidecar files of several Ntuples can be
+ * concatenated into a single file, e.g. with cat. The file name in the header is the final location of the Ntuple
+ * (see eventIndexNtupleFileName in produceNtuple_cfg.py), rather than the name it has been written to by the job.
+ */
+
+struct EventIndexEntry
+{
+  RUN_TYPE run;
+  LUMI_TYPE lumi;
+  EVT_TYPE event;
+  Long64_t entry;      ///< index of the event in the TTree
+  UInt_t numLeptons;   ///< number of selected leptons
+  UInt_t numHadTaus;   ///< number of selected hadronic taus
+  UInt_t numJets;      ///< number of selected jets
+  std::size_t fileIdx; ///< index of the Ntuple the event is stored in (see EventIndex::getFileName)
+};
+
+class EventIndexWriter
+{
+ public:
+  EventIndexWriter(const std::string & indexFileName,
+                   const std::string & ntupleFileName);
+  ~EventIndexWriter();
+
+  /**
+   * @brief Append an event to the sidecar file
+   * @param entry Index of the event in the output TTree (i.e. outputTree->GetEntries() - 1 right after Fill())
+   */
+  void
+  write(RUN_TYPE run,
+        LUMI_TYPE lumi,
+        EVT_TYPE event,
+        Long64_t entry,
+        unsigned numLeptons,
+        unsigned numHadTaus,
+        unsigned numJets);
+
+ private:
+  std::string indexFileName_;
+  std::ofstream indexFile_;
+  long numEventsWritten_;
+};
+
+/**
+ * @brief Read event index sidecar files and select entries to be read
+ *
+ * Events can be selected by run + luminosity section + event number (in the format of selEventsFileName_input)
+ * and/or by lower thresholds on the object multiplicities stored in the index.
+ * Lookup of individual events by run + luminosity section + event number takes constant time.
+ */
+class EventIndex
+{
+ public:
+  EventIndex();
+  ~EventIndex() {}
+
+  /**
+   * @brief Read sidecar file; can be called repeatedly to combine several sidecar files
+   *
+   * @throws cms::Exception if the same run:lumi:event triplet is indexed more than once
+   */
+  EventIndex &
+  read(const std::string & indexFileName);
+
+  /**
+   * @brief Restrict selection to the run:lumi:event triplets listed in an ASCII file, one triplet per line
+   */
+  EventIndex &
+  readEventList(const std::string & eventListFileName);
+
+  EventIndex &
+  addEvent(RUN_TYPE run,
+           LUMI_TYPE lumi,
+           EVT_TYPE event);
+
+  EventIndex & setMinNumLeptons(unsigned minNumLeptons);
+  EventIndex & setMinNumHadTaus(unsigned minNumHadTaus);
+  EventIndex & setMinNumJets(unsigned minNumJets);
+
+  /**
+   * @brief Find event by run + luminosity section + event number
+   * @return Pointer to index entry, or nullptr if the event is not in the index
+   */
+  const EventIndexEntry *
+  find(RUN_TYPE run,
+       LUMI_TYPE lumi,
+       EVT_TYPE event) const;
+
+  const std::string &
+  getFileName(std::size_t fileIdx) const;
+
+  /**
+   * @brief Check if the index contains any selected entries for the Ntuple given as function argument
+   *
+   * @throws cms::Exception if the Ntuple is not in the index (see getEntries)
+   */
+  bool
+  hasEntries(const std::string & ntupleFileName) const;
+
+  /**
+   * @brief Return selected TTree entries of the Ntuple given as function argument, in ascending order
+   *
+   * @note The Ntuple is identified by its full path as written in the sidecar file;
+   *       if there is no exact match, the file is looked up by its base name
+   * @throws cms::Exception if the Ntuple is not in the index or if its base name is not unique
+   */
+  std::vector<Long64_t>
+  getEntries(const std::string & ntupleFileName) const;
+
+  std::size_t
+  size() const;
+
+ private:
+  struct EventKey
+  {
+    RUN_TYPE run;
+    LUMI_TYPE lumi;
+    EVT_TYPE event;
+    bool operator==(const EventKey & other) const
+    {
+      return run == other.run && lumi == other.lumi && event == other.event;
+    }
+  };
+  struct EventKeyHash
+  {
+    std::size_t operator()(const EventKey & key) const;
+  };
+
+  bool
+  isSelected(const EventIndexEntry & entry) const;
+
+  const std::vector<std::size_t> &
+  findFile(const std::string & ntupleFileName) const;
+
+  std::vector<EventIndexEntry> entries_;
+  std::vector<std::string> fileNames_;
+  std::unordered_map<EventKey, std::size_t, EventKeyHash> entryLookup_;                ///< key = run:lumi:event, value = position in entries_
+  std::map<std::string, std::vector<std::size_t>> fileLookup_;                         ///< key = Ntuple file name, value = positions in entries_
+  std::map<std::string, std::string> fileLookup_basename_;                             ///< key = Ntuple base name, value = Ntuple file name (empty if ambiguous)
+  std::unordered_set<EventKey, EventKeyHash> selEvents_;
+
+  unsigned minNumLeptons_;
+  unsigned minNumHadTaus_;
+  unsigned minNumJets_;
+};
+
+#endif // tthAnalysis_HiggsToTauTau_EventIndex_h
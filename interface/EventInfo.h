@@ -41,6 +41,15 @@ public:
   std::string
   getDecayModeString() const;
 
+  /**
+   * @brief Returns the position of the Higgs decay mode in the list returned by getDecayModes(),
+   *        or -1 if the decay mode is not recognized
+   *
+   * @note Unlike getDecayModeString(), does not throw for background events (returns -1)
+   */
+  int
+  getDecayModeIdx() const;
+
   static std::vector<std::string>
   getDecayModes();
 
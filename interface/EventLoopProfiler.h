@@ -0,0 +1,207 @@
+#ifndef EVENTLOOPPROFILER_H
+#define EVENTLOOPPROFILER_H
+
+#include <vector> // std::vector<>
+#include <string> // std::string
+#include <memory> // std::unique_ptr<>
+#include <mutex> // std::mutex
+#include <chrono> // std::chrono::
+#include <ostream> // std::ostream
+#include <cstdint> // std::uint64_t
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h> // __rdtsc()
+#endif
+
+// forward declarations
+class TFileDirectory;
+
+/**
+ * @brief Breaks the time spent in an event loop down into named stages
+ *
+ * The profiler keeps track of the stage that each thread is currently in. Switching to a new stage
+ * (via enter() or an instance of EventLoopProfiler::Scope) adds the time elapsed since the previous switch
+ * to the previous stage, so that the event loop can be instrumented by marking the start of each stage only,
+ * and the time spent after a `continue' statement is attributed to the stage in which the event was rejected.
+ *
+ * Timestamps are taken from the time-stamp counter of the CPU where available (a few ns per call),
+ * and converted to seconds by comparing the number of ticks with the steady clock over the lifetime of the profiler.
+ * The ticks are accumulated separately for each thread, without locking; the results of all threads are summed up
+ * when the breakdown is reported by print() or written to the output file by write().
+ *
+ * @note All stages and counters need to be added before the event loop starts,
+ *       and the breakdown should be reported after all threads have finished
+ */
+class EventLoopProfiler
+{
+public:
+  /**
+   * @brief Stages that are defined by default, in the order in which they typically occur in an analyze_* event loop
+   */
+  enum Stage
+  {
+    kRead = 0,        ///< TTree::GetEntry() and building the object collections
+    kCleaning,        ///< overlap removal
+    kSelection,       ///< object and event selection, computation of event weights
+    kMVA,             ///< evaluation of MVA discriminators
+    kHadTopTagger,    ///< hadronic top tagger
+    kKinFit,          ///< kinematic fits
+    kSVfit,           ///< SVfit integrations
+    kFillHistograms,  ///< filling of histograms
+    kWrite,           ///< filling of output TTrees and text files
+    kNumDefaultStages
+  };
+
+  /**
+   * @brief Creates a profiler with the default stages
+   * @param name Name of the profiler, used in the printout and as prefix of the histograms written by write()
+   */
+  explicit EventLoopProfiler(const std::string & name);
+  ~EventLoopProfiler();
+
+  /**
+   * @brief Add a stage in addition to the stages defined by default
+   * @return Index of the new stage, to be passed to enter()
+   */
+  std::size_t
+  addStage(const std::string & stageName);
+
+  /**
+   * @brief Add a counter
+   * @return Index of the new counter, to be passed to count()
+   */
+  std::size_t
+  addCounter(const std::string & counterName);
+
+  /**
+   * @brief Switch the calling thread to the stage given as function argument
+   *
+   * @note The time elapsed since the previous call to enter() is added to the previous stage
+   */
+  void
+  enter(std::size_t stage);
+
+  /**
+   * @brief Add the time elapsed since the previous call to enter() to the current stage,
+   *        and stop timing the calling thread until the next call to enter()
+   */
+  void
+  stop();
+
+  /**
+   * @brief Increment the number of processed events
+   */
+  void
+  countEvent();
+
+  /**
+   * @brief Increment the counter given as function argument
+   */
+  void
+  count(std::size_t counter,
+        std::uint64_t value = 1);
+
+  /**
+   * @brief Prints the time spent in each stage, the number of times each stage has been entered,
+   *        the values of the counters and the number of events processed per second
+   */
+  void
+  print(std::ostream & stream) const;
+
+  /**
+   * @brief Stores the breakdown in the output file, so that it can be compared across jobs:
+   *        the histogram <name>_time contains the time in seconds spent in each stage,
+   *        the histogram <name>_calls the number of times each stage has been entered,
+   *        and the histogram <name>_counters the number of processed events (first bin) and the values of the counters;
+   *        the bins are labeled by the names of the stages and of the counters
+   */
+  void
+  write(TFileDirectory & dir) const;
+
+  /**
+   * @brief Switches the calling thread to a given stage for the lifetime of this object,
+   *        and switches it back to the previous stage when going out of scope
+   *
+   * @note Does nothing if the profiler is a null pointer, so that the instrumentation can be left in the code
+   *       also when profiling is disabled
+   */
+  class Scope
+  {
+  public:
+    Scope(EventLoopProfiler * profiler,
+          std::size_t stage);
+    ~Scope();
+
+  private:
+    Scope(const Scope &) = delete;
+    Scope & operator=(const Scope &) = delete;
+
+    EventLoopProfiler * profiler_;
+    int previousStage_;
+  };
+
+private:
+  EventLoopProfiler(const EventLoopProfiler &) = delete;
+  EventLoopProfiler & operator=(const EventLoopProfiler &) = delete;
+
+  /**
+   * @brief Time and counters accumulated by one thread
+   */
+  struct ThreadData
+  {
+    ThreadData(std::size_t numStages, std::size_t numCounters);
+
+    std::vector<std::uint64_t> ticks_;
+    std::vector<std::uint64_t> calls_;
+    std::vector<std::uint64_t> counters_;
+    std::uint64_t numEvents_;
+    int currentStage_;          ///< -1 if the thread is currently not timed
+    std::uint64_t lastTick_;
+  };
+
+  /**
+   * @brief Returns the data of the calling thread, creating it on the first call
+   */
+  ThreadData &
+  getThreadData();
+
+  /**
+   * @brief Switch the calling thread to a stage, returning the previous stage (-1 if not timed)
+   */
+  int
+  switchStage(int stage,
+              bool isNewCall = true);
+
+  /**
+   * @brief Sum the data of all threads
+   */
+  ThreadData
+  sum() const;
+
+  /**
+   * @brief Number of ticks per second, calibrated against the steady clock
+   */
+  double
+  getTicksPerSecond() const;
+
+  static inline std::uint64_t
+  getTick()
+  {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+  }
+
+  std::string name_;
+  std::vector<std::string> stageNames_;
+  std::vector<std::string> counterNames_;
+  unsigned id_;                                         ///< unique id, so that the per-thread lookup is not confused by a new profiler at the address of a deleted one
+  mutable std::mutex mutex_;                            ///< protects threadData_
+  std::vector<std::unique_ptr<ThreadData>> threadData_; ///< data of each thread that has used this profiler
+  std::uint64_t startTick_;
+  std::chrono::steady_clock::time_point startTime_;
+};
+
+#endif // EVENTLOOPPROFILER_H
@@ -0,0 +1,87 @@
+#ifndef tthAnalysis_HiggsToTauTau_EventWeightCalculator_h
+#define tthAnalysis_HiggsToTauTau_EventWeightCalculator_h
+
+/** \class EventWeightCalculator
+ *
+ * Compute the event weight as product of its components (lumiScale, genWeight, pileupWeight, b-tagging, trigger, data/MC corrections, fake-rates, ...)
+ * for the nominal case and for a list of systematic shifts.
+ *
+ * Each component is registered once, before the event loop, together with the names of the shifts that change its value.
+ * In each event, the nominal value of each component is set once and the shifted values only for the shifts that the component depends on;
+ * the event weight for any other shift uses the nominal value of the component.
+ * The shift with index 0 is always "central".
+ *
+ */
+
+#include <string>
+#include <vector>
+
+class EventWeightCalculator
+{
+ public:
+  EventWeightCalculator(const std::vector<std::string>& shifts = std::vector<std::string>());
+  ~EventWeightCalculator() {}
+
+  /**
+   * @brief Register a component of the event weight
+   * @param name   name of the component, e.g. "pileupWeight"
+   *        shifts names of the shifts that change the value of the component (shifts not given to the constructor are ignored)
+   * @return index of the component, to be passed to setWeight
+   */
+  int addComponent(const std::string& name, const std::vector<std::string>& shifts = std::vector<std::string>());
+
+  /**
+   * @brief Return index of shift, or -1 if the shift has not been given to the constructor
+   */
+  int getShiftIndex(const std::string& shift) const;
+
+  /**
+   * @brief Reset all components to one; to be called at the start of each event
+   */
+  void reset();
+
+  /**
+   * @brief Set nominal value of a component. The value is used for all shifts, unless it is overwritten by a subsequent call to setWeight(idxComponent, idxShift, weight)
+   */
+  void setWeight(int idxComponent, double weight);
+
+  /**
+   * @brief Set value of a component for a shift that the component depends on
+   */
+  void setWeight(int idxComponent, int idxShift, double weight);
+
+  /**
+   * @brief Return event weight, i.e. the product of all components, for the nominal case (idxShift = 0) or for the given shift
+   */
+  double getWeight(int idxShift = 0) const;
+
+  /**
+   * @brief Return event weights for all shifts, in the order of getShifts()
+   */
+  const std::vector<double>& getWeights() const;
+
+  /**
+   * @brief Return value of one component for the nominal case or for the given shift
+   */
+  double getComponentWeight(int idxComponent, int idxShift = 0) const;
+
+  const std::vector<std::string>& getShifts() const { return shifts_; }
+  const std::vector<std::string>& getComponentNames() const { return componentNames_; }
+
+ private:
+  void checkComponentIndex(int idxComponent) const;
+  void checkShiftIndex(int idxShift) const;
+  void update() const;
+
+  std::vector<std::string> shifts_;
+  size_t numShifts_;
+
+  std::vector<std::string> componentNames_;
+  std::vector<bool> isAffected_; // matrix of components x shifts, true if the component depends on the shift
+  std::vector<double> values_;   // matrix of components x shifts
+
+  mutable std::vector<double> evtWeights_;
+  mutable bool isUpToDate_;
+};
+
+#endif // tthAnalysis_HiggsToTauTau_EventWeightCalculator_h
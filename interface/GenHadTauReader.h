@@ -9,7 +9,7 @@
 
 #include <string>
 #include <vector>
-#include <map>
+#include <memory> // std::shared_ptr<>
 
 class GenHadTauReader
   : public ReaderBase
@@ -24,12 +24,23 @@ class GenHadTauReader
    */
   void setBranchAddresses(TTree* tree) override;
 
+  /**
+   * @brief Request the buffers for all GenHadTau branches from the registry
+   */
+  void setBranchBuffers(BranchBufferRegistry& branchBuffers) override;
+
   /**
    * @brief Read branches from tree and use information to fill collection of GenHadTau objects
    * @return Collection of GenHadTau objects
    */
   std::vector<GenHadTau> read() const;
 
+  /**
+   * @brief Same as read(), but fill the collection given as function argument,
+   *        so that the memory allocated by the collection in previous events is reused
+   */
+  void read(std::vector<GenHadTau>& hadTaus) const;
+
  protected:
  /**
    * @brief Initialize names of branches to be read from tree
@@ -46,17 +57,16 @@ class GenHadTauReader
   std::string branchName_mass_;
   std::string branchName_charge_;
 
-  Int_t nHadTaus_;
+  Int_t* nHadTaus_;
   Float_t* hadTau_pt_;
   Float_t* hadTau_eta_;
   Float_t* hadTau_phi_;
   Float_t* hadTau_mass_;
   Float_t* hadTau_charge_;
 
-  // CV: make sure that only one GenHadTauReader instance exists for a given branchName,
-  //     as ROOT cannot handle multiple TTree::SetBranchAddress calls for the same branch.
-  static std::map<std::string, int> numInstances_;
-  static std::map<std::string, GenHadTauReader*> instances_;
+  // CV: the buffers are owned by the BranchBufferRegistry shared by all readers of the same tree
+  //     (set only if the reader is bound directly to a TTree rather than through TTreeWrapper)
+  std::shared_ptr<BranchBufferRegistry> branchBuffers_;
 };
 
 #endif // tthAnalysis_HiggsToTauTau_GenHadTauReader_h
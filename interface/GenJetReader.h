@@ -9,7 +9,7 @@
 
 #include <string>
 #include <vector>
-#include <map>
+#include <memory> // std::shared_ptr<>
 
 class GenJetReader
   : public ReaderBase
@@ -24,12 +24,23 @@ class GenJetReader
    */
   void setBranchAddresses(TTree* tree) override;
 
+  /**
+   * @brief Request the buffers for all GenJet branches from the registry
+   */
+  void setBranchBuffers(BranchBufferRegistry& branchBuffers) override;
+
   /**
    * @brief Read branches from tree and use information to fill collection of GenJet objects
    * @return Collection of GenJet objects
    */
   std::vector<GenJet> read() const;
 
+  /**
+   * @brief Same as read(), but fill the collection given as function argument,
+   *        so that the memory allocated by the collection in previous events is reused
+   */
+  void read(std::vector<GenJet>& jets) const;
+
  protected:
  /**
    * @brief Initialize names of branches to be read from tree
@@ -45,16 +56,15 @@ class GenJetReader
   std::string branchName_phi_;
   std::string branchName_mass_;
 
-  Int_t nJets_;
+  Int_t* nJets_;
   Float_t* jet_pt_;
   Float_t* jet_eta_;
   Float_t* jet_phi_;
   Float_t* jet_mass_;
 
-  // CV: make sure that only one RecoJetReader instance exists for a given branchName,
-  //     as ROOT cannot handle multiple TTree::SetBranchAddress calls for the same branch.
-  static std::map<std::string, int> numInstances_;
-  static std::map<std::string, GenJetReader*> instances_;
+  // CV: the buffers are owned by the BranchBufferRegistry shared by all readers of the same tree
+  //     (set only if the reader is bound directly to a TTree rather than through TTreeWrapper)
+  std::shared_ptr<BranchBufferRegistry> branchBuffers_;
 };
 
 #endif // tthAnalysis_HiggsToTauTau_GenJetReader_h
@@ -9,7 +9,7 @@
 
 #include <string>
 #include <vector>
-#include <map>
+#include <memory> // std::shared_ptr<>
 
 class GenLeptonReader
   : public ReaderBase
@@ -25,12 +25,23 @@ class GenLeptonReader
    */
   void setBranchAddresses(TTree* tree) override;
 
+  /**
+   * @brief Request the buffers for all GenLepton branches from the registry
+   */
+  void setBranchBuffers(BranchBufferRegistry& branchBuffers) override;
+
   /**
    * @brief Read branches from tree and use information to fill collection of GenLepton objects
    * @return Collection of GenLepton objects
    */
   std::vector<GenLepton> read() const;
 
+  /**
+   * @brief Same as read(), but fill the collection given as function argument,
+   *        so that the memory allocated by the collection in previous events is reused
+   */
+  void read(std::vector<GenLepton>& leptons) const;
+
  protected:
  /**
    * @brief Initialize names of branches to be read from tree
@@ -55,7 +66,7 @@ class GenLeptonReader
   std::string branchName_promptLepton_mass_;
   std::string branchName_promptLepton_pdgId_;
 
-  Int_t nPromptLeptons_;
+  Int_t* nPromptLeptons_;
   Float_t* promptLepton_pt_;
   Float_t* promptLepton_eta_;
   Float_t* promptLepton_phi_;
@@ -68,17 +79,16 @@ class GenLeptonReader
   std::string branchName_leptonFromTau_mass_;
   std::string branchName_leptonFromTau_pdgId_;
 
-  Int_t nLeptonsFromTau_;
+  Int_t* nLeptonsFromTau_;
   Float_t* leptonFromTau_pt_;
   Float_t* leptonFromTau_eta_;
   Float_t* leptonFromTau_phi_;
   Float_t* leptonFromTau_mass_;
   Int_t* leptonFromTau_pdgId_;
 
-  // CV: make sure that only one GenLeptonReader instance exists for a given branchName,
-  //     as ROOT cannot handle multiple TTree::SetBranchAddress calls for the same branch.
-  static std::map<std::string, int> numInstances_;
-  static std::map<std::string, GenLeptonReader*> instances_;
+  // CV: the buffers are owned by the BranchBufferRegistry shared by all readers of the same tree
+  //     (set only if the reader is bound directly to a TTree rather than through TTreeWrapper)
+  std::shared_ptr<BranchBufferRegistry> branchBuffers_;
 };
 
 #endif // tthAnalysis_HiggsToTauTau_GenLeptonReader_h
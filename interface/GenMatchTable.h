@@ -0,0 +1,78 @@
+#ifndef tthAnalysis_HiggsToTauTau_GenMatchTable_h
+#define tthAnalysis_HiggsToTauTau_GenMatchTable_h
+
+/** \class GenMatchTable
+ *
+ * Per-event table of the generator level electrons, muons, hadronic taus and jets
+ * that are matched to the reconstructed objects of one collection (branches <collection>_genLepton, <collection>_genHadTau and <collection>_genJet).
+ *
+ * The table is owned by the reader of the reconstructed objects and is refilled in place in each event,
+ * so that memory is allocated in the first events only.
+ * The reconstructed objects are linked to the entries of the table by non-owning pointers
+ * (in the same way as ParticleCollectionGenMatcher links them to the generator level collections),
+ * which stay valid until the generator level information of the next event is read.
+ *
+ */
+
+#include "tthAnalysis/HiggsToTauTau/interface/GenLeptonReader.h" // GenLeptonReader
+#include "tthAnalysis/HiggsToTauTau/interface/GenHadTauReader.h" // GenHadTauReader
+#include "tthAnalysis/HiggsToTauTau/interface/GenJetReader.h" // GenJetReader
+
+#include <vector>
+#include <assert.h> // assert
+
+class GenMatchTable
+{
+ public:
+  GenMatchTable() {}
+  ~GenMatchTable() {}
+
+  /**
+   * @brief Read generator level particles matched to the reconstructed objects of the current event
+   */
+  void read(const GenLeptonReader& genLeptonReader, const GenHadTauReader& genHadTauReader, const GenJetReader& genJetReader)
+  {
+    genLeptonReader.read(genLeptons_);
+    genHadTauReader.read(genHadTaus_);
+    genJetReader.read(genJets_);
+    assert(genHadTaus_.size() == genLeptons_.size() && genJets_.size() == genLeptons_.size());
+  }
+
+  /**
+   * @brief Number of reconstructed objects in the Ntuple
+   */
+  size_t size() const { return genLeptons_.size(); }
+
+  /**
+   * @brief Link reconstructed object to the generator level particles matched to it
+   * @param recObject reconstructed object (RecoElectron, RecoMuon, RecoHadTau or RecoJet)
+   *        idx       index of the reconstructed object in the Ntuple
+   */
+  template<typename T>
+  void link(T& recObject, size_t idx) const
+  {
+    assert(idx < size());
+    if ( genLeptons_[idx].isValid() ) recObject.set_genLepton(&genLeptons_[idx]);
+    if ( genHadTaus_[idx].isValid() ) recObject.set_genHadTau(&genHadTaus_[idx]);
+    if ( genJets_[idx].isValid()    ) recObject.set_genJet(&genJets_[idx]);
+  }
+
+  /**
+   * @brief Link collection of reconstructed objects, stored in the same order as in the Ntuple, to the generator level particles matched to them
+   */
+  template<typename T>
+  void link(std::vector<T>& recObjects) const
+  {
+    assert(recObjects.size() == size());
+    for ( size_t idx = 0; idx < recObjects.size(); ++idx ) {
+      link(recObjects[idx], idx);
+    }
+  }
+
+ private:
+  std::vector<GenLepton> genLeptons_;
+  std::vector<GenHadTau> genHadTaus_;
+  std::vector<GenJet> genJets_;
+};
+
+#endif // tthAnalysis_HiggsToTauTau_GenMatchTable_h
@@ -0,0 +1,81 @@
+#ifndef tthAnalysis_HiggsToTauTau_HistManagerDispatchTable_h
+#define tthAnalysis_HiggsToTauTau_HistManagerDispatchTable_h
+
+/** \class HistManagerDispatchTable
+ *
+ * Dense table of histogram managers, indexed by the lepton and hadronic tau generator level matching
+ * (the idx_ members of leptonGenMatchEntry and hadTauGenMatchEntry).
+ * The table is sized when the histogram managers are booked,
+ * so that selecting the histogram manager for an event is a plain array lookup.
+ *
+ */
+
+#include <FWCore/Utilities/interface/Exception.h> // cms::Exception
+
+#include <vector> // std::vector<>
+#include <cstddef> // std::size_t
+
+template <typename T>
+class HistManagerDispatchTable
+{
+ public:
+  HistManagerDispatchTable(int numLeptonGenMatches, int numHadTauGenMatches = 1)
+    : numLeptonGenMatches_(numLeptonGenMatches)
+    , numHadTauGenMatches_(numHadTauGenMatches)
+    , table_(numLeptonGenMatches*numHadTauGenMatches, 0)
+  {}
+  ~HistManagerDispatchTable() {}
+
+  void set(int idxLeptonGenMatch, int idxHadTauGenMatch, T* histManager)
+  {
+    if ( !isInRange(idxLeptonGenMatch, idxHadTauGenMatch) )
+      throw cms::Exception("HistManagerDispatchTable")
+	<< "Invalid indices: idxLeptonGenMatch = " << idxLeptonGenMatch << ", idxHadTauGenMatch = " << idxHadTauGenMatch
+	<< " (table has size " << numLeptonGenMatches_ << " x " << numHadTauGenMatches_ << ") !!\n";
+    table_[getIndex(idxLeptonGenMatch, idxHadTauGenMatch)] = histManager;
+  }
+
+  /**
+   * @brief Returns the histogram manager booked for the given generator level matching,
+   *        or 0 if no histogram manager has been booked for it
+   */
+  T* get(int idxLeptonGenMatch, int idxHadTauGenMatch = 0) const
+  {
+    if ( !isInRange(idxLeptonGenMatch, idxHadTauGenMatch) ) return 0;
+    return table_[getIndex(idxLeptonGenMatch, idxHadTauGenMatch)];
+  }
+
+  const std::vector<T*>& getAll() const { return table_; }
+
+ private:
+  bool isInRange(int idxLeptonGenMatch, int idxHadTauGenMatch) const
+  {
+    return idxLeptonGenMatch >= 0 && idxLeptonGenMatch < numLeptonGenMatches_ &&
+           idxHadTauGenMatch >= 0 && idxHadTauGenMatch < numHadTauGenMatches_;
+  }
+  std::size_t getIndex(int idxLeptonGenMatch, int idxHadTauGenMatch) const
+  {
+    return idxLeptonGenMatch*numHadTauGenMatches_ + idxHadTauGenMatch;
+  }
+
+  int numLeptonGenMatches_;
+  int numHadTauGenMatches_;
+  std::vector<T*> table_;
+};
+
+/**
+ * @brief Returns the size of a HistManagerDispatchTable dimension needed for the given generator level matching definitions
+ *        (the largest idx_ member plus one)
+ */
+template <typename T>
+int getNumGenMatches(const std::vector<T>& genMatch_definitions)
+{
+  int numGenMatches = 0;
+  for ( typename std::vector<T>::const_iterator genMatch_definition = genMatch_definitions.begin();
+	genMatch_definition != genMatch_definitions.end(); ++genMatch_definition ) {
+    if ( (genMatch_definition->idx_ + 1) > numGenMatches ) numGenMatches = genMatch_definition->idx_ + 1;
+  }
+  return numGenMatches;
+}
+
+#endif // tthAnalysis_HiggsToTauTau_HistManagerDispatchTable_h
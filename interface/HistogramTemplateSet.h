@@ -0,0 +1,72 @@
+#ifndef tthAnalysis_HiggsToTauTau_HistogramTemplateSet_h
+#define tthAnalysis_HiggsToTauTau_HistogramTemplateSet_h
+
+/** \class HistogramTemplateSet
+ *
+ * Immutable description (name, title and binning) of a set of one-dimensional histograms,
+ * shared by all systematic shifts and by all HistManagers that fill the same distributions.
+ *
+ * The bin contents are stored separately for each shift by ShiftedHistograms,
+ * so that filling the same distributions for many shifts in one job costs only the bin contents for each shift,
+ * instead of one TH1 object (name, title, axes and functions in addition to the bin contents) per shift.
+ *
+ */
+
+#include <TH1.h> // TH1
+
+#include <string> // std::string
+#include <vector> // std::vector
+
+class HistogramTemplateSet
+{
+ public:
+  HistogramTemplateSet() {}
+  ~HistogramTemplateSet() {}
+
+  /**
+   * @brief Add a histogram with uniform binning
+   * @return Index of the histogram, to be passed to ShiftedHistograms::fillWithOverFlow()
+   */
+  int add1D(const std::string& distribution, const std::string& title, int numBins, double min, double max);
+
+  /**
+   * @brief Add a histogram with variable binning (numBins + 1 bin edges)
+   */
+  int add1D(const std::string& distribution, const std::string& title, int numBins, const float* binning);
+
+  size_t getNumHistograms() const { return templates_.size(); }
+
+  const std::string& getDistribution(int idxHistogram) const;
+
+  /**
+   * @brief Returns the number of bins of a histogram, including underflow and overflow bins
+   */
+  int getNumCells(int idxHistogram) const;
+
+  /**
+   * @brief Returns the bin that contains the value given as function argument,
+   *        with values outside of the histogram range counted in the first or last bin (as in fillWithOverFlow)
+   */
+  int findBinWithOverFlow(int idxHistogram, double x) const;
+
+  /**
+   * @brief Create an empty TH1D with the binning of a histogram, in the current directory
+   */
+  TH1* makeHistogram(int idxHistogram, const std::string& histogramName) const;
+
+ private:
+  struct templateType
+  {
+    std::string distribution_;
+    std::string title_;
+    int numBins_;
+    double min_;
+    double max_;
+    std::vector<double> binning_; // empty for uniform binning
+  };
+  const templateType& getTemplate(int idxHistogram) const;
+
+  std::vector<templateType> templates_;
+};
+
+#endif // tthAnalysis_HiggsToTauTau_HistogramTemplateSet_h
@@ -14,6 +14,11 @@
 #include "tthAnalysis/HiggsToTauTau/interface/HistManagerBase.h" // HistManagerBase
 
 #include "tthAnalysis/HiggsToTauTau/interface/LHEInfoReader.h" // LHEInfoReader
+#include "tthAnalysis/HiggsToTauTau/interface/LHEWeightEngine.h" // LHEWeightEngine
+#include "tthAnalysis/HiggsToTauTau/interface/HistogramTemplateSet.h" // HistogramTemplateSet
+#include "tthAnalysis/HiggsToTauTau/interface/ShiftedHistograms.h" // ShiftedHistograms
+
+#include <memory> // std::shared_ptr<>, std::unique_ptr<>
 
 class LHEInfoHistManager : public HistManagerBase
 {
@@ -25,6 +30,16 @@ class LHEInfoHistManager : public HistManagerBase
   void bookHistograms(TFileDirectory& dir);
   void fillHistograms(const LHEInfoReader& lheInfoReader, double evtWeight = 1.);
 
+  /// book the histograms of the given template set for all scale and PDF variations of LHEWeightEngine;
+  /// the histograms are named <variation>_<distribution>, like the histograms booked by a HistManager with central_or_shift = <variation>.
+  /// The template set is shared by all LHEInfoHistManagers and the bin contents are allocated per variation when first filled,
+  /// so that the histograms need to be written by calling writeHistograms_variations at the end of the job
+  void bookHistograms_variations(TFileDirectory& dir, const LHEWeightEngine& lheWeightEngine,
+				 const std::shared_ptr<const HistogramTemplateSet>& histogramTemplates);
+  /// idxDistribution is the index of the histogram in the template set
+  void fillHistograms_variations(int idxDistribution, double value, const LHEWeightEngine& lheWeightEngine);
+  void writeHistograms_variations();
+
  private:
   TH1* histogram_scaleWeights_;
   TH1* histogram_pdfWeights_;
@@ -33,6 +48,9 @@ class LHEInfoHistManager : public HistManagerBase
   TH1* histogram_EventCounter_;
 
   std::vector<TH1*> histograms_;
+
+  std::unique_ptr<ShiftedHistograms> histograms_variations_;
+  TDirectory* dir_variations_;
 };
 
 #endif
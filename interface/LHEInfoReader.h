@@ -12,6 +12,9 @@
 
 enum { kLHE_scale_central, kLHE_scale_xUp, kLHE_scale_xDown, kLHE_scale_yUp, kLHE_scale_yDown };
 
+// index of the first PDF weight in the array returned by LHEInfoReader::getWeights
+enum { kLHE_pdf_offset = kLHE_scale_yDown + 1 };
+
 class LHEInfoReader
   : public ReaderBase
 {
@@ -38,6 +41,15 @@ class LHEInfoReader
   int getNumWeights_pdf() const;
   double getWeight_pdf(int idx) const;
 
+  /**
+   * @brief Return all scale and PDF weights of the current event as one contiguous array:
+   *        the entries with indices kLHE_scale_central (always 1), kLHE_scale_xUp, .., kLHE_scale_yDown hold the scale weights,
+   *        followed by max_pdf_nWeights PDF weights starting at index kLHE_pdf_offset
+   *       (PDF weights that are not stored in the Ntuple for the current event are set to 1)
+   */
+  const std::vector<double>& getWeights() const;
+  int getMaxNumWeights_pdf() const;
+
  protected:
  /**
    * @brief Initialize names of branches to be read from tree
@@ -58,10 +70,7 @@ class LHEInfoReader
   Int_t pdf_nWeights_;
   Float_t* pdf_weights_;
 
-  mutable double weight_scale_xUp_;
-  mutable double weight_scale_xDown_;
-  mutable double weight_scale_yUp_;
-  mutable double weight_scale_yDown_;
+  mutable std::vector<double> weights_;
 
   // CV: make sure that only one LHEInfoReader instance exists for a given branchName,
   //     as ROOT cannot handle multiple TTree::SetBranchAddress calls for the same branch.
@@ -0,0 +1,49 @@
+#ifndef tthAnalysis_HiggsToTauTau_LHEWeightEngine_h
+#define tthAnalysis_HiggsToTauTau_LHEWeightEngine_h
+
+/** \class LHEWeightEngine
+ *
+ * Compute the event weights for all LHE scale and PDF variations in one pass,
+ * so that the histograms for all variations can be filled in the same event loop
+ * (instead of running one analysis job per central_or_shift = "CMS_ttHl_thu_shape_*" value)
+ *
+ * The variations are ordered as follows:
+ *   0..3 : scale variations x1Up, x1Down, y1Up, y1Down, named <scaleShiftName>_x1Up etc.
+ *   4..  : PDF variations, named <pdfShiftName><idx>
+ *
+ */
+
+#include "tthAnalysis/HiggsToTauTau/interface/LHEInfoReader.h" // LHEInfoReader
+
+#include <string>
+#include <vector>
+
+class LHEWeightEngine
+{
+ public:
+  LHEWeightEngine(const std::string& scaleShiftName, const std::string& pdfShiftName, int numWeights_pdf);
+  ~LHEWeightEngine() {}
+
+  /**
+   * @brief Compute event weights for all variations,
+   *        by multiplying the nominal event weight with the scale and PDF weights of the current event
+   * @param lheInfoReader reader on which read() has been called for the current event
+   *        evtWeight     nominal event weight
+   */
+  void compute(const LHEInfoReader& lheInfoReader, double evtWeight);
+
+  size_t getNumVariations() const { return variationNames_.size(); }
+  const std::vector<std::string>& getVariationNames() const { return variationNames_; }
+
+  /**
+   * @brief Return event weights computed by the last call to compute(), in the same order as getVariationNames()
+   */
+  const std::vector<double>& getEvtWeights() const { return evtWeights_; }
+
+ private:
+  int numWeights_pdf_;
+  std::vector<std::string> variationNames_;
+  std::vector<double> evtWeights_;
+};
+
+#endif // tthAnalysis_HiggsToTauTau_LHEWeightEngine_h
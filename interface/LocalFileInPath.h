@@ -53,6 +53,13 @@
 //  2. All environment variables are read only once, when the FileInPath object is constructed.
 //     Therefore, any changes made to these variables externally during the lifetime of
 //     a FileInPath object will have no effect.
+//
+//  3. The files found in the search path are cached for the lifetime of the process,
+//     so that the filesystem is probed only once per relative path.
+//     The cache can be stored in and read from a manifest file, either explicitly
+//     via writeManifest() and readManifest() or by setting the environment variable
+//     LOCALFILEINPATH_MANIFEST: the manifest file is read if it exists, otherwise
+//     it is written when the process exits.
 
 
 // TODO: Find the correct package for this class to reside. It
@@ -114,6 +121,13 @@
     void read(std::istream& is);
 
     void readFromParameterSetBlob(std::istream& is);
+
+    /// Add the files listed in the given manifest file to the process-wide cache.
+    /// Manifest files written for a different search path are ignored.
+    static void readManifest(const std::string& manifestFileName);
+
+    /// Write the files found by this process to the given manifest file.
+    static void writeManifest(const std::string& manifestFileName);
   private:
     std::string    relativePath_;
     std::string    canonicalFilename_;
@@ -126,6 +140,7 @@
     // Helper function for construction.
     void getEnvironment();
     void initialize_();
+    void locate_();
   };
 
   // Free swap function
@@ -1,9 +1,7 @@
 #ifndef MEMPERMUTATIONWRITER_H
 #define MEMPERMUTATIONWRITER_H
 
-#include "tthAnalysis/HiggsToTauTau/interface/RecoHadTauCollectionSelectorLoose.h" // RecoHadTauCollectionSelectorLoose
-#include "tthAnalysis/HiggsToTauTau/interface/RecoHadTauCollectionSelectorFakeable.h" // RecoHadTauCollectionSelectorFakeable
-#include "tthAnalysis/HiggsToTauTau/interface/RecoHadTauCollectionSelectorTight.h" // RecoHadTauCollectionSelectorTight
+#include "tthAnalysis/HiggsToTauTau/interface/RecoHadTauCollectionSelectorMultiWP.h" // RecoHadTauCollectionSelectorMultiWP, RecoHadTauWorkingPointView
 
 #include <string> // std::string
 #include <vector> // std::vector<>
@@ -18,7 +16,7 @@ class RecoJet;
 
 typedef std::function<
     int(const std::vector<const RecoLepton*> & /*selLeptons*/,
-        const std::vector<const RecoHadTau*> & /*selHadTaus*/,
+        const RecoHadTauWorkingPointView & /*selHadTaus*/,
         const std::vector<const RecoJet*> & /*selBJets_loose*/,
         const std::vector<const RecoJet*> & /*selBJets_medium*/,
         bool /*failsZbosonMassVeto*/)
@@ -71,9 +69,7 @@ private:
 
   std::map<std::string, MEMPremutationCondition> conditions_;
   std::map<std::string, std::map<int, std::map<int, std::map<std::string, int>>>> branches_;
-  std::map<std::string, RecoHadTauCollectionSelectorLoose *>    hadTauSelectorsLoose_;
-  std::map<std::string, RecoHadTauCollectionSelectorFakeable *> hadTauSelectorsFakeable_;
-  std::map<std::string, RecoHadTauCollectionSelectorTight *>    hadTauSelectorsTight_;
+  RecoHadTauCollectionSelectorMultiWP * hadTauSelector_ = nullptr;
 
   std::string
   find_selection_str(int selection_idx);
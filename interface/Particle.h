@@ -9,6 +9,7 @@ class Particle
 {
  public:
   typedef math::PtEtaPhiMLorentzVector LorentzVector;
+  typedef math::PxPyPzELorentzVector LorentzVectorCartesian;
 
   Particle();
   Particle(Double_t pt,
@@ -37,6 +38,22 @@ class Particle
 
   virtual const Particle::LorentzVector& p4() const { return p4_; }
 
+  /**
+   * @brief 4-momentum in Cartesian coordinates (px, py, pz, E), computed on the first call
+   *
+   * NOTE: adding two 4-vectors in (pT, eta, phi, mass) coordinates converts both of them to Cartesian coordinates
+   *       (calling sin, cos and sinh) and converts the sum back; the Cartesian 4-momenta can be added without any conversion,
+   *       so they should be used when summing the 4-momenta of many pairs or triplets of particles
+   */
+  const Particle::LorentzVectorCartesian& p4_cartesian() const
+  {
+    if ( !p4_cartesian_isValid_ ) {
+      p4_cartesian_ = Particle::LorentzVectorCartesian(p4_);
+      p4_cartesian_isValid_ = true;
+    }
+    return p4_cartesian_;
+  }
+
  protected:
   Double_t pt_;   ///< pT of the particle
   Double_t eta_;  ///< eta of the particle
@@ -47,6 +64,9 @@ class Particle
 
   Particle::LorentzVector p4_; ///< 4-momentum constructed from the pT, eta, phi and mass
 
+  mutable Particle::LorentzVectorCartesian p4_cartesian_; ///< p4_ in Cartesian coordinates, computed on the first call to p4_cartesian()
+  mutable bool p4_cartesian_isValid_;                      ///< true if p4_cartesian_ has been computed
+
   bool isValid_; ///< true if the particle is physical (meaning that its pT > 0)
 };
 
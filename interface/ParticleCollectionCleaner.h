@@ -1,6 +1,8 @@
 #ifndef tthAnalysis_HiggsToTauTau_ParticleCollectionCleaner_h
 #define tthAnalysis_HiggsToTauTau_ParticleCollectionCleaner_h
 
+#include "tthAnalysis/HiggsToTauTau/interface/EventGeometry.h" // EventGeometry
+
 #include <DataFormats/Math/interface/deltaR.h> // deltaR()
 
 template <typename T>
@@ -9,9 +11,19 @@ class ParticleCollectionCleaner
 public:
   ParticleCollectionCleaner(double dR = 0.4)
     : dR_(dR)
+    , geometry_(nullptr)
   {}
   ~ParticleCollectionCleaner() {}
 
+  /**
+   * @brief Take the distances between particles from the cache of the current event instead of computing them
+   */
+  void
+  setGeometry(const EventGeometry * geometry)
+  {
+    geometry_ = geometry;
+  }
+
   /**
    * @brief Select subset of particles not overlapping with any of the other particles passed as function argument
    * @return Collection of non-overlapping particles
@@ -26,7 +38,8 @@ public:
       bool isOverlap = false;
       for(const Toverlap* overlap: overlaps)
       {
-        const double dRoverlap = deltaR(particle->eta(), particle->phi(), overlap->eta(), overlap->phi());
+        const double dRoverlap = geometry_ ? geometry_->dR(*particle, *overlap) :
+                                             deltaR(particle->eta(), particle->phi(), overlap->eta(), overlap->phi());
         if(dRoverlap < dR_)
         {
           isOverlap = true;
@@ -52,7 +65,8 @@ public:
       bool isOverlap = false;
       for(const Toverlap* overlap: overlaps)
       {
-        const double dRoverlap = deltaR(particle->eta(), particle->phi(), overlap->eta(), overlap->phi());
+        const double dRoverlap = geometry_ ? geometry_->dR(*particle, *overlap) :
+                                             deltaR(particle->eta(), particle->phi(), overlap->eta(), overlap->phi());
         if(dRoverlap < dR_)
         {
           isOverlap = true;
@@ -69,6 +83,7 @@ public:
 
 protected:
   double dR_;
+  const EventGeometry * geometry_;
 };
 
 #include "tthAnalysis/HiggsToTauTau/interface/RecoElectron.h"
@@ -1,6 +1,8 @@
 #ifndef READERBASE_H
 #define READERBASE_H
 
+#include "tthAnalysis/HiggsToTauTau/interface/BranchBufferRegistry.h" // BranchBufferRegistry
+
 class TTree; // forward declaration
 
 class ReaderBase
@@ -11,6 +13,19 @@ public:
 
   virtual void
   setBranchAddresses(TTree * tree) = 0;
+
+  /**
+   * @brief Request the buffers for all branches from a registry shared with other readers
+   * @param branchBuffers The registry, bound to the input tree
+   *
+   * @note Readers that do not (yet) take their buffers from the registry
+   *       set the branch addresses on the tree the registry is bound to
+   */
+  virtual void
+  setBranchBuffers(BranchBufferRegistry & branchBuffers)
+  {
+    setBranchAddresses(branchBuffers.getTree());
+  }
 };
 
 #endif // READERBASE_H
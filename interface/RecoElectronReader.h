@@ -11,6 +11,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <memory> // std::shared_ptr<>
 
 class RecoElectronReader
   : public ReaderBase
@@ -25,6 +26,11 @@ class RecoElectronReader
    */
   void setBranchAddresses(TTree* tree) override;
 
+  /**
+   * @brief Request the buffers for all lepton branches specific to RecoElectrons from the registry
+   */
+  void setBranchBuffers(BranchBufferRegistry& branchBuffers) override;
+
   /**
    * @brief Read branches from tree and use information to fill collection of RecoElectron objects
    * @return Collection of RecoElectron objects
@@ -62,10 +68,9 @@ class RecoElectronReader
   Int_t* lostHits_;
   Int_t* conversionVeto_;
 
-  // CV: make sure that only one RecoElectronReader instance exists for a given branchName,
-  //     as ROOT cannot handle multiple TTree::SetBranchAddress calls for the same branch.
-  static std::map<std::string, int> numInstances_;
-  static std::map<std::string, RecoElectronReader*> instances_;
+  // CV: the buffers are owned by the BranchBufferRegistry shared by all readers of the same tree
+  //     (set only if the reader is bound directly to a TTree rather than through TTreeWrapper)
+  std::shared_ptr<BranchBufferRegistry> branchBuffers_;
 };
 
 #endif // tthAnalysis_HiggsToTauTau_RecoElectronReader_h
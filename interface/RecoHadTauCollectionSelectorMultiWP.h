@@ -0,0 +1,162 @@
+#ifndef tthAnalysis_HiggsToTauTau_RecoHadTauCollectionSelectorMultiWP_h
+#define tthAnalysis_HiggsToTauTau_RecoHadTauCollectionSelectorMultiWP_h
+
+#include "tthAnalysis/HiggsToTauTau/interface/RecoHadTau.h" // RecoHadTau
+#include "tthAnalysis/HiggsToTauTau/interface/RecoHadTauCollectionSelectorLoose.h" // RecoHadTauSelectorLoose
+
+#include <string> // std::string
+#include <vector> // std::vector<>
+#include <cstdint> // std::uint32_t
+#include <cstddef> // std::size_t, std::ptrdiff_t
+#include <iterator> // std::forward_iterator_tag
+
+/**
+ * @brief Bitmask holding the result of all tau ID working points evaluated for a single hadronic tau;
+ *        bit i is set if the tau passes the i-th working point registered in RecoHadTauCollectionSelectorMultiWP
+ */
+typedef std::uint32_t hadTauWorkingPointMask;
+
+/**
+ * @brief Zero-copy view of the subset of hadronic taus that pass a given working point.
+ *
+ * The view refers to the input collection and to the bitmasks computed by RecoHadTauCollectionSelectorMultiWP,
+ * so it is only valid until the next call to RecoHadTauCollectionSelectorMultiWP::operator()
+ */
+class RecoHadTauWorkingPointView
+{
+ public:
+  RecoHadTauWorkingPointView(const std::vector<const RecoHadTau*>& hadTaus,
+                             const std::vector<hadTauWorkingPointMask>& masks,
+                             hadTauWorkingPointMask bit)
+    : hadTaus_(&hadTaus)
+    , masks_(&masks)
+    , bit_(bit)
+  {}
+
+  class const_iterator
+  {
+   public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef const RecoHadTau* value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const RecoHadTau* const* pointer;
+    typedef const RecoHadTau* const& reference;
+
+    const_iterator(const RecoHadTauWorkingPointView* view, std::size_t idx)
+      : view_(view)
+      , idx_(idx)
+    {
+      skip();
+    }
+
+    reference operator*() const { return (*view_->hadTaus_)[idx_]; }
+    const_iterator& operator++() { ++idx_; skip(); return *this; }
+    const_iterator operator++(int) { const_iterator tmp(*this); ++(*this); return tmp; }
+    bool operator==(const const_iterator& other) const { return idx_ == other.idx_; }
+    bool operator!=(const const_iterator& other) const { return idx_ != other.idx_; }
+
+    /**
+     * @brief Position of the current hadronic tau in the input collection
+     */
+    std::size_t index() const { return idx_; }
+
+   private:
+    void skip()
+    {
+      const std::size_t numHadTaus = view_->hadTaus_->size();
+      while ( idx_ < numHadTaus && !((*view_->masks_)[idx_] & view_->bit_) ) ++idx_;
+    }
+
+    const RecoHadTauWorkingPointView* view_;
+    std::size_t idx_;
+  };
+
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, hadTaus_->size()); }
+
+  /**
+   * @brief Number of hadronic taus passing the working point
+   */
+  std::size_t size() const;
+  bool empty() const { return begin() == end(); }
+
+  /**
+   * @brief Check if hadronic tau at position idx of the input collection passes the working point
+   */
+  bool passes(std::size_t idx) const { return (*masks_)[idx] & bit_; }
+
+  /**
+   * @brief Copy the selected hadronic taus into a new collection, for interfaces that require std::vector
+   */
+  std::vector<const RecoHadTau*> toVector() const;
+
+ private:
+  const std::vector<const RecoHadTau*>* hadTaus_;
+  const std::vector<hadTauWorkingPointMask>* masks_;
+  hadTauWorkingPointMask bit_;
+};
+
+/**
+ * @brief Evaluate several tau ID working points in a single pass over the hadronic tau collection.
+ *
+ * The cuts that do not depend on the working point (pT, eta, dz, decayModeFinding, anti-electron and anti-muon discriminators)
+ * are applied once per tau; the result of each working point is then stored as one bit in a per-tau bitmask.
+ * The working points are specified by the same strings as accepted by RecoHadTauSelectorBase::set.
+ * In contrast to RecoHadTauCollectionSelectorLoose/Fakeable/Tight, no selection flags are set on the hadronic taus.
+ */
+class RecoHadTauCollectionSelectorMultiWP
+{
+ public:
+  explicit RecoHadTauCollectionSelectorMultiWP(int era, bool debug = false);
+  ~RecoHadTauCollectionSelectorMultiWP() {}
+
+  void set_min_pt(double min_pt) { commonSelector_.set_min_pt(min_pt); }
+  void set_max_absEta(double max_absEta) { commonSelector_.set_max_absEta(max_absEta); }
+  void set_min_antiElectron(int min_antiElectron) { commonSelector_.set_min_antiElectron(min_antiElectron); }
+  void set_min_antiMuon(int min_antiMuon) { commonSelector_.set_min_antiMuon(min_antiMuon); }
+
+  /**
+   * @brief Register working point (e.g. "dR03mvaTight")
+   * @return Index of the working point, to be passed to getView() and passes()
+   */
+  std::size_t addWorkingPoint(const std::string& cut);
+
+  std::size_t getWorkingPointIndex(const std::string& cut) const;
+  const std::vector<std::string>& getWorkingPoints() const { return workingPoints_; }
+
+  /**
+   * @brief Evaluate all registered working points for the hadronic taus given as function argument
+   * @return Bitmasks, one per hadronic tau, in the same order as the input collection
+   */
+  const std::vector<hadTauWorkingPointMask>& operator()(const std::vector<const RecoHadTau*>& hadTaus);
+
+  /**
+   * @brief Collection of hadronic taus passing the working point with index wpIdx,
+   *        computed by the last call to operator()
+   */
+  RecoHadTauWorkingPointView getView(std::size_t wpIdx) const;
+
+  /**
+   * @brief Check if hadronic tau at position idx of the last input collection passes the working point with index wpIdx
+   */
+  bool passes(std::size_t idx, std::size_t wpIdx) const { return masks_[idx] & (hadTauWorkingPointMask(1) << wpIdx); }
+
+  hadTauWorkingPointMask getMask(std::size_t idx) const { return masks_[idx]; }
+
+ protected:
+  /**
+   * @brief Compute the bitmask for a single hadronic tau
+   */
+  hadTauWorkingPointMask compMask(const RecoHadTau& hadTau) const;
+
+  bool debug_;
+  RecoHadTauSelectorLoose commonSelector_; ///< applies working-point independent cuts
+  std::vector<std::string> workingPoints_;
+  std::vector<Int_t> min_id_mva_dR03_;     ///< lower cut threshold on MVA-based tau id (dR=0.3), one entry per working point
+  std::vector<Int_t> min_id_cut_dR05_;     ///< lower cut threshold on cut-based tau id (dR=0.5), one entry per working point
+
+  const std::vector<const RecoHadTau*>* hadTaus_; ///< input collection of the last call to operator()
+  std::vector<hadTauWorkingPointMask> masks_;
+};
+
+#endif // tthAnalysis_HiggsToTauTau_RecoHadTauCollectionSelectorMultiWP_h
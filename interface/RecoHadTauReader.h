@@ -8,6 +8,7 @@
 #include "tthAnalysis/HiggsToTauTau/interface/GenHadTau.h" // GenHadTau
 #include "tthAnalysis/HiggsToTauTau/interface/GenJetReader.h" // GenJetReader
 #include "tthAnalysis/HiggsToTauTau/interface/GenJet.h" // GenJet
+#include "tthAnalysis/HiggsToTauTau/interface/GenMatchTable.h" // GenMatchTable
 #include "tthAnalysis/HiggsToTauTau/interface/ReaderBase.h" // ReaderBase
 
 #include <Rtypes.h> // Int_t, Float_t
@@ -75,6 +76,7 @@ class RecoHadTauReader
   GenHadTauReader* genHadTauReader_;
   GenJetReader* genJetReader_;
   bool readGenMatching_;
+  mutable GenMatchTable genMatchTable_;
 
   std::string branchName_pt_;
   std::string branchName_eta_;
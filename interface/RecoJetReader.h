@@ -8,6 +8,7 @@
 #include "tthAnalysis/HiggsToTauTau/interface/GenHadTau.h" // GenHadTau
 #include "tthAnalysis/HiggsToTauTau/interface/GenJetReader.h" // GenJetReader
 #include "tthAnalysis/HiggsToTauTau/interface/GenJet.h" // GenJet
+#include "tthAnalysis/HiggsToTauTau/interface/GenMatchTable.h" // GenMatchTable
 #include "tthAnalysis/HiggsToTauTau/interface/analysisAuxFunctions.h" // kEra_2015, kEra_2016
 #include "tthAnalysis/HiggsToTauTau/interface/ReaderBase.h" // ReaderBase
 
@@ -17,6 +18,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <memory> // std::shared_ptr<>
 
 class RecoJetReader
   : public ReaderBase
@@ -38,6 +40,11 @@ class RecoJetReader
    */
   void setBranchAddresses(TTree* tree) override;
 
+  /**
+   * @brief Request the buffers for all RecoJet branches from the registry
+   */
+  void setBranchBuffers(BranchBufferRegistry& branchBuffers) override;
+
   /**
    * @brief Read branches from tree and use information to fill collection of RecoJet objects
    * @return Collection of RecoJet objects
@@ -67,6 +74,7 @@ class RecoJetReader
   GenHadTauReader* genHadTauReader_;
   GenJetReader* genJetReader_;
   bool readGenMatching_;
+  mutable GenMatchTable genMatchTable_;
  
   std::string branchName_pt_;
   std::string branchName_eta_;
@@ -86,7 +94,7 @@ class RecoJetReader
 
   bool read_BtagWeight_systematics_;
 
-  Int_t nJets_;
+  Int_t* nJets_;
   Float_t* jet_pt_;
   Float_t* jet_eta_;
   Float_t* jet_phi_;
@@ -101,10 +109,14 @@ class RecoJetReader
 
   std::map<int, Float_t*> jet_BtagWeights_systematics_; // CV: needed by RecoJetWriter
 
-  // CV: make sure that only one RecoJetReader instance exists for a given branchName,
-  //     as ROOT cannot handle multiple TTree::SetBranchAddress calls for the same branch.
-  static std::map<std::string, int> numInstances_;
-  static std::map<std::string, RecoJetReader*> instances_;
+  // default values for the branches that are not read from the tree
+  std::vector<Float_t> jet_BtagWeight_default_;
+  std::vector<Float_t> jet_QGDiscr_default_;
+  std::vector<Int_t> jet_heppyFlavour_default_;
+
+  // CV: the buffers are owned by the BranchBufferRegistry shared by all readers of the same tree
+  //     (set only if the reader is bound directly to a TTree rather than through TTreeWrapper)
+  std::shared_ptr<BranchBufferRegistry> branchBuffers_;
 };
 
 #endif // tthAnalysis_HiggsToTauTau_RecoJetReader_h
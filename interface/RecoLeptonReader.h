@@ -8,6 +8,7 @@
 #include "tthAnalysis/HiggsToTauTau/interface/GenHadTau.h" // GenHadTau
 #include "tthAnalysis/HiggsToTauTau/interface/GenJetReader.h" // GenJetReader
 #include "tthAnalysis/HiggsToTauTau/interface/GenJet.h" // GenJet
+#include "tthAnalysis/HiggsToTauTau/interface/GenMatchTable.h" // GenMatchTable
 #include "tthAnalysis/HiggsToTauTau/interface/ReaderBase.h" // ReaderBase
 
 #include <Rtypes.h> // Int_t, Float_t
@@ -16,6 +17,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <memory> // std::shared_ptr<>
 
 class RecoLeptonReader
   : public ReaderBase
@@ -26,10 +28,16 @@ class RecoLeptonReader
   ~RecoLeptonReader();
 
   /**
-   * @brief Call tree->SetBranchAddress for all lepton branches common to RecoElectrons and RecoMuons
+   * @brief Call tree->SetBranchAddress for all lepton branches common to RecoElectrons and RecoMuons,
+   *        using the buffers shared by all readers of this tree
    */
   void setBranchAddresses(TTree* tree) override;
 
+  /**
+   * @brief Request the buffers for all lepton branches common to RecoElectrons and RecoMuons from the registry
+   */
+  void setBranchBuffers(BranchBufferRegistry& branchBuffers) override;
+
   friend class RecoElectronReader;
   friend class RecoMuonReader;
 
@@ -46,36 +54,27 @@ class RecoLeptonReader
   /**
    * @brief Read branches containing information on matching of RecoElectrons and RecoMuons
    *        to generator level electrons, muons, hadronic taus, and jets from tree
-   *        and add this information to collection of RecoElectron and RecoMuon objects given as function argument
+   */
+  void readGenMatching() const;
+
+  /**
+   * @brief Add information on matching to generator level particles to the RecoElectron or RecoMuon object given as function argument
+   * @param lepton    RecoElectron or RecoMuon object
+   *        idxLepton index of the lepton in the Ntuple
+   *
+   * @note readGenMatching() needs to be called first
    */
   template<typename T>
-  void readGenMatching(std::vector<T>& leptons) const
+  void linkGenMatching(T& lepton, int idxLepton) const
   {
-    if ( readGenMatching_ ) {
-      assert(genLeptonReader_ && genHadTauReader_ && genJetReader_);
-      size_t nLeptons = leptons.size();
-      std::vector<GenLepton> matched_genLeptons = genLeptonReader_->read();
-      assert(matched_genLeptons.size() == nLeptons);
-      std::vector<GenHadTau> matched_genHadTaus = genHadTauReader_->read();
-      assert(matched_genHadTaus.size() == nLeptons);
-      std::vector<GenJet> matched_genJets = genJetReader_->read();
-      assert(matched_genJets.size() == nLeptons);
-      for ( size_t idxLepton = 0; idxLepton < nLeptons; ++idxLepton ) {
-	T* lepton = &leptons[idxLepton];
-	const GenLepton& matched_genLepton = matched_genLeptons[idxLepton];
-	if ( matched_genLepton.isValid() ) lepton->set_genLepton(new GenLepton(matched_genLepton), true);
-	const GenHadTau& matched_genHadTau = matched_genHadTaus[idxLepton];
-	if ( matched_genHadTau.isValid() ) lepton->set_genHadTau(new GenHadTau(matched_genHadTau), true);
-	const GenJet& matched_genJet = matched_genJets[idxLepton];
-	if ( matched_genJet.isValid() ) lepton->set_genJet(new GenJet(matched_genJet), true);
-      }
-    }
+    if ( readGenMatching_ ) genMatchTable_.link(lepton, idxLepton);
   }
 
   GenLeptonReader* genLeptonReader_;
   GenHadTauReader* genHadTauReader_;
   GenJetReader* genJetReader_;
   bool readGenMatching_;
+  mutable GenMatchTable genMatchTable_;
 
   std::string branchName_pt_;
   std::string branchName_eta_;
@@ -97,7 +96,7 @@ class RecoLeptonReader
   std::string branchName_tightCharge_;
   std::string branchName_charge_;
 
-  Int_t nLeptons_;
+  Int_t* nLeptons_;
   Float_t* pt_;
   Float_t* eta_;
   Float_t* phi_;
@@ -118,10 +117,10 @@ class RecoLeptonReader
   Int_t* tightCharge_;
   Int_t* charge_;
 
-  // CV: make sure that only one RecoLeptonReader instance exists for a given branchName,
-  //     as ROOT cannot handle multiple TTree::SetBranchAddress calls for the same branch.
-  static std::map<std::string, int> numInstances_;
-  static std::map<std::string, RecoLeptonReader*> instances_;
+  // CV: ROOT cannot handle multiple TTree::SetBranchAddress calls for the same branch,
+  //     so the buffers are owned by a BranchBufferRegistry that is shared by all readers of the same tree
+  //     (set only if the reader is bound directly to a TTree rather than through TTreeWrapper)
+  std::shared_ptr<BranchBufferRegistry> branchBuffers_;
 };
 
 #endif // tthAnalysis_HiggsToTauTau_RecoLeptonReader_h
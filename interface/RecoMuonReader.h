@@ -11,6 +11,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <memory> // std::shared_ptr<>
 
 class RecoMuonReader
   : public ReaderBase
@@ -34,6 +35,11 @@ class RecoMuonReader
    */
   void setBranchAddresses(TTree* tree) override;
 
+  /**
+   * @brief Request the buffers for all lepton branches specific to RecoMuons from the registry
+   */
+  void setBranchBuffers(BranchBufferRegistry& branchBuffers) override;
+
   /**
    * @brief Read branches from tree and use information to fill collection of RecoMuon objects
    * @return Collection of RecoMuon objects
@@ -67,10 +73,9 @@ class RecoMuonReader
 #endif
   Float_t* segmentCompatibility_;
 
-  // CV: make sure that only one RecoMuonReader instance exists for a given branchName,
-  //     as ROOT cannot handle multiple TTree::SetBranchAddress calls for the same branch.
-  static std::map<std::string, int> numInstances_;
-  static std::map<std::string, RecoMuonReader*> instances_;
+  // CV: the buffers are owned by the BranchBufferRegistry shared by all readers of the same tree
+  //     (set only if the reader is bound directly to a TTree rather than through TTreeWrapper)
+  std::shared_ptr<BranchBufferRegistry> branchBuffers_;
 };
 
 #endif // tthAnalysis_HiggsToTauTau_RecoMuonReader_h
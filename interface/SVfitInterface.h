@@ -0,0 +1,49 @@
+#ifndef tthAnalysis_HiggsToTauTau_SVfitInterface_h
+#define tthAnalysis_HiggsToTauTau_SVfitInterface_h
+
+#include "tthAnalysis/HiggsToTauTau/interface/RecoLepton.h" // RecoLepton
+#include "tthAnalysis/HiggsToTauTau/interface/RecoHadTau.h" // RecoHadTau
+#include "tthAnalysis/HiggsToTauTau/interface/RecoMEt.h" // RecoMEt
+
+#include "TauAnalysis/ClassicSVfit/interface/MeasuredTauLepton.h" // classic_svFit::MeasuredTauLepton
+
+#include <vector> // std::vector<>
+
+class ClassicSVfit;
+
+/**
+ * @brief Reconstruct the mass of the tau pair with the ClassicSVfit algorithm
+ *
+ * A single ClassicSVfit instance is kept for the lifetime of this object, instead of constructing it for every event.
+ */
+class SVfitInterface
+{
+ public:
+  /**
+   * @param logM_kappa Strength of the log(M) regularization term; a value <= 0 disables the term
+   */
+  SVfitInterface(double logM_kappa);
+  ~SVfitInterface();
+
+  /**
+   * @brief Build input to SVfit for a given lepton or hadronic tau
+   */
+  static classic_svFit::MeasuredTauLepton
+  getMeasuredTauLepton(const RecoLepton * lepton);
+
+  static classic_svFit::MeasuredTauLepton
+  getMeasuredTauLepton(const RecoHadTau * hadTau);
+
+  /**
+   * @brief Reconstruct the mass of the tau pair
+   * @return Mass of the tau pair, or -1 if the integration did not find a valid solution
+   */
+  double
+  operator()(const std::vector<classic_svFit::MeasuredTauLepton> & measuredTauLeptons,
+             const RecoMEt & met);
+
+ private:
+  ClassicSVfit * svFitAlgo_;
+};
+
+#endif // tthAnalysis_HiggsToTauTau_SVfitInterface_h
@@ -0,0 +1,63 @@
+#ifndef tthAnalysis_HiggsToTauTau_ShiftedHistograms_h
+#define tthAnalysis_HiggsToTauTau_ShiftedHistograms_h
+
+/** \class ShiftedHistograms
+ *
+ * Bin contents of the histograms of a HistogramTemplateSet for a list of systematic shifts.
+ *
+ * The bin contents of a histogram are allocated for a shift when the histogram is filled for this shift for the first time;
+ * until then, the histogram is empty and takes no memory.
+ * The TH1 objects are created only when the histograms are written, one at a time,
+ * and are named <shift>_<distribution> (or <distribution> for the shift "central"),
+ * like the histograms booked by HistManagers for a given central_or_shift.
+ *
+ */
+
+#include "tthAnalysis/HiggsToTauTau/interface/HistogramTemplateSet.h" // HistogramTemplateSet
+
+#include <TDirectory.h> // TDirectory
+
+#include <memory> // std::shared_ptr<>
+#include <string> // std::string
+#include <vector> // std::vector
+
+class ShiftedHistograms
+{
+ public:
+  ShiftedHistograms(const std::shared_ptr<const HistogramTemplateSet>& histogramTemplates, const std::vector<std::string>& shifts);
+  ~ShiftedHistograms() {}
+
+  void fillWithOverFlow(int idxHistogram, int idxShift, double x, double evtWeight, double evtWeightErr = 0.);
+
+  /**
+   * @brief Fill the same value into the histogram for all shifts, with the event weight given for each shift
+   */
+  void fillWithOverFlow(int idxHistogram, double x, const std::vector<double>& evtWeights);
+
+  /**
+   * @brief Create the TH1 objects for all histograms and shifts in the directory given as function argument, write and delete them
+   */
+  void write(TDirectory* dir) const;
+
+  /**
+   * @brief Returns the number of bytes allocated for bin contents
+   */
+  size_t getMemoryUsage() const;
+
+ private:
+  struct contentType
+  {
+    contentType() : numEntries_(0.) {}
+    std::vector<double> sumw_;
+    std::vector<double> sumw2_;
+    double numEntries_;
+  };
+
+  contentType& getContent(int idxHistogram, int idxShift);
+
+  std::shared_ptr<const HistogramTemplateSet> histogramTemplates_;
+  std::vector<std::string> shifts_;
+  std::vector<contentType> contents_; // indexed by idxShift*numHistograms + idxHistogram
+};
+
+#endif // tthAnalysis_HiggsToTauTau_ShiftedHistograms_h
@@ -26,6 +26,13 @@ public:
   ~SyncNtupleManager();
 
   void initializeBranches();
+  /**
+   * @brief Creates one branch per distinct HLT path
+   * @param hltPaths Collections of HLT paths
+   *
+   * @note Must be called only once; read(hltPaths) must be given the same
+   *       collections, in the same order
+   */
   void initializeHLTBranches(const std::vector<std::vector<hltPath *>> & hltPaths);
   void readRunLumiEvent(UInt_t run,
                         UInt_t lumi,
@@ -164,7 +171,9 @@ private:
   Float_t MHT;
   Float_t metLD;
 
-  std::map<std::string, Int_t> hltMap;
+  std::vector<Int_t> hltValues;                    // one value per HLT branch, in alphabetical order of the branch names
+  std::vector<std::vector<std::size_t>> hltIdxs;   // hltIdxs[i][j] = index in hltValues of the j-th path in the i-th collection
+                                                   // passed to initializeHLTBranches()
 
   Float_t lep0_conept;
   Float_t lep1_conept;
@@ -0,0 +1,75 @@
+#ifndef TTREEOUTPUTWRITER_H
+#define TTREEOUTPUTWRITER_H
+
+#include <Rtypes.h> // Long64_t
+
+#include <string> // std::string
+#include <chrono> // std::chrono::
+#include <ostream> // std::ostream
+
+// forward declarations
+class TTree;
+
+/**
+ * @brief Wrapper around the output TTree of produceNtuple and preselNtuple_*,
+ *        which tunes the TTree for write throughput
+ *
+ * - compression algorithm and level of the output file are configurable:
+ *   LZ4 is fast to write and to read and thus suited for intermediate Ntuples,
+ *   LZMA gives the smallest files and is thus suited for archival;
+ * - the basket sizes are optimized after the first numEntries_autoFlush entries:
+ *   the baskets of all branches are flushed after every numEntries_autoFlush entries,
+ *   and ROOT resizes the baskets according to the size of the branches at the first flush;
+ * - the baskets can be compressed in parallel by ROOT's implicit multi-threading.
+ *
+ * The time spent in TTree::Fill() and the number of bytes written are reported by printStatistics().
+ */
+class TTreeOutputWriter
+{
+public:
+  /**
+   * @brief Default constructor
+   * @param tree                 Output TTree (not owned by this class)
+   * @param compression          Compression algorithm: "LZ4", "LZMA", "ZLIB"; or an empty string to keep the setting of the output file
+   * @param compressionLevel     Compression level (1-9)
+   * @param numEntries_autoFlush Number of entries after which the baskets are flushed and their sizes optimized;
+   *                             0 keeps the ROOT default (flush after 30 MB)
+   * @param numThreads           Number of threads used for compressing the baskets;
+   *                             0 or 1 disables the implicit multi-threading
+   *
+   * @note Will throw if the compression algorithm is not recognized or not supported by the ROOT version
+   */
+  TTreeOutputWriter(TTree * tree,
+                    const std::string & compression,
+                    int compressionLevel,
+                    Long64_t numEntries_autoFlush,
+                    unsigned numThreads = 0);
+
+  /**
+   * @brief Fills the current event to the output TTree
+   * @return Number of bytes written, as returned by TTree::Fill()
+   */
+  int
+  fill();
+
+  /**
+   * @brief Prints the number of entries and bytes written, the compression factor and the write rate
+   */
+  void
+  printStatistics(std::ostream & stream) const;
+
+  /**
+   * @brief Converts the name of the compression algorithm and the compression level to ROOT compression settings
+   */
+  static int
+  getCompressionSettings(const std::string & compression,
+                         int compressionLevel);
+
+private:
+  TTree * tree_;
+  Long64_t numEntries_;
+  Long64_t numBytes_;
+  std::chrono::duration<double> fillTime_;
+};
+
+#endif // TTREEOUTPUTWRITER_H
@@ -5,11 +5,15 @@
 #include <string> // std::string
 #include <type_traits> // std::is_base_of<,>, std::enable_if<>
 #include <algorithm> // std::transform()
+#include <memory> // std::unique_ptr<>
 
 // forward declarations
 class TFile;
 class TTree;
 class ReaderBase;
+class BranchBufferRegistry;
+class EventIndex;
+class EventLoopProfiler;
 
 /**
  * @brief Alternative class to TChain for reading
@@ -135,6 +139,9 @@ public:
    * @return Reference to this object
    *
    * @note The reader object must implement setBranchAddresses() function
+   * @note The readers take their buffers from a BranchBufferRegistry owned by this object,
+   *       via ReaderBase::setBranchBuffers(), so that the branches requested by several readers
+   *       are read into the same buffer
    * @note Expected usage:
    *         TTreeWrapper wrapper;
    *         wrapper.register(reader1)
@@ -172,6 +179,32 @@ public:
     return *this;
   }
 
+  /**
+   * @brief Read only the entries selected by an event index
+   * @param eventIndex Pointer to EventIndex instance, or nullptr to read all entries
+   * @return Reference to this object
+   *
+   * @note Files that do not contain any selected entries are not opened at all;
+   *       the remaining files are read entry by entry via TTree::GetEntry()
+   *       on the selected entries only
+   * @note Every input file must be listed in the event index, otherwise hasNextEvent() throws
+   * @note This class won't own the pointer
+   */
+  TTreeWrapper &
+  setEventIndex(const EventIndex * eventIndex);
+
+  /**
+   * @brief Attribute the time spent in reading the events to the ,,read'' stage of a profiler
+   * @param profiler Pointer to EventLoopProfiler instance, or nullptr to disable the profiling
+   * @return Reference to this object
+   *
+   * @note The profiler is switched to the ,,read'' stage whenever hasNextEvent() is called,
+   *       and the number of events read is counted by the profiler
+   * @note This class won't own the pointer
+   */
+  TTreeWrapper &
+  setProfiler(EventLoopProfiler * profiler);
+
   /**
    * @brief Checks if it is possible to reader next event from the list of files
    *        and, if so, proceeds to read it
@@ -205,9 +238,13 @@ private:
   std::string treeName_;                ///< Name of the input TTree
   std::vector<std::string> fileNames_;  ///< List of input files
   std::vector<ReaderBase *> readers_;   ///< List of pointers to *Reader objects
+  std::unique_ptr<BranchBufferRegistry> branchBuffers_; ///< Buffers shared by the readers, bound to currently open TTree
   unsigned fileCount_;                  ///< Total number of input files
   long long cumulativeMaxEventCount_;   ///< Sum of total nof events across all processed files
   mutable long long eventCount_;        ///< Total number of events across all files
+  const EventIndex * eventIndex_;       ///< Optional event index restricting the entries to be read
+  std::vector<long long> currentEntries_; ///< Entries to be read in currently open file (if eventIndex_ is set)
+  EventLoopProfiler * profiler_;        ///< Optional profiler of the event loop
 
   /**
    * @brief Closes a currently open file, if there is any
@@ -12,6 +12,7 @@
  */
 
 #include "tthAnalysis/HiggsToTauTau/interface/HistManagerBase.h" // HistManagerBase
+#include "tthAnalysis/HiggsToTauTau/interface/EventWeightCalculator.h" // EventWeightCalculator
 
 #include <string> // std::string
 #include <map> // std::map
@@ -28,6 +29,8 @@ class WeightHistManager
   void bookHistograms(TFileDirectory& dir, const std::vector<std::string>& weight_names);
   void bookHistograms(TFileDirectory& dir) { assert (0); } // call bookHistograms(TFileDirectory& dir, const std::vector<std::string>& weight_names) instead !!
   void fillHistograms(const std::string& weight_name, double weight_value);
+  /// fill histograms for all components of the event weight for which a histogram of the same name has been booked
+  void fillHistograms(const EventWeightCalculator& evtWeightCalculator, int idxShift = 0);
 
  private:
   struct binningOptionType
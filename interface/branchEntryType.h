@@ -54,6 +54,14 @@ struct branchEntryBaseType
   virtual void setInputTree(TTree*) = 0;
   virtual void setOutputTree(TTree*) = 0;
   virtual void update() {}
+  // CV: in "passthrough" mode the output branch shares the buffer of the input branch,
+  //     so that the value read from the input Tree is written to the output Tree without being copied;
+  //     must be called before setOutputTree
+  virtual void enablePassthrough()
+  {
+    throw cms::Exception("branchEntryBaseType") 
+      << "Branch = '" << outputBranchName_ << "' does not support passthrough mode !!\n";
+  }
   virtual void copyBranch() = 0;
   virtual Float_t getValue_float(int idxElement = 0) const = 0;
   virtual Double_t getValue_double(int idxElement = 0) const = 0;
@@ -71,11 +79,26 @@ struct branchEntryBaseType
   int outputBranchPrecision_;
 };
 
+// auxiliary class to share the buffer of input and output branch in passthrough mode,
+// which is possible only if input and output branch are of the same type
+template <typename T1, typename T2>
+struct passthroughBuffer
+{
+  static T2* get(T1*) { return 0; }
+};
+template <typename T>
+struct passthroughBuffer<T, T>
+{
+  static T* get(T* inputBuffer) { return inputBuffer; }
+};
+
 template <typename T1, typename T2>
 struct branchEntryType : branchEntryBaseType
 {
   branchEntryType(const std::string& inputBranchName, const std::string& inputBranchType, const std::string& outputBranchName, const std::string& outputBranchType, int idx = -1)
     : branchEntryBaseType(inputBranchName, inputBranchType, outputBranchName, outputBranchType, idx)
+    , passthrough_(false)
+    , outputValuePtr_(&outputValue_)
   {}
   ~branchEntryType() {}
   void setInputTree(TTree* inputTree)
@@ -84,10 +107,21 @@ struct branchEntryType : branchEntryBaseType
   }
   void setOutputTree(TTree* outputTree)
   {
-    outputTree->Branch(outputBranchName_.data(), &outputValue_, Form("%s/%s", outputBranchName_.data(), outputBranchType_string_.data()));
+    outputTree->Branch(outputBranchName_.data(), outputValuePtr_, Form("%s/%s", outputBranchName_.data(), outputBranchType_string_.data()));
+  }
+  void enablePassthrough()
+  {
+    T2* inputBuffer = passthroughBuffer<T1, T2>::get(&inputValue_);
+    if ( !inputBuffer || inputBranchType_ != outputBranchType_ ) 
+      throw cms::Exception("branchEntryType") 
+        << "Passthrough mode not supported for conversion of Branch = '" << inputBranchName_ << "' of Type = " << inputBranchType_string_ 
+        << " to Branch = '" << outputBranchName_ << "' of Type = " << outputBranchType_string_ << " !!\n";
+    passthrough_ = true;
+    outputValuePtr_ = inputBuffer;
   }
   void copyBranch()
   {
+    if ( passthrough_ ) return;
     if ( inputBranchType_ == kF && outputBranchType_ == kI ) {
       outputValue_ = TMath::Nint((Float_t)inputValue_);
     } else if ( inputBranchType_ == kD && outputBranchType_ == kI ) {
@@ -98,18 +132,20 @@ struct branchEntryType : branchEntryBaseType
   }
   Float_t getValue_float(int idxElement = 0) const
   {
-    return outputValue_;
+    return *outputValuePtr_;
   }
   Double_t getValue_double(int idxElement = 0) const
   {
-    return outputValue_;
+    return *outputValuePtr_;
   }
   Int_t getValue_int(int idxElement = 0) const
   {
-    return TMath::Nint(outputValue_);
+    return TMath::Nint(*outputValuePtr_);
   }
   T1 inputValue_;
   T2 outputValue_;
+  bool passthrough_;
+  T2* outputValuePtr_; // points to outputValue_, or to inputValue_ in passthrough mode
 };
 typedef branchEntryType<Float_t,     Float_t> branchEntryTypeFF;
 typedef branchEntryType<Float_t,    Double_t> branchEntryTypeFD;
@@ -182,6 +218,7 @@ struct branchEntryVType : branchEntryBaseType
     : branchEntryBaseType(inputBranchName, inputBranchType, outputBranchName, outputBranchType, idx)
     , branch_nElements_(branch_nElements)
     , max_nElements_(max_nElements)
+    , passthrough_(false)
   {
     assert(branch_nElements_);
     assert(max_nElements_ >= 1);
@@ -190,8 +227,8 @@ struct branchEntryVType : branchEntryBaseType
   }
   ~branchEntryVType() 
   {
+    if ( !passthrough_ ) delete[] outputValues_;
     delete[] inputValues_;    
-    delete[] outputValues_;
   }
   void setInputTree(TTree* inputTree)
   {
@@ -202,9 +239,26 @@ struct branchEntryVType : branchEntryBaseType
     outputTree->Branch(outputBranchName_.data(), outputValues_, 
       Form("%s[%s]/%s", outputBranchName_.data(), branch_nElements_->outputBranchName_.data(), outputBranchType_string_.data()));
   }
+  void enablePassthrough()
+  {
+    T2* inputBuffer = passthroughBuffer<T1, T2>::get(inputValues_);
+    if ( !inputBuffer || inputBranchType_ != outputBranchType_ ) 
+      throw cms::Exception("branchEntryVType") 
+        << "Passthrough mode not supported for conversion of Branch = '" << inputBranchName_ << "' of Type = " << inputBranchType_string_ 
+        << " to Branch = '" << outputBranchName_ << "' of Type = " << outputBranchType_string_ << " !!\n";
+    if ( !passthrough_ ) delete[] outputValues_;
+    passthrough_ = true;
+    outputValues_ = inputBuffer;
+  }
   void copyBranch()
   {
     assert(branch_nElements_);
+    if ( passthrough_ ) {
+      // CV: the branch containing the number of elements is read from the input Tree into the shared buffer as well,
+      //     only the size of the buffer needs to be checked
+      assert(branch_nElements_->getValue_int() <= max_nElements_);
+      return;
+    }
     // CV: branches of "simple" type need to be copied before branches of "vector" type,
     //     to ensure that the branches containing the number of elements in the vectors are initialized before the vectors get copied
     (const_cast<branchEntryBaseType*>(branch_nElements_))->copyBranch();
@@ -241,7 +295,8 @@ struct branchEntryVType : branchEntryBaseType
   const branchEntryBaseType* branch_nElements_;
   int max_nElements_;
   T1* inputValues_;
-  T2* outputValues_;
+  T2* outputValues_; // points to inputValues_ in passthrough mode
+  bool passthrough_;
 };
 typedef branchEntryVType<Float_t,   Float_t> branchEntryTypeVFVF;
 typedef branchEntryVType<Double_t, Double_t> branchEntryTypeVDVD;
@@ -17,7 +17,9 @@ std::vector<outputCommandEntry> getOutputCommands(const std::vector<std::string>
 
 std::map<std::string, bool> getBranchesToKeep(TTree* inputTree, std::vector<outputCommandEntry>& outputCommands);
 
-void copyBranches_singleType(TTree* inputTree, TTree* outputTree, std::map<std::string, bool>& isBranchToKeep, std::map<std::string, branchEntryBaseType*>& outputTree_branches);
-void copyBranches_vectorType(TTree* inputTree, TTree* outputTree, std::map<std::string, bool>& isBranchToKeep, std::map<std::string, branchEntryBaseType*>& outputTree_branches);
+// CV: in passthrough mode the output branches share the buffers of the input branches,
+//     so that copyBranch() does not need to copy the values of the branches for each event
+void copyBranches_singleType(TTree* inputTree, TTree* outputTree, std::map<std::string, bool>& isBranchToKeep, std::map<std::string, branchEntryBaseType*>& outputTree_branches, bool passthrough = true);
+void copyBranches_vectorType(TTree* inputTree, TTree* outputTree, std::map<std::string, bool>& isBranchToKeep, std::map<std::string, branchEntryBaseType*>& outputTree_branches, bool passthrough = true);
 
 #endif
@@ -3,6 +3,7 @@
 
 #include <string> // std::string
 #include <map> // std::map<>
+#include <vector> // std::vector<>
 #include <ostream> // ostream
 
 /**
@@ -15,23 +16,47 @@ namespace cutFlowTable_namespace
     std::string cut_;
     int selEvents_;
     double selEvents_weighted_;
-    int idx_;
+    int idx_; ///< position of the row in the printout, given by the order in which the cuts are passed for the first time (-1 if not passed yet)
   };
 
-  bool isLowerIdx(const rowType* row1, const rowType* row2)
+  inline bool isLowerIdx(const rowType* row1, const rowType* row2)
   {
     return (row1->idx_ < row2->idx_);
   }
 }
 
+/**
+ * @brief Cut-flow table
+ *
+ * Cuts can either be referred to by name, or by an integer handle returned by registerCut().
+ * The latter avoids the lookup of the cut name in every event: 
+ *
+ *   const int cut_trigger = cutFlowTable.registerCut("trigger");
+ *   ...
+ *   cutFlowTable.update(cut_trigger, evtWeight);
+ *
+ * Each thread should update its own copy of the table; the copies can be combined by merge() at the end of the job.
+ */
 class cutFlowTableType
 {
  public:
   cutFlowTableType();
   ~cutFlowTableType();
 
+  /**
+   * @brief Register cut (if not registered already)
+   * @return Handle to be passed to update(int, double)
+   */
+  int registerCut(const std::string& cut);
+
+  void update(int cutIdx, double evtWeight = 1.);
   void update(const std::string& cut, double evtWeight = 1.);
 
+  /**
+   * @brief Add the number of events passing each cut in another table (e.g. filled by another thread) to this table
+   */
+  void merge(const cutFlowTableType& cutFlowTable);
+
   void print(std::ostream& stream) const;
 
   friend std::ostream &
@@ -39,8 +64,17 @@ class cutFlowTableType
              const cutFlowTableType & cutFlowTable);
 
  protected:
-  std::map<std::string, cutFlowTable_namespace::rowType*> rows_;
+  std::vector<cutFlowTable_namespace::rowType> rows_;
+  std::map<std::string, int> rowIdxs_; ///< key = cut, value = handle (position in rows_)
   int row_idx_;
 };
 
+inline void cutFlowTableType::update(int cutIdx, double evtWeight)
+{
+  cutFlowTable_namespace::rowType& row = rows_[cutIdx];
+  if ( row.idx_ < 0 ) row.idx_ = row_idx_++;
+  ++row.selEvents_;
+  row.selEvents_weighted_ += evtWeight;
+}
+
 #endif // tthAnalysis_HiggsToTauTau_cutFlowTable_h
@@ -40,6 +40,33 @@ int getHadTauGenMatch_int(const std::vector<hadTauGenMatchEntry>& hadTauGenMatch
 const hadTauGenMatchEntry& getHadTauGenMatch(const std::vector<hadTauGenMatchEntry>& hadTauGenMatch_definitions,
 					     const RecoHadTau* hadTau_lead, const RecoHadTau* hadTau_sublead = 0, const RecoHadTau* hadTau_third = 0);
 
+/**
+ * @brief Map the numbers of reconstructed hadronic taus matched to generator level hadronic taus, electrons, muons and to jets
+ *        to the corresponding entry of hadTauGenMatch_definitions by a table lookup,
+ *        instead of searching hadTauGenMatch_definitions in every event
+ *
+ * @note The table refers to the entries of hadTauGenMatch_definitions, which hence need to be kept unchanged while the table is in use
+ */
+class hadTauGenMatchLookupTable
+{
+ public:
+  hadTauGenMatchLookupTable(const std::vector<hadTauGenMatchEntry>& hadTauGenMatch_definitions);
+  ~hadTauGenMatchLookupTable() {}
+
+  const hadTauGenMatchEntry& get(int numGenMatchedHadTaus, int numGenMatchedElectrons, int numGenMatchedMuons, int numGenMatchedJets) const;
+
+ private:
+  enum { kMaxHadTaus = 3 };
+  static int getIndex(int numGenMatchedHadTaus, int numGenMatchedElectrons, int numGenMatchedMuons, int numGenMatchedJets)
+  {
+    return ((numGenMatchedHadTaus*(kMaxHadTaus + 1) + numGenMatchedElectrons)*(kMaxHadTaus + 1) + numGenMatchedMuons)*(kMaxHadTaus + 1) + numGenMatchedJets;
+  }
+  std::vector<const hadTauGenMatchEntry*> table_; // indexed by getIndex(); 0 if no entry matches
+};
+
+const hadTauGenMatchEntry& getHadTauGenMatch(const hadTauGenMatchLookupTable& hadTauGenMatch_lookupTable,
+					     const RecoHadTau* hadTau_lead, const RecoHadTau* hadTau_sublead = 0, const RecoHadTau* hadTau_third = 0);
+
 std::ostream& operator<<(std::ostream& stream, const hadTauGenMatchEntry& hadTauGenMatch_definition);
 std::ostream& operator<<(std::ostream& stream, const std::vector<hadTauGenMatchEntry>& hadTauGenMatch_definitions);
 
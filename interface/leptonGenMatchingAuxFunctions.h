@@ -35,6 +35,29 @@ int getLeptonGenMatch_int(const std::vector<leptonGenMatchEntry>& leptonGenMatch
 const leptonGenMatchEntry& getLeptonGenMatch(const std::vector<leptonGenMatchEntry>& leptonGenMatch_definitions,
 					     const RecoLepton* lepton_lead, const RecoLepton* lepton_sublead = 0, const RecoLepton* lepton_third = 0);
 
+/**
+ * @brief Map the numbers of reconstructed leptons matched to generator level leptons and to jets
+ *        to the corresponding entry of leptonGenMatch_definitions by a table lookup,
+ *        instead of searching leptonGenMatch_definitions in every event
+ *
+ * @note The table refers to the entries of leptonGenMatch_definitions, which hence need to be kept unchanged while the table is in use
+ */
+class leptonGenMatchLookupTable
+{
+ public:
+  leptonGenMatchLookupTable(const std::vector<leptonGenMatchEntry>& leptonGenMatch_definitions);
+  ~leptonGenMatchLookupTable() {}
+
+  const leptonGenMatchEntry& get(int numGenMatchedLeptons, int numGenMatchedJets) const;
+
+ private:
+  enum { kMaxLeptons = 3 };
+  std::vector<const leptonGenMatchEntry*> table_; // indexed by numGenMatchedLeptons*(kMaxLeptons + 1) + numGenMatchedJets; 0 if no entry matches
+};
+
+const leptonGenMatchEntry& getLeptonGenMatch(const leptonGenMatchLookupTable& leptonGenMatch_lookupTable,
+					     const RecoLepton* lepton_lead, const RecoLepton* lepton_sublead = 0, const RecoLepton* lepton_third = 0);
+
 std::ostream& operator<<(std::ostream& stream, const leptonGenMatchEntry& leptonGenMatch_definition);
 std::ostream& operator<<(std::ostream& stream, const std::vector<leptonGenMatchEntry>& leptonGenMatch_definitions);
 
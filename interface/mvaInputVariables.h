@@ -9,6 +9,7 @@
 #include "tthAnalysis/HiggsToTauTau/interface/RecoJet.h" // RecoJet
 #include "tthAnalysis/HiggsToTauTau/interface/RecoLepton.h" // RecoLepton
 #include "tthAnalysis/HiggsToTauTau/interface/RecoHadTau.h" // RecoHadTau
+#include "tthAnalysis/HiggsToTauTau/interface/EventGeometry.h" // EventGeometry
 
 double comp_MT_met_lep1(const Particle::LorentzVector& leptonP4, double met_pt, double met_phi);
 double comp_MT_met_lep1(const Particle& lepton, double met_pt, double met_phi);
@@ -31,6 +32,21 @@ double comp_lep2_conePt(const RecoLepton& lepton);
 double comp_lep3_conePt(const RecoLepton& lepton);
 double comp_avg_dr_jet(const std::vector<const RecoJet*>& jets_cleaned);
 double comp_max_dr_jet(const std::vector<const RecoJet*>& jets_cleaned);
+
+/**
+ * @brief Versions of the functions above that take the distances between particles and the jet acceptance
+ *        from the cache of the current event
+ */
+double comp_n_jet25_recl(const std::vector<const RecoJet*>& jets_cleaned, const EventGeometry& geometry);
+double comp_mindr_lep1_jet(const Particle& lepton, const std::vector<const RecoJet*>& jets_cleaned, const EventGeometry& geometry);
+double comp_mindr_lep2_jet(const Particle& lepton, const std::vector<const RecoJet*>& jets_cleaned, const EventGeometry& geometry);
+double comp_mindr_lep3_jet(const Particle& lepton, const std::vector<const RecoJet*>& jets_cleaned, const EventGeometry& geometry);
+double comp_mindr_hadTau1_jet(const Particle& hadTau, const std::vector<const RecoJet*>& jets_cleaned, const EventGeometry& geometry);
+double comp_mindr_hadTau2_jet(const Particle& hadTau, const std::vector<const RecoJet*>& jets_cleaned, const EventGeometry& geometry);
+double comp_mindr_hadTau3_jet(const Particle& hadTau, const std::vector<const RecoJet*>& jets_cleaned, const EventGeometry& geometry);
+double comp_avg_dr_jet(const std::vector<const RecoJet*>& jets_cleaned, const EventGeometry& geometry);
+double comp_max_dr_jet(const std::vector<const RecoJet*>& jets_cleaned, const EventGeometry& geometry);
+
 double compHT(const std::vector<const RecoLepton*>& leptons, const std::vector<const RecoHadTau*>& hadTaus, const std::vector<const RecoJet*>& jets_cleaned);
 
 #endif // mvaInputVariables_h
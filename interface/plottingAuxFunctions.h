@@ -106,4 +106,16 @@ double compYmaxForClearance(TH1* histogram, double legendPosX, double legendPosY
 
 std::vector<plotEntryType*> readDistributions(const edm::VParameterSet& cfgDistributions);
 
+//-----------------------------------------------------------------------------
+// Fork numProcesses - 1 worker processes for making plots in parallel
+// (ROOT graphics is not thread-safe, so the plots cannot be made in threads).
+// Returns the index of the calling process: 0 for the parent process, 1..numProcesses - 1 for the workers;
+// the process IDs of the workers are stored in workerPIDs (filled in the parent process only).
+// Each process is expected to make the plots with index % numProcesses == returned index.
+unsigned forkWorkerProcesses(unsigned numProcesses, std::vector<int>& workerPIDs);
+
+// Wait for the worker processes to finish; throws if any of them failed
+void waitForWorkerProcesses(const std::vector<int>& workerPIDs);
+//-----------------------------------------------------------------------------
+
 #endif
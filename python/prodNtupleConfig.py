@@ -105,6 +105,8 @@ class prodNtupleConfig:
         lines = []
         lines.append("process.fwliteInput.fileNames = cms.vstring(%s)" % jobOptions['inputFiles'])
         lines.append("process.fwliteOutput.fileName = cms.string('%s')" % os.path.basename(jobOptions['outputFile']))
+        # the output file is copied to its final location at the end of the job; record that location in the event index
+        lines.append("process.produceNtuple.eventIndexNtupleFileName = cms.string('%s')" % jobOptions['outputFile'])
         lines.append("process.produceNtuple.era = cms.string('%s')" % self.era)
         lines.append("process.produceNtuple.use_HIP_mitigation_mediumMuonId = cms.bool(%s)" % jobOptions['use_HIP_mitigation_mediumMuonId'])
         lines.append("process.produceNtuple.minNumLeptons = cms.int32(%i)" % self.preselection_cuts['minNumLeptons'])
@@ -0,0 +1,70 @@
+#include "tthAnalysis/HiggsToTauTau/interface/BranchBufferRegistry.h"
+
+#include <mutex> // std::mutex, std::lock_guard<>
+
+BranchBufferRegistry::BranchBufferRegistry()
+  : tree_(nullptr)
+{}
+
+BranchBufferRegistry::~BranchBufferRegistry()
+{}
+
+void
+BranchBufferRegistry::setTree(TTree * tree)
+{
+  tree_ = tree;
+  if(tree_)
+  {
+    for(auto & buffer: buffers_)
+    {
+      buffer.second -> bind(tree_, buffer.first);
+    }
+  }
+}
+
+TTree *
+BranchBufferRegistry::getTree() const
+{
+  return tree_;
+}
+
+std::size_t
+BranchBufferRegistry::getBufferCount() const
+{
+  return buffers_.size();
+}
+
+std::shared_ptr<BranchBufferRegistry>
+BranchBufferRegistry::getSharedInstance(TTree * tree)
+{
+  if(! tree)
+  {
+    throw cms::Exception("BranchBufferRegistry") << "No tree given\n";
+  }
+
+  static std::mutex instancesMutex;
+  static std::map<TTree *, std::weak_ptr<BranchBufferRegistry>> instances;
+  std::lock_guard<std::mutex> lock(instancesMutex);
+
+  // forget the registries of trees whose readers have all been deleted
+  for(auto instance = instances.begin(); instance != instances.end();)
+  {
+    if(instance -> second.expired())
+    {
+      instance = instances.erase(instance);
+    }
+    else
+    {
+      ++instance;
+    }
+  }
+
+  std::shared_ptr<BranchBufferRegistry> instance = instances[tree].lock();
+  if(! instance)
+  {
+    instance = std::make_shared<BranchBufferRegistry>();
+    instance -> setTree(tree);
+    instances[tree] = instance;
+  }
+  return instance;
+}
@@ -35,16 +35,24 @@ void CutFlowTableHistManager_0l_3tau::bookHistograms(TFileDirectory& dir)
 }
 
 void CutFlowTableHistManager_0l_3tau::fillHistograms(const std::string& cut, double evtWeight)
+{
+  fillHistograms(getCutIdx(cut), evtWeight);
+}
+
+void CutFlowTableHistManager_0l_3tau::fillHistograms(int idxCut, double evtWeight)
 {
   double evtWeightErr = 0.;
+  // bin idxCut is centered at idxCut - 1, cf. bookHistograms
+  fill(histogram_cutFlow_, idxCut - 1, evtWeight, evtWeightErr);
+}
 
+int CutFlowTableHistManager_0l_3tau::getCutIdx(const std::string& cut) const
+{
   const TAxis* xAxis = histogram_cutFlow_->GetXaxis();
   int idxBin = (const_cast<TAxis*>(xAxis))->FindBin(cut.data());
-  if ( idxBin >= 1 && idxBin <= xAxis->GetNbins() ) {
-    double binCenter = xAxis->GetBinCenter(idxBin);
-    fill(histogram_cutFlow_, binCenter, evtWeight, evtWeightErr);
-  } else {
+  if ( !(idxBin >= 1 && idxBin <= xAxis->GetNbins()) ) {
     std::cerr << "Error: cut = '" << cut << "' not defined !!" << std::endl;
     assert(0);
   }
+  return idxBin;
 }
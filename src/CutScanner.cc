@@ -0,0 +1,203 @@
+#include "tthAnalysis/HiggsToTauTau/interface/CutScanner.h"
+
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <algorithm> // std::sort(), std::lower_bound(), std::upper_bound()
+#include <cmath> // std::sqrt()
+#include <iomanip> // std::setw()
+#include <assert.h> // assert
+
+CutScanner::CutScanner()
+  : numCells_(1)
+  , isUpToDate_(false)
+{}
+
+int CutScanner::addCut(const std::string& expression, const std::string& op, const std::vector<double>& thresholds)
+{
+  if ( !samples_.empty() )
+    throw cms::Exception("CutScanner")
+      << "Cut = '" << expression << "' must be added before the first sample !!\n";
+  if ( thresholds.empty() )
+    throw cms::Exception("CutScanner")
+      << "No thresholds given for cut = '" << expression << "' !!\n";
+  cutType cut;
+  cut.expression_ = expression;
+  cut.op_string_ = op;
+  if      ( op == ">"  ) cut.op_ = kGreaterThan;
+  else if ( op == ">=" ) cut.op_ = kGreaterEqual;
+  else if ( op == "<"  ) cut.op_ = kLessThan;
+  else if ( op == "<=" ) cut.op_ = kLessEqual;
+  else throw cms::Exception("CutScanner")
+    << "Invalid operator = '" << op << "' for cut = '" << expression << "' !!\n";
+  cut.thresholds_ascending_ = thresholds;
+  std::sort(cut.thresholds_ascending_.begin(), cut.thresholds_ascending_.end());
+//--- a lower bound on the value gets tighter with increasing threshold, an upper bound with decreasing threshold
+  cut.thresholds_ = cut.thresholds_ascending_;
+  if ( cut.op_ == kLessThan || cut.op_ == kLessEqual ) std::reverse(cut.thresholds_.begin(), cut.thresholds_.end());
+  cuts_.push_back(cut);
+  numCells_ *= thresholds.size();
+  return cuts_.size() - 1;
+}
+
+int CutScanner::addSample(const std::string& name, bool isSignal)
+{
+  sampleType sample;
+  sample.name_ = name;
+  sample.isSignal_ = isSignal;
+  sample.cells_.assign(numCells_, 0.);
+  samples_.push_back(sample);
+  isUpToDate_ = false;
+  return samples_.size() - 1;
+}
+
+size_t CutScanner::getNumPassed(const cutType& cut, double value)
+{
+  const std::vector<double>& thresholds = cut.thresholds_ascending_;
+  switch ( cut.op_ ) {
+    case kGreaterThan:  return std::lower_bound(thresholds.begin(), thresholds.end(), value) - thresholds.begin();
+    case kGreaterEqual: return std::upper_bound(thresholds.begin(), thresholds.end(), value) - thresholds.begin();
+    case kLessThan:     return thresholds.end() - std::upper_bound(thresholds.begin(), thresholds.end(), value);
+    case kLessEqual:    return thresholds.end() - std::lower_bound(thresholds.begin(), thresholds.end(), value);
+  }
+  assert(0);
+  return 0;
+}
+
+void CutScanner::fill(int idxSample, const std::vector<std::vector<float> >& columns, const std::vector<float>& weights)
+{
+  assert(idxSample >= 0 && idxSample < (int)samples_.size());
+  if ( columns.size() != cuts_.size() )
+    throw cms::Exception("CutScanner")
+      << "Number of columns = " << columns.size() << " does not match number of cuts = " << cuts_.size() << " !!\n";
+  const size_t numEvents = weights.size();
+
+//--- compute the cell of each event, one cut at a time;
+//    events that fail the loosest point of any cut are marked by -1
+  idxCells_.assign(numEvents, 0);
+  for ( size_t idxCut = 0; idxCut < cuts_.size(); ++idxCut ) {
+    const cutType& cut = cuts_[idxCut];
+    const std::vector<float>& column = columns[idxCut];
+    if ( column.size() != numEvents )
+      throw cms::Exception("CutScanner")
+	<< "Number of values = " << column.size() << " for cut = '" << cut.expression_ << "' does not match number of weights = " << numEvents << " !!\n";
+    const int numThresholds = cut.thresholds_.size();
+    for ( size_t idxEvent = 0; idxEvent < numEvents; ++idxEvent ) {
+      int& idxCell = idxCells_[idxEvent];
+      if ( idxCell < 0 ) continue;
+      const int numPassed = getNumPassed(cut, column[idxEvent]);
+      idxCell = ( numPassed > 0 ) ? idxCell*numThresholds + (numPassed - 1) : -1;
+    }
+  }
+
+  std::vector<double>& cells = samples_[idxSample].cells_;
+  for ( size_t idxEvent = 0; idxEvent < numEvents; ++idxEvent ) {
+    if ( idxCells_[idxEvent] >= 0 ) cells[idxCells_[idxEvent]] += weights[idxEvent];
+  }
+  isUpToDate_ = false;
+}
+
+void CutScanner::compYields() const
+{
+  if ( isUpToDate_ ) return;
+  yields_.resize(samples_.size());
+  for ( size_t idxSample = 0; idxSample < samples_.size(); ++idxSample ) {
+    std::vector<double>& yields = yields_[idxSample];
+    yields = samples_[idxSample].cells_;
+//--- sum the cells along each cut, from the tightest to the loosest point, keeping the other cuts fixed
+    size_t stride = numCells_;
+    for ( size_t idxCut = 0; idxCut < cuts_.size(); ++idxCut ) {
+      const size_t numThresholds = cuts_[idxCut].thresholds_.size();
+      stride /= numThresholds;
+      for ( size_t idxCell = numCells_; idxCell-- > 0; ) {
+	if ( ((idxCell/stride) % numThresholds) < (numThresholds - 1) ) yields[idxCell] += yields[idxCell + stride];
+      }
+    }
+  }
+  isUpToDate_ = true;
+}
+
+std::vector<double> CutScanner::getThresholds(size_t idxCutPoint) const
+{
+  assert(idxCutPoint < numCells_);
+  std::vector<double> thresholds(cuts_.size());
+  for ( size_t idxCut = cuts_.size(); idxCut-- > 0; ) {
+    const std::vector<double>& thresholds_cut = cuts_[idxCut].thresholds_;
+    thresholds[idxCut] = thresholds_cut[idxCutPoint % thresholds_cut.size()];
+    idxCutPoint /= thresholds_cut.size();
+  }
+  return thresholds;
+}
+
+double CutScanner::getYield(int idxSample, size_t idxCutPoint) const
+{
+  assert(idxSample >= 0 && idxSample < (int)samples_.size());
+  assert(idxCutPoint < numCells_);
+  compYields();
+  return yields_[idxSample][idxCutPoint];
+}
+
+double CutScanner::getYield_signal(size_t idxCutPoint) const
+{
+  double yield = 0.;
+  for ( size_t idxSample = 0; idxSample < samples_.size(); ++idxSample ) {
+    if ( samples_[idxSample].isSignal_ ) yield += getYield(idxSample, idxCutPoint);
+  }
+  return yield;
+}
+
+double CutScanner::getYield_background(size_t idxCutPoint) const
+{
+  double yield = 0.;
+  for ( size_t idxSample = 0; idxSample < samples_.size(); ++idxSample ) {
+    if ( !samples_[idxSample].isSignal_ ) yield += getYield(idxSample, idxCutPoint);
+  }
+  return yield;
+}
+
+double CutScanner::getSignificance(size_t idxCutPoint) const
+{
+  double yield_background = getYield_background(idxCutPoint);
+  return ( yield_background > 0. ) ? getYield_signal(idxCutPoint)/std::sqrt(yield_background) : 0.;
+}
+
+size_t CutScanner::getBestCutPoint() const
+{
+  size_t idxCutPoint_best = 0;
+  double significance_best = -1.;
+  for ( size_t idxCutPoint = 0; idxCutPoint < numCells_; ++idxCutPoint ) {
+    double significance = getSignificance(idxCutPoint);
+    if ( significance > significance_best ) {
+      idxCutPoint_best = idxCutPoint;
+      significance_best = significance;
+    }
+  }
+  return idxCutPoint_best;
+}
+
+void CutScanner::print(std::ostream& stream) const
+{
+  stream << "#";
+  for ( std::vector<cutType>::const_iterator cut = cuts_.begin();
+	cut != cuts_.end(); ++cut ) {
+    stream << " " << std::setw(15) << (cut->expression_ + " " + cut->op_string_);
+  }
+  for ( std::vector<sampleType>::const_iterator sample = samples_.begin();
+	sample != samples_.end(); ++sample ) {
+    stream << " " << std::setw(15) << sample->name_;
+  }
+  stream << " " << std::setw(15) << "S" << " " << std::setw(15) << "B" << " " << std::setw(15) << "S/sqrt(B)" << std::endl;
+  for ( size_t idxCutPoint = 0; idxCutPoint < numCells_; ++idxCutPoint ) {
+    stream << " ";
+    std::vector<double> thresholds = getThresholds(idxCutPoint);
+    for ( std::vector<double>::const_iterator threshold = thresholds.begin();
+	  threshold != thresholds.end(); ++threshold ) {
+      stream << " " << std::setw(15) << (*threshold);
+    }
+    for ( size_t idxSample = 0; idxSample < samples_.size(); ++idxSample ) {
+      stream << " " << std::setw(15) << getYield(idxSample, idxCutPoint);
+    }
+    stream << " " << std::setw(15) << getYield_signal(idxCutPoint)
+	   << " " << std::setw(15) << getYield_background(idxCutPoint)
+	   << " " << std::setw(15) << getSignificance(idxCutPoint) << std::endl;
+  }
+}
@@ -0,0 +1,131 @@
+#include "tthAnalysis/HiggsToTauTau/interface/EventGeometry.h"
+
+#include <DataFormats/Math/interface/deltaR.h> // deltaR()
+#include <DataFormats/Math/interface/deltaPhi.h> // reco::deltaPhi()
+
+#include <cmath> // std::fabs()
+#include <algorithm> // std::copy()
+
+EventGeometry::EventGeometry()
+  : numParticles_(0)
+{}
+
+EventGeometry::~EventGeometry()
+{}
+
+void
+EventGeometry::reset()
+{
+  // the capacity of the vectors is kept, so that no memory is allocated in the following events
+  collections_.clear();
+  eta_.clear();
+  phi_.clear();
+  isJetInAcceptance_.clear();
+  numParticles_ = 0;
+  dR_.clear();
+  dPhi_.clear();
+}
+
+bool
+EventGeometry::passesJetAcceptance(const Particle & jet)
+{
+  return jet.pt() > 25. && std::fabs(jet.eta()) < 2.4;
+}
+
+void
+EventGeometry::addParticle(const Particle & particle)
+{
+  eta_.push_back(particle.eta());
+  phi_.push_back(particle.phi());
+  isJetInAcceptance_.push_back(passesJetAcceptance(particle));
+}
+
+void
+EventGeometry::resizeMatrix()
+{
+  const std::size_t numParticles_old = numParticles_;
+  const std::size_t numParticles_new = eta_.size();
+  if(numParticles_new == numParticles_old)
+  {
+    return;
+  }
+  for(std::vector<double> * matrix: { &dR_, &dPhi_ })
+  {
+    buffer_.assign(numParticles_new * numParticles_new, -1.);
+    for(std::size_t row = 0; row < numParticles_old; ++row)
+    {
+      std::copy(
+        matrix -> begin() + row * numParticles_old, matrix -> begin() + (row + 1) * numParticles_old,
+        buffer_.begin() + row * numParticles_new
+      );
+    }
+    matrix -> swap(buffer_);
+  }
+  numParticles_ = numParticles_new;
+}
+
+int
+EventGeometry::getIndex(const Particle & particle) const
+{
+  const std::uintptr_t particleAddress = address(particle);
+  for(const collectionType & collection: collections_)
+  {
+    if(particleAddress >= collection.begin_ && particleAddress < collection.end_)
+    {
+      const std::uintptr_t offset = particleAddress - collection.begin_;
+      return offset % collection.stride_ ? -1 : collection.offset_ + offset / collection.stride_;
+    }
+  }
+  return -1;
+}
+
+void
+EventGeometry::fill(int index1,
+                    int index2) const
+{
+  const std::size_t entry12 = index1 * numParticles_ + index2;
+  if(dR_[entry12] >= 0.)
+  {
+    return;
+  }
+  const std::size_t entry21 = index2 * numParticles_ + index1;
+  dR_[entry12] = deltaR(eta_[index1], phi_[index1], eta_[index2], phi_[index2]);
+  dR_[entry21] = dR_[entry12];
+  dPhi_[entry12] = reco::deltaPhi(phi_[index1], phi_[index2]);
+  dPhi_[entry21] = -dPhi_[entry12];
+}
+
+double
+EventGeometry::dR(const Particle & particle1,
+                  const Particle & particle2) const
+{
+  const int index1 = getIndex(particle1);
+  const int index2 = getIndex(particle2);
+  if(index1 < 0 || index2 < 0)
+  {
+    return deltaR(particle1.eta(), particle1.phi(), particle2.eta(), particle2.phi());
+  }
+  fill(index1, index2);
+  return dR_[index1 * numParticles_ + index2];
+}
+
+double
+EventGeometry::dPhi(const Particle & particle1,
+                    const Particle & particle2) const
+{
+  const int index1 = getIndex(particle1);
+  const int index2 = getIndex(particle2);
+  if(index1 < 0 || index2 < 0)
+  {
+    return reco::deltaPhi(particle1.phi(), particle2.phi());
+  }
+  fill(index1, index2);
+  return dPhi_[index1 * numParticles_ + index2];
+}
+
+bool
+EventGeometry::isJetInAcceptance(const Particle & jet) const
+{
+  const int index = getIndex(jet);
+  return index >= 0 ? isJetInAcceptance_[index] : passesJetAcceptance(jet);
+}
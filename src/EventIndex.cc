@@ -0,0 +1,303 @@
+#include "tthAnalysis/HiggsToTauTau/interface/EventIndex.h" // EventIndex, EventIndexWriter
+
+#include "FWCore/Utilities/interface/Exception.h" // cms::Exception
+
+#include <boost/algorithm/string/predicate.hpp> // boost::starts_with()
+#include <boost/algorithm/string/trim.hpp> // boost::trim_copy()
+
+#include <sstream> // std::istringstream
+#include <iostream> // std::cout
+#include <algorithm> // std::sort()
+#include <functional> // std::hash<>
+
+namespace
+{
+  const std::string ntupleHeader = "# ntuple:";
+
+  std::string
+  get_basename(const std::string & fileName)
+  {
+    const std::size_t pos = fileName.find_last_of('/');
+    return pos == std::string::npos ? fileName : fileName.substr(pos + 1);
+  }
+
+  /**
+   * @brief Parse a run:lumi:event triplet
+   * @return True if parsing succeeded; false otherwise
+   */
+  bool
+  parse_runLumiEvent(const std::string & str,
+                     RUN_TYPE & run,
+                     LUMI_TYPE & lumi,
+                     EVT_TYPE & event)
+  {
+    std::istringstream stream(str);
+    char separator1 = '\0';
+    char separator2 = '\0';
+    stream >> run >> separator1 >> lumi >> separator2 >> event;
+    return ! stream.fail() && separator1 == ':' && separator2 == ':';
+  }
+}
+
+EventIndexWriter::EventIndexWriter(const std::string & indexFileName,
+                                   const std::string & ntupleFileName)
+  : indexFileName_(indexFileName)
+  , indexFile_(indexFileName_.data(), std::ios::out)
+  , numEventsWritten_(0)
+{
+  if(! indexFile_.good())
+  {
+    throw cms::Exception("EventIndexWriter")
+      << "Could not open file '" << indexFileName_ << "' for writing";
+  }
+  indexFile_ << ntupleHeader << ' ' << ntupleFileName << '\n';
+}
+
+EventIndexWriter::~EventIndexWriter()
+{
+  std::cout << "<EventIndexWriter::~EventIndexWriter>: wrote " << numEventsWritten_ << " events to " << indexFileName_ << '\n';
+}
+
+void
+EventIndexWriter::write(RUN_TYPE run,
+                        LUMI_TYPE lumi,
+                        EVT_TYPE event,
+                        Long64_t entry,
+                        unsigned numLeptons,
+                        unsigned numHadTaus,
+                        unsigned numJets)
+{
+  indexFile_ << run << ':' << lumi << ':' << event << ' ' << entry << ' '
+             << numLeptons << ' ' << numHadTaus << ' ' << numJets << '\n';
+  ++numEventsWritten_;
+}
+
+std::size_t
+EventIndex::EventKeyHash::operator()(const EventKey & key) const
+{
+  std::size_t seed = std::hash<EVT_TYPE>()(key.event);
+  seed ^= std::hash<RUN_TYPE>()(key.run)   + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  seed ^= std::hash<LUMI_TYPE>()(key.lumi) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  return seed;
+}
+
+EventIndex::EventIndex()
+  : minNumLeptons_(0)
+  , minNumHadTaus_(0)
+  , minNumJets_(0)
+{}
+
+EventIndex &
+EventIndex::read(const std::string & indexFileName)
+{
+  std::ifstream indexFile(indexFileName.data());
+  if(! indexFile.good())
+  {
+    throw cms::Exception("EventIndex") << "Could not open file '" << indexFileName << "'";
+  }
+
+  bool hasFile = false;
+  std::size_t numEventsRead = 0;
+  int iLine = 0;
+  std::string line;
+  while(std::getline(indexFile, line))
+  {
+    ++iLine;
+    if(line.empty())
+    {
+      continue;
+    }
+    if(boost::starts_with(line, ntupleHeader))
+    {
+      const std::string ntupleFileName = boost::trim_copy(line.substr(ntupleHeader.size()));
+      fileNames_.push_back(ntupleFileName);
+      // register the Ntuple even if none of its events has been written to the index
+      fileLookup_[ntupleFileName];
+      // the same base name used by Ntuples in different directories is ambiguous; mark it by an empty string
+      const std::string ntupleFileName_basename = get_basename(ntupleFileName);
+      if(fileLookup_basename_.count(ntupleFileName_basename) && fileLookup_basename_[ntupleFileName_basename] != ntupleFileName)
+      {
+        fileLookup_basename_[ntupleFileName_basename] = "";
+      }
+      else
+      {
+        fileLookup_basename_[ntupleFileName_basename] = ntupleFileName;
+      }
+      hasFile = true;
+      continue;
+    }
+    if(! hasFile)
+    {
+      throw cms::Exception("EventIndex")
+        << "Missing '" << ntupleHeader << "' header before line " << iLine << " in file " << indexFileName;
+    }
+
+    std::istringstream lineStream(line);
+    std::string runLumiEvent;
+    EventIndexEntry entry;
+    lineStream >> runLumiEvent >> entry.entry >> entry.numLeptons >> entry.numHadTaus >> entry.numJets;
+    if(lineStream.fail() || ! parse_runLumiEvent(runLumiEvent, entry.run, entry.lumi, entry.event))
+    {
+      throw cms::Exception("EventIndex")
+        << "Error in parsing line " << iLine << " = '" << line << "' of file " << indexFileName;
+    }
+    entry.fileIdx = fileNames_.size() - 1;
+
+    const std::size_t entryIdx = entries_.size();
+    const auto entryLookup_inserted = entryLookup_.insert({ { entry.run, entry.lumi, entry.event }, entryIdx });
+    if(! entryLookup_inserted.second)
+    {
+      throw cms::Exception("EventIndex")
+        << "Duplicate event " << runLumiEvent << " in line " << iLine << " of file " << indexFileName
+        << " (already indexed for Ntuple " << fileNames_[entries_[entryLookup_inserted.first -> second].fileIdx] << ')';
+    }
+    entries_.push_back(entry);
+    fileLookup_[fileNames_.back()].push_back(entryIdx);
+    ++numEventsRead;
+  }
+  std::cout << "<EventIndex::read>: read " << numEventsRead << " events from " << indexFileName << '\n';
+  return *this;
+}
+
+EventIndex &
+EventIndex::readEventList(const std::string & eventListFileName)
+{
+  std::ifstream eventListFile(eventListFileName.data());
+  if(! eventListFile.good())
+  {
+    throw cms::Exception("EventIndex") << "Could not open file '" << eventListFileName << "'";
+  }
+  int iLine = 0;
+  std::string line;
+  while(std::getline(eventListFile, line))
+  {
+    ++iLine;
+    const std::string line_trimmed = boost::trim_copy(line);
+    if(line_trimmed.empty())
+    {
+      continue;
+    }
+    RUN_TYPE run;
+    LUMI_TYPE lumi;
+    EVT_TYPE event;
+    if(! parse_runLumiEvent(line_trimmed, run, lumi, event))
+    {
+      throw cms::Exception("EventIndex")
+        << "Error in parsing line " << iLine << " = '" << line << "' of file " << eventListFileName;
+    }
+    addEvent(run, lumi, event);
+  }
+  return *this;
+}
+
+EventIndex &
+EventIndex::addEvent(RUN_TYPE run,
+                     LUMI_TYPE lumi,
+                     EVT_TYPE event)
+{
+  selEvents_.insert({ run, lumi, event });
+  return *this;
+}
+
+EventIndex &
+EventIndex::setMinNumLeptons(unsigned minNumLeptons)
+{
+  minNumLeptons_ = minNumLeptons;
+  return *this;
+}
+
+EventIndex &
+EventIndex::setMinNumHadTaus(unsigned minNumHadTaus)
+{
+  minNumHadTaus_ = minNumHadTaus;
+  return *this;
+}
+
+EventIndex &
+EventIndex::setMinNumJets(unsigned minNumJets)
+{
+  minNumJets_ = minNumJets;
+  return *this;
+}
+
+const EventIndexEntry *
+EventIndex::find(RUN_TYPE run,
+                 LUMI_TYPE lumi,
+                 EVT_TYPE event) const
+{
+  const auto entryIdx = entryLookup_.find({ run, lumi, event });
+  return entryIdx != entryLookup_.end() ? &entries_[entryIdx -> second] : nullptr;
+}
+
+const std::string &
+EventIndex::getFileName(std::size_t fileIdx) const
+{
+  return fileNames_.at(fileIdx);
+}
+
+bool
+EventIndex::isSelected(const EventIndexEntry & entry) const
+{
+  if(entry.numLeptons < minNumLeptons_ || entry.numHadTaus < minNumHadTaus_ || entry.numJets < minNumJets_)
+  {
+    return false;
+  }
+  return selEvents_.empty() || selEvents_.count({ entry.run, entry.lumi, entry.event });
+}
+
+const std::vector<std::size_t> &
+EventIndex::findFile(const std::string & ntupleFileName) const
+{
+  const auto file = fileLookup_.find(ntupleFileName);
+  if(file != fileLookup_.end())
+  {
+    return file -> second;
+  }
+  const auto file_basename = fileLookup_basename_.find(get_basename(ntupleFileName));
+  if(file_basename == fileLookup_basename_.end())
+  {
+    throw cms::Exception("EventIndex") << "No event index for Ntuple " << ntupleFileName;
+  }
+  if(file_basename -> second.empty())
+  {
+    throw cms::Exception("EventIndex")
+      << "Base name of Ntuple " << ntupleFileName << " matches several Ntuples in the event index";
+  }
+  return fileLookup_.at(file_basename -> second);
+}
+
+bool
+EventIndex::hasEntries(const std::string & ntupleFileName) const
+{
+  for(std::size_t entryIdx: findFile(ntupleFileName))
+  {
+    if(isSelected(entries_[entryIdx]))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::vector<Long64_t>
+EventIndex::getEntries(const std::string & ntupleFileName) const
+{
+  std::vector<Long64_t> selEntries;
+  for(std::size_t entryIdx: findFile(ntupleFileName))
+  {
+    const EventIndexEntry & entry = entries_[entryIdx];
+    if(isSelected(entry))
+    {
+      selEntries.push_back(entry.entry);
+    }
+  }
+  // read the entries in the order in which they are stored in the TTree
+  std::sort(selEntries.begin(), selEntries.end());
+  return selEntries;
+}
+
+std::size_t
+EventIndex::size() const
+{
+  return entries_.size();
+}
@@ -99,6 +99,25 @@ EventInfo::getDecayModeString() const
   return ""; // unrecognizable decay mode
 }
 
+int
+EventInfo::getDecayModeIdx() const
+{
+  if(! is_signal())
+  {
+    return -1;
+  }
+  int idx = 0;
+  for(const auto & kv: EventInfo::decayMode_idString)
+  {
+    if(std::fabs(genHiggsDecayMode - kv.second) < EPS)
+    {
+      return idx;
+    }
+    ++idx;
+  }
+  return -1; // unrecognizable decay mode
+}
+
 std::vector<std::string>
 EventInfo::getDecayModes()
 {
@@ -0,0 +1,293 @@
+#include "tthAnalysis/HiggsToTauTau/interface/EventLoopProfiler.h"
+
+#include "CommonTools/Utils/interface/TFileDirectory.h" // TFileDirectory
+
+#include <FWCore/Utilities/interface/Exception.h> // cms::Exception
+
+#include <TH1.h> // TH1D
+#include <TString.h> // Form()
+
+#include <iostream> // std::cout
+#include <iomanip> // std::setw(), std::setprecision()
+#include <sstream> // std::ostringstream
+#include <atomic> // std::atomic<>
+#include <utility> // std::pair<>
+
+namespace
+{
+  std::atomic<unsigned> nextProfilerId(0);
+
+  // data of the calling thread in each profiler used by that thread, key = id of the profiler;
+  // a thread typically uses a single profiler, so that a linear search is the fastest lookup
+  thread_local std::vector<std::pair<unsigned, void *>> threadDataLookup;
+
+  const char * const defaultStageNames[EventLoopProfiler::kNumDefaultStages] = {
+    "read", "cleaning", "selection", "MVA", "hadTopTagger", "kinFit", "SVfit", "fillHistograms", "write"
+  };
+}
+
+EventLoopProfiler::ThreadData::ThreadData(std::size_t numStages,
+                                          std::size_t numCounters)
+  : ticks_(numStages, 0)
+  , calls_(numStages, 0)
+  , counters_(numCounters, 0)
+  , numEvents_(0)
+  , currentStage_(-1)
+  , lastTick_(0)
+{}
+
+EventLoopProfiler::EventLoopProfiler(const std::string & name)
+  : name_(name)
+  , stageNames_(defaultStageNames, defaultStageNames + kNumDefaultStages)
+  , id_(nextProfilerId++)
+  , startTick_(getTick())
+  , startTime_(std::chrono::steady_clock::now())
+{}
+
+EventLoopProfiler::~EventLoopProfiler()
+{
+  // the entries in the lookup tables of other threads cannot be removed from here,
+  // but they are never matched again, as the ids are unique
+  for(std::size_t idx = 0; idx < threadDataLookup.size(); ++idx)
+  {
+    if(threadDataLookup[idx].first == id_)
+    {
+      threadDataLookup.erase(threadDataLookup.begin() + idx);
+      break;
+    }
+  }
+}
+
+std::size_t
+EventLoopProfiler::addStage(const std::string & stageName)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if(! threadData_.empty())
+  {
+    throw cms::Exception("EventLoopProfiler")
+      << "Cannot add stage '" << stageName << "' to profiler " << name_ << " after profiling has started\n";
+  }
+  stageNames_.push_back(stageName);
+  return stageNames_.size() - 1;
+}
+
+std::size_t
+EventLoopProfiler::addCounter(const std::string & counterName)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if(! threadData_.empty())
+  {
+    throw cms::Exception("EventLoopProfiler")
+      << "Cannot add counter '" << counterName << "' to profiler " << name_ << " after profiling has started\n";
+  }
+  counterNames_.push_back(counterName);
+  return counterNames_.size() - 1;
+}
+
+EventLoopProfiler::ThreadData &
+EventLoopProfiler::getThreadData()
+{
+  for(const std::pair<unsigned, void *> & entry: threadDataLookup)
+  {
+    if(entry.first == id_)
+    {
+      return *static_cast<ThreadData *>(entry.second);
+    }
+  }
+  // first call from this thread
+  std::lock_guard<std::mutex> lock(mutex_);
+  threadData_.emplace_back(new ThreadData(stageNames_.size(), counterNames_.size()));
+  threadDataLookup.emplace_back(id_, threadData_.back().get());
+  return *threadData_.back();
+}
+
+int
+EventLoopProfiler::switchStage(int stage,
+                               bool isNewCall)
+{
+  ThreadData & data = getThreadData();
+  const std::uint64_t tick = getTick();
+  const int previousStage = data.currentStage_;
+  if(previousStage >= 0)
+  {
+    data.ticks_[previousStage] += tick - data.lastTick_;
+  }
+  if(isNewCall && stage >= 0 && stage != previousStage)
+  {
+    ++data.calls_[stage];
+  }
+  data.currentStage_ = stage;
+  data.lastTick_ = tick;
+  return previousStage;
+}
+
+void
+EventLoopProfiler::enter(std::size_t stage)
+{
+  if(stage >= stageNames_.size())
+  {
+    throw cms::Exception("EventLoopProfiler") << "Invalid stage #" << stage << " in profiler " << name_ << '\n';
+  }
+  switchStage(stage);
+}
+
+void
+EventLoopProfiler::stop()
+{
+  switchStage(-1);
+}
+
+void
+EventLoopProfiler::countEvent()
+{
+  ++getThreadData().numEvents_;
+}
+
+void
+EventLoopProfiler::count(std::size_t counter,
+                         std::uint64_t value)
+{
+  if(counter >= counterNames_.size())
+  {
+    throw cms::Exception("EventLoopProfiler") << "Invalid counter #" << counter << " in profiler " << name_ << '\n';
+  }
+  getThreadData().counters_[counter] += value;
+}
+
+EventLoopProfiler::ThreadData
+EventLoopProfiler::sum() const
+{
+  // the threads that are still timed are not interrupted, i.e. the time of their current stage is not yet included
+  ThreadData total(stageNames_.size(), counterNames_.size());
+  std::lock_guard<std::mutex> lock(mutex_);
+  for(const std::unique_ptr<ThreadData> & data: threadData_)
+  {
+    for(std::size_t stage = 0; stage < stageNames_.size(); ++stage)
+    {
+      total.ticks_[stage] += data -> ticks_[stage];
+      total.calls_[stage] += data -> calls_[stage];
+    }
+    for(std::size_t counter = 0; counter < counterNames_.size(); ++counter)
+    {
+      total.counters_[counter] += data -> counters_[counter];
+    }
+    total.numEvents_ += data -> numEvents_;
+  }
+  return total;
+}
+
+double
+EventLoopProfiler::getTicksPerSecond() const
+{
+  const double elapsedTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime_).count();
+  const std::uint64_t elapsedTicks = getTick() - startTick_;
+  return elapsedTime > 0. ? elapsedTicks / elapsedTime : 1.e+9;
+}
+
+void
+EventLoopProfiler::print(std::ostream & stream) const
+{
+  const ThreadData total = sum();
+  const double ticksPerSecond = getTicksPerSecond();
+  std::size_t numThreads = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    numThreads = threadData_.size();
+  }
+
+  double totalTime = 0.;
+  for(std::uint64_t ticks: total.ticks_)
+  {
+    totalTime += ticks / ticksPerSecond;
+  }
+
+  // format into a local stream, so that the flags and precision of the caller's stream are left unchanged
+  std::ostringstream profile;
+  profile << "Profile of " << name_ << " (" << total.numEvents_ << " events, " << numThreads << " thread(s)):\n"
+          << std::fixed << std::setprecision(3)
+          << "  " << std::left << std::setw(20) << "stage" << std::right
+          << std::setw(12) << "time [s]" << std::setw(10) << "fraction" << std::setw(14) << "calls" << std::setw(17) << "time/event [us]" << '\n';
+  for(std::size_t stage = 0; stage < stageNames_.size(); ++stage)
+  {
+    if(! total.calls_[stage])
+    {
+      continue;
+    }
+    const double time = total.ticks_[stage] / ticksPerSecond;
+    profile << "  " << std::left << std::setw(20) << stageNames_[stage] << std::right
+            << std::setw(12) << time
+            << std::setw(10) << (totalTime > 0. ? time / totalTime : 0.)
+            << std::setw(14) << total.calls_[stage]
+            << std::setw(17) << (total.numEvents_ ? 1.e+6 * time / total.numEvents_ : 0.) << '\n';
+  }
+  profile << "  " << std::left << std::setw(20) << "total" << std::right << std::setw(12) << totalTime;
+  if(totalTime > 0.)
+  {
+    profile << " (" << total.numEvents_ / totalTime << " events/s)";
+  }
+  profile << '\n';
+  for(std::size_t counter = 0; counter < counterNames_.size(); ++counter)
+  {
+    profile << "  counter " << counterNames_[counter] << " = " << total.counters_[counter] << '\n';
+  }
+  stream << profile.str();
+}
+
+void
+EventLoopProfiler::write(TFileDirectory & dir) const
+{
+  const ThreadData total = sum();
+  const double ticksPerSecond = getTicksPerSecond();
+  const int numStages = stageNames_.size();
+  const int numCounters = counterNames_.size();
+
+  TH1 * histogram_time = dir.make<TH1D>(
+    Form("%s_time", name_.data()), Form("%s: time [s]", name_.data()), numStages, -0.5, numStages - 0.5
+  );
+  TH1 * histogram_calls = dir.make<TH1D>(
+    Form("%s_calls", name_.data()), Form("%s: calls", name_.data()), numStages, -0.5, numStages - 0.5
+  );
+  for(int stage = 0; stage < numStages; ++stage)
+  {
+    histogram_time -> GetXaxis() -> SetBinLabel(stage + 1, stageNames_[stage].data());
+    histogram_time -> SetBinContent(stage + 1, total.ticks_[stage] / ticksPerSecond);
+    histogram_calls -> GetXaxis() -> SetBinLabel(stage + 1, stageNames_[stage].data());
+    histogram_calls -> SetBinContent(stage + 1, total.calls_[stage]);
+  }
+
+  TH1 * histogram_counters = dir.make<TH1D>(
+    Form("%s_counters", name_.data()), Form("%s: counters", name_.data()), numCounters + 1, -0.5, numCounters + 0.5
+  );
+  histogram_counters -> GetXaxis() -> SetBinLabel(1, "events");
+  histogram_counters -> SetBinContent(1, total.numEvents_);
+  for(int counter = 0; counter < numCounters; ++counter)
+  {
+    histogram_counters -> GetXaxis() -> SetBinLabel(counter + 2, counterNames_[counter].data());
+    histogram_counters -> SetBinContent(counter + 2, total.counters_[counter]);
+  }
+}
+
+EventLoopProfiler::Scope::Scope(EventLoopProfiler * profiler,
+                                std::size_t stage)
+  : profiler_(profiler)
+  , previousStage_(-1)
+{
+  if(profiler_)
+  {
+    if(stage >= profiler_ -> stageNames_.size())
+    {
+      throw cms::Exception("EventLoopProfiler")
+        << "Invalid stage #" << stage << " in profiler " << profiler_ -> name_ << '\n';
+    }
+    previousStage_ = profiler_ -> switchStage(stage);
+  }
+}
+
+EventLoopProfiler::Scope::~Scope()
+{
+  if(profiler_)
+  {
+    // returning to the previous stage does not count as a new call of that stage
+    profiler_ -> switchStage(previousStage_, false);
+  }
+}
@@ -0,0 +1,122 @@
+#include "tthAnalysis/HiggsToTauTau/interface/EventWeightCalculator.h" // EventWeightCalculator
+
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <algorithm> // std::find, std::fill
+
+EventWeightCalculator::EventWeightCalculator(const std::vector<std::string>& shifts)
+  : isUpToDate_(false)
+{
+  shifts_.push_back("central");
+  for ( std::vector<std::string>::const_iterator shift = shifts.begin();
+	shift != shifts.end(); ++shift ) {
+    if ( (*shift) == "central" ) continue;
+    if ( std::find(shifts_.begin(), shifts_.end(), *shift) != shifts_.end() ) {
+      throw cms::Exception("EventWeightCalculator") 
+	<< "Shift = " << (*shift) << " given more than once !!\n";
+    }
+    shifts_.push_back(*shift);
+  }
+  numShifts_ = shifts_.size();
+  evtWeights_.assign(numShifts_, 1.);
+}
+
+int EventWeightCalculator::addComponent(const std::string& name, const std::vector<std::string>& shifts)
+{
+  if ( std::find(componentNames_.begin(), componentNames_.end(), name) != componentNames_.end() ) {
+    throw cms::Exception("EventWeightCalculator") 
+      << "Component = " << name << " registered more than once !!\n";
+  }
+  componentNames_.push_back(name);
+  std::vector<bool> isAffected(numShifts_, false);
+  for ( std::vector<std::string>::const_iterator shift = shifts.begin();
+	shift != shifts.end(); ++shift ) {
+    int idxShift = getShiftIndex(*shift);
+    if ( idxShift > 0 ) isAffected[idxShift] = true;
+  }
+  isAffected_.insert(isAffected_.end(), isAffected.begin(), isAffected.end());
+  values_.insert(values_.end(), numShifts_, 1.);
+  isUpToDate_ = false;
+  return componentNames_.size() - 1;
+}
+
+int EventWeightCalculator::getShiftIndex(const std::string& shift) const
+{
+  std::vector<std::string>::const_iterator it = std::find(shifts_.begin(), shifts_.end(), shift);
+  return ( it != shifts_.end() ) ? it - shifts_.begin() : -1;
+}
+
+void EventWeightCalculator::reset()
+{
+  std::fill(values_.begin(), values_.end(), 1.);
+  isUpToDate_ = false;
+}
+
+void EventWeightCalculator::checkComponentIndex(int idxComponent) const
+{
+  if ( !(idxComponent >= 0 && idxComponent < (int)componentNames_.size()) ) {
+    throw cms::Exception("EventWeightCalculator") 
+      << "Invalid component index = " << idxComponent << " !!\n";
+  }
+}
+
+void EventWeightCalculator::checkShiftIndex(int idxShift) const
+{
+  if ( !(idxShift >= 0 && idxShift < (int)numShifts_) ) {
+    throw cms::Exception("EventWeightCalculator") 
+      << "Invalid shift index = " << idxShift << " !!\n";
+  }
+}
+
+void EventWeightCalculator::setWeight(int idxComponent, double weight)
+{
+  checkComponentIndex(idxComponent);
+  std::fill(values_.begin() + idxComponent*numShifts_, values_.begin() + (idxComponent + 1)*numShifts_, weight);
+  isUpToDate_ = false;
+}
+
+void EventWeightCalculator::setWeight(int idxComponent, int idxShift, double weight)
+{
+  checkComponentIndex(idxComponent);
+  checkShiftIndex(idxShift);
+  const size_t idx = idxComponent*numShifts_ + idxShift;
+  if ( !isAffected_[idx] ) {
+    throw cms::Exception("EventWeightCalculator") 
+      << "Component = " << componentNames_[idxComponent] << " has not been registered to depend on shift = " << shifts_[idxShift] << " !!\n";
+  }
+  values_[idx] = weight;
+  isUpToDate_ = false;
+}
+
+void EventWeightCalculator::update() const
+{
+  std::fill(evtWeights_.begin(), evtWeights_.end(), 1.);
+  const size_t numComponents = componentNames_.size();
+  for ( size_t idxComponent = 0; idxComponent < numComponents; ++idxComponent ) {
+    const double* values_component = values_.data() + idxComponent*numShifts_;
+    for ( size_t idxShift = 0; idxShift < numShifts_; ++idxShift ) {
+      evtWeights_[idxShift] *= values_component[idxShift];
+    }
+  }
+  isUpToDate_ = true;
+}
+
+double EventWeightCalculator::getWeight(int idxShift) const
+{
+  checkShiftIndex(idxShift);
+  if ( !isUpToDate_ ) update();
+  return evtWeights_[idxShift];
+}
+
+const std::vector<double>& EventWeightCalculator::getWeights() const
+{
+  if ( !isUpToDate_ ) update();
+  return evtWeights_;
+}
+
+double EventWeightCalculator::getComponentWeight(int idxComponent, int idxShift) const
+{
+  checkComponentIndex(idxComponent);
+  checkShiftIndex(idxShift);
+  return values_[idxComponent*numShifts_ + idxShift];
+}
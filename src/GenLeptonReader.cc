@@ -4,9 +4,6 @@
 
 #include <TString.h> // Form
 
-std::map<std::string, int> GenLeptonReader::numInstances_;
-std::map<std::string, GenLeptonReader*> GenLeptonReader::instances_;
-
 GenLeptonReader::GenLeptonReader()
   : max_nPromptLeptons_(32)
   , branchName_nPromptLeptons_("nGenLep")
@@ -14,11 +11,13 @@ GenLeptonReader::GenLeptonReader()
   , max_nLeptonsFromTau_(32)
   , branchName_nLeptonsFromTau_("nGenLepFromTau")
   , branchName_leptonsFromTau_("GenLepFromTau")
+  , nPromptLeptons_(0)
   , promptLepton_pt_(0)
   , promptLepton_eta_(0)
   , promptLepton_phi_(0)
   , promptLepton_mass_(0)
   , promptLepton_pdgId_(0)
+  , nLeptonsFromTau_(0)
   , leptonFromTau_pt_(0)
   , leptonFromTau_eta_(0)
   , leptonFromTau_phi_(0)
@@ -38,11 +37,13 @@ GenLeptonReader::GenLeptonReader(const std::string& branchName_nPromptLeptons, c
   , max_nLeptonsFromTau_(32)
   , branchName_nLeptonsFromTau_(branchName_nLeptonsFromTau)
   , branchName_leptonsFromTau_(branchName_leptonsFromTau)			 
+  , nPromptLeptons_(0)
   , promptLepton_pt_(0)
   , promptLepton_eta_(0)
   , promptLepton_phi_(0)
   , promptLepton_mass_(0)
   , promptLepton_pdgId_(0)
+  , nLeptonsFromTau_(0)
   , leptonFromTau_pt_(0)
   , leptonFromTau_eta_(0)
   , leptonFromTau_phi_(0)
@@ -56,103 +57,63 @@ GenLeptonReader::GenLeptonReader(const std::string& branchName_nPromptLeptons, c
 }
 
 GenLeptonReader::~GenLeptonReader()
-{
-  --numInstances_[branchName_promptLeptons_];
-  assert(numInstances_[branchName_promptLeptons_] >= 0);
-  if ( numInstances_[branchName_promptLeptons_] == 0 ) {
-    GenLeptonReader* gInstance = instances_[branchName_promptLeptons_];
-    assert(gInstance);
-    delete[] gInstance->promptLepton_pt_;
-    delete[] gInstance->promptLepton_eta_;
-    delete[] gInstance->promptLepton_phi_;
-    delete[] gInstance->promptLepton_mass_;
-    delete[] gInstance->promptLepton_pdgId_;
-    delete[] gInstance->leptonFromTau_pt_;
-    delete[] gInstance->leptonFromTau_eta_;
-    delete[] gInstance->leptonFromTau_phi_;
-    delete[] gInstance->leptonFromTau_mass_;
-    delete[] gInstance->leptonFromTau_pdgId_;
-    instances_[branchName_promptLeptons_] = 0;
-  }
-}
+{}
 
 void GenLeptonReader::setBranchNames()
 {
-  if ( numInstances_[branchName_promptLeptons_] == 0 ) {
-    branchName_promptLepton_pt_ = Form("%s_%s", branchName_promptLeptons_.data(), "pt");
-    branchName_promptLepton_eta_ = Form("%s_%s", branchName_promptLeptons_.data(), "eta");
-    branchName_promptLepton_phi_ = Form("%s_%s", branchName_promptLeptons_.data(), "phi");
-    branchName_promptLepton_mass_ = Form("%s_%s", branchName_promptLeptons_.data(), "mass");
-    branchName_promptLepton_pdgId_ = Form("%s_%s", branchName_promptLeptons_.data(), "pdgId");
-    branchName_leptonFromTau_pt_ = Form("%s_%s", branchName_leptonsFromTau_.data(), "pt");
-    branchName_leptonFromTau_eta_ = Form("%s_%s", branchName_leptonsFromTau_.data(), "eta");
-    branchName_leptonFromTau_phi_ = Form("%s_%s", branchName_leptonsFromTau_.data(), "phi");
-    branchName_leptonFromTau_mass_ = Form("%s_%s", branchName_leptonsFromTau_.data(), "mass");
-    branchName_leptonFromTau_pdgId_ = Form("%s_%s", branchName_leptonsFromTau_.data(), "pdgId");
-    instances_[branchName_promptLeptons_] = this;
-  } else {
-    GenLeptonReader* gInstance = instances_[branchName_promptLeptons_];
-    assert(gInstance);
-    if ( branchName_nPromptLeptons_  != gInstance->branchName_nPromptLeptons_  ||
-	 branchName_nLeptonsFromTau_ != gInstance->branchName_nLeptonsFromTau_ ||
-	 branchName_leptonsFromTau_  != gInstance->branchName_leptonsFromTau_  ) {
-      throw cms::Exception("GenLeptonReader") 
-	<< "Association between configuration parameters 'branchName_nPromptLeptons', 'branchName_nLeptonsFromTau', 'branchName_leptonsFromTau' and 'branchName_promptLeptons' must be unique:"
-	<< " present association 'branchName_nPromptLeptons' = " << branchName_nPromptLeptons_ << "," 
-	<< " 'branchName_nLeptonsFromTau' = " << branchName_nLeptonsFromTau_ << "," 
-	<< " 'branchName_leptonsFromTau' = " << branchName_leptonsFromTau_ 
-	<< " with 'branchName_promptLeptons' = " << branchName_promptLeptons_ 
-	<< " does not match previous association 'branchName_nPromptLeptons' = " << gInstance->branchName_nPromptLeptons_ << "," 
-	<< " 'branchName_nLeptonsFromTau' = " << gInstance->branchName_nLeptonsFromTau_ << "," 
-	<< " 'branchName_leptonsFromTau' = " << gInstance->branchName_leptonsFromTau_ 
-	<< " with 'branchName_promptLeptons' = " << gInstance->branchName_promptLeptons_ << " !!\n";
-    }
-  }
-  ++numInstances_[branchName_promptLeptons_];
+  branchName_promptLepton_pt_ = Form("%s_%s", branchName_promptLeptons_.data(), "pt");
+  branchName_promptLepton_eta_ = Form("%s_%s", branchName_promptLeptons_.data(), "eta");
+  branchName_promptLepton_phi_ = Form("%s_%s", branchName_promptLeptons_.data(), "phi");
+  branchName_promptLepton_mass_ = Form("%s_%s", branchName_promptLeptons_.data(), "mass");
+  branchName_promptLepton_pdgId_ = Form("%s_%s", branchName_promptLeptons_.data(), "pdgId");
+  branchName_leptonFromTau_pt_ = Form("%s_%s", branchName_leptonsFromTau_.data(), "pt");
+  branchName_leptonFromTau_eta_ = Form("%s_%s", branchName_leptonsFromTau_.data(), "eta");
+  branchName_leptonFromTau_phi_ = Form("%s_%s", branchName_leptonsFromTau_.data(), "phi");
+  branchName_leptonFromTau_mass_ = Form("%s_%s", branchName_leptonsFromTau_.data(), "mass");
+  branchName_leptonFromTau_pdgId_ = Form("%s_%s", branchName_leptonsFromTau_.data(), "pdgId");
 }
 
 void GenLeptonReader::setBranchAddresses(TTree* tree)
 {
-  if ( instances_[branchName_promptLeptons_] == this ) {
-    if ( read_promptLeptons_ ) {
-      std::cout << "setting branch addresses for PromptLeptons: " << branchName_promptLeptons_ << std::endl;
-      tree->SetBranchAddress(branchName_nPromptLeptons_.data(), &nPromptLeptons_);   
-      promptLepton_pt_ = new Float_t[max_nPromptLeptons_];
-      tree->SetBranchAddress(branchName_promptLepton_pt_.data(), promptLepton_pt_); 
-      promptLepton_eta_ = new Float_t[max_nPromptLeptons_];
-      tree->SetBranchAddress(branchName_promptLepton_eta_.data(), promptLepton_eta_); 
-      promptLepton_phi_ = new Float_t[max_nPromptLeptons_];
-      tree->SetBranchAddress(branchName_promptLepton_phi_.data(), promptLepton_phi_); 
-      promptLepton_mass_ = new Float_t[max_nPromptLeptons_];
-      tree->SetBranchAddress(branchName_promptLepton_mass_.data(), promptLepton_mass_); 
-      promptLepton_pdgId_ = new Int_t[max_nPromptLeptons_];
-      tree->SetBranchAddress(branchName_promptLepton_pdgId_.data(), promptLepton_pdgId_); 
-    }
-    if ( read_leptonsFromTau_ ) {
-      std::cout << "setting branch addresses for LeptonsFromTau" << std::endl;
-      tree->SetBranchAddress(branchName_nLeptonsFromTau_.data(), &nLeptonsFromTau_);   
-      leptonFromTau_pt_ = new Float_t[max_nLeptonsFromTau_];
-      tree->SetBranchAddress(branchName_leptonFromTau_pt_.data(), leptonFromTau_pt_); 
-      leptonFromTau_eta_ = new Float_t[max_nLeptonsFromTau_];
-      tree->SetBranchAddress(branchName_leptonFromTau_eta_.data(), leptonFromTau_eta_); 
-      leptonFromTau_phi_ = new Float_t[max_nLeptonsFromTau_];
-      tree->SetBranchAddress(branchName_leptonFromTau_phi_.data(), leptonFromTau_phi_); 
-      leptonFromTau_mass_ = new Float_t[max_nLeptonsFromTau_];
-      tree->SetBranchAddress(branchName_leptonFromTau_mass_.data(), leptonFromTau_mass_); 
-      leptonFromTau_pdgId_ = new Int_t[max_nLeptonsFromTau_];
-      tree->SetBranchAddress(branchName_leptonFromTau_pdgId_.data(), leptonFromTau_pdgId_); 
-    } 
+  branchBuffers_ = BranchBufferRegistry::getSharedInstance(tree);
+  setBranchBuffers(*branchBuffers_);
+}
+
+void GenLeptonReader::setBranchBuffers(BranchBufferRegistry& branchBuffers)
+{
+  if ( read_promptLeptons_ ) {
+    std::cout << "setting branch addresses for PromptLeptons: " << branchName_promptLeptons_ << std::endl;
+    nPromptLeptons_ = branchBuffers.getScalar<Int_t>(branchName_nPromptLeptons_);
+    promptLepton_pt_ = branchBuffers.getArray<Float_t>(branchName_promptLepton_pt_, max_nPromptLeptons_);
+    promptLepton_eta_ = branchBuffers.getArray<Float_t>(branchName_promptLepton_eta_, max_nPromptLeptons_);
+    promptLepton_phi_ = branchBuffers.getArray<Float_t>(branchName_promptLepton_phi_, max_nPromptLeptons_);
+    promptLepton_mass_ = branchBuffers.getArray<Float_t>(branchName_promptLepton_mass_, max_nPromptLeptons_);
+    promptLepton_pdgId_ = branchBuffers.getArray<Int_t>(branchName_promptLepton_pdgId_, max_nPromptLeptons_);
+  }
+  if ( read_leptonsFromTau_ ) {
+    std::cout << "setting branch addresses for LeptonsFromTau" << std::endl;
+    nLeptonsFromTau_ = branchBuffers.getScalar<Int_t>(branchName_nLeptonsFromTau_);
+    leptonFromTau_pt_ = branchBuffers.getArray<Float_t>(branchName_leptonFromTau_pt_, max_nLeptonsFromTau_);
+    leptonFromTau_eta_ = branchBuffers.getArray<Float_t>(branchName_leptonFromTau_eta_, max_nLeptonsFromTau_);
+    leptonFromTau_phi_ = branchBuffers.getArray<Float_t>(branchName_leptonFromTau_phi_, max_nLeptonsFromTau_);
+    leptonFromTau_mass_ = branchBuffers.getArray<Float_t>(branchName_leptonFromTau_mass_, max_nLeptonsFromTau_);
+    leptonFromTau_pdgId_ = branchBuffers.getArray<Int_t>(branchName_leptonFromTau_pdgId_, max_nLeptonsFromTau_);
   }
 }
 
 std::vector<GenLepton> GenLeptonReader::read() const
+{
+  std::vector<GenLepton> leptons;
+  read(leptons);
+  return leptons;
+}
+
+void GenLeptonReader::read(std::vector<GenLepton>& leptons) const
 {
   //std::cout << "<GenLeptonReader::read()>:" << std::endl;
-  GenLeptonReader* gInstance = instances_[branchName_promptLeptons_];
-  assert(gInstance);
   Int_t nPromptLeptons = 0;
   if ( read_promptLeptons_ ) {
-    nPromptLeptons = gInstance->nPromptLeptons_;
+    nPromptLeptons = *nPromptLeptons_;
     //std::cout << "nPromptLeptons = " << nPromptLeptons << std::endl;
     if ( nPromptLeptons > max_nPromptLeptons_ ) {
       throw cms::Exception("GenLeptonReader") 
@@ -162,7 +123,7 @@ std::vector<GenLepton> GenLeptonReader::read() const
   }
   Int_t nLeptonsFromTau = 0;
   if ( read_leptonsFromTau_ ) {
-    nLeptonsFromTau = gInstance->nLeptonsFromTau_;
+    nLeptonsFromTau = *nLeptonsFromTau_;
     //std::cout << "nLeptonsFromTau = " << nLeptonsFromTau << std::endl;
     if ( nLeptonsFromTau > max_nLeptonsFromTau_ ) {
       throw cms::Exception("GenLeptonReader") 
@@ -170,25 +131,24 @@ std::vector<GenLepton> GenLeptonReader::read() const
 	<< " exceeds max_nLeptonsFromTau = " << max_nLeptonsFromTau_ << " !!\n";
     }
   }
-  std::vector<GenLepton> leptons;
+  leptons.clear();
   if ( (nPromptLeptons + nLeptonsFromTau) > 0 ) {
     leptons.reserve(nPromptLeptons + nLeptonsFromTau);
     for ( Int_t idxLepton = 0; idxLepton < nPromptLeptons; ++idxLepton ) {
       leptons.push_back(GenLepton({ 
-        gInstance->promptLepton_pt_[idxLepton],
-        gInstance->promptLepton_eta_[idxLepton],
-        gInstance->promptLepton_phi_[idxLepton],
-        gInstance->promptLepton_mass_[idxLepton],
-        gInstance->promptLepton_pdgId_[idxLepton] }));
+        promptLepton_pt_[idxLepton],
+        promptLepton_eta_[idxLepton],
+        promptLepton_phi_[idxLepton],
+        promptLepton_mass_[idxLepton],
+        promptLepton_pdgId_[idxLepton] }));
     }
     for ( Int_t idxLepton = 0; idxLepton < nLeptonsFromTau; ++idxLepton ) {
       leptons.push_back(GenLepton({ 
-        gInstance->leptonFromTau_pt_[idxLepton],
-        gInstance->leptonFromTau_eta_[idxLepton],
-        gInstance->leptonFromTau_phi_[idxLepton],
-        gInstance->leptonFromTau_mass_[idxLepton],
-        gInstance->leptonFromTau_pdgId_[idxLepton] }));
+        leptonFromTau_pt_[idxLepton],
+        leptonFromTau_eta_[idxLepton],
+        leptonFromTau_phi_[idxLepton],
+        leptonFromTau_mass_[idxLepton],
+        leptonFromTau_pdgId_[idxLepton] }));
     } 
   } 
-  return leptons;
 }
@@ -43,9 +43,10 @@ std::vector<double> HadTopTagger::operator()(const RecoJet& recBJet, const RecoJ
   char* pklpath=(char*) mvaFileNameWithKinFit_; //"HadTopTagger_sklearnV0o17o1_HypOpt/all_HadTopTagger_sklearnV0o17o1_HypOpt_XGB_ntrees_1000_deph_3_lr_0o01_CSV_sort_withKinFit.pkl";
   mvaInputsWithKinFit_["CSV_b"]                  = recBJet.BtagCSV();
   mvaInputsWithKinFit_["qg_Wj2"]                 = recWJet2.QGDiscr();
-  Particle::LorentzVector p4_bWj1Wj2 = recBJet.p4() + recWJet1.p4() + recWJet2.p4();
+  // sum the 4-momenta in Cartesian coordinates, which are computed once per jet and event rather than once per jet triplet
+  Particle::LorentzVectorCartesian p4_bWj1Wj2 = recBJet.p4_cartesian() + recWJet1.p4_cartesian() + recWJet2.p4_cartesian();
   mvaInputsWithKinFit_["pT_bWj1Wj2"]             = p4_bWj1Wj2.pt();
-  Particle::LorentzVector p4_Wj1Wj2 = recWJet1.p4() + recWJet2.p4();
+  Particle::LorentzVectorCartesian p4_Wj1Wj2 = recWJet1.p4_cartesian() + recWJet2.p4_cartesian();
   mvaInputsWithKinFit_["m_Wj1Wj2"]               = p4_Wj1Wj2.mass();
   kinFit_->fit(recBJet.p4(), recWJet1.p4(), recWJet2.p4());
   mvaInputsWithKinFit_["nllKinFit"]              = kinFit_->nll();
@@ -117,20 +118,20 @@ bool HadTopTagger::isTruth3Jet(const RecoJet& recBJet, const RecoJet& recWJet1,
 		for ( std::vector<GenParticle>::const_iterator it2 = it1 + 1; it2 != genWJets.end(); ++it2 ) {
 			if ( ((it1->charge() + it2->charge()) - genWBosonFromTop->charge()) < 1.e-2 ) {
 			  if ( genWJetsFromTop_mass == -1. ||
-				   std::fabs((it1->p4() + it2->p4()).mass() - genWBosonFromTop->mass()) < std::fabs(genWJetsFromTop_mass - genWBosonFromTop->mass()) ) {
+				   std::fabs((it1->p4_cartesian() + it2->p4_cartesian()).mass() - genWBosonFromTop->mass()) < std::fabs(genWJetsFromTop_mass - genWBosonFromTop->mass()) ) {
 				genWJetsFromTop.clear();
 				genWJetsFromTop.push_back(&(*it1));
 				genWJetsFromTop.push_back(&(*it2));
-				genWJetsFromTop_mass = (it1->p4() + it2->p4()).mass();
+				genWJetsFromTop_mass = (it1->p4_cartesian() + it2->p4_cartesian()).mass();
 			  }
 			}
 			if ( ((it1->charge() + it2->charge()) - genWBosonFromAntiTop->charge()) < 1.e-2 ) {
 			  if ( genWJetsFromAntiTop_mass == -1. ||
-				   std::fabs((it1->p4() + it2->p4()).mass() - genWBosonFromAntiTop->mass()) < std::fabs(genWJetsFromAntiTop_mass - genWBosonFromAntiTop->mass()) ) {
+				   std::fabs((it1->p4_cartesian() + it2->p4_cartesian()).mass() - genWBosonFromAntiTop->mass()) < std::fabs(genWJetsFromAntiTop_mass - genWBosonFromAntiTop->mass()) ) {
 				genWJetsFromAntiTop.clear();
 				genWJetsFromAntiTop.push_back(&(*it1));
 				genWJetsFromAntiTop.push_back(&(*it2));
-				genWJetsFromAntiTop_mass = (it1->p4() + it2->p4()).mass();
+				genWJetsFromAntiTop_mass = (it1->p4_cartesian() + it2->p4_cartesian()).mass();
 				}
 			}
 		}
@@ -208,8 +209,8 @@ bool HadTopTagger::isTruth3Jet(const RecoJet& recBJet, const RecoJet& recWJet1,
 std::vector<Particle::LorentzVector> HadTopTagger::Particles(const RecoJet& recBJet, const RecoJet& recWJet1, const RecoJet& recWJet2)
 {
   std::vector<Particle::LorentzVector> particles;
-  Particle::LorentzVector p4_bWj1Wj2 = recBJet.p4() + recWJet1.p4() + recWJet2.p4();
-  Particle::LorentzVector p4_Wj1Wj2 = recWJet1.p4() + recWJet2.p4();
+  Particle::LorentzVector p4_bWj1Wj2(recBJet.p4_cartesian() + recWJet1.p4_cartesian() + recWJet2.p4_cartesian());
+  Particle::LorentzVector p4_Wj1Wj2(recWJet1.p4_cartesian() + recWJet2.p4_cartesian());
   particles.push_back(p4_bWj1Wj2);
   particles.push_back(recBJet.p4());
   particles.push_back(p4_Wj1Wj2);
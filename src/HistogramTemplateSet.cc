@@ -0,0 +1,82 @@
+#include "tthAnalysis/HiggsToTauTau/interface/HistogramTemplateSet.h"
+
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <algorithm> // std::upper_bound()
+#include <assert.h> // assert
+
+int HistogramTemplateSet::add1D(const std::string& distribution, const std::string& title, int numBins, double min, double max)
+{
+  if ( !(numBins >= 1 && max > min) )
+    throw cms::Exception("HistogramTemplateSet")
+      << "Invalid binning for histogram = '" << distribution << "': numBins = " << numBins << ", min = " << min << ", max = " << max << " !!\n";
+  templateType histogramTemplate;
+  histogramTemplate.distribution_ = distribution;
+  histogramTemplate.title_ = title;
+  histogramTemplate.numBins_ = numBins;
+  histogramTemplate.min_ = min;
+  histogramTemplate.max_ = max;
+  templates_.push_back(histogramTemplate);
+  return templates_.size() - 1;
+}
+
+int HistogramTemplateSet::add1D(const std::string& distribution, const std::string& title, int numBins, const float* binning)
+{
+  if ( !(numBins >= 1 && binning) )
+    throw cms::Exception("HistogramTemplateSet")
+      << "Invalid binning for histogram = '" << distribution << "' !!\n";
+  templateType histogramTemplate;
+  histogramTemplate.distribution_ = distribution;
+  histogramTemplate.title_ = title;
+  histogramTemplate.numBins_ = numBins;
+  histogramTemplate.binning_.assign(binning, binning + numBins + 1);
+  histogramTemplate.min_ = histogramTemplate.binning_.front();
+  histogramTemplate.max_ = histogramTemplate.binning_.back();
+  templates_.push_back(histogramTemplate);
+  return templates_.size() - 1;
+}
+
+const HistogramTemplateSet::templateType& HistogramTemplateSet::getTemplate(int idxHistogram) const
+{
+  assert(idxHistogram >= 0 && idxHistogram < (int)templates_.size());
+  return templates_[idxHistogram];
+}
+
+const std::string& HistogramTemplateSet::getDistribution(int idxHistogram) const
+{
+  return getTemplate(idxHistogram).distribution_;
+}
+
+int HistogramTemplateSet::getNumCells(int idxHistogram) const
+{
+  return getTemplate(idxHistogram).numBins_ + 2;
+}
+
+int HistogramTemplateSet::findBinWithOverFlow(int idxHistogram, double x) const
+{
+  const templateType& histogramTemplate = getTemplate(idxHistogram);
+  int bin;
+  if ( histogramTemplate.binning_.empty() ) {
+    if      ( x <  histogramTemplate.min_ ) bin = 0;
+    else if ( x >= histogramTemplate.max_ ) bin = histogramTemplate.numBins_ + 1;
+    else bin = 1 + (int)(histogramTemplate.numBins_*(x - histogramTemplate.min_)/(histogramTemplate.max_ - histogramTemplate.min_));
+  } else {
+    bin = std::upper_bound(histogramTemplate.binning_.begin(), histogramTemplate.binning_.end(), x) - histogramTemplate.binning_.begin();
+  }
+  if ( bin < 1                          ) bin = 1;
+  if ( bin > histogramTemplate.numBins_ ) bin = histogramTemplate.numBins_;
+  return bin;
+}
+
+TH1* HistogramTemplateSet::makeHistogram(int idxHistogram, const std::string& histogramName) const
+{
+  const templateType& histogramTemplate = getTemplate(idxHistogram);
+  TH1* histogram = 0;
+  if ( histogramTemplate.binning_.empty() ) {
+    histogram = new TH1D(histogramName.data(), histogramTemplate.title_.data(), histogramTemplate.numBins_, histogramTemplate.min_, histogramTemplate.max_);
+  } else {
+    histogram = new TH1D(histogramName.data(), histogramTemplate.title_.data(), histogramTemplate.numBins_, histogramTemplate.binning_.data());
+  }
+  if ( !histogram->GetSumw2N() ) histogram->Sumw2();
+  return histogram;
+}
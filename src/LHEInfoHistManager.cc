@@ -6,7 +6,8 @@
 
 LHEInfoHistManager::LHEInfoHistManager(const edm::ParameterSet& cfg)
   : HistManagerBase(cfg),
-    histogram_pdfWeights_(0)
+    histogram_pdfWeights_(0),
+    dir_variations_(0)
 {}
 
 void LHEInfoHistManager::bookHistograms(TFileDirectory& dir)
@@ -40,3 +41,21 @@ void LHEInfoHistManager::fillHistograms(const LHEInfoReader& lheInfoReader, doub
   
   fillWithOverFlow(histogram_EventCounter_, 0., evtWeight, evtWeightErr);
 }
+
+void LHEInfoHistManager::bookHistograms_variations(TFileDirectory& dir, const LHEWeightEngine& lheWeightEngine,
+						   const std::shared_ptr<const HistogramTemplateSet>& histogramTemplates)
+{
+  dir_variations_ = createHistogramSubdirectory(dir);
+  histograms_variations_.reset(new ShiftedHistograms(histogramTemplates, lheWeightEngine.getVariationNames()));
+}
+
+void LHEInfoHistManager::fillHistograms_variations(int idxDistribution, double value, const LHEWeightEngine& lheWeightEngine)
+{
+  assert(histograms_variations_);
+  histograms_variations_->fillWithOverFlow(idxDistribution, value, lheWeightEngine.getEvtWeights());
+}
+
+void LHEInfoHistManager::writeHistograms_variations()
+{
+  if ( histograms_variations_ ) histograms_variations_->write(dir_variations_);
+}
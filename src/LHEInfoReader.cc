@@ -15,10 +15,7 @@ LHEInfoReader::LHEInfoReader()
   , max_pdf_nWeights_(103)
   , branchName_pdf_nWeights_("nLHE_weights_pdf")
   , branchName_pdf_weights_("LHE_weights_pdf_wgt")
-  , weight_scale_xUp_(1.)
-  , weight_scale_xDown_(1.)
-  , weight_scale_yUp_(1.)
-  , weight_scale_yDown_(1.)
+  , weights_(kLHE_pdf_offset + max_pdf_nWeights_, 1.)
 {
   setBranchNames();
 }
@@ -78,39 +75,47 @@ void LHEInfoReader::read() const
     throw cms::Exception("LHEInfoReader") 
       << "Number of Scale weights stored in Ntuple = " << gInstance->scale_nWeights_ << ", exceeds max_scale_nWeights_ = " << max_scale_nWeights_ << " !!\n";
   }
-  weight_scale_xUp_   = 1.;
-  weight_scale_xDown_ = 1.;
-  weight_scale_yUp_   = 1.;
-  weight_scale_yDown_ = 1.;
+  for ( int idx = kLHE_scale_central; idx < kLHE_pdf_offset; ++idx ) {
+    weights_[idx] = 1.;
+  }
   for ( int idx = 0; idx < gInstance->scale_nWeights_; ++idx ) {
     double weight = gInstance->scale_weights_[idx];
     int id = gInstance->scale_ids_[idx];
-    if      ( id == 1002 ) weight_scale_xUp_   = weight; // muF = 2, muR = 1
-    else if ( id == 1003 ) weight_scale_xDown_ = weight; // muF = 0.5, muR = 1
-    else if ( id == 1004 ) weight_scale_yUp_   = weight; // muF = 1, muR = 2
-    else if ( id == 1007 ) weight_scale_yDown_ = weight; // muF = 1, muR = 0.5
+    if      ( id == 1002 ) weights_[kLHE_scale_xUp]   = weight; // muF = 2, muR = 1
+    else if ( id == 1003 ) weights_[kLHE_scale_xDown] = weight; // muF = 0.5, muR = 1
+    else if ( id == 1004 ) weights_[kLHE_scale_yUp]   = weight; // muF = 1, muR = 2
+    else if ( id == 1007 ) weights_[kLHE_scale_yDown] = weight; // muF = 1, muR = 0.5
   }
   if ( gInstance->pdf_nWeights_ > max_pdf_nWeights_ ) {
     throw cms::Exception("LHEInfoReader") 
       << "Number of PDF weights stored in Ntuple = " << gInstance->pdf_nWeights_ << ", exceeds max_pdf_nWeights_ = " << max_pdf_nWeights_ << " !!\n";
   }
+//--- copy the PDF weights into the same array as the scale weights,
+//    so that the event weights for all variations can be computed in a single loop
+  double* weights_pdf = weights_.data() + kLHE_pdf_offset;
+  for ( int idx = 0; idx < gInstance->pdf_nWeights_; ++idx ) {
+    weights_pdf[idx] = gInstance->pdf_weights_[idx];
+  }
+  for ( int idx = gInstance->pdf_nWeights_; idx < max_pdf_nWeights_; ++idx ) {
+    weights_pdf[idx] = 1.;
+  }
 }
 
 double LHEInfoReader::getWeight_scale_xUp() const 
 { 
-  return weight_scale_xUp_; 
+  return weights_[kLHE_scale_xUp]; 
 }
 double LHEInfoReader::getWeight_scale_xDown() const 
 { 
-  return weight_scale_xDown_; 
+  return weights_[kLHE_scale_xDown]; 
 }
 double LHEInfoReader::getWeight_scale_yUp() const 
 {
-  return weight_scale_yUp_; 
+  return weights_[kLHE_scale_yUp]; 
 }
 double LHEInfoReader::getWeight_scale_yDown() const 
 { 
-  return weight_scale_yDown_; 
+  return weights_[kLHE_scale_yDown]; 
 }
 
 int LHEInfoReader::getNumWeights_pdf() const
@@ -132,3 +137,13 @@ double LHEInfoReader::getWeight_pdf(int idx) const
 
 
 
+
+const std::vector<double>& LHEInfoReader::getWeights() const
+{
+  return weights_;
+}
+
+int LHEInfoReader::getMaxNumWeights_pdf() const
+{
+  return max_pdf_nWeights_;
+}
@@ -0,0 +1,40 @@
+#include "tthAnalysis/HiggsToTauTau/interface/LHEWeightEngine.h" // LHEWeightEngine
+
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <TString.h> // Form
+
+LHEWeightEngine::LHEWeightEngine(const std::string& scaleShiftName, const std::string& pdfShiftName, int numWeights_pdf)
+  : numWeights_pdf_(numWeights_pdf)
+{
+  if ( numWeights_pdf_ < 0 ) {
+    throw cms::Exception("LHEWeightEngine") 
+      << "Invalid number of PDF weights = " << numWeights_pdf_ << " !!\n";
+  }
+//--- the order of the variations matches the order of the weights returned by LHEInfoReader::getWeights,
+//    so that the event weights can be computed by a single loop over contiguous arrays
+  variationNames_.push_back(Form("%s_x1Up", scaleShiftName.data()));   // kLHE_scale_xUp
+  variationNames_.push_back(Form("%s_x1Down", scaleShiftName.data())); // kLHE_scale_xDown
+  variationNames_.push_back(Form("%s_y1Up", scaleShiftName.data()));   // kLHE_scale_yUp
+  variationNames_.push_back(Form("%s_y1Down", scaleShiftName.data())); // kLHE_scale_yDown
+  for ( int idx = 0; idx < numWeights_pdf_; ++idx ) {
+    variationNames_.push_back(Form("%s%i", pdfShiftName.data(), idx));
+  }
+  evtWeights_.assign(variationNames_.size(), 1.);
+}
+
+void LHEWeightEngine::compute(const LHEInfoReader& lheInfoReader, double evtWeight)
+{
+  static_assert(kLHE_pdf_offset == kLHE_scale_xUp + 4, "Scale weights in LHEInfoReader::getWeights do not match the scale variations of LHEWeightEngine");
+  const std::vector<double>& lheWeights = lheInfoReader.getWeights();
+  if ( numWeights_pdf_ > lheInfoReader.getMaxNumWeights_pdf() ) {
+    throw cms::Exception("LHEWeightEngine") 
+      << "Number of PDF variations = " << numWeights_pdf_ << ", exceeds number of PDF weights read from Ntuple = " << lheInfoReader.getMaxNumWeights_pdf() << " !!\n";
+  }
+  const double* lheWeights_variations = lheWeights.data() + kLHE_scale_xUp;
+  double* evtWeights = evtWeights_.data();
+  const size_t numVariations = evtWeights_.size();
+  for ( size_t idx = 0; idx < numVariations; ++idx ) {
+    evtWeights[idx] = evtWeight*lheWeights_variations[idx];
+  }
+}
@@ -3,6 +3,10 @@
 
 #include <cstdlib>
 #include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <fstream>
+#include <iostream>
 #include "boost/filesystem/path.hpp"
 #include "boost/filesystem/operations.hpp"
 
@@ -24,6 +28,8 @@ namespace
   const std::string LOCALTOP("CMSSW_BASE");
   const std::string RELEASETOP("CMSSW_RELEASE_BASE");
   const std::string DATATOP("CMSSW_DATA_PATH");
+  // Environment variable giving the name of the manifest file of resolved paths
+  const std::string MANIFEST("LOCALFILEINPATH_MANIFEST");
 
 #if 1
   // Needed for backward compatibility prior to CMSSW_1_5_0_pre3.
@@ -101,6 +107,135 @@ namespace
     //}
     return true;
   }
+
+  const std::string manifestHeader("# LocalFileInPath manifest; CMSSW_SEARCH_PATH = ");
+
+  /// Process-wide cache of the files found in the search path,
+  /// keyed by the relative path given to the LocalFileInPath constructor.
+  ///
+  /// If the environment variable LOCALFILEINPATH_MANIFEST is set,
+  /// the cache is filled from the manifest file it points to when the first file is looked up;
+  /// if the manifest file does not exist yet, it is written when the process exits,
+  /// so that subsequent jobs with the same search path do not need to probe the filesystem.
+  class FileLookupCache
+  {
+  public:
+    struct Entry
+    {
+      std::string relativePath;
+      std::string canonicalFilename;
+      LocalFileInPath::LocationCode location;
+    };
+
+    FileLookupCache() :
+      manifestChecked_(false),
+      writeManifestAtExit_(false)
+    {}
+
+    ~FileLookupCache()
+    {
+      if (writeManifestAtExit_) {
+        write(manifestFileName_);
+      }
+    }
+
+    bool
+    find(std::string const& searchPath, std::string const& key, Entry& entry)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!manifestChecked_) {
+        checkManifest_(searchPath);
+      }
+      auto const cached = entries_.find(key);
+      if (cached == entries_.end()) return false;
+      entry = cached->second;
+      return true;
+    }
+
+    void
+    insert(std::string const& searchPath, std::string const& key, Entry const& entry)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      searchPath_ = searchPath;
+      entries_[key] = entry;
+    }
+
+    void
+    read(std::string const& searchPath, std::string const& manifestFileName)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      read_(searchPath, manifestFileName);
+    }
+
+    void
+    write(std::string const& manifestFileName)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      std::ofstream manifestFile(manifestFileName.c_str(), std::ios::out);
+      manifestFile << manifestHeader << searchPath_ << '\n';
+      for (auto const& entry : entries_) {
+        manifestFile << entry.first << ' ' << entry.second.relativePath << ' '
+                     << entry.second.location << ' ' << entry.second.canonicalFilename << '\n';
+      }
+      if (!manifestFile) {
+        std::cerr << "Warning in <LocalFileInPath>: failed to write manifest file " << manifestFileName << '\n';
+      }
+    }
+
+  private:
+    void
+    checkManifest_(std::string const& searchPath)
+    {
+      manifestChecked_ = true;
+      char const* const var = getenv(MANIFEST.c_str());
+      if (var == nullptr || std::string(var).empty()) return;
+      manifestFileName_ = var;
+      if (bf::exists(manifestFileName_)) {
+        read_(searchPath, manifestFileName_);
+      } else {
+        writeManifestAtExit_ = true;
+      }
+    }
+
+    void
+    read_(std::string const& searchPath, std::string const& manifestFileName)
+    {
+      std::ifstream manifestFile(manifestFileName.c_str());
+      std::string line;
+      if (!std::getline(manifestFile, line)) {
+        throw edm::Exception(edm::errors::FileInPathError)
+          << "Failed to read manifest file " << manifestFileName << '\n';
+      }
+      if (line != manifestHeader + searchPath) {
+        // the paths in the manifest may not be found with the current search path
+        std::cerr << "Warning in <LocalFileInPath>: manifest file " << manifestFileName
+                  << " was written for a different search path, ignoring it\n";
+        return;
+      }
+      std::string key;
+      Entry entry;
+      int location;
+      while (manifestFile >> key >> entry.relativePath >> location >> entry.canonicalFilename) {
+        entry.location = static_cast<LocalFileInPath::LocationCode>(location);
+        entries_[key] = entry;
+      }
+      searchPath_ = searchPath;
+    }
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+    std::string searchPath_;
+    std::string manifestFileName_;
+    bool manifestChecked_;
+    bool writeManifestAtExit_;
+  };
+
+  FileLookupCache&
+  getFileLookupCache()
+  {
+    static FileLookupCache cache;
+    return cache;
+  }
 }
 
   LocalFileInPath::LocalFileInPath() :
@@ -383,6 +518,19 @@ namespace
     }
   }
 
+  void
+  LocalFileInPath::readManifest(std::string const& manifestFileName)
+  {
+    LocalFileInPath const environment;
+    getFileLookupCache().read(environment.searchPath_, manifestFileName);
+  }
+
+  void
+  LocalFileInPath::writeManifest(std::string const& manifestFileName)
+  {
+    getFileLookupCache().write(manifestFileName);
+  }
+
   //------------------------------------------------------------
 
 
@@ -427,6 +575,22 @@ namespace
 	<< "Relative path must not be empty\n";
     }
 
+    // Look up the files that have already been found by this process, or that are listed in the manifest file
+    FileLookupCache::Entry cached;
+    if (getFileLookupCache().find(searchPath_, relativePath_, cached)) {
+      relativePath_ = cached.relativePath;
+      canonicalFilename_ = cached.canonicalFilename;
+      location_ = cached.location;
+      return;
+    }
+    std::string const key = relativePath_;
+    locate_();
+    getFileLookupCache().insert(searchPath_, key, { relativePath_, canonicalFilename_, location_ });
+  }
+
+  void
+  LocalFileInPath::locate_() {
+
     // Find the file, based on the value of path variable.
     typedef std::vector<std::string> stringvec_t;
     stringvec_t  pathElements = edm::tokenize(searchPath_, ":");
@@ -11,24 +11,7 @@
 
 MEMPermutationWriter::~MEMPermutationWriter()
 {
-  for(auto & kv: hadTauSelectorsLoose_)
-  {
-    if(hadTauSelectorsLoose_[kv.first])
-    {
-      delete hadTauSelectorsLoose_[kv.first];
-      hadTauSelectorsLoose_[kv.first] = nullptr;
-    }
-    if(hadTauSelectorsFakeable_[kv.first])
-    {
-      delete hadTauSelectorsFakeable_[kv.first];
-      hadTauSelectorsFakeable_[kv.first] = nullptr;
-    }
-    if(hadTauSelectorsTight_[kv.first])
-    {
-      delete hadTauSelectorsTight_[kv.first];
-      hadTauSelectorsTight_[kv.first] = nullptr;
-    }
-  }
+  delete hadTauSelector_;
 }
 
 MEMPermutationWriter &
@@ -89,7 +72,7 @@ MEMPermutationWriter::addCondition(const std::string & channel,
       minSelLeptons, minSelHadTaus, minSelBJets_loose, minSelBJets_medium
     ](
       const std::vector<const RecoLepton*> & selLeptons,
-      const std::vector<const RecoHadTau*> & selHadTaus,
+      const RecoHadTauWorkingPointView & selHadTaus,
       const std::vector<const RecoJet*> & selBJets_loose,
       const std::vector<const RecoJet*> & selBJets_medium,
       bool failsZbosonMassVeto
@@ -110,26 +93,16 @@ MEMPermutationWriter::setBranchNames(TTree * tree,
                                      int era,
                                      bool verbose)
 {
-  // initialize the selector classes
+  // initialize the selector class: all working points are evaluated in a single pass over the taus
+  // NB! the loose, fakeable and tight tau selections share the same cuts once the working point,
+  //     pT threshold and anti-lepton discriminators are set, so one selector serves all of them
+  hadTauSelector_ = new RecoHadTauCollectionSelectorMultiWP(era);
+  hadTauSelector_ -> set_min_antiElectron(-1);
+  hadTauSelector_ -> set_min_antiMuon(-1);
+  hadTauSelector_ -> set_min_pt(18.);
   for(const std::string & hadTauWorkingPoint: hadTauWorkingPoints_)
   {
-    hadTauSelectorsLoose_[hadTauWorkingPoint] = new RecoHadTauCollectionSelectorLoose(era);
-    hadTauSelectorsLoose_[hadTauWorkingPoint] -> set(hadTauWorkingPoint);
-    hadTauSelectorsLoose_[hadTauWorkingPoint] -> set_min_antiElectron(-1);
-    hadTauSelectorsLoose_[hadTauWorkingPoint] -> set_min_antiMuon(-1);
-    hadTauSelectorsLoose_[hadTauWorkingPoint] -> set_min_pt(18.);
-
-    hadTauSelectorsFakeable_[hadTauWorkingPoint] = new RecoHadTauCollectionSelectorFakeable(era);
-    hadTauSelectorsFakeable_[hadTauWorkingPoint] -> set(hadTauWorkingPoint);
-    hadTauSelectorsFakeable_[hadTauWorkingPoint] -> set_min_antiElectron(-1);
-    hadTauSelectorsFakeable_[hadTauWorkingPoint] -> set_min_antiMuon(-1);
-    hadTauSelectorsFakeable_[hadTauWorkingPoint] -> set_min_pt(18.);
-
-    hadTauSelectorsTight_[hadTauWorkingPoint] = new RecoHadTauCollectionSelectorTight(era);
-    hadTauSelectorsTight_[hadTauWorkingPoint] -> set(hadTauWorkingPoint);
-    hadTauSelectorsTight_[hadTauWorkingPoint] -> set_min_antiElectron(-1);
-    hadTauSelectorsTight_[hadTauWorkingPoint] -> set_min_antiMuon(-1);
-    hadTauSelectorsTight_[hadTauWorkingPoint] -> set_min_pt(18.);
+    hadTauSelector_ -> addWorkingPoint(hadTauWorkingPoint);
   }
 
   // initialize the branches
@@ -193,26 +166,23 @@ MEMPermutationWriter::write(const std::array<const std::vector<const RecoLepton*
   const std::vector<const RecoJet*> & selBJets_loose  = selBJets.at(0);
   const std::vector<const RecoJet*> & selBJets_medium = selBJets.at(1);
 
+  // evaluate all had tau working points at once
+  (*hadTauSelector_)(cleanedHadTaus);
+
   // loop over the lepton, had tau and had tau wp branches
   for(int leptonSelection_idx = minLepSelection_; leptonSelection_idx <= maxLepSelection_; ++leptonSelection_idx)
   {
     const std::vector<const RecoLepton*> & selLeptons = leptons.at(leptonSelection_idx);
     for(int hadTauSelection_idx = minHadTauSelection_; hadTauSelection_idx <= maxHadTauSelection_; ++hadTauSelection_idx)
     {
-      for(const std::string & hadTauWorkingPoint: hadTauWorkingPoints_)
+      if(hadTauSelection_idx != kLoose && hadTauSelection_idx != kFakeable && hadTauSelection_idx != kTight)
       {
-        const std::vector<const RecoHadTau*> selHadTaus = [&]()
-        {
-          // pick the had tau selector
-          switch(hadTauSelection_idx)
-          {
-            case kLoose:    return (*hadTauSelectorsLoose_   [hadTauWorkingPoint])(cleanedHadTaus);
-            case kFakeable: return (*hadTauSelectorsFakeable_[hadTauWorkingPoint])(cleanedHadTaus);
-            case kTight:    return (*hadTauSelectorsTight_   [hadTauWorkingPoint])(cleanedHadTaus);
-            default:        throw cms::Exception("MEMPermutationWriter")
-                              << "Unexpected had tau selection: " << hadTauSelection_idx;
-          }
-        }(); // selHadTaus
+        throw cms::Exception("MEMPermutationWriter") << "Unexpected had tau selection: " << hadTauSelection_idx;
+      }
+      for(std::size_t hadTauWorkingPoint_idx = 0; hadTauWorkingPoint_idx < hadTauWorkingPoints_.size(); ++hadTauWorkingPoint_idx)
+      {
+        const std::string & hadTauWorkingPoint = hadTauWorkingPoints_[hadTauWorkingPoint_idx];
+        const RecoHadTauWorkingPointView selHadTaus = hadTauSelector_ -> getView(hadTauWorkingPoint_idx);
 
         // loop over the channels and assign an estimate for the MEM permutations
         for(const auto & kv: branches_)
@@ -221,7 +191,7 @@ MEMPermutationWriter::write(const std::array<const std::vector<const RecoLepton*
           branches_[channel][leptonSelection_idx][hadTauSelection_idx][hadTauWorkingPoint] =
             conditions_[channel](selLeptons, selHadTaus, selBJets_loose, selBJets_medium, failsZbosonMassVeto);
         } // branches
-      } // hadTauWorkingPoint
+      } // hadTauWorkingPoint_idx
     } // hadTauSelection_idx
   } // leptonSelection_idx
   return;
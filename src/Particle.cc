@@ -16,6 +16,7 @@ Particle::Particle(Double_t pt,
   , mass_(mass)
   , absEta_(std::fabs(eta_))
   , p4_{pt_, eta_, phi_, mass_}
+  , p4_cartesian_isValid_(false)
   , isValid_(pt_ > 0.)
 { }
 
@@ -26,6 +27,7 @@ Particle::Particle(const Particle::LorentzVector & p4)
   , mass_(p4.mass())
   , absEta_(std::fabs(eta_))
   , p4_(p4)
+  , p4_cartesian_isValid_(false)
   , isValid_(true)
 { }
 
@@ -4,9 +4,6 @@
 
 #include <TString.h> // Form
 
-std::map<std::string, int> RecoElectronReader::numInstances_;
-std::map<std::string, RecoElectronReader *> RecoElectronReader::instances_;
-
 RecoElectronReader::RecoElectronReader(int era, bool readGenMatching)
   : branchName_num_("nselLeptons")
   , branchName_obj_("selLeptons")
@@ -46,126 +43,89 @@ RecoElectronReader::RecoElectronReader(int era, const std::string& branchName_nu
 RecoElectronReader::~RecoElectronReader()
 {
   delete leptonReader_;
-  leptonReader_ = 0;
-  --numInstances_[branchName_obj_];
-  assert(numInstances_[branchName_obj_] >= 0);
-
-  if (numInstances_[branchName_obj_] == 0) {
-    RecoElectronReader* gInstance = instances_[branchName_obj_];
-    assert(gInstance);
-    delete[] gInstance->mvaRawPOG_GP_;
-    delete[] gInstance->mvaRawPOG_HZZ_;
-    delete[] gInstance->sigmaEtaEta_;
-    delete[] gInstance->HoE_;
-    delete[] gInstance->deltaEta_;
-    delete[] gInstance->deltaPhi_;
-    delete[] gInstance->OoEminusOoP_;
-    delete[] gInstance->lostHits_;
-    delete[] gInstance->conversionVeto_;
-    instances_[branchName_obj_] = 0;
-  }
 }
 
 void RecoElectronReader::setBranchNames()
 {
-  if (numInstances_[branchName_obj_] == 0) {
-    branchName_mvaRawPOG_GP_ = Form("%s_%s", branchName_obj_.data(), "eleMVArawSpring16GP");
-    branchName_mvaRawPOG_HZZ_ = Form("%s_%s", branchName_obj_.data(), "eleMVArawSpring16HZZ");
-    branchName_sigmaEtaEta_ = Form("%s_%s", branchName_obj_.data(), "eleSieie");
-    branchName_HoE_ = Form("%s_%s", branchName_obj_.data(), "eleHoE");
-    branchName_deltaEta_ = Form("%s_%s", branchName_obj_.data(), "eleDEta");
-    branchName_deltaPhi_ = Form("%s_%s", branchName_obj_.data(), "eleDPhi");
-    branchName_OoEminusOoP_ = Form("%s_%s", branchName_obj_.data(), "eleooEmooP");
-    branchName_lostHits_ = Form("%s_%s", branchName_obj_.data(), "lostHits");
-    branchName_conversionVeto_ = Form("%s_%s", branchName_obj_.data(), "convVeto");
-    instances_[branchName_obj_] = this;
-  } else {
-    if ( branchName_num_ != instances_[branchName_obj_]->branchName_num_ ) {
-      throw cms::Exception("RecoElectronReader")
-	<< "Association between configuration parameters 'branchName_num' and 'branchName_obj' must be unique:"
-	<< " present association 'branchName_num' = " << branchName_num_ << " with 'branchName_obj' = " << branchName_obj_
-	<< " does not match previous association 'branchName_num' = " << instances_[branchName_obj_]->branchName_num_ << " with 'branchName_obj' = " << instances_[branchName_obj_]->branchName_obj_ << " !!\n";
-    }
-  }
-  ++numInstances_[branchName_obj_];
+  branchName_mvaRawPOG_GP_ = Form("%s_%s", branchName_obj_.data(), "eleMVArawSpring16GP");
+  branchName_mvaRawPOG_HZZ_ = Form("%s_%s", branchName_obj_.data(), "eleMVArawSpring16HZZ");
+  branchName_sigmaEtaEta_ = Form("%s_%s", branchName_obj_.data(), "eleSieie");
+  branchName_HoE_ = Form("%s_%s", branchName_obj_.data(), "eleHoE");
+  branchName_deltaEta_ = Form("%s_%s", branchName_obj_.data(), "eleDEta");
+  branchName_deltaPhi_ = Form("%s_%s", branchName_obj_.data(), "eleDPhi");
+  branchName_OoEminusOoP_ = Form("%s_%s", branchName_obj_.data(), "eleooEmooP");
+  branchName_lostHits_ = Form("%s_%s", branchName_obj_.data(), "lostHits");
+  branchName_conversionVeto_ = Form("%s_%s", branchName_obj_.data(), "convVeto");
 }
 
 void RecoElectronReader::setBranchAddresses(TTree *tree)
 {
-  if ( instances_[branchName_obj_] == this ) {
-    leptonReader_->setBranchAddresses(tree);
-    int max_nLeptons = leptonReader_->max_nLeptons_;
-    mvaRawPOG_GP_ = new Float_t[max_nLeptons];
-    tree->SetBranchAddress(branchName_mvaRawPOG_GP_.data(), mvaRawPOG_GP_);
-    mvaRawPOG_HZZ_ = new Float_t[max_nLeptons];
-    tree->SetBranchAddress(branchName_mvaRawPOG_HZZ_.data(), mvaRawPOG_HZZ_);
-    sigmaEtaEta_ = new Float_t[max_nLeptons];
-    tree->SetBranchAddress(branchName_sigmaEtaEta_.data(), sigmaEtaEta_);
-    HoE_ = new Float_t[max_nLeptons];
-    tree->SetBranchAddress(branchName_HoE_.data(), HoE_);
-    deltaEta_ = new Float_t[max_nLeptons];
-    tree->SetBranchAddress(branchName_deltaEta_.data(), deltaEta_);
-    deltaPhi_ = new Float_t[max_nLeptons];
-    tree->SetBranchAddress(branchName_deltaPhi_.data(), deltaPhi_);
-    OoEminusOoP_ = new Float_t[max_nLeptons];
-    tree->SetBranchAddress(branchName_OoEminusOoP_.data(), OoEminusOoP_);
-    lostHits_ = new Int_t[max_nLeptons];
-    tree->SetBranchAddress(branchName_lostHits_.data(), lostHits_);
-    conversionVeto_ = new Int_t[max_nLeptons];
-    tree->SetBranchAddress(branchName_conversionVeto_.data(), conversionVeto_);
-  }
+  branchBuffers_ = BranchBufferRegistry::getSharedInstance(tree);
+  setBranchBuffers(*branchBuffers_);
+}
+
+void RecoElectronReader::setBranchBuffers(BranchBufferRegistry& branchBuffers)
+{
+  leptonReader_->setBranchBuffers(branchBuffers);
+  int max_nLeptons = leptonReader_->max_nLeptons_;
+  mvaRawPOG_GP_ = branchBuffers.getArray<Float_t>(branchName_mvaRawPOG_GP_, max_nLeptons);
+  mvaRawPOG_HZZ_ = branchBuffers.getArray<Float_t>(branchName_mvaRawPOG_HZZ_, max_nLeptons);
+  sigmaEtaEta_ = branchBuffers.getArray<Float_t>(branchName_sigmaEtaEta_, max_nLeptons);
+  HoE_ = branchBuffers.getArray<Float_t>(branchName_HoE_, max_nLeptons);
+  deltaEta_ = branchBuffers.getArray<Float_t>(branchName_deltaEta_, max_nLeptons);
+  deltaPhi_ = branchBuffers.getArray<Float_t>(branchName_deltaPhi_, max_nLeptons);
+  OoEminusOoP_ = branchBuffers.getArray<Float_t>(branchName_OoEminusOoP_, max_nLeptons);
+  lostHits_ = branchBuffers.getArray<Int_t>(branchName_lostHits_, max_nLeptons);
+  conversionVeto_ = branchBuffers.getArray<Int_t>(branchName_conversionVeto_, max_nLeptons);
 }
 
 std::vector<RecoElectron> RecoElectronReader::read() const
 {
-  RecoLeptonReader* gLeptonReader = leptonReader_->instances_[branchName_obj_];
-  assert(gLeptonReader);
-  RecoElectronReader* gElectronReader = instances_[branchName_obj_];
-  assert(gElectronReader);
   std::vector<RecoElectron> electrons;
-  Int_t nLeptons = gLeptonReader->nLeptons_;
+  Int_t nLeptons = *leptonReader_->nLeptons_;
 
   if ( nLeptons > leptonReader_->max_nLeptons_ ) {
     throw cms::Exception("RecoElectronReader")
       << "Number of leptons stored in Ntuple = " << nLeptons << ", exceeds max_nLeptons = " << leptonReader_->max_nLeptons_ << " !!\n";
   }
   if ( nLeptons > 0 ) {
+    leptonReader_->readGenMatching();
     electrons.reserve(nLeptons);
     for ( Int_t idxLepton = 0; idxLepton < nLeptons; ++idxLepton ) {
-      if ( std::abs(gLeptonReader->pdgId_[idxLepton]) == 11 ) {
+      if ( std::abs(leptonReader_->pdgId_[idxLepton]) == 11 ) {
         electrons.push_back(RecoElectron({
-          gLeptonReader->pt_[idxLepton],
-          gLeptonReader->eta_[idxLepton],
-          gLeptonReader->phi_[idxLepton],
-          gLeptonReader->mass_[idxLepton],
-          gLeptonReader->pdgId_[idxLepton],
-          gLeptonReader->dxy_[idxLepton],
-          gLeptonReader->dz_[idxLepton],
-          gLeptonReader->relIso_[idxLepton],
-          gLeptonReader->chargedHadRelIso03_[idxLepton],
-          gLeptonReader->miniIsoCharged_[idxLepton],
-          gLeptonReader->miniIsoNeutral_[idxLepton],
-          gLeptonReader->sip3d_[idxLepton],
-          gLeptonReader->mvaRawTTH_[idxLepton],
-          gLeptonReader->jetNDauChargedMVASel_[idxLepton],
-          gLeptonReader->jetPtRel_[idxLepton],
-          gLeptonReader->jetPtRatio_[idxLepton],
-          gLeptonReader->jetBtagCSV_[idxLepton],
-          gLeptonReader->tightCharge_[idxLepton],
-          gLeptonReader->charge_[idxLepton],
-          gElectronReader->mvaRawPOG_GP_[idxLepton],
-          gElectronReader->mvaRawPOG_HZZ_[idxLepton],
-          gElectronReader->sigmaEtaEta_[idxLepton],
-          gElectronReader->HoE_[idxLepton],
-          gElectronReader->deltaEta_[idxLepton],
-          gElectronReader->deltaPhi_[idxLepton],
-          gElectronReader->OoEminusOoP_[idxLepton],
-          gElectronReader->lostHits_[idxLepton],
-          gElectronReader->conversionVeto_[idxLepton]
+          leptonReader_->pt_[idxLepton],
+          leptonReader_->eta_[idxLepton],
+          leptonReader_->phi_[idxLepton],
+          leptonReader_->mass_[idxLepton],
+          leptonReader_->pdgId_[idxLepton],
+          leptonReader_->dxy_[idxLepton],
+          leptonReader_->dz_[idxLepton],
+          leptonReader_->relIso_[idxLepton],
+          leptonReader_->chargedHadRelIso03_[idxLepton],
+          leptonReader_->miniIsoCharged_[idxLepton],
+          leptonReader_->miniIsoNeutral_[idxLepton],
+          leptonReader_->sip3d_[idxLepton],
+          leptonReader_->mvaRawTTH_[idxLepton],
+          leptonReader_->jetNDauChargedMVASel_[idxLepton],
+          leptonReader_->jetPtRel_[idxLepton],
+          leptonReader_->jetPtRatio_[idxLepton],
+          leptonReader_->jetBtagCSV_[idxLepton],
+          leptonReader_->tightCharge_[idxLepton],
+          leptonReader_->charge_[idxLepton],
+          mvaRawPOG_GP_[idxLepton],
+          mvaRawPOG_HZZ_[idxLepton],
+          sigmaEtaEta_[idxLepton],
+          HoE_[idxLepton],
+          deltaEta_[idxLepton],
+          deltaPhi_[idxLepton],
+          OoEminusOoP_[idxLepton],
+          lostHits_[idxLepton],
+          conversionVeto_[idxLepton]
         }));
+        leptonReader_->linkGenMatching(electrons.back(), idxLepton);
       }
     }
-    gLeptonReader->readGenMatching(electrons);
   }
   return electrons;
 }
@@ -0,0 +1,107 @@
+#include "tthAnalysis/HiggsToTauTau/interface/RecoHadTauCollectionSelectorMultiWP.h" // RecoHadTauCollectionSelectorMultiWP
+
+#include "FWCore/Utilities/interface/Exception.h" // cms::Exception
+
+#include <algorithm> // std::find()
+#include <iostream> // std::cout
+
+std::size_t
+RecoHadTauWorkingPointView::size() const
+{
+  std::size_t numSelHadTaus = 0;
+  for ( const hadTauWorkingPointMask & mask: *masks_ ) {
+    if ( mask & bit_ ) ++numSelHadTaus;
+  }
+  return numSelHadTaus;
+}
+
+std::vector<const RecoHadTau*>
+RecoHadTauWorkingPointView::toVector() const
+{
+  return std::vector<const RecoHadTau*>(begin(), end());
+}
+
+RecoHadTauCollectionSelectorMultiWP::RecoHadTauCollectionSelectorMultiWP(int era, bool debug)
+  : debug_(debug)
+  , commonSelector_(era, -1, debug, false)
+  , hadTaus_(0)
+{
+//--- disable the working-point dependent cut that is set in the constructor of RecoHadTauSelectorLoose;
+//    the tau ID discriminators are checked separately for each working point in compMask()
+  commonSelector_.set_min_id_mva_dR03(-1000);
+}
+
+std::size_t
+RecoHadTauCollectionSelectorMultiWP::addWorkingPoint(const std::string& cut)
+{
+  const std::vector<std::string>::const_iterator workingPoint = std::find(workingPoints_.begin(), workingPoints_.end(), cut);
+  if ( workingPoint != workingPoints_.end() ) {
+    return workingPoint - workingPoints_.begin();
+  }
+  if ( workingPoints_.size() >= 8 * sizeof(hadTauWorkingPointMask) ) {
+    throw cms::Exception("RecoHadTauCollectionSelectorMultiWP")
+      << "Cannot register more than " << 8 * sizeof(hadTauWorkingPointMask) << " working points";
+  }
+//--- parse the working point with the same logic as used by the single working point selectors
+  RecoHadTauSelectorLoose selector(0, -1, false, false);
+  selector.set(cut);
+  workingPoints_.push_back(cut);
+  min_id_mva_dR03_.push_back(selector.get_min_id_mva_dR03());
+  min_id_cut_dR05_.push_back(selector.get_min_id_cut_dR05());
+  return workingPoints_.size() - 1;
+}
+
+std::size_t
+RecoHadTauCollectionSelectorMultiWP::getWorkingPointIndex(const std::string& cut) const
+{
+  const std::vector<std::string>::const_iterator workingPoint = std::find(workingPoints_.begin(), workingPoints_.end(), cut);
+  if ( workingPoint == workingPoints_.end() ) {
+    throw cms::Exception("RecoHadTauCollectionSelectorMultiWP")
+      << "Working point '" << cut << "' has not been registered";
+  }
+  return workingPoint - workingPoints_.begin();
+}
+
+hadTauWorkingPointMask
+RecoHadTauCollectionSelectorMultiWP::compMask(const RecoHadTau& hadTau) const
+{
+  if ( !commonSelector_(hadTau) ) return 0;
+  hadTauWorkingPointMask mask = 0;
+  const std::size_t numWorkingPoints = workingPoints_.size();
+  for ( std::size_t idxWorkingPoint = 0; idxWorkingPoint < numWorkingPoints; ++idxWorkingPoint ) {
+    if ( hadTau.id_mva_dR03() >= min_id_mva_dR03_[idxWorkingPoint] &&
+         hadTau.id_cut_dR05() >= min_id_cut_dR05_[idxWorkingPoint] ) {
+      mask |= hadTauWorkingPointMask(1) << idxWorkingPoint;
+    }
+  }
+  if ( debug_ ) {
+    std::cout << "<RecoHadTauCollectionSelectorMultiWP::compMask>: pT = " << hadTau.pt() << ", eta = " << hadTau.eta()
+              << ", mask = " << std::hex << mask << std::dec << std::endl;
+  }
+  return mask;
+}
+
+const std::vector<hadTauWorkingPointMask>&
+RecoHadTauCollectionSelectorMultiWP::operator()(const std::vector<const RecoHadTau*>& hadTaus)
+{
+  hadTaus_ = &hadTaus;
+  masks_.resize(hadTaus.size());
+  for ( std::size_t idxHadTau = 0; idxHadTau < hadTaus.size(); ++idxHadTau ) {
+    masks_[idxHadTau] = compMask(*hadTaus[idxHadTau]);
+  }
+  return masks_;
+}
+
+RecoHadTauWorkingPointView
+RecoHadTauCollectionSelectorMultiWP::getView(std::size_t wpIdx) const
+{
+  if ( !hadTaus_ ) {
+    throw cms::Exception("RecoHadTauCollectionSelectorMultiWP")
+      << "No hadronic tau collection has been evaluated yet";
+  }
+  if ( wpIdx >= workingPoints_.size() ) {
+    throw cms::Exception("RecoHadTauCollectionSelectorMultiWP")
+      << "Invalid working point index: " << wpIdx;
+  }
+  return RecoHadTauWorkingPointView(*hadTaus_, masks_, hadTauWorkingPointMask(1) << wpIdx);
+}
@@ -4,9 +4,6 @@
 
 #include <TString.h> // Form
 
-std::map<std::string, int> RecoLeptonReader::numInstances_;
-std::map<std::string, RecoLeptonReader *> RecoLeptonReader::instances_;
-
 RecoLeptonReader::RecoLeptonReader(bool readGenMatching)
   : max_nLeptons_(32)
   , branchName_num_("nselLeptons")
@@ -15,6 +12,7 @@ RecoLeptonReader::RecoLeptonReader(bool readGenMatching)
   , genHadTauReader_(0)
   , genJetReader_(0)
   , readGenMatching_(readGenMatching)
+  , nLeptons_(0)
   , pt_(0)
   , eta_(0)
   , phi_(0)
@@ -51,6 +49,7 @@ RecoLeptonReader::RecoLeptonReader(const std::string& branchName_num, const std:
   , genHadTauReader_(0)
   , genJetReader_(0)
   , readGenMatching_(readGenMatching)
+  , nLeptons_(0)
   , pt_(0)
   , eta_(0)
   , phi_(0)
@@ -81,119 +80,73 @@ RecoLeptonReader::RecoLeptonReader(const std::string& branchName_num, const std:
 
 RecoLeptonReader::~RecoLeptonReader()
 {
-  --numInstances_[branchName_obj_];
-  assert(numInstances_[branchName_obj_] >= 0);
-
-  if ( numInstances_[branchName_obj_] == 0 ) {
-    RecoLeptonReader* gInstance = instances_[branchName_obj_];
-    assert(gInstance);
-    delete gInstance->genLeptonReader_;
-    delete gInstance->genHadTauReader_;
-    delete gInstance->genJetReader_;
-    delete gInstance->pt_;
-    delete gInstance->eta_;
-    delete gInstance->phi_;
-    delete gInstance->mass_;
-    delete gInstance->pdgId_;
-    delete gInstance->dxy_;
-    delete gInstance->dz_;
-    delete gInstance->relIso_;
-    delete gInstance->chargedHadRelIso03_;
-    delete gInstance->miniIsoCharged_;
-    delete gInstance->miniIsoNeutral_;
-    delete gInstance->sip3d_;
-    delete gInstance->mvaRawTTH_;
-    delete gInstance->jetNDauChargedMVASel_;
-    delete gInstance->jetPtRel_;
-    delete gInstance->jetPtRatio_;
-    delete gInstance->jetBtagCSV_;
-    delete gInstance->tightCharge_;
-    delete gInstance->charge_;
-    instances_[branchName_obj_] = 0;
-  }
+  delete genLeptonReader_;
+  delete genHadTauReader_;
+  delete genJetReader_;
 }
 
 void RecoLeptonReader::setBranchNames()
 {
-  if ( numInstances_[branchName_obj_] == 0 ) {
-    branchName_pt_ = Form("%s_%s", branchName_obj_.data(), "pt");
-    branchName_eta_ = Form("%s_%s", branchName_obj_.data(), "eta");
-    branchName_phi_ = Form("%s_%s", branchName_obj_.data(), "phi");
-    branchName_mass_ = Form("%s_%s", branchName_obj_.data(), "mass");
-    branchName_pdgId_ = Form("%s_%s", branchName_obj_.data(), "pdgId");
-    branchName_dxy_ = Form("%s_%s", branchName_obj_.data(), "dxy");
-    branchName_dz_ = Form("%s_%s", branchName_obj_.data(), "dz");
-    branchName_relIso_ = Form("%s_%s", branchName_obj_.data(), "miniRelIso");
-    branchName_chargedHadRelIso03_ = Form("%s_%s", branchName_obj_.data(), "chargedHadRelIso03");
-    branchName_miniIsoCharged_ = Form("%s_%s", branchName_obj_.data(), "miniIsoCharged");
-    branchName_miniIsoNeutral_ = Form("%s_%s", branchName_obj_.data(), "miniIsoNeutral");
-    branchName_sip3d_ = Form("%s_%s", branchName_obj_.data(), "sip3d");
-    branchName_mvaRawTTH_ = Form("%s_%s", branchName_obj_.data(), "mvaTTH");
-    branchName_jetNDauChargedMVASel_ = Form("%s_%s", branchName_obj_.data(), "mvaTTHjetNDauChargedMVASel");
-    branchName_jetPtRel_ = Form("%s_%s", branchName_obj_.data(), "mvaTTHjetPtRel");
-    branchName_jetPtRatio_ = Form("%s_%s", branchName_obj_.data(), "jetPtRatio");
-    branchName_jetBtagCSV_ = Form("%s_%s", branchName_obj_.data(), "jetBTagCSV");
-    branchName_tightCharge_ = Form("%s_%s", branchName_obj_.data(), "tightCharge");
-    branchName_charge_ = Form("%s_%s", branchName_obj_.data(), "charge");
-    instances_[branchName_obj_] = this;
-  } else {
-    if ( branchName_num_ != instances_[branchName_obj_]->branchName_num_ ) {
-      throw cms::Exception("RecoLeptonReader")
-	<< "Association between configuration parameters 'branchName_num' and 'branchName_obj' must be unique:"
-	<< " present association 'branchName_num' = " << branchName_num_ << " with 'branchName_obj' = " << branchName_obj_
-	<< " does not match previous association 'branchName_num' = " << instances_[branchName_obj_]->branchName_num_ << " with 'branchName_obj' = " << instances_[branchName_obj_]->branchName_obj_ << " !!\n";
-    }
-  }
-  ++numInstances_[branchName_obj_];
+  branchName_pt_ = Form("%s_%s", branchName_obj_.data(), "pt");
+  branchName_eta_ = Form("%s_%s", branchName_obj_.data(), "eta");
+  branchName_phi_ = Form("%s_%s", branchName_obj_.data(), "phi");
+  branchName_mass_ = Form("%s_%s", branchName_obj_.data(), "mass");
+  branchName_pdgId_ = Form("%s_%s", branchName_obj_.data(), "pdgId");
+  branchName_dxy_ = Form("%s_%s", branchName_obj_.data(), "dxy");
+  branchName_dz_ = Form("%s_%s", branchName_obj_.data(), "dz");
+  branchName_relIso_ = Form("%s_%s", branchName_obj_.data(), "miniRelIso");
+  branchName_chargedHadRelIso03_ = Form("%s_%s", branchName_obj_.data(), "chargedHadRelIso03");
+  branchName_miniIsoCharged_ = Form("%s_%s", branchName_obj_.data(), "miniIsoCharged");
+  branchName_miniIsoNeutral_ = Form("%s_%s", branchName_obj_.data(), "miniIsoNeutral");
+  branchName_sip3d_ = Form("%s_%s", branchName_obj_.data(), "sip3d");
+  branchName_mvaRawTTH_ = Form("%s_%s", branchName_obj_.data(), "mvaTTH");
+  branchName_jetNDauChargedMVASel_ = Form("%s_%s", branchName_obj_.data(), "mvaTTHjetNDauChargedMVASel");
+  branchName_jetPtRel_ = Form("%s_%s", branchName_obj_.data(), "mvaTTHjetPtRel");
+  branchName_jetPtRatio_ = Form("%s_%s", branchName_obj_.data(), "jetPtRatio");
+  branchName_jetBtagCSV_ = Form("%s_%s", branchName_obj_.data(), "jetBTagCSV");
+  branchName_tightCharge_ = Form("%s_%s", branchName_obj_.data(), "tightCharge");
+  branchName_charge_ = Form("%s_%s", branchName_obj_.data(), "charge");
 }
 
 void RecoLeptonReader::setBranchAddresses(TTree *tree)
 {
-  if ( instances_[branchName_obj_] == this ) {
-    if ( readGenMatching_ ) {
-      genLeptonReader_->setBranchAddresses(tree);
-      genHadTauReader_->setBranchAddresses(tree);
-      genJetReader_->setBranchAddresses(tree);  
-    }
-    tree->SetBranchAddress(branchName_num_.data(), &nLeptons_);
-    pt_ = new Float_t[max_nLeptons_];
-    tree->SetBranchAddress(branchName_pt_.data(), pt_);
-    eta_ = new Float_t[max_nLeptons_];
-    tree->SetBranchAddress(branchName_eta_.data(), eta_);
-    phi_ = new Float_t[max_nLeptons_];
-    tree->SetBranchAddress(branchName_phi_.data(), phi_);
-    mass_ = new Float_t[max_nLeptons_];
-    tree->SetBranchAddress(branchName_mass_.data(), mass_);
-    pdgId_ = new Int_t[max_nLeptons_];
-    tree->SetBranchAddress(branchName_pdgId_.data(), pdgId_);
-    dxy_ = new Float_t[max_nLeptons_];
-    tree->SetBranchAddress(branchName_dxy_.data(), dxy_);
-    dz_ = new Float_t[max_nLeptons_];
-    tree->SetBranchAddress(branchName_dz_.data(), dz_);
-    relIso_ = new Float_t[max_nLeptons_];
-    tree->SetBranchAddress(branchName_relIso_.data(), relIso_);
-    chargedHadRelIso03_ = new Float_t[max_nLeptons_];
-    tree->SetBranchAddress(branchName_chargedHadRelIso03_.data(), chargedHadRelIso03_);
-    miniIsoCharged_ = new Float_t[max_nLeptons_];
-    tree->SetBranchAddress(branchName_miniIsoCharged_.data(), miniIsoCharged_);
-    miniIsoNeutral_ = new Float_t[max_nLeptons_];
-    tree->SetBranchAddress(branchName_miniIsoNeutral_.data(), miniIsoNeutral_);
-    sip3d_ = new Float_t[max_nLeptons_];
-    tree->SetBranchAddress(branchName_sip3d_.data(), sip3d_);
-    mvaRawTTH_ = new Float_t[max_nLeptons_];
-    tree->SetBranchAddress(branchName_mvaRawTTH_.data(), mvaRawTTH_);
-    jetNDauChargedMVASel_ = new Float_t[max_nLeptons_];
-    tree->SetBranchAddress(branchName_jetNDauChargedMVASel_.data(), jetNDauChargedMVASel_);
-    jetPtRel_ = new Float_t[max_nLeptons_];
-    tree->SetBranchAddress(branchName_jetPtRel_.data(), jetPtRel_);
-    jetPtRatio_ = new Float_t[max_nLeptons_];
-    tree->SetBranchAddress(branchName_jetPtRatio_.data(), jetPtRatio_);
-    jetBtagCSV_ = new Float_t[max_nLeptons_];
-    tree->SetBranchAddress(branchName_jetBtagCSV_.data(), jetBtagCSV_);
-    tightCharge_ = new Int_t[max_nLeptons_];
-    tree->SetBranchAddress(branchName_tightCharge_.data(), tightCharge_);
-    charge_ = new Int_t[max_nLeptons_];
-    tree->SetBranchAddress(branchName_charge_.data(), charge_);
+  branchBuffers_ = BranchBufferRegistry::getSharedInstance(tree);
+  setBranchBuffers(*branchBuffers_);
+}
+
+void RecoLeptonReader::setBranchBuffers(BranchBufferRegistry& branchBuffers)
+{
+  if ( readGenMatching_ ) {
+    genLeptonReader_->setBranchBuffers(branchBuffers);
+    genHadTauReader_->setBranchBuffers(branchBuffers);
+    genJetReader_->setBranchBuffers(branchBuffers);
   }
+  nLeptons_ = branchBuffers.getScalar<Int_t>(branchName_num_);
+  pt_ = branchBuffers.getArray<Float_t>(branchName_pt_, max_nLeptons_);
+  eta_ = branchBuffers.getArray<Float_t>(branchName_eta_, max_nLeptons_);
+  phi_ = branchBuffers.getArray<Float_t>(branchName_phi_, max_nLeptons_);
+  mass_ = branchBuffers.getArray<Float_t>(branchName_mass_, max_nLeptons_);
+  pdgId_ = branchBuffers.getArray<Int_t>(branchName_pdgId_, max_nLeptons_);
+  dxy_ = branchBuffers.getArray<Float_t>(branchName_dxy_, max_nLeptons_);
+  dz_ = branchBuffers.getArray<Float_t>(branchName_dz_, max_nLeptons_);
+  relIso_ = branchBuffers.getArray<Float_t>(branchName_relIso_, max_nLeptons_);
+  chargedHadRelIso03_ = branchBuffers.getArray<Float_t>(branchName_chargedHadRelIso03_, max_nLeptons_);
+  miniIsoCharged_ = branchBuffers.getArray<Float_t>(branchName_miniIsoCharged_, max_nLeptons_);
+  miniIsoNeutral_ = branchBuffers.getArray<Float_t>(branchName_miniIsoNeutral_, max_nLeptons_);
+  sip3d_ = branchBuffers.getArray<Float_t>(branchName_sip3d_, max_nLeptons_);
+  mvaRawTTH_ = branchBuffers.getArray<Float_t>(branchName_mvaRawTTH_, max_nLeptons_);
+  jetNDauChargedMVASel_ = branchBuffers.getArray<Float_t>(branchName_jetNDauChargedMVASel_, max_nLeptons_);
+  jetPtRel_ = branchBuffers.getArray<Float_t>(branchName_jetPtRel_, max_nLeptons_);
+  jetPtRatio_ = branchBuffers.getArray<Float_t>(branchName_jetPtRatio_, max_nLeptons_);
+  jetBtagCSV_ = branchBuffers.getArray<Float_t>(branchName_jetBtagCSV_, max_nLeptons_);
+  tightCharge_ = branchBuffers.getArray<Int_t>(branchName_tightCharge_, max_nLeptons_);
+  charge_ = branchBuffers.getArray<Int_t>(branchName_charge_, max_nLeptons_);
 }
 
+void RecoLeptonReader::readGenMatching() const
+{
+  if ( readGenMatching_ ) {
+    assert(genLeptonReader_ && genHadTauReader_ && genJetReader_);
+    genMatchTable_.read(*genLeptonReader_, *genHadTauReader_, *genJetReader_);
+  }
+}
@@ -6,9 +6,6 @@
 
 #include <TString.h> // Form
 
-std::map<std::string, int> RecoMuonReader::numInstances_;
-std::map<std::string, RecoMuonReader *> RecoMuonReader::instances_;
-
 RecoMuonReader::RecoMuonReader(int era, bool readGenMatching)
   : era_(era)
   , use_HIP_mitigation_(true)
@@ -45,115 +42,88 @@ RecoMuonReader::RecoMuonReader(int era, const std::string& branchName_num, const
 
 RecoMuonReader::~RecoMuonReader()
 {
-  --numInstances_[branchName_obj_];
-  assert(numInstances_[branchName_obj_] >= 0);
-
-  if (numInstances_[branchName_obj_] == 0) {
-    RecoMuonReader *gInstance = instances_[branchName_obj_];
-    assert(gInstance);
-    delete[] gInstance->looseIdPOG_;
-    delete[] gInstance->mediumIdPOG_;
-#ifdef DPT_DIV_PT
-    delete[] gInstance->dpt_div_pt_;
-#endif // ifdef DPT_DIV_PT
-    delete[] gInstance->segmentCompatibility_;
-    instances_[branchName_obj_] = 0;
-  }
+  delete leptonReader_;
 }
 
 void RecoMuonReader::setBranchNames()
 {
-  if ( numInstances_[branchName_obj_] == 0 ) {
-    branchName_looseIdPOG_ = Form("%s_%s", branchName_obj_.data(), "looseIdPOG");
-    // CV: for 2016 data, switch to short term Muon POG recommendation for ICHEP,
-    //     given at https://twiki.cern.ch/twiki/bin/view/CMS/SWGuideMuonIdRun2#Short_Term_Medium_Muon_Definitio
-    if ( era_ == kEra_2015 ) {
-      branchName_mediumIdPOG_ = Form("%s_%s", branchName_obj_.data(), "mediumMuonId");
-    } else if ( era_ == kEra_2016 ) {
-      if ( use_HIP_mitigation_ ) branchName_mediumIdPOG_ = Form("%s_%s", branchName_obj_.data(), "mediumIdPOG_ICHEP2016");
-      else branchName_mediumIdPOG_ = Form("%s_%s", branchName_obj_.data(), "mediumMuonId");
-    } else assert(0);
+  branchName_looseIdPOG_ = Form("%s_%s", branchName_obj_.data(), "looseIdPOG");
+  // CV: for 2016 data, switch to short term Muon POG recommendation for ICHEP,
+  //     given at https://twiki.cern.ch/twiki/bin/view/CMS/SWGuideMuonIdRun2#Short_Term_Medium_Muon_Definitio
+  if ( era_ == kEra_2015 ) {
+    branchName_mediumIdPOG_ = Form("%s_%s", branchName_obj_.data(), "mediumMuonId");
+  } else if ( era_ == kEra_2016 ) {
+    if ( use_HIP_mitigation_ ) branchName_mediumIdPOG_ = Form("%s_%s", branchName_obj_.data(), "mediumIdPOG_ICHEP2016");
+    else branchName_mediumIdPOG_ = Form("%s_%s", branchName_obj_.data(), "mediumMuonId");
+  } else assert(0);
 #ifdef DPT_DIV_PT
-    branchName_dpt_div_pt_ = Form("%s_%s", branchName_obj_.data(), "dpt_div_pt");
+  branchName_dpt_div_pt_ = Form("%s_%s", branchName_obj_.data(), "dpt_div_pt");
 #endif // ifdef DPT_DIV_PT
-    branchName_segmentCompatibility_ = Form("%s_%s", branchName_obj_.data(), "segmentCompatibility");
-    instances_[branchName_obj_] = this;
-  } else {
-    if (branchName_num_ != instances_[branchName_obj_]->branchName_num_) {
-      throw cms::Exception("RecoMuonReader")
-	<< "Association between configuration parameters 'branchName_num' and 'branchName_obj' must be unique:"
-	<< " present association 'branchName_num' = " << branchName_num_ << " with 'branchName_obj' = " << branchName_obj_
-	<< " does not match previous association 'branchName_num' = " << instances_[branchName_obj_]->branchName_num_ << " with 'branchName_obj' = " << instances_[branchName_obj_]->branchName_obj_ << " !!\n";
-    }
-  }
-  ++numInstances_[branchName_obj_];
+  branchName_segmentCompatibility_ = Form("%s_%s", branchName_obj_.data(), "segmentCompatibility");
 }
 
 void RecoMuonReader::setBranchAddresses(TTree *tree)
 {
-  if ( instances_[branchName_obj_] == this ) {
-    leptonReader_->setBranchAddresses(tree);
-    int max_nLeptons = leptonReader_->max_nLeptons_;
-    looseIdPOG_ = new Int_t[max_nLeptons];
-    tree->SetBranchAddress(branchName_looseIdPOG_.data(), looseIdPOG_);
-    mediumIdPOG_ = new Int_t[max_nLeptons];
-    tree->SetBranchAddress(branchName_mediumIdPOG_.data(), mediumIdPOG_);
+  branchBuffers_ = BranchBufferRegistry::getSharedInstance(tree);
+  setBranchBuffers(*branchBuffers_);
+}
+
+void RecoMuonReader::setBranchBuffers(BranchBufferRegistry& branchBuffers)
+{
+  leptonReader_->setBranchBuffers(branchBuffers);
+  int max_nLeptons = leptonReader_->max_nLeptons_;
+  looseIdPOG_ = branchBuffers.getArray<Int_t>(branchName_looseIdPOG_, max_nLeptons);
+  mediumIdPOG_ = branchBuffers.getArray<Int_t>(branchName_mediumIdPOG_, max_nLeptons);
 #ifdef DPT_DIV_PT
-    dpt_div_pt_ = new Float_t[max_nLeptons];
-    tree->SetBranchAddress(branchName_dpt_div_pt_.data(), dpt_div_pt_);
+  dpt_div_pt_ = branchBuffers.getArray<Float_t>(branchName_dpt_div_pt_, max_nLeptons);
 #endif // ifdef DPT_DIV_PT
-    segmentCompatibility_ = new Float_t[max_nLeptons];
-    tree->SetBranchAddress(branchName_segmentCompatibility_.data(), segmentCompatibility_);
-  }
+  segmentCompatibility_ = branchBuffers.getArray<Float_t>(branchName_segmentCompatibility_, max_nLeptons);
 }
 
 std::vector<RecoMuon> RecoMuonReader::read() const
 {
-  RecoLeptonReader* gLeptonReader = leptonReader_->instances_[branchName_obj_];
-  assert(gLeptonReader);
-  RecoMuonReader* gMuonReader = instances_[branchName_obj_];
-  assert(gMuonReader);
   std::vector<RecoMuon> muons;
-  Int_t nLeptons = gLeptonReader->nLeptons_;
+  Int_t nLeptons = *leptonReader_->nLeptons_;
   
   if ( nLeptons > leptonReader_->max_nLeptons_ ) {
     throw cms::Exception("RecoMuonReader")
       << "Number of leptons stored in Ntuple = " << nLeptons << ", exceeds max_nLeptons = " << leptonReader_->max_nLeptons_ << " !!\n";
   }
   if ( nLeptons > 0 ) {
+    leptonReader_->readGenMatching();
     muons.reserve(nLeptons);
     for ( Int_t idxLepton = 0; idxLepton < nLeptons; ++idxLepton ) {
-      if ( std::abs(gLeptonReader->pdgId_[idxLepton]) == 13 ) {
+      if ( std::abs(leptonReader_->pdgId_[idxLepton]) == 13 ) {
         muons.push_back(RecoMuon({
-          gLeptonReader->pt_[idxLepton],
-          gLeptonReader->eta_[idxLepton],
-          gLeptonReader->phi_[idxLepton],
-          gLeptonReader->mass_[idxLepton],
-          gLeptonReader->pdgId_[idxLepton],
-          gLeptonReader->dxy_[idxLepton],
-          gLeptonReader->dz_[idxLepton],
-          gLeptonReader->relIso_[idxLepton],
-          gLeptonReader->chargedHadRelIso03_[idxLepton],
-          gLeptonReader->miniIsoCharged_[idxLepton],
-          gLeptonReader->miniIsoNeutral_[idxLepton],
-          gLeptonReader->sip3d_[idxLepton],
-          gLeptonReader->mvaRawTTH_[idxLepton],
-          gLeptonReader->jetNDauChargedMVASel_[idxLepton],
-          gLeptonReader->jetPtRel_[idxLepton],
-          gLeptonReader->jetPtRatio_[idxLepton],
-          gLeptonReader->jetBtagCSV_[idxLepton],
-          gLeptonReader->tightCharge_[idxLepton],
-          gLeptonReader->charge_[idxLepton],
-          gMuonReader->looseIdPOG_[idxLepton],
-          gMuonReader->mediumIdPOG_[idxLepton],
+          leptonReader_->pt_[idxLepton],
+          leptonReader_->eta_[idxLepton],
+          leptonReader_->phi_[idxLepton],
+          leptonReader_->mass_[idxLepton],
+          leptonReader_->pdgId_[idxLepton],
+          leptonReader_->dxy_[idxLepton],
+          leptonReader_->dz_[idxLepton],
+          leptonReader_->relIso_[idxLepton],
+          leptonReader_->chargedHadRelIso03_[idxLepton],
+          leptonReader_->miniIsoCharged_[idxLepton],
+          leptonReader_->miniIsoNeutral_[idxLepton],
+          leptonReader_->sip3d_[idxLepton],
+          leptonReader_->mvaRawTTH_[idxLepton],
+          leptonReader_->jetNDauChargedMVASel_[idxLepton],
+          leptonReader_->jetPtRel_[idxLepton],
+          leptonReader_->jetPtRatio_[idxLepton],
+          leptonReader_->jetBtagCSV_[idxLepton],
+          leptonReader_->tightCharge_[idxLepton],
+          leptonReader_->charge_[idxLepton],
+          looseIdPOG_[idxLepton],
+          mediumIdPOG_[idxLepton],
 #ifdef DPT_DIV_PT
-          gMuonReader->dpt_div_pt_[idxLepton],
+          dpt_div_pt_[idxLepton],
 #endif // ifdef DPT_DIV_PT
-          gMuonReader->segmentCompatibility_[idxLepton]
+          segmentCompatibility_[idxLepton]
         }));
+        leptonReader_->linkGenMatching(muons.back(), idxLepton);
       }
     }
-    gLeptonReader->readGenMatching(muons);
   }
   return muons;
 }
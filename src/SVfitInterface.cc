@@ -0,0 +1,56 @@
+#include "tthAnalysis/HiggsToTauTau/interface/SVfitInterface.h" // SVfitInterface
+
+#include "TauAnalysis/ClassicSVfit/interface/ClassicSVfit.h" // ClassicSVfit
+#include "TauAnalysis/ClassicSVfit/interface/svFitHistogramAdapter.h" // classic_svFit::DiTauSystemHistogramAdapter
+#include "TauAnalysis/ClassicSVfit/interface/svFitAuxFunctions.h" // classic_svFit::chargedPionMass
+
+#include "FWCore/Utilities/interface/Exception.h" // cms::Exception
+
+#include <cstdlib> // std::abs()
+
+SVfitInterface::SVfitInterface(double logM_kappa)
+  : svFitAlgo_(new ClassicSVfit())
+{
+  svFitAlgo_->addLogM_dynamic(false);
+  svFitAlgo_->addLogM_fixed(logM_kappa > 0., logM_kappa);
+}
+
+SVfitInterface::~SVfitInterface()
+{
+  delete svFitAlgo_;
+}
+
+classic_svFit::MeasuredTauLepton
+SVfitInterface::getMeasuredTauLepton(const RecoLepton * lepton)
+{
+  classic_svFit::MeasuredTauLepton::kDecayType type = classic_svFit::MeasuredTauLepton::kUndefinedDecayType;
+  double mass = 0.;
+  if ( std::abs(lepton->pdgId()) == 11 ) {
+    type = classic_svFit::MeasuredTauLepton::kTauToElecDecay;
+    mass = classic_svFit::electronMass;
+  } else if ( std::abs(lepton->pdgId()) == 13 ) {
+    type = classic_svFit::MeasuredTauLepton::kTauToMuDecay;
+    mass = classic_svFit::muonMass;
+  } else {
+    throw cms::Exception("SVfitInterface")
+      << "Invalid lepton pdgId = " << lepton->pdgId() << " !!\n";
+  }
+  return classic_svFit::MeasuredTauLepton(type, lepton->pt(), lepton->eta(), lepton->phi(), mass);
+}
+
+classic_svFit::MeasuredTauLepton
+SVfitInterface::getMeasuredTauLepton(const RecoHadTau * hadTau)
+{
+  double mass = hadTau->mass();
+  if ( mass < classic_svFit::chargedPionMass ) mass = classic_svFit::chargedPionMass;
+  if ( mass > 1.5                            ) mass = 1.5;
+  return classic_svFit::MeasuredTauLepton(classic_svFit::MeasuredTauLepton::kTauToHadDecay, hadTau->pt(), hadTau->eta(), hadTau->phi(), mass);
+}
+
+double
+SVfitInterface::operator()(const std::vector<classic_svFit::MeasuredTauLepton> & measuredTauLeptons,
+                           const RecoMEt & met)
+{
+  svFitAlgo_->integrate(measuredTauLeptons, met.p4().px(), met.p4().py(), met.cov());
+  return ( svFitAlgo_->isValidSolution() ) ? static_cast<classic_svFit::DiTauSystemHistogramAdapter*>(svFitAlgo_->getHistogramAdapter())->getMass() : -1.;
+}
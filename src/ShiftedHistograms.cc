@@ -0,0 +1,87 @@
+#include "tthAnalysis/HiggsToTauTau/interface/ShiftedHistograms.h"
+
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <TMath.h> // TMath::Sqrt()
+
+#include <assert.h> // assert
+
+ShiftedHistograms::ShiftedHistograms(const std::shared_ptr<const HistogramTemplateSet>& histogramTemplates, const std::vector<std::string>& shifts)
+  : histogramTemplates_(histogramTemplates)
+  , shifts_(shifts)
+{
+  if ( !histogramTemplates_ )
+    throw cms::Exception("ShiftedHistograms")
+      << "No histogram templates given !!\n";
+  contents_.resize(shifts_.size()*histogramTemplates_->getNumHistograms());
+}
+
+ShiftedHistograms::contentType& ShiftedHistograms::getContent(int idxHistogram, int idxShift)
+{
+  const int numHistograms = histogramTemplates_->getNumHistograms();
+  assert(idxHistogram >= 0 && idxHistogram < numHistograms);
+  assert(idxShift >= 0 && idxShift < (int)shifts_.size());
+  contentType& content = contents_[idxShift*numHistograms + idxHistogram];
+//--- allocate the bin contents when the histogram is filled for the first time
+  if ( content.sumw_.empty() ) {
+    const int numCells = histogramTemplates_->getNumCells(idxHistogram);
+    content.sumw_.assign(numCells, 0.);
+    content.sumw2_.assign(numCells, 0.);
+  }
+  return content;
+}
+
+void ShiftedHistograms::fillWithOverFlow(int idxHistogram, int idxShift, double x, double evtWeight, double evtWeightErr)
+{
+  contentType& content = getContent(idxHistogram, idxShift);
+  const int bin = histogramTemplates_->findBinWithOverFlow(idxHistogram, x);
+  content.sumw_[bin] += evtWeight;
+  content.sumw2_[bin] += evtWeight*evtWeight + evtWeightErr*evtWeightErr;
+  content.numEntries_ += 1.;
+}
+
+void ShiftedHistograms::fillWithOverFlow(int idxHistogram, double x, const std::vector<double>& evtWeights)
+{
+  assert(evtWeights.size() == shifts_.size());
+  const int bin = histogramTemplates_->findBinWithOverFlow(idxHistogram, x);
+  for ( size_t idxShift = 0; idxShift < shifts_.size(); ++idxShift ) {
+    contentType& content = getContent(idxHistogram, idxShift);
+    const double evtWeight = evtWeights[idxShift];
+    content.sumw_[bin] += evtWeight;
+    content.sumw2_[bin] += evtWeight*evtWeight;
+    content.numEntries_ += 1.;
+  }
+}
+
+void ShiftedHistograms::write(TDirectory* dir) const
+{
+  assert(dir);
+  const int numHistograms = histogramTemplates_->getNumHistograms();
+  for ( size_t idxShift = 0; idxShift < shifts_.size(); ++idxShift ) {
+    const std::string& shift = shifts_[idxShift];
+    for ( int idxHistogram = 0; idxHistogram < numHistograms; ++idxHistogram ) {
+      std::string histogramName = histogramTemplates_->getDistribution(idxHistogram);
+      if ( !(shift == "" || shift == "central") ) histogramName = shift + "_" + histogramName;
+      dir->cd();
+      TH1* histogram = histogramTemplates_->makeHistogram(idxHistogram, histogramName);
+      const contentType& content = contents_[idxShift*numHistograms + idxHistogram];
+      for ( size_t bin = 0; bin < content.sumw_.size(); ++bin ) {
+	histogram->SetBinContent(bin, content.sumw_[bin]);
+	histogram->SetBinError(bin, TMath::Sqrt(content.sumw2_[bin]));
+      }
+      histogram->SetEntries(content.numEntries_);
+      dir->WriteTObject(histogram);
+      delete histogram;
+    }
+  }
+}
+
+size_t ShiftedHistograms::getMemoryUsage() const
+{
+  size_t memoryUsage = 0;
+  for ( std::vector<contentType>::const_iterator content = contents_.begin();
+	content != contents_.end(); ++content ) {
+    memoryUsage += (content->sumw_.capacity() + content->sumw2_.capacity())*sizeof(double);
+  }
+  return memoryUsage;
+}
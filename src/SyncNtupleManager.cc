@@ -1,7 +1,7 @@
 #include "tthAnalysis/HiggsToTauTau/interface/SyncNtupleManager.h"
 #include "tthAnalysis/HiggsToTauTau/interface/mvaInputVariables.h" // comp_lep*_conePt()
 
-#include <algorithm> // std::min()
+#include <algorithm> // std::min(), std::fill()
 #include <type_traits> // std::remove_pointer<>
 
 #include <boost/algorithm/string/predicate.hpp> // boost::starts_with()
@@ -85,39 +85,40 @@ SyncNtupleManager::initializeBranches()
   ele_iscutsel = new std::remove_pointer<decltype(ele_iscutsel)>::type[nof_eles];
   ele_ismvasel = new std::remove_pointer<decltype(ele_ismvasel)>::type[nof_eles];
 
-  tau_pt = new std::remove_pointer<decltype(tau_pt)>::type[nof_eles];
-  tau_eta = new std::remove_pointer<decltype(tau_eta)>::type[nof_eles];
-  tau_phi = new std::remove_pointer<decltype(tau_phi)>::type[nof_eles];
-  tau_E = new std::remove_pointer<decltype(tau_E)>::type[nof_eles];
-  tau_charge = new std::remove_pointer<decltype(tau_charge)>::type[nof_eles];
-  tau_dxy = new std::remove_pointer<decltype(tau_dxy)>::type[nof_eles];
-  tau_dz = new std::remove_pointer<decltype(tau_dz)>::type[nof_eles];
-  tau_decayModeFindingOldDMs = new std::remove_pointer<decltype(tau_decayModeFindingOldDMs)>::type[nof_eles];
-  tau_decayModeFindingNewDMs = new std::remove_pointer<decltype(tau_decayModeFindingNewDMs)>::type[nof_eles];
-  tau_byCombinedIsolationDeltaBetaCorr3Hits = new std::remove_pointer<decltype(tau_byCombinedIsolationDeltaBetaCorr3Hits)>::type[nof_eles];
-  tau_byLooseCombinedIsolationDeltaBetaCorr3Hits = new std::remove_pointer<decltype(tau_byLooseCombinedIsolationDeltaBetaCorr3Hits)>::type[nof_eles];
-  tau_byMediumCombinedIsolationDeltaBetaCorr3Hits = new std::remove_pointer<decltype(tau_byMediumCombinedIsolationDeltaBetaCorr3Hits)>::type[nof_eles];
-  tau_byTightCombinedIsolationDeltaBetaCorr3Hits = new std::remove_pointer<decltype(tau_byTightCombinedIsolationDeltaBetaCorr3Hits)>::type[nof_eles];
-  tau_byLooseCombinedIsolationDeltaBetaCorr3HitsdR03 = new std::remove_pointer<decltype(tau_byLooseCombinedIsolationDeltaBetaCorr3HitsdR03)>::type[nof_eles];
-  tau_byMediumCombinedIsolationDeltaBetaCorr3HitsdR03 = new std::remove_pointer<decltype(tau_byMediumCombinedIsolationDeltaBetaCorr3HitsdR03)>::type[nof_eles];
-  tau_byTightCombinedIsolationDeltaBetaCorr3HitsdR03 = new std::remove_pointer<decltype(tau_byTightCombinedIsolationDeltaBetaCorr3HitsdR03)>::type[nof_eles];
-  tau_byLooseIsolationMVArun2v1DBdR03oldDMwLT = new std::remove_pointer<decltype(tau_byLooseIsolationMVArun2v1DBdR03oldDMwLT)>::type[nof_eles];
-  tau_byMediumIsolationMVArun2v1DBdR03oldDMwLT = new std::remove_pointer<decltype(tau_byMediumIsolationMVArun2v1DBdR03oldDMwLT)>::type[nof_eles];
-  tau_byTightIsolationMVArun2v1DBdR03oldDMwLT = new std::remove_pointer<decltype(tau_byTightIsolationMVArun2v1DBdR03oldDMwLT)>::type[nof_eles];
-  tau_byVTightIsolationMVArun2v1DBdR03oldDMwLT = new std::remove_pointer<decltype(tau_byVTightIsolationMVArun2v1DBdR03oldDMwLT)>::type[nof_eles];
-  tau_againstMuonLoose3 = new std::remove_pointer<decltype(tau_againstMuonLoose3)>::type[nof_eles];
-  tau_againstMuonTight3 = new std::remove_pointer<decltype(tau_againstMuonTight3)>::type[nof_eles];
-  tau_againstElectronVLooseMVA6 = new std::remove_pointer<decltype(tau_againstElectronVLooseMVA6)>::type[nof_eles];
-  tau_againstElectronLooseMVA6 = new std::remove_pointer<decltype(tau_againstElectronLooseMVA6)>::type[nof_eles];
-  tau_againstElectronMediumMVA6 = new std::remove_pointer<decltype(tau_againstElectronMediumMVA6)>::type[nof_eles];
-  tau_againstElectronTightMVA6 = new std::remove_pointer<decltype(tau_againstElectronTightMVA6)>::type[nof_eles];
-  tau_againstElectronVTightMVA6 = new std::remove_pointer<decltype(tau_againstElectronVTightMVA6)>::type[nof_eles];
-
-  jet_pt = new std::remove_pointer<decltype(jet_pt)>::type[nof_eles];
-  jet_eta = new std::remove_pointer<decltype(jet_eta)>::type[nof_eles];
-  jet_phi = new std::remove_pointer<decltype(jet_phi)>::type[nof_eles];
-  jet_E = new std::remove_pointer<decltype(jet_E)>::type[nof_eles];
-  jet_CSV = new std::remove_pointer<decltype(jet_CSV)>::type[nof_eles];
+  tau_pt = new std::remove_pointer<decltype(tau_pt)>::type[nof_taus];
+  tau_eta = new std::remove_pointer<decltype(tau_eta)>::type[nof_taus];
+  tau_phi = new std::remove_pointer<decltype(tau_phi)>::type[nof_taus];
+  tau_E = new std::remove_pointer<decltype(tau_E)>::type[nof_taus];
+  tau_charge = new std::remove_pointer<decltype(tau_charge)>::type[nof_taus];
+  tau_dxy = new std::remove_pointer<decltype(tau_dxy)>::type[nof_taus];
+  tau_dz = new std::remove_pointer<decltype(tau_dz)>::type[nof_taus];
+  tau_decayModeFindingOldDMs = new std::remove_pointer<decltype(tau_decayModeFindingOldDMs)>::type[nof_taus];
+  tau_decayModeFindingNewDMs = new std::remove_pointer<decltype(tau_decayModeFindingNewDMs)>::type[nof_taus];
+  tau_byCombinedIsolationDeltaBetaCorr3Hits = new std::remove_pointer<decltype(tau_byCombinedIsolationDeltaBetaCorr3Hits)>::type[nof_taus];
+  tau_byLooseCombinedIsolationDeltaBetaCorr3Hits = new std::remove_pointer<decltype(tau_byLooseCombinedIsolationDeltaBetaCorr3Hits)>::type[nof_taus];
+  tau_byMediumCombinedIsolationDeltaBetaCorr3Hits = new std::remove_pointer<decltype(tau_byMediumCombinedIsolationDeltaBetaCorr3Hits)>::type[nof_taus];
+  tau_byTightCombinedIsolationDeltaBetaCorr3Hits = new std::remove_pointer<decltype(tau_byTightCombinedIsolationDeltaBetaCorr3Hits)>::type[nof_taus];
+  tau_byLooseCombinedIsolationDeltaBetaCorr3HitsdR03 = new std::remove_pointer<decltype(tau_byLooseCombinedIsolationDeltaBetaCorr3HitsdR03)>::type[nof_taus];
+  tau_byMediumCombinedIsolationDeltaBetaCorr3HitsdR03 = new std::remove_pointer<decltype(tau_byMediumCombinedIsolationDeltaBetaCorr3HitsdR03)>::type[nof_taus];
+  tau_byTightCombinedIsolationDeltaBetaCorr3HitsdR03 = new std::remove_pointer<decltype(tau_byTightCombinedIsolationDeltaBetaCorr3HitsdR03)>::type[nof_taus];
+  tau_byLooseIsolationMVArun2v1DBdR03oldDMwLT = new std::remove_pointer<decltype(tau_byLooseIsolationMVArun2v1DBdR03oldDMwLT)>::type[nof_taus];
+  tau_byMediumIsolationMVArun2v1DBdR03oldDMwLT = new std::remove_pointer<decltype(tau_byMediumIsolationMVArun2v1DBdR03oldDMwLT)>::type[nof_taus];
+  tau_byTightIsolationMVArun2v1DBdR03oldDMwLT = new std::remove_pointer<decltype(tau_byTightIsolationMVArun2v1DBdR03oldDMwLT)>::type[nof_taus];
+  tau_byVTightIsolationMVArun2v1DBdR03oldDMwLT = new std::remove_pointer<decltype(tau_byVTightIsolationMVArun2v1DBdR03oldDMwLT)>::type[nof_taus];
+  tau_againstMuonLoose3 = new std::remove_pointer<decltype(tau_againstMuonLoose3)>::type[nof_taus];
+  tau_againstMuonTight3 = new std::remove_pointer<decltype(tau_againstMuonTight3)>::type[nof_taus];
+  tau_againstElectronVLooseMVA6 = new std::remove_pointer<decltype(tau_againstElectronVLooseMVA6)>::type[nof_taus];
+  tau_againstElectronLooseMVA6 = new std::remove_pointer<decltype(tau_againstElectronLooseMVA6)>::type[nof_taus];
+  tau_againstElectronMediumMVA6 = new std::remove_pointer<decltype(tau_againstElectronMediumMVA6)>::type[nof_taus];
+  tau_againstElectronTightMVA6 = new std::remove_pointer<decltype(tau_againstElectronTightMVA6)>::type[nof_taus];
+  tau_againstElectronVTightMVA6 = new std::remove_pointer<decltype(tau_againstElectronVTightMVA6)>::type[nof_taus];
+
+  jet_pt = new std::remove_pointer<decltype(jet_pt)>::type[nof_jets];
+  jet_eta = new std::remove_pointer<decltype(jet_eta)>::type[nof_jets];
+  jet_phi = new std::remove_pointer<decltype(jet_phi)>::type[nof_jets];
+  jet_E = new std::remove_pointer<decltype(jet_E)>::type[nof_jets];
+  jet_CSV = new std::remove_pointer<decltype(jet_CSV)>::type[nof_jets];
+  jet_heppyFlavour = new std::remove_pointer<decltype(jet_heppyFlavour)>::type[nof_jets];
 
   if(outputTree)
   {
@@ -275,12 +276,35 @@ SyncNtupleManager::initializeBranches()
 void
 SyncNtupleManager::initializeHLTBranches(const std::vector<std::vector<hltPath *>> & hltPaths)
 {
+  if(! hltValues.empty())
+    throw cms::Exception("sync_ntuple") << "HLT branches already initialized";
+
+//--- assign each HLT branch a slot in hltValues once, so that read() and reset()
+//    do not need to look up the branch names event by event
+  std::map<std::string, std::size_t> hltBranchIdxs;
   for(const auto & hltVector: hltPaths)
     for(const auto & hlt: hltVector)
-      hltMap[hlt -> getBranchName()] = -1;
-  for(auto & kv: hltMap)
-    outputTree -> Branch(hltMangle(kv.first).c_str(), &(hltMap[kv.first]),
-                         Form("%s/%s", hltMangle(kv.first).c_str(), Traits<decltype(kv.second)>::TYPE_NAME));
+      hltBranchIdxs[hlt -> getBranchName()] = 0;
+  std::size_t hltBranchIdx = 0;
+  for(auto & kv: hltBranchIdxs)
+    kv.second = hltBranchIdx++;
+
+  hltIdxs.clear();
+  for(const auto & hltVector: hltPaths)
+  {
+    hltIdxs.push_back({});
+    for(const auto & hlt: hltVector)
+      hltIdxs.back().push_back(hltBranchIdxs[hlt -> getBranchName()]);
+  }
+
+//--- the branch addresses point into hltValues, so it must not be resized afterwards
+  hltValues.assign(hltBranchIdxs.size(), -1);
+  for(const auto & kv: hltBranchIdxs)
+  {
+    const std::string hltBranchName = hltMangle(kv.first);
+    outputTree -> Branch(hltBranchName.c_str(), &(hltValues[kv.second]),
+                         Form("%s/%s", hltBranchName.c_str(), Traits<Int_t>::TYPE_NAME));
+  }
 }
 
 void
@@ -513,9 +537,17 @@ SyncNtupleManager::read(Float_t value,
 void
 SyncNtupleManager::read(const std::vector<std::vector<hltPath *>> & hltPaths)
 {
-  for(const auto & hltVector: hltPaths)
-    for(const auto & hlt: hltVector)
-      hltMap[hlt -> getBranchName()] = hlt -> getValue();
+  if(hltPaths.size() != hltIdxs.size())
+    throw cms::Exception("sync_ntuple") << "Expected " << hltIdxs.size() << " HLT path collections "
+                                        << "but got " << hltPaths.size();
+  for(std::size_t i = 0; i < hltPaths.size(); ++i)
+  {
+    if(hltPaths[i].size() != hltIdxs[i].size())
+      throw cms::Exception("sync_ntuple") << "Expected " << hltIdxs[i].size() << " HLT paths in collection #" << i
+                                          << " but got " << hltPaths[i].size();
+    for(std::size_t j = 0; j < hltPaths[i].size(); ++j)
+      hltValues[hltIdxs[i][j]] = hltPaths[i][j] -> getValue();
+  }
 }
 
 void
@@ -662,8 +694,7 @@ SyncNtupleManager::reset(bool is_initializing)
   genWeight         = placeholder_value;
   lumiScale         = placeholder_value;
 
-  for(auto & kv: hltMap)
-    hltMap[kv.first] = -1;
+  std::fill(hltValues.begin(), hltValues.end(), -1);
 }
 
 std::string
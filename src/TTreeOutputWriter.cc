@@ -0,0 +1,142 @@
+#include "tthAnalysis/HiggsToTauTau/interface/TTreeOutputWriter.h"
+
+#include <FWCore/Utilities/interface/Exception.h> // cms::Exception
+
+#include <TTree.h> // TTree
+#include <TFile.h> // TFile
+#include <TBranch.h> // TBranch
+#include <TObjArray.h> // TObjArray
+#include <TROOT.h> // ROOT::EnableImplicitMT()
+#include <RVersion.h> // ROOT_VERSION_CODE, ROOT_VERSION()
+#include <Compression.h> // ROOT::kZLIB, ROOT::kLZMA, ROOT::kLZ4
+
+#include <iostream> // std::cout
+#include <iomanip> // std::setprecision()
+#include <sstream> // std::ostringstream
+
+TTreeOutputWriter::TTreeOutputWriter(TTree * tree,
+                                     const std::string & compression,
+                                     int compressionLevel,
+                                     Long64_t numEntries_autoFlush,
+                                     unsigned numThreads)
+  : tree_(tree)
+  , numEntries_(0)
+  , numBytes_(0)
+  , fillTime_(0.)
+{
+  if(! tree_)
+  {
+    throw cms::Exception("TTreeOutputWriter") << "No output TTree given\n";
+  }
+
+  if(! compression.empty())
+  {
+    const int compressionSettings = getCompressionSettings(compression, compressionLevel);
+    // branches inherit the compression settings of the file when they are created,
+    // the settings of the branches that already exist need to be updated explicitly
+    TFile * file = tree_ -> GetCurrentFile();
+    if(file)
+    {
+      file -> SetCompressionSettings(compressionSettings);
+    }
+    TObjArray * branches = tree_ -> GetListOfBranches();
+    for(int branchIdx = 0; branchIdx < branches -> GetEntries(); ++branchIdx)
+    {
+      static_cast<TBranch *>(branches -> At(branchIdx)) -> SetCompressionSettings(compressionSettings);
+    }
+    std::cout << "Compressing output TTree " << tree_ -> GetName() << " with " << compression
+              << " (level " << compressionLevel << ")\n";
+  }
+
+  if(numEntries_autoFlush > 0)
+  {
+    // ROOT calls TTree::OptimizeBaskets() at the first flush
+    tree_ -> SetAutoFlush(numEntries_autoFlush);
+  }
+
+  if(numThreads > 1)
+  {
+#ifdef R__USE_IMT
+    ROOT::EnableImplicitMT(numThreads);
+    tree_ -> SetImplicitMT(true);
+    std::cout << "Compressing baskets of output TTree " << tree_ -> GetName() << " in " << numThreads << " threads\n";
+#else
+    std::cout << "Warning: ROOT has been built without support for implicit multi-threading, "
+                 "compressing baskets in a single thread\n";
+#endif
+  }
+}
+
+int
+TTreeOutputWriter::fill()
+{
+  const std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+  const int numBytes = tree_ -> Fill();
+  fillTime_ += std::chrono::high_resolution_clock::now() - start;
+
+  if(numBytes < 0)
+  {
+    throw cms::Exception("TTreeOutputWriter")
+      << "Failed to write entry #" << numEntries_ << " to output TTree " << tree_ -> GetName() << '\n';
+  }
+  ++numEntries_;
+  numBytes_ += numBytes;
+  return numBytes;
+}
+
+void
+TTreeOutputWriter::printStatistics(std::ostream & stream) const
+{
+  const double fillTime = fillTime_.count();
+  const double totBytes = tree_ -> GetTotBytes();
+  const double zipBytes = tree_ -> GetZipBytes();
+  // format into a local stream, so that the precision is not changed for the caller
+  std::ostringstream statistics;
+  statistics << "Output TTree " << tree_ -> GetName() << ":\n"
+             << std::fixed << std::setprecision(2)
+             << " entries written = " << numEntries_ << '\n'
+             << " uncompressed size = " << totBytes / (1024. * 1024.) << " MB, "
+                "compressed size = "   << zipBytes / (1024. * 1024.) << " MB"
+             << " (compression factor = " << (zipBytes > 0. ? totBytes / zipBytes : 0.) << ")\n"
+             << " time spent in TTree::Fill() = " << fillTime << " s";
+  if(fillTime > 0.)
+  {
+    statistics << " (" << numEntries_ / fillTime << " entries/s, "
+               << numBytes_ / (1024. * 1024.) / fillTime << " MB/s uncompressed)";
+  }
+  statistics << '\n';
+  stream << statistics.str();
+}
+
+int
+TTreeOutputWriter::getCompressionSettings(const std::string & compression,
+                                          int compressionLevel)
+{
+  if(compressionLevel < 1 || compressionLevel > 9)
+  {
+    throw cms::Exception("TTreeOutputWriter") << "Invalid compression level: " << compressionLevel << '\n';
+  }
+
+  int algorithm = -1;
+  if(compression == "ZLIB")
+  {
+    algorithm = ROOT::kZLIB;
+  }
+  else if(compression == "LZMA")
+  {
+    algorithm = ROOT::kLZMA;
+  }
+  else if(compression == "LZ4")
+  {
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,12,0)
+    algorithm = ROOT::kLZ4;
+#else
+    throw cms::Exception("TTreeOutputWriter") << "LZ4 compression requires ROOT 6.12 or newer\n";
+#endif
+  }
+  else
+  {
+    throw cms::Exception("TTreeOutputWriter") << "Invalid compression algorithm: " << compression << '\n';
+  }
+  return 100 * algorithm + compressionLevel;
+}
@@ -2,6 +2,9 @@
 
 #include "tthAnalysis/HiggsToTauTau/interface/TFileOpenWrapper.h" // TFileOpenWrapper::
 #include "tthAnalysis/HiggsToTauTau/interface/ReaderBase.h" // ReaderBase
+#include "tthAnalysis/HiggsToTauTau/interface/BranchBufferRegistry.h" // BranchBufferRegistry
+#include "tthAnalysis/HiggsToTauTau/interface/EventIndex.h" // EventIndex
+#include "tthAnalysis/HiggsToTauTau/interface/EventLoopProfiler.h" // EventLoopProfiler
 
 #include <FWCore/Utilities/interface/Exception.h> // cms::Exception
 
@@ -24,9 +27,12 @@ TTreeWrapper::TTreeWrapper(const std::string & treeName,
   , currentTreePtr_(nullptr)
   , treeName_(treeName)
   , fileNames_(fileNames)
+  , branchBuffers_(new BranchBufferRegistry())
   , fileCount_(fileNames_.size())
   , cumulativeMaxEventCount_(0)
   , eventCount_(-1)
+  , eventIndex_(nullptr)
+  , profiler_(nullptr)
 {
   if(! treeName_.empty())
   {
@@ -109,12 +115,39 @@ TTreeWrapper::registerReader(ReaderBase * reader)
   return *this;
 }
 
+TTreeWrapper &
+TTreeWrapper::setEventIndex(const EventIndex * eventIndex)
+{
+  eventIndex_ = eventIndex;
+  return *this;
+}
+
+TTreeWrapper &
+TTreeWrapper::setProfiler(EventLoopProfiler * profiler)
+{
+  profiler_ = profiler;
+  return *this;
+}
+
 bool
 TTreeWrapper::hasNextEvent()
 {
+  if(profiler_)
+  {
+    profiler_ -> enter(EventLoopProfiler::kRead);
+  }
+
   // check if we already have an open file
   if(! isOpen())
   {
+    // skip the files that do not contain any events selected by the event index
+    while(eventIndex_ && currentFileIdx_ < fileCount_ && ! eventIndex_ -> hasEntries(fileNames_[currentFileIdx_]))
+    {
+      std::cout << "Skipping #" << currentFileIdx_ << " file " << fileNames_[currentFileIdx_]
+                << " (no events selected by the event index)\n";
+      ++currentFileIdx_;
+    }
+
     // try to open the file
     if(currentFileIdx_ < fileCount_)
     {
@@ -156,14 +189,26 @@ TTreeWrapper::hasNextEvent()
         << treeName_ << '\n';
     }
 
-    // set the branch addresses
+    // set the branch addresses; the buffers requested for the previous file are reused
+    branchBuffers_ -> setTree(currentTreePtr_);
     for(ReaderBase * reader: readers_)
     {
-      reader -> setBranchAddresses(currentTreePtr_);
+      reader -> setBranchBuffers(*branchBuffers_);
     }
 
     // save the total number of events in this file
-    currentMaxEvents_ = currentTreePtr_ -> GetEntries();
+    if(eventIndex_)
+    {
+      const std::vector<Long64_t> entries = eventIndex_ -> getEntries(fileNames_[currentFileIdx_]);
+      currentEntries_.assign(entries.begin(), entries.end());
+      currentMaxEvents_ = currentEntries_.size();
+      std::cout << "Reading " << currentMaxEvents_ << " out of " << currentTreePtr_ -> GetEntries()
+                << " entries selected by the event index\n";
+    }
+    else
+    {
+      currentMaxEvents_ = currentTreePtr_ -> GetEntries();
+    }
     cumulativeMaxEventCount_ += currentMaxEvents_;
   }
 
@@ -171,9 +216,13 @@ TTreeWrapper::hasNextEvent()
   if(currentEventIdx_ < currentMaxEvents_ && belowMaxEvents)
   {
     // we still have some events to be read here
-    currentTreePtr_ -> GetEntry(currentEventIdx_);
+    currentTreePtr_ -> GetEntry(eventIndex_ ? currentEntries_[currentEventIdx_] : currentEventIdx_);
     ++currentEventIdx_;
     ++currentMaxEventIdx_;
+    if(profiler_)
+    {
+      profiler_ -> countEvent();
+    }
   }
   else
   {
@@ -204,8 +253,10 @@ TTreeWrapper::close()
     }
 #endif
     currentTreePtr_ = nullptr;
+    branchBuffers_ -> setTree(nullptr);
     currentMaxEvents_ = -1;
     currentEventIdx_  =  0;
+    currentEntries_.clear();
   }
 }
 
@@ -57,3 +57,16 @@ void WeightHistManager::fillHistograms(const std::string& weight_name, double we
   
   fillWithOverFlow(histogram_iter->second, weight_value, evtWeight, evtWeightErr);
 }
+
+void WeightHistManager::fillHistograms(const EventWeightCalculator& evtWeightCalculator, int idxShift)
+{
+  double evtWeight = 1.;
+  double evtWeightErr = 0.;
+
+  const std::vector<std::string>& componentNames = evtWeightCalculator.getComponentNames();
+  for ( size_t idxComponent = 0; idxComponent < componentNames.size(); ++idxComponent ) {
+    std::map<std::string, TH1*>::const_iterator histogram_iter = histograms_weights_.find(componentNames[idxComponent]);
+    if ( histogram_iter == histograms_weights_.end() ) continue;
+    fillWithOverFlow(histogram_iter->second, evtWeightCalculator.getComponentWeight(idxComponent, idxShift), evtWeight, evtWeightErr);
+  }
+}
@@ -147,20 +147,21 @@ int getHadTau_genPdgId(const RecoHadTau* hadTau)
 
 Particle::LorentzVector compMHT(const std::vector<const RecoLepton*>& leptons, const std::vector<const RecoHadTau*>& hadTaus, const std::vector<const RecoJet*>& jets)
 {
-  math::PtEtaPhiMLorentzVector mht_p4(0,0,0,0);
+//--- sum in Cartesian coordinates and convert the sum to (pT, eta, phi, mass) only once
+  Particle::LorentzVectorCartesian mht_p4(0,0,0,0);
   for ( std::vector<const RecoLepton*>::const_iterator lepton = leptons.begin();
 	lepton != leptons.end(); ++lepton ) {
-    mht_p4 += (*lepton)->p4();
+    mht_p4 += (*lepton)->p4_cartesian();
   }
   for ( std::vector<const RecoHadTau*>::const_iterator hadTau = hadTaus.begin();
 	hadTau != hadTaus.end(); ++hadTau ) {
-    mht_p4 += (*hadTau)->p4();
+    mht_p4 += (*hadTau)->p4_cartesian();
   }
   for ( std::vector<const RecoJet*>::const_iterator jet = jets.begin();
 	jet != jets.end(); ++jet ) {
-    mht_p4 += (*jet)->p4();
+    mht_p4 += (*jet)->p4_cartesian();
   }
-  return mht_p4;
+  return Particle::LorentzVector(mht_p4);
 }
 
 double compMEt_LD(const Particle::LorentzVector& met_p4, const Particle::LorentzVector& mht_p4)
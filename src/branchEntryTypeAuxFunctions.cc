@@ -80,7 +80,7 @@ std::map<std::string, bool> getBranchesToKeep(TTree* inputTree, std::vector<outp
   return isBranchToKeep;
 }
 
-void copyBranches_singleType(TTree* inputTree, TTree* outputTree, std::map<std::string, bool>& isBranchToKeep, std::map<std::string, branchEntryBaseType*>& outputTree_branches)
+void copyBranches_singleType(TTree* inputTree, TTree* outputTree, std::map<std::string, bool>& isBranchToKeep, std::map<std::string, branchEntryBaseType*>& outputTree_branches, bool passthrough)
 {
   // add branches of "simple" type (containing a single number for each event)
   //std::cout << "<copyBranches_singleType>:" << std::endl;
@@ -112,13 +112,14 @@ void copyBranches_singleType(TTree* inputTree, TTree* outputTree, std::map<std::
       else throw cms::Exception("copyBranches") 
 	<< "Branch = '" << branchName << "' is of unsupported Type = " << branchType << " !!\n";
       outputTree_branch->setInputTree(inputTree);
+      if ( passthrough ) outputTree_branch->enablePassthrough();
       outputTree_branch->setOutputTree(outputTree);
       outputTree_branches[branchName] = outputTree_branch;
     }
   }
 }
 
-void copyBranches_vectorType(TTree* inputTree, TTree* outputTree, std::map<std::string, bool>& isBranchToKeep, std::map<std::string, branchEntryBaseType*>& outputTree_branches)
+void copyBranches_vectorType(TTree* inputTree, TTree* outputTree, std::map<std::string, bool>& isBranchToKeep, std::map<std::string, branchEntryBaseType*>& outputTree_branches, bool passthrough)
 {
   // add branches of "vector" type (containing a vector of numbers for each event)
   //std::cout << "<copyBranches_vectorType>:" << std::endl;
@@ -155,6 +156,7 @@ void copyBranches_vectorType(TTree* inputTree, TTree* outputTree, std::map<std::
       else throw cms::Exception("copyBranches") 
 	<< "Branch = '" << branchName << "' is of unsupported Type = " << branchType << " !!\n";
       outputTree_branch->setInputTree(inputTree);
+      if ( passthrough ) outputTree_branch->enablePassthrough();
       outputTree_branch->setOutputTree(outputTree);
       outputTree_branches[branchName] = outputTree_branch;
     }
@@ -1,6 +1,5 @@
 #include "tthAnalysis/HiggsToTauTau/interface/cutFlowTable.h"
 
-#include <vector> // std::vector<>
 #include <algorithm> // std::sort
 
 using namespace cutFlowTable_namespace;
@@ -10,37 +9,52 @@ cutFlowTableType::cutFlowTableType()
 {}
  
 cutFlowTableType::~cutFlowTableType()
+{}
+
+int cutFlowTableType::registerCut(const std::string& cut)
 {
-  for ( std::map<std::string, rowType*>::iterator it = rows_.begin();
-	it != rows_.end(); ++it ) {
-    delete it->second;
-  }
+  std::map<std::string, int>::const_iterator rowIdx_iter = rowIdxs_.find(cut);
+  if ( rowIdx_iter != rowIdxs_.end() ) return rowIdx_iter->second;
+  rowType row;
+  row.cut_ = cut;
+  row.selEvents_ = 0;
+  row.selEvents_weighted_ = 0.;
+  row.idx_ = -1;
+  const int cutIdx = rows_.size();
+  rows_.push_back(row);
+  rowIdxs_[cut] = cutIdx;
+  return cutIdx;
 }
 
 void cutFlowTableType::update(const std::string& cut, double evtWeight)
 {
-  std::map<std::string, rowType*>::iterator row_iter = rows_.find(cut);
-  if ( row_iter != rows_.end() ) {
-    rowType* row = row_iter->second;
-    ++row->selEvents_;
-    row->selEvents_weighted_ += evtWeight;
-  } else {
-    rowType* row = new rowType();
-    row->cut_ = cut;
-    row->selEvents_ = 1;
-    row->selEvents_weighted_ = evtWeight;
-    row->idx_ = row_idx_;
-    rows_[cut] = row;
-    ++row_idx_;
+  update(registerCut(cut), evtWeight);
+}
+
+void cutFlowTableType::merge(const cutFlowTableType& cutFlowTable)
+{
+  std::vector<const rowType*> row_ptrs;
+  for(const rowType & row: cutFlowTable.rows_)
+  {
+    if ( row.idx_ >= 0 ) row_ptrs.push_back(&row);
+  }
+  std::sort(row_ptrs.begin(), row_ptrs.end(), isLowerIdx);
+
+  for(const rowType* row_ptr: row_ptrs)
+  {
+    rowType& row = rows_[registerCut(row_ptr->cut_)];
+    if ( row.idx_ < 0 ) row.idx_ = row_idx_++;
+    row.selEvents_ += row_ptr->selEvents_;
+    row.selEvents_weighted_ += row_ptr->selEvents_weighted_;
   }
 }
 
 void cutFlowTableType::print(std::ostream& stream) const
 {
   std::vector<const rowType*> row_ptrs;
-  for(const auto & row: rows_)
+  for(const rowType & row: rows_)
   {
-    row_ptrs.push_back(row.second);
+    if ( row.idx_ >= 0 ) row_ptrs.push_back(&row);
   }
   std::sort(row_ptrs.begin(), row_ptrs.end(), isLowerIdx);
 
@@ -116,8 +116,8 @@ namespace
     else return false;
   } 
 
-  const hadTauGenMatchEntry& getHadTauGenMatch(const std::vector<hadTauGenMatchEntry>& hadTauGenMatch_definitions,
-					       int numGenMatchedHadTaus, int numGenMatchedElectrons, int numGenMatchedMuons, int numGenMatchedJets)
+  const hadTauGenMatchEntry* findHadTauGenMatch(const std::vector<hadTauGenMatchEntry>& hadTauGenMatch_definitions,
+						int numGenMatchedHadTaus, int numGenMatchedElectrons, int numGenMatchedMuons, int numGenMatchedJets)
   {
     const hadTauGenMatchEntry* hadTauGenMatch = 0;
     for ( std::vector<hadTauGenMatchEntry>::const_iterator hadTauGenMatch_definition = hadTauGenMatch_definitions.begin();
@@ -127,12 +127,24 @@ namespace
 	   matches(hadTauGenMatch_definition->numGenMatchedMuons_, numGenMatchedMuons)         &&
 	   matches(hadTauGenMatch_definition->numGenMatchedJets_, numGenMatchedJets)           ) hadTauGenMatch = &(*hadTauGenMatch_definition);
     }
-    if ( !hadTauGenMatch ) throw cms::Exception("getHadTauGenMatch") 
+    return hadTauGenMatch;
+  }
+
+  void throwHadTauGenMatchNotFound(int numGenMatchedHadTaus, int numGenMatchedElectrons, int numGenMatchedMuons, int numGenMatchedJets)
+  {
+    throw cms::Exception("getHadTauGenMatch") 
       << "Failed to compute 'hadTauGenMatch' for numGenMatched:"
       << " hadTaus = " << numGenMatchedHadTaus << ","
       << " electrons = " << numGenMatchedElectrons << ","
       << " muons = " << numGenMatchedMuons << ","
       << " jets = " << numGenMatchedJets << " !!\n";
+  }
+
+  const hadTauGenMatchEntry& getHadTauGenMatch(const std::vector<hadTauGenMatchEntry>& hadTauGenMatch_definitions,
+					       int numGenMatchedHadTaus, int numGenMatchedElectrons, int numGenMatchedMuons, int numGenMatchedJets)
+  {
+    const hadTauGenMatchEntry* hadTauGenMatch = findHadTauGenMatch(hadTauGenMatch_definitions, numGenMatchedHadTaus, numGenMatchedElectrons, numGenMatchedMuons, numGenMatchedJets);
+    if ( !hadTauGenMatch ) throwHadTauGenMatchNotFound(numGenMatchedHadTaus, numGenMatchedElectrons, numGenMatchedMuons, numGenMatchedJets);
     return *hadTauGenMatch;
   }
 }
@@ -149,6 +161,43 @@ const hadTauGenMatchEntry& getHadTauGenMatch(const std::vector<hadTauGenMatchEnt
   return getHadTauGenMatch(hadTauGenMatch_definitions, numGenMatchedHadTaus, numGenMatchedElectrons, numGenMatchedMuons, numGenMatchedJets);
 }
 
+hadTauGenMatchLookupTable::hadTauGenMatchLookupTable(const std::vector<hadTauGenMatchEntry>& hadTauGenMatch_definitions)
+  : table_((kMaxHadTaus + 1)*(kMaxHadTaus + 1)*(kMaxHadTaus + 1)*(kMaxHadTaus + 1), 0)
+{
+  for ( int numGenMatchedHadTaus = 0; numGenMatchedHadTaus <= kMaxHadTaus; ++numGenMatchedHadTaus ) {
+    for ( int numGenMatchedElectrons = 0; numGenMatchedElectrons <= kMaxHadTaus; ++numGenMatchedElectrons ) {
+      for ( int numGenMatchedMuons = 0; numGenMatchedMuons <= kMaxHadTaus; ++numGenMatchedMuons ) {
+	for ( int numGenMatchedJets = 0; numGenMatchedJets <= kMaxHadTaus; ++numGenMatchedJets ) {
+	  if ( (numGenMatchedHadTaus + numGenMatchedElectrons + numGenMatchedMuons + numGenMatchedJets) > kMaxHadTaus ) continue;
+	  table_[getIndex(numGenMatchedHadTaus, numGenMatchedElectrons, numGenMatchedMuons, numGenMatchedJets)] = findHadTauGenMatch(
+	    hadTauGenMatch_definitions, numGenMatchedHadTaus, numGenMatchedElectrons, numGenMatchedMuons, numGenMatchedJets);
+	}
+      }
+    }
+  }
+}
+
+const hadTauGenMatchEntry& hadTauGenMatchLookupTable::get(int numGenMatchedHadTaus, int numGenMatchedElectrons, int numGenMatchedMuons, int numGenMatchedJets) const
+{
+  assert(numGenMatchedHadTaus >= 0 && numGenMatchedElectrons >= 0 && numGenMatchedMuons >= 0 && numGenMatchedJets >= 0);
+  assert((numGenMatchedHadTaus + numGenMatchedElectrons + numGenMatchedMuons + numGenMatchedJets) <= kMaxHadTaus);
+  const hadTauGenMatchEntry* hadTauGenMatch = table_[getIndex(numGenMatchedHadTaus, numGenMatchedElectrons, numGenMatchedMuons, numGenMatchedJets)];
+  if ( !hadTauGenMatch ) throwHadTauGenMatchNotFound(numGenMatchedHadTaus, numGenMatchedElectrons, numGenMatchedMuons, numGenMatchedJets);
+  return *hadTauGenMatch;
+}
+
+const hadTauGenMatchEntry& getHadTauGenMatch(const hadTauGenMatchLookupTable& hadTauGenMatch_lookupTable,
+					     const RecoHadTau* hadTau_lead, const RecoHadTau* hadTau_sublead, const RecoHadTau* hadTau_third)
+{
+  int numGenMatchedHadTaus, numGenMatchedElectrons, numGenMatchedMuons, numGenMatchedJets;
+  resetHadTauGenMatches(numGenMatchedHadTaus, numGenMatchedElectrons, numGenMatchedMuons, numGenMatchedJets);
+  assert(hadTau_lead);
+  countHadTauGenMatches(hadTau_lead, numGenMatchedHadTaus, numGenMatchedElectrons, numGenMatchedMuons, numGenMatchedJets);
+  if ( hadTau_sublead ) countHadTauGenMatches(hadTau_sublead, numGenMatchedHadTaus, numGenMatchedElectrons, numGenMatchedMuons, numGenMatchedJets);
+  if ( hadTau_third   ) countHadTauGenMatches(hadTau_third, numGenMatchedHadTaus, numGenMatchedElectrons, numGenMatchedMuons, numGenMatchedJets);
+  return hadTauGenMatch_lookupTable.get(numGenMatchedHadTaus, numGenMatchedElectrons, numGenMatchedMuons, numGenMatchedJets);
+}
+
 std::ostream& operator<<(std::ostream& stream, const hadTauGenMatchEntry& hadTauGenMatch_definition)\
 {
   stream << " hadTauGenMatch #" << hadTauGenMatch_definition.idx_ << ": " << hadTauGenMatch_definition.name_ << std::endl;
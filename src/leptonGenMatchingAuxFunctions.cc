@@ -87,8 +87,8 @@ namespace
     else return false;
   } 
   
-  const leptonGenMatchEntry& getLeptonGenMatch(const std::vector<leptonGenMatchEntry>& leptonGenMatch_definitions,
-					       int numGenMatchedLeptons, int numGenMatchedJets)
+  const leptonGenMatchEntry* findLeptonGenMatch(const std::vector<leptonGenMatchEntry>& leptonGenMatch_definitions,
+						int numGenMatchedLeptons, int numGenMatchedJets)
   {
     const leptonGenMatchEntry* leptonGenMatch = 0;
     for ( std::vector<leptonGenMatchEntry>::const_iterator leptonGenMatch_definition = leptonGenMatch_definitions.begin();
@@ -96,10 +96,22 @@ namespace
       if ( matches(leptonGenMatch_definition->numGenMatchedLeptons_, numGenMatchedLeptons) &&
 	   matches(leptonGenMatch_definition->numGenMatchedJets_, numGenMatchedJets)       ) leptonGenMatch = &(*leptonGenMatch_definition);
     }
-    if ( !leptonGenMatch ) throw cms::Exception("getLeptonGenMatch") 
+    return leptonGenMatch;
+  }
+
+  void throwLeptonGenMatchNotFound(int numGenMatchedLeptons, int numGenMatchedJets)
+  {
+    throw cms::Exception("getLeptonGenMatch") 
       << "Failed to compute 'leptonGenMatch' for numGenMatched:"
       << " leptons = " << numGenMatchedLeptons << ","
       << " jets = " << numGenMatchedJets << " !!\n";
+  }
+
+  const leptonGenMatchEntry& getLeptonGenMatch(const std::vector<leptonGenMatchEntry>& leptonGenMatch_definitions,
+					       int numGenMatchedLeptons, int numGenMatchedJets)
+  {
+    const leptonGenMatchEntry* leptonGenMatch = findLeptonGenMatch(leptonGenMatch_definitions, numGenMatchedLeptons, numGenMatchedJets);
+    if ( !leptonGenMatch ) throwLeptonGenMatchNotFound(numGenMatchedLeptons, numGenMatchedJets);
     return *leptonGenMatch;
   }
 }
@@ -116,6 +128,36 @@ const leptonGenMatchEntry& getLeptonGenMatch(const std::vector<leptonGenMatchEnt
   return getLeptonGenMatch(leptonGenMatch_definitions, numGenMatchedLeptons, numGenMatchedJets);
 }
 
+leptonGenMatchLookupTable::leptonGenMatchLookupTable(const std::vector<leptonGenMatchEntry>& leptonGenMatch_definitions)
+  : table_((kMaxLeptons + 1)*(kMaxLeptons + 1), 0)
+{
+  for ( int numGenMatchedLeptons = 0; numGenMatchedLeptons <= kMaxLeptons; ++numGenMatchedLeptons ) {
+    for ( int numGenMatchedJets = 0; numGenMatchedJets <= kMaxLeptons - numGenMatchedLeptons; ++numGenMatchedJets ) {
+      table_[numGenMatchedLeptons*(kMaxLeptons + 1) + numGenMatchedJets] = findLeptonGenMatch(leptonGenMatch_definitions, numGenMatchedLeptons, numGenMatchedJets);
+    }
+  }
+}
+
+const leptonGenMatchEntry& leptonGenMatchLookupTable::get(int numGenMatchedLeptons, int numGenMatchedJets) const
+{
+  assert(numGenMatchedLeptons >= 0 && numGenMatchedJets >= 0 && (numGenMatchedLeptons + numGenMatchedJets) <= kMaxLeptons);
+  const leptonGenMatchEntry* leptonGenMatch = table_[numGenMatchedLeptons*(kMaxLeptons + 1) + numGenMatchedJets];
+  if ( !leptonGenMatch ) throwLeptonGenMatchNotFound(numGenMatchedLeptons, numGenMatchedJets);
+  return *leptonGenMatch;
+}
+
+const leptonGenMatchEntry& getLeptonGenMatch(const leptonGenMatchLookupTable& leptonGenMatch_lookupTable,
+					     const RecoLepton* lepton_lead, const RecoLepton* lepton_sublead, const RecoLepton* lepton_third)
+{
+  int numGenMatchedLeptons, numGenMatchedJets;
+  resetLeptonGenMatches(numGenMatchedLeptons, numGenMatchedJets);
+  assert(lepton_lead);
+  countLeptonGenMatches(lepton_lead, numGenMatchedLeptons, numGenMatchedJets);
+  if ( lepton_sublead ) countLeptonGenMatches(lepton_sublead, numGenMatchedLeptons, numGenMatchedJets);
+  if ( lepton_third   ) countLeptonGenMatches(lepton_third, numGenMatchedLeptons, numGenMatchedJets);
+  return leptonGenMatch_lookupTable.get(numGenMatchedLeptons, numGenMatchedJets);
+}
+
 std::ostream& operator<<(std::ostream& stream, const leptonGenMatchEntry& leptonGenMatch_definition)\
 {
   stream << " leptonGenMatch #" << leptonGenMatch_definition.idx_ << ": " << leptonGenMatch_definition.name_ << std::endl;
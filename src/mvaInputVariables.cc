@@ -13,6 +13,85 @@ namespace
   {
     return x*x;
   }
+
+  /**
+   * @brief Computes the distances between particles and the jet acceptance on every call,
+   *        for the versions of the functions that are called without an EventGeometry
+   */
+  struct uncachedGeometry
+  {
+    double dR(const Particle& particle1, const Particle& particle2) const
+    {
+      return deltaR(particle1.eta(), particle1.phi(), particle2.eta(), particle2.phi());
+    }
+    bool isJetInAcceptance(const Particle& jet) const
+    {
+      return EventGeometry::passesJetAcceptance(jet);
+    }
+  };
+
+  template <typename G>
+  double comp_n_jet25_recl_impl(const std::vector<const RecoJet*>& jets_cleaned, const G& geometry)
+  {
+    int n_jets = 0;
+    for ( std::vector<const RecoJet*>::const_iterator jet = jets_cleaned.begin();
+	  jet != jets_cleaned.end(); ++jet ) {
+      if ( geometry.isJetInAcceptance(**jet) ) ++n_jets;
+    }
+    return n_jets;
+  }
+
+  template <typename G>
+  double comp_mindr_jet_impl(const Particle& particle, const std::vector<const RecoJet*>& jets_cleaned, const G& geometry)
+  {
+    double dRmin = 1.e+3;
+    for ( std::vector<const RecoJet*>::const_iterator jet = jets_cleaned.begin();
+	  jet != jets_cleaned.end(); ++jet ) {
+      double dR = geometry.dR(particle, **jet);
+      if ( dR < dRmin ) dRmin = dR;
+    }
+    return dRmin;
+  }
+
+  template <typename G>
+  double comp_avg_dr_jet_impl(const std::vector<const RecoJet*>& jets_cleaned, const G& geometry)
+  {
+    int n_jet_pairs = 0;
+    double dRsum = 0.;
+    for ( std::vector<const RecoJet*>::const_iterator jet1 = jets_cleaned.begin();
+	  jet1 != jets_cleaned.end(); ++jet1 ) {
+      if ( geometry.isJetInAcceptance(**jet1) ) {
+	for ( std::vector<const RecoJet*>::const_iterator jet2 = jet1 + 1;
+	      jet2 != jets_cleaned.end(); ++jet2 ) {
+	  if ( geometry.isJetInAcceptance(**jet2) ) {
+	    dRsum += geometry.dR(**jet1, **jet2);
+	    ++n_jet_pairs;
+	  }
+	}
+      }
+    }
+    double avg_dr_jet = ( n_jet_pairs > 0 ) ? dRsum/n_jet_pairs : 0.;
+    return avg_dr_jet;
+  }
+
+  template <typename G>
+  double comp_max_dr_jet_impl(const std::vector<const RecoJet*>& jets_cleaned, const G& geometry)
+  {
+    double dRmax = 0.;
+    for ( std::vector<const RecoJet*>::const_iterator jet1 = jets_cleaned.begin();
+	  jet1 != jets_cleaned.end(); ++jet1 ) {
+      if ( geometry.isJetInAcceptance(**jet1) ) {
+	for ( std::vector<const RecoJet*>::const_iterator jet2 = jet1 + 1;
+	      jet2 != jets_cleaned.end(); ++jet2 ) {
+	  if ( geometry.isJetInAcceptance(**jet2) ) {
+	    double dR = geometry.dR(**jet1, **jet2);
+	    if ( dR > dRmax ) dRmax = dR;
+	  }
+	}
+      }
+    }
+    return dRmax;
+  }
 }
 
 double comp_MT_met_lep1(const Particle::LorentzVector& leptonP4, double met_pt, double met_phi)
@@ -65,23 +144,17 @@ double comp_MT_met_hadTau3(const Particle& hadTau, double met_pt, double met_phi
 
 double comp_n_jet25_recl(const std::vector<const RecoJet*>& jets_cleaned)
 {
-  int n_jets = 0;
-  for ( std::vector<const RecoJet*>::const_iterator jet = jets_cleaned.begin();
-	jet != jets_cleaned.end(); ++jet ) {
-    if ( (*jet)->pt() > 25. && std::fabs((*jet)->eta()) < 2.4 ) ++n_jets;
-  }
-  return n_jets;
+  return comp_n_jet25_recl_impl(jets_cleaned, uncachedGeometry());
+}
+
+double comp_n_jet25_recl(const std::vector<const RecoJet*>& jets_cleaned, const EventGeometry& geometry)
+{
+  return comp_n_jet25_recl_impl(jets_cleaned, geometry);
 }
 
 double comp_mindr_lep1_jet(const Particle& lepton, const std::vector<const RecoJet*>& jets_cleaned)
 {
-  double dRmin = 1.e+3;
-  for ( std::vector<const RecoJet*>::const_iterator jet = jets_cleaned.begin();
-	jet != jets_cleaned.end(); ++jet ) {
-    double dR = deltaR(lepton.eta(), lepton.phi(), (*jet)->eta(), (*jet)->phi());
-    if ( dR < dRmin ) dRmin = dR;
-  }
-  return dRmin;
+  return comp_mindr_jet_impl(lepton, jets_cleaned, uncachedGeometry());
 }
 
 double comp_mindr_lep2_jet(const Particle& lepton, const std::vector<const RecoJet*>& jets_cleaned)
@@ -109,6 +182,36 @@ double comp_mindr_hadTau3_jet(const Particle& hadTau, const std::vector<const Re
   return comp_mindr_lep1_jet(hadTau, jets_cleaned);
 }
 
+double comp_mindr_lep1_jet(const Particle& lepton, const std::vector<const RecoJet*>& jets_cleaned, const EventGeometry& geometry)
+{
+  return comp_mindr_jet_impl(lepton, jets_cleaned, geometry);
+}
+
+double comp_mindr_lep2_jet(const Particle& lepton, const std::vector<const RecoJet*>& jets_cleaned, const EventGeometry& geometry)
+{
+  return comp_mindr_lep1_jet(lepton, jets_cleaned, geometry);
+}
+
+double comp_mindr_lep3_jet(const Particle& lepton, const std::vector<const RecoJet*>& jets_cleaned, const EventGeometry& geometry)
+{
+  return comp_mindr_lep1_jet(lepton, jets_cleaned, geometry);
+}
+
+double comp_mindr_hadTau1_jet(const Particle& hadTau, const std::vector<const RecoJet*>& jets_cleaned, const EventGeometry& geometry)
+{
+  return comp_mindr_lep1_jet(hadTau, jets_cleaned, geometry);
+}
+
+double comp_mindr_hadTau2_jet(const Particle& hadTau, const std::vector<const RecoJet*>& jets_cleaned, const EventGeometry& geometry)
+{
+  return comp_mindr_lep1_jet(hadTau, jets_cleaned, geometry);
+}
+
+double comp_mindr_hadTau3_jet(const Particle& hadTau, const std::vector<const RecoJet*>& jets_cleaned, const EventGeometry& geometry)
+{
+  return comp_mindr_lep1_jet(hadTau, jets_cleaned, geometry);
+}
+
 double comp_lep1_conePt(const RecoLepton& lepton)
 {
   return lepton.cone_pt();
@@ -126,41 +229,22 @@ double comp_lep3_conePt(const RecoLepton& lepton)
 
 double comp_avg_dr_jet(const std::vector<const RecoJet*>& jets_cleaned)
 {
-  int n_jet_pairs = 0;
-  double dRsum = 0.;
-  for ( std::vector<const RecoJet*>::const_iterator jet1 = jets_cleaned.begin();
-	jet1 != jets_cleaned.end(); ++jet1 ) {
-    if ( (*jet1)->pt() > 25. && std::fabs((*jet1)->eta()) < 2.4 ) {
-      for ( std::vector<const RecoJet*>::const_iterator jet2 = jet1 + 1;
-	    jet2 != jets_cleaned.end(); ++jet2 ) {
-	if ( (*jet2)->pt() > 25. && std::fabs((*jet2)->eta()) < 2.4 ) {
-	  double dR = deltaR((*jet1)->eta(), (*jet1)->phi(), (*jet2)->eta(), (*jet2)->phi());
-	  dRsum += dR;
-	  ++n_jet_pairs;
-	}
-      }
-    }
-  }
-  double avg_dr_jet = ( n_jet_pairs > 0 ) ? dRsum/n_jet_pairs : 0.;
-  return avg_dr_jet;
+  return comp_avg_dr_jet_impl(jets_cleaned, uncachedGeometry());
+}
+
+double comp_avg_dr_jet(const std::vector<const RecoJet*>& jets_cleaned, const EventGeometry& geometry)
+{
+  return comp_avg_dr_jet_impl(jets_cleaned, geometry);
 }
 
 double comp_max_dr_jet(const std::vector<const RecoJet*>& jets_cleaned)
 {
-  double dRmax = 0.;
-  for ( std::vector<const RecoJet*>::const_iterator jet1 = jets_cleaned.begin();
-	jet1 != jets_cleaned.end(); ++jet1 ) {
-    if ( (*jet1)->pt() > 25. && std::fabs((*jet1)->eta()) < 2.4 ) {
-      for ( std::vector<const RecoJet*>::const_iterator jet2 = jet1 + 1;
-	    jet2 != jets_cleaned.end(); ++jet2 ) {
-	if ( (*jet2)->pt() > 25. && std::fabs((*jet2)->eta()) < 2.4 ) {
-	  double dR = deltaR((*jet1)->eta(), (*jet1)->phi(), (*jet2)->eta(), (*jet2)->phi());
-	  if ( dR > dRmax ) dRmax = dR;
-	}
-      }
-    }
-  }
-  return dRmax;
+  return comp_max_dr_jet_impl(jets_cleaned, uncachedGeometry());
+}
+
+double comp_max_dr_jet(const std::vector<const RecoJet*>& jets_cleaned, const EventGeometry& geometry)
+{
+  return comp_max_dr_jet_impl(jets_cleaned, geometry);
 }
 
 double compHT(const std::vector<const RecoLepton*>& leptons, const std::vector<const RecoHadTau*>& hadTaus, const std::vector<const RecoJet*>& jets_cleaned)
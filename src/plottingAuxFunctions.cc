@@ -13,7 +13,12 @@
 #include <TObjArray.h>
 
 #include <iostream>
+#include <cstdio> // std::fflush()
+#include <cstring> // std::strerror()
+#include <cerrno> // errno
 #include <assert.h>
+#include <unistd.h> // fork()
+#include <sys/wait.h> // waitpid(), WIFEXITED, WEXITSTATUS, WIFSIGNALED, WTERMSIG
 
 typedef std::vector<std::string> vstring;
 typedef std::pair<double, double> pdouble; 
@@ -398,3 +403,47 @@ std::vector<plotEntryType*> readDistributions(const edm::VParameterSet& cfgDistr
   }
   return distributions;
 }
+
+unsigned forkWorkerProcesses(unsigned numProcesses, std::vector<int>& workerPIDs)
+{
+  workerPIDs.clear();
+  // flush buffered output, so that it does not get printed once more by every worker process
+  std::cout.flush();
+  std::fflush(0);
+  for ( unsigned idxProcess = 1; idxProcess < numProcesses; ++idxProcess ) {
+    pid_t pid = fork();
+    if ( pid < 0 ) {
+      throw cms::Exception("forkWorkerProcesses") 
+	<< "Failed to fork worker process #" << idxProcess << ": " << std::strerror(errno) << " !!\n";
+    }
+    if ( pid == 0 ) {
+      workerPIDs.clear();
+      return idxProcess;
+    }
+    workerPIDs.push_back(pid);
+  }
+  return 0;
+}
+
+void waitForWorkerProcesses(const std::vector<int>& workerPIDs)
+{
+  int numFailures = 0;
+  for ( std::vector<int>::const_iterator workerPID = workerPIDs.begin();
+	workerPID != workerPIDs.end(); ++workerPID ) {
+    int status = 0;
+    if ( waitpid(*workerPID, &status, 0) < 0 ) {
+      std::cerr << "Failed to wait for worker process with PID = " << (*workerPID) << ": " << std::strerror(errno) << " !!" << std::endl;
+      ++numFailures;
+    } else if ( WIFSIGNALED(status) ) {
+      std::cerr << "Worker process with PID = " << (*workerPID) << " was terminated by signal " << WTERMSIG(status) << " !!" << std::endl;
+      ++numFailures;
+    } else if ( WIFEXITED(status) && WEXITSTATUS(status) != 0 ) {
+      std::cerr << "Worker process with PID = " << (*workerPID) << " exited with status " << WEXITSTATUS(status) << " !!" << std::endl;
+      ++numFailures;
+    }
+  }
+  if ( numFailures > 0 ) {
+    throw cms::Exception("waitForWorkerProcesses") 
+      << numFailures << " out of " << workerPIDs.size() << " worker processes failed !!\n";
+  }
+}
@@ -80,6 +80,12 @@ process.analyze_2lss_1tau = cms.PSet(
 
     fillGenEvtHistograms = cms.bool(False),
 
+    # fill histograms of the final discriminants for the LHE scale variations (CMS_ttHl_thu_shape_*)
+    # and for the first numWeights_pdf PDF variations in the same job (requires central_or_shift = 'central')
+    fillHistograms_lheVariations = cms.bool(False),
+    lhePdfShiftName = cms.string('CMS_ttHl_pdf'),
+    numWeights_pdf = cms.int32(0),
+
     branchName_electrons = cms.string('selLeptons'),
     branchName_muons = cms.string('selLeptons'),
     branchName_hadTaus = cms.string('TauGood'),
@@ -95,6 +101,7 @@ process.analyze_2lss_1tau = cms.PSet(
     redoGenMatching = cms.bool(True),
 
     selEventsFileName_input = cms.string(''),
+    eventIndexFileNames_input = cms.vstring(),
     selEventsFileName_output = cms.string('selEvents_analyze_2lss_1tau.txt'),
     selectBDT = cms.bool(False)
 )
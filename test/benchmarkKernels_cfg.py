@@ -0,0 +1,55 @@
+import FWCore.ParameterSet.Config as cms
+
+import os
+
+process = cms.PSet()
+
+process.benchmarkKernels = cms.PSet(
+    era = cms.string('2016'),
+
+    # benchmarks to run; an empty list runs all of them:
+    # 'RecoJetReader::read', 'ParticleCollectionCleaner', 'RecoHadTauSelectorBase', 'lutWrapperBase::getSF',
+    # 'TMVAInterface::operator()', 'XGBReader', 'HadTopKinFit::fit', 'HadTopTagger::operator()',
+    # 'fill', 'fillWithOverFlow', 'addHistograms'
+    benchmarks = cms.vstring(),
+
+    # the synthetic events are drawn from a fixed seed, so that successive runs benchmark identical inputs
+    seed = cms.uint32(12345),
+    numEvents = cms.uint32(1000),
+    # number of operations for the fast benchmarks and for the slow ones (XGBReader, HadTopKinFit::fit, HadTopTagger::operator(), addHistograms)
+    numOps = cms.uint32(1000000),
+    numOps_slow = cms.uint32(1000),
+
+    # recorded Ntuple for the benchmark of RecoJetReader::read (skipped if empty)
+    inputFileName = cms.string(''),
+    treeName = cms.string('tree'),
+    branchName_jets = cms.string('Jet'),
+    numReadsPerEntry = cms.uint32(100),
+
+    lutFileName = cms.string('tthAnalysis/HiggsToTauTau/data/leptonSF/2016/el_scaleFactors_Moriond17.root'),
+    lutName = cms.string('GsfElectronToMVAVLooseFOIDEmuTightIP2D'),
+
+    mvaFileName = cms.string('tthAnalysis/HiggsToTauTau/data/2lss_1tau_ttV_BDTG.weights.xml'),
+    mvaInputVariables = cms.vstring(
+        'mindr_lep1_jet',
+        'mindr_lep2_jet',
+        'avg_dr_jet',
+        'TMath::Max(TMath::Abs(lep1_eta),TMath::Abs(lep2_eta))',
+        'lep1_conePt',
+        'lep2_conePt',
+        'mT_lep1',
+        'dr_leps',
+        'mTauTauVis1',
+        'mTauTauVis2',
+    ),
+
+    mvaFileName_hadTopTaggerWithKinFit = cms.string('all_HadTopTagger_sklearnV0o17o1_HypOpt_XGB_ntrees_1000_deph_3_lr_0o01_CSV_sort_withKinFit.pkl'),
+    mvaFileName_hadTopTaggerNoKinFit = cms.string('all_HadTopTagger_sklearnV0o17o1_HypOpt_XGB_ntrees_1000_deph_3_lr_0o01_CSV_sort.pkl'),
+
+    # results of a previous run to compare to (no comparison if empty), and file to which the results of this run are written (not written if empty);
+    # a benchmark is reported as a regression if it is slower than the baseline by more than the tolerance, or if it allocates more memory
+    baselineFileName_input = cms.string(''),
+    baselineFileName_output = cms.string('benchmarkKernels_baseline.txt'),
+    tolerance = cms.double(0.10),
+    failOnRegression = cms.bool(False),
+)
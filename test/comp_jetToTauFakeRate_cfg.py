@@ -52,5 +52,8 @@ process.comp_jetToTauFakeRate = cms.PSet(
 
     fitFunction = cms.string("[0] + [1]*x"),
     xMin = cms.double(0.),
-    xMax = cms.double(200.)
+    xMax = cms.double(200.),
+
+    makeControlPlots = cms.bool(True),
+    numThreads = cms.uint32(1)
 )
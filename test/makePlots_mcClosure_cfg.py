@@ -50,5 +50,7 @@ process.makePlots_mcClosure = cms.PSet(
     labelOnTop = cms.string("CMS Simulation; ttH, H #rightarrow #tau#tau; %1.1f fb^{-1} at #sqrt{s} = 13 TeV"),    
     intLumiData = cms.double(12.9), # in units of fb^-1
 
-    outputFileName = cms.string("plots/makePlots_mcClosure.png")
+    outputFileName = cms.string("plots/makePlots_mcClosure.png"),
+
+    numProcesses = cms.uint32(1) # number of processes in which the plots are made
 )
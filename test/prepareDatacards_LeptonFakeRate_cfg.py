@@ -232,6 +232,8 @@ process.prepareDatacards = cms.PSet(
             ),
         ),
     makeSubDir = cms.bool(True),
+    # number of threads in which the categories are processed
+    numThreads = cms.uint32(1),
 
     histogramToFit = cms.string("mT_fix_L"),
     histogramToFit_rebin = cms.int32(1),
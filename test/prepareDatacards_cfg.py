@@ -38,6 +38,8 @@ process.prepareDatacards = cms.PSet(
         )
     ),
     makeSubDir = cms.bool(False),
+    # number of threads in which the categories are processed
+    numThreads = cms.uint32(1),
 
     histogramToFit = cms.string("mvaDiscr_2lss"),
     histogramToFit_rebin = cms.int32(1),
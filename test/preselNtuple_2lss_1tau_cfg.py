@@ -37,6 +37,18 @@ process.produceNtuple_2lss_1tau = cms.PSet(
     
     selEventsFileName_input = cms.string(''),
 
+    eventIndexFileName_output = cms.string(''),
+    # name of the Ntuple recorded in the event index ('' = fwliteOutput.fileName)
+    eventIndexNtupleFileName = cms.string(''),
+
+    # compression of the output Ntuple: 'LZ4' (fast, for intermediate Ntuples), 'LZMA' (small, for archival), 'ZLIB' or '' (ROOT default)
+    outputCompression = cms.string(''),
+    outputCompressionLevel = cms.int32(4),
+    # optimize basket sizes after the first N entries (0 = ROOT default)
+    outputAutoFlush = cms.int32(0),
+    # number of threads for compressing the baskets of the output Ntuple
+    outputNumThreads = cms.uint32(0),
+
     selEventsFileName_addMEM = cms.string(''),
 
     outputCommands = cms.vstring(
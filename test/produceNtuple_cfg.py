@@ -46,6 +46,18 @@ process.produceNtuple = cms.PSet(
 
     selEventsFileName_input = cms.string(''),
 
+    eventIndexFileName_output = cms.string(''),
+    # name of the Ntuple recorded in the event index ('' = fwliteOutput.fileName)
+    eventIndexNtupleFileName = cms.string(''),
+
+    # compression of the output Ntuple: 'LZ4' (fast, for intermediate Ntuples), 'LZMA' (small, for archival), 'ZLIB' or '' (ROOT default)
+    outputCompression = cms.string(''),
+    outputCompressionLevel = cms.int32(4),
+    # optimize basket sizes after the first N entries (0 = ROOT default)
+    outputAutoFlush = cms.int32(0),
+    # number of threads for compressing the baskets of the output Ntuple
+    outputNumThreads = cms.uint32(0),
+
     #----------------------------------------------------------------------------
     # CV: Copy additional branches from input to output tree
     #     Note that branches that are accessed by
@@ -0,0 +1,57 @@
+import FWCore.ParameterSet.Config as cms
+
+process = cms.PSet()
+
+process.scanCuts = cms.PSet(
+    # Ntuples written by EvtTreeManager_2lss_1tau (or NtupleFillerBDT) with selectBDT = True
+    treeName = cms.string('2lss_1tau_lepSS_sumOS_Tight/sel/evtTree/evtTree'),
+
+    # selection applied to all samples before the scan, and weight of each event (TTree::Draw expressions)
+    selection = cms.string('nJet >= 3'),
+    weight = cms.string('evtWeight'),
+
+    samples = cms.VPSet(
+        cms.PSet(
+            name = cms.string('signal'),
+            type = cms.string('signal'), # either 'signal' or 'background'
+            inputFileNames = cms.vstring('analyze_2lss_1tau_ttHToNonbb.root'),
+            # optional: selection and weight in addition to the common ones
+            selection = cms.string(''),
+            weight = cms.string(''),
+        ),
+        cms.PSet(
+            name = cms.string('TTW'),
+            type = cms.string('background'),
+            inputFileNames = cms.vstring('analyze_2lss_1tau_TTW.root'),
+        ),
+        cms.PSet(
+            name = cms.string('TTZ'),
+            type = cms.string('background'),
+            inputFileNames = cms.vstring('analyze_2lss_1tau_TTZ.root'),
+        ),
+    ),
+
+    # each cut is one dimension of the grid; yields are computed for all combinations of thresholds
+    cuts = cms.VPSet(
+        cms.PSet(
+            expression = cms.string('tau_pt'),
+            operator = cms.string('>'), # one of '>', '>=', '<', '<='
+            thresholds = cms.vdouble(20., 25., 30., 35., 40.),
+        ),
+        cms.PSet(
+            expression = cms.string('TMath::Min(lep1_conePt, lep2_conePt)'),
+            operator = cms.string('>'),
+            thresholds = cms.vdouble(10., 15., 20., 25.),
+        ),
+        cms.PSet(
+            expression = cms.string('nBJetMedium'),
+            operator = cms.string('>='),
+            thresholds = cms.vdouble(0., 1., 2.),
+        ),
+    ),
+
+    maxEvents = cms.int32(-1),
+    outputEvery = cms.uint32(100000),
+
+    outputFileName = cms.string('scanCuts.txt'),
+)
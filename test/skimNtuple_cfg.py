@@ -0,0 +1,122 @@
+import FWCore.ParameterSet.Config as cms
+
+import os
+
+process = cms.PSet()
+
+process.fwliteInput = cms.PSet(
+    fileNames = cms.vstring('produceNtuple.root'),
+
+    maxEvents = cms.int32(-1),
+    outputEvery = cms.uint32(100000)
+)
+
+# branches read by the analyze_* executables in addition to the branches read by the
+# RecoElectron, RecoMuon, RecoHadTau, RecoJet, RecoMEt and GenLepton, GenHadTau, GenJet reader classes,
+# which are kept automatically
+outputCommands_analyze = cms.vstring(
+    "drop *",
+    "keep isData",
+    "keep HLT_BIT_HLT_*",
+    "keep Flag_*",
+    "keep xsec",
+    "keep *LHE*",
+    "keep nPU",
+    "keep nPVs",
+    "keep rho*",
+    "keep puWeight*",
+    "keep genWeight*",
+    "keep btagWeight*",
+    "keep genHiggsDecayMode",
+    "keep genTTH*",
+    "keep *maxPermutations*",
+)
+
+process.skimNtuple = cms.PSet(
+    treeName = cms.string('tree'),
+
+    era = cms.string('2016'),
+
+    # loosest selection applied by any of the analyze_* executables
+    leptonSelection = cms.string('Fakeable'),
+    hadTauSelection = cms.string('Fakeable|dR03mvaMedium'),
+
+    branchName_electrons = cms.string('Electron'),
+    branchName_muons = cms.string('Muon'),
+    branchName_hadTaus = cms.string('HadTau'),
+    branchName_jets = cms.string('Jet'),
+    branchName_met = cms.string('met'),
+    branchName_genLeptons1 = cms.string('GenLep'),
+    branchName_genLeptons2 = cms.string(''),
+    branchName_genHadTaus = cms.string('GenHadTaus'),
+    branchName_genJets = cms.string('GenJet'),
+
+    use_HIP_mitigation_mediumMuonId = cms.bool(False),
+
+    isMC = cms.bool(True),
+
+    selEventsFileName_input = cms.string(''),
+
+    # compression of the output Ntuples: 'LZ4' (fast, for intermediate Ntuples), 'LZMA' (small, for archival), 'ZLIB' or '' (ROOT default)
+    outputCompression = cms.string('LZ4'),
+    outputCompressionLevel = cms.int32(4),
+    # optimize basket sizes after the first N entries (0 = ROOT default)
+    outputAutoFlush = cms.int32(10000),
+    # number of threads for compressing the baskets of the output Ntuples
+    outputNumThreads = cms.uint32(0),
+
+    # each event is written to the output Ntuple of every channel whose preselection it passes;
+    # an empty list of triggers disables the trigger requirement, otherwise at least one of the triggers needs to fire
+    channels = cms.VPSet(
+        cms.PSet(
+            name = cms.string('2lss_1tau'),
+            outputFileName = cms.string('skimNtuple_2lss_1tau.root'),
+            manifestFileName = cms.string('skimNtuple_2lss_1tau_manifest.txt'),
+            minNumLeptons = cms.int32(2),
+            minNumHadTaus = cms.int32(1),
+            minNumLeptons_and_HadTaus = cms.int32(3),
+            minNumJets = cms.int32(2),
+            minNumBJets_loose = cms.int32(2),
+            minNumBJets_medium = cms.int32(1),
+            triggers = cms.vstring(),
+            outputCommands = outputCommands_analyze,
+        ),
+        cms.PSet(
+            name = cms.string('1l_2tau'),
+            outputFileName = cms.string('skimNtuple_1l_2tau.root'),
+            manifestFileName = cms.string('skimNtuple_1l_2tau_manifest.txt'),
+            minNumLeptons = cms.int32(1),
+            minNumHadTaus = cms.int32(2),
+            minNumLeptons_and_HadTaus = cms.int32(3),
+            minNumJets = cms.int32(2),
+            minNumBJets_loose = cms.int32(2),
+            minNumBJets_medium = cms.int32(1),
+            # OR of all triggers enabled in test/analyze_1l_2tau_cfg.py
+            triggers = cms.vstring('HLT_BIT_HLT_Ele23_WPLoose_Gsf_v', 'HLT_BIT_HLT_IsoMu20_v', 'HLT_BIT_HLT_IsoTkMu20_v'),
+            outputCommands = outputCommands_analyze,
+        ),
+        cms.PSet(
+            name = cms.string('0l_2tau'),
+            outputFileName = cms.string('skimNtuple_0l_2tau.root'),
+            manifestFileName = cms.string('skimNtuple_0l_2tau_manifest.txt'),
+            minNumLeptons = cms.int32(0),
+            minNumHadTaus = cms.int32(2),
+            minNumLeptons_and_HadTaus = cms.int32(2),
+            minNumJets = cms.int32(2),
+            minNumBJets_loose = cms.int32(2),
+            minNumBJets_medium = cms.int32(1),
+            triggers = cms.vstring(),
+            outputCommands = outputCommands_analyze,
+        ),
+    ),
+
+    copy_histograms = cms.vstring(
+        "Count",
+        "CountFullWeighted",
+        "CountWeighted",
+        "CountPosWeight",
+        "CountNegWeight",
+        "CountWeightedLHEWeightScale",
+        "CountWeightedLHEWeightPdf",
+    ),
+)
@@ -84,6 +84,7 @@ process.syncNtuple = cms.PSet(
         )
     ),    
     debug = cms.bool(False), # set it to True if you select only few events
+    numWorkers = cms.uint32(1), # number of processes over which the input entries are split; their outputs are merged at the end
     lumiScale = cms.double(0.002600),
     apply_trigger_bits = cms.bool(True),
     #apply_leptonGenMatching = cms.bool(True)
@@ -0,0 +1,93 @@
+import FWCore.ParameterSet.Config as cms
+
+import os
+
+process = cms.PSet()
+
+process.fwliteInput = cms.PSet(
+    fileNames = cms.vstring(),
+
+    maxEvents = cms.int32(-1),
+
+    outputEvery = cms.uint32(100000)
+)
+
+process.fwliteInput.fileNames = cms.vstring(
+    '/home/arun/ttHAnalysis/2016Aug09_dR03mvaVVLoose/histograms/histograms_harvested_stage1_1l_2tau.root'
+)
+
+process.trainTTHMVA_scan = cms.PSet(
+
+    treeName = cms.string('evtTree'),
+
+    signalDirPath = cms.string('1l_2tau_OS_Tight/sel/evtntuple/signal'),
+    backgroundDirPath = cms.string('1l_2tau_OS_Tight/sel/evtntuple/TT'),
+
+    branchNameEvtWeight = cms.string(''),
+
+    mvaName = cms.string("mvaTTHvsTTbar1l2tau"),
+    mvaConfigurations = cms.VPSet(
+        cms.PSet(
+            name = cms.string("BDTG_NTrees500_MaxDepth3"),
+            mvaMethodType = cms.string("BDT"),
+            mvaTrainingOptions = cms.string(
+                "!H:!V:NTrees=500:BoostType=Grad:Shrinkage=0.30:UseBaggedBoost:GradBaggingFraction=0.5:SeparationType=GiniIndex:nCuts=500:PruneMethod=NoPruning:MaxDepth=3"
+            )
+        ),
+        cms.PSet(
+            name = cms.string("BDTG_NTrees1000_MaxDepth3"),
+            mvaMethodType = cms.string("BDT"),
+            mvaTrainingOptions = cms.string(
+                "!H:!V:NTrees=1000:BoostType=Grad:Shrinkage=0.10:UseBaggedBoost:GradBaggingFraction=0.5:SeparationType=GiniIndex:nCuts=500:PruneMethod=NoPruning:MaxDepth=3"
+            )
+        ),
+        cms.PSet(
+            name = cms.string("BDTG_NTrees500_MaxDepth4"),
+            mvaMethodType = cms.string("BDT"),
+            mvaTrainingOptions = cms.string(
+                "!H:!V:NTrees=500:BoostType=Grad:Shrinkage=0.30:UseBaggedBoost:GradBaggingFraction=0.5:SeparationType=GiniIndex:nCuts=500:PruneMethod=NoPruning:MaxDepth=4"
+            )
+        )
+    ),
+    inputVariables = cms.vstring(
+        'lep_pt/F',
+        'lep_eta/F',
+        'lep_tth_mva/F',
+        'mindr_lep_jet/F',
+        'mindr_tau1_jet/F',
+        'mindr_tau2_jet/F',
+        'avg_dr_jet/F',
+        'ptmiss/F',
+        'mT_lep/F',
+        'htmiss/F',
+        'tau1_pt/F',
+        'tau2_pt/F',
+        'tau1_eta/F',
+        'tau2_eta/F',
+        'dr_lep_tau_os/F',
+        'dr_lep_tau_ss/F',
+        'dr_taus/F',
+        'mTauTauVis/F'
+    ),
+    spectatorVariables = cms.vstring(
+        'nJet/I',
+        'nBJetLoose/I',
+        'nBJetMedium/I',
+        'tau1_mva/F',
+        'tau2_mva/F'
+    ),
+
+    # number of MVA configurations trained in parallel (in forked processes)
+    numProcesses = cms.uint32(1),
+    # suppress the printout of TMVA
+    isSilent = cms.bool(False),
+    # ROOT file in which the input and spectator variables of the selected events are cached;
+    # read instead of the input files if it exists and has been written for the same variables
+    featureCacheFileName = cms.string(''),
+    # seed for splitting the events into training and test samples
+    splitSeed = cms.uint32(100),
+
+    # one output file per MVA configuration, with the name of the configuration appended
+    outputFileName = cms.string('trainTTHMVA_scan_1l_2tau.root'),
+    reportFileName = cms.string('trainTTHMVA_scan_1l_2tau.txt')
+)